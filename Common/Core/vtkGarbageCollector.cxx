@@ -18,6 +18,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointerBase.h"
 
+#include <atomic>
+#include <mutex>
 #include <queue>
 #include <sstream>
 #include <stack>
@@ -181,8 +183,21 @@ public:
   int TotalNumberOfReferences;
 
   // The number of times DeferredCollectionPush has been called not
-  // matched by a DeferredCollectionPop.
-  int DeferredCollectionCount;
+  // matched by a DeferredCollectionPop.  Other threads read it to decide
+  // whether to hand over their references.
+  std::atomic<int> DeferredCollectionCount;
+
+  // Accept a reference released by a thread other than the main thread.
+  int GiveThreadReference(vtkObjectBase* obj);
+
+  // Release the references accepted by GiveThreadReference.  Called from
+  // the main thread.
+  void ReleaseThreadReferences();
+
+  // References handed over by other threads while collection is
+  // deferred, protected by ThreadReferencesMutex.
+  std::vector<vtkObjectBase*> ThreadReferences;
+  std::mutex ThreadReferencesMutex;
 };
 
 //----------------------------------------------------------------------------
@@ -933,15 +948,25 @@ int vtkGarbageCollector::GiveReference(vtkObjectBase* obj)
   assert(obj != nullptr);
 
   // See if the singleton will accept a reference.
-  if (vtkGarbageCollectorIsMainThread() && vtkGarbageCollectorSingletonInstance)
+  if (vtkGarbageCollectorSingletonInstance)
   {
-    return vtkGarbageCollectorSingletonInstance->GiveReference(obj);
+    if (vtkGarbageCollectorIsMainThread())
+    {
+      return vtkGarbageCollectorSingletonInstance->GiveReference(obj);
+    }
+    return vtkGarbageCollectorSingletonInstance->GiveThreadReference(obj);
   }
 
   // Could not accept the reference.
   return 0;
 }
 
+//----------------------------------------------------------------------------
+bool vtkGarbageCollector::IsMainThread()
+{
+  return vtkGarbageCollectorIsMainThread() != 0;
+}
+
 //----------------------------------------------------------------------------
 int vtkGarbageCollector::TakeReference(vtkObjectBase* obj)
 {
@@ -970,6 +995,7 @@ vtkGarbageCollectorSingleton::~vtkGarbageCollectorSingleton()
 {
   // There should be no deferred collections left.
   assert(this->TotalNumberOfReferences == 0);
+  assert(this->ThreadReferences.empty());
 }
 
 //----------------------------------------------------------------------------
@@ -1019,6 +1045,40 @@ int vtkGarbageCollectorSingleton::TakeReference(vtkObjectBase* obj)
   return 0;
 }
 
+//----------------------------------------------------------------------------
+int vtkGarbageCollectorSingleton::GiveThreadReference(vtkObjectBase* obj)
+{
+  // Walking the reference graph from this thread could race with other
+  // threads modifying it.  While the main thread defers collection, keep
+  // the reference instead and let the main thread release it later.
+  if (this->DeferredCollectionCount.load() <= 0)
+  {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(this->ThreadReferencesMutex);
+  if (this->DeferredCollectionCount.load() <= 0)
+  {
+    return 0;
+  }
+  this->ThreadReferences.push_back(obj);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkGarbageCollectorSingleton::ReleaseThreadReferences()
+{
+  std::vector<vtkObjectBase*> references;
+  {
+    std::lock_guard<std::mutex> lock(this->ThreadReferencesMutex);
+    references.swap(this->ThreadReferences);
+  }
+  // Releasing from the main thread may collect or defer as usual.
+  for (vtkObjectBase* obj : references)
+  {
+    obj->UnRegister(nullptr);
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkTypeBool vtkGarbageCollectorSingleton::CheckAccept()
 {
@@ -1045,9 +1105,17 @@ void vtkGarbageCollectorSingleton::DeferredCollectionPush()
 //----------------------------------------------------------------------------
 void vtkGarbageCollectorSingleton::DeferredCollectionPop()
 {
-  if (--this->DeferredCollectionCount <= 0)
+  int count;
   {
-    // Deferred collection is disabled.  Collect immediately.
+    // Once the count drops, other threads no longer hand over references.
+    std::lock_guard<std::mutex> lock(this->ThreadReferencesMutex);
+    count = --this->DeferredCollectionCount;
+  }
+  if (count <= 0)
+  {
+    // Deferred collection is disabled.  Release references held for
+    // other threads and collect immediately.
+    this->ReleaseThreadReferences();
     vtkGarbageCollector::Collect();
   }
 }
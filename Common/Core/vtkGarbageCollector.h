@@ -130,12 +130,21 @@ public:
    * Push/Pop whether to do deferred collection.  Whenever the total
    * number of pushes exceeds the total number of pops collection will
    * be deferred.  Code can call the Collect method directly to force
-   * collection.
+   * collection.  These must be called from the main thread.  While
+   * collection is deferred, references released by other threads are
+   * also held and handed back to the main thread by the final pop, so
+   * that no thread walks a reference graph that others are modifying.
    */
   static void DeferredCollectionPush();
   static void DeferredCollectionPop();
   //@}
 
+  /**
+   * Return true when called from the main thread, the only thread that
+   * may push or pop deferred collection.
+   */
+  static bool IsMainThread();
+
   //@{
   /**
    * Set/Get global garbage collection debugging flag.  When set to true,
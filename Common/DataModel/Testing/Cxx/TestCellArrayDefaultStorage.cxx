@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellArrayDefaultStorage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Exercise the runtime default storage of vtkCellArray and report the memory
+// saved by compact 32-bit connectivity in an unstructured grid.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+namespace
+{
+
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(vtkIdType dim)
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(dim * dim * dim);
+  vtkIdType id = 0;
+  for (vtkIdType k = 0; k < dim; ++k)
+  {
+    for (vtkIdType j = 0; j < dim; ++j)
+    {
+      for (vtkIdType i = 0; i < dim; ++i)
+      {
+        points->SetPoint(id++, i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+
+  const vtkIdType numCells = (dim - 1) * (dim - 1) * (dim - 1);
+  grid->AllocateExact(numCells, 8 * numCells);
+  for (vtkIdType k = 0; k < dim - 1; ++k)
+  {
+    for (vtkIdType j = 0; j < dim - 1; ++j)
+    {
+      for (vtkIdType i = 0; i < dim - 1; ++i)
+      {
+        const vtkIdType p0 = i + dim * (j + dim * k);
+        const vtkIdType hex[8] = { p0, p0 + 1, p0 + 1 + dim, p0 + dim, p0 + dim * dim,
+          p0 + 1 + dim * dim, p0 + 1 + dim + dim * dim, p0 + dim + dim * dim };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+  return grid;
+}
+
+} // end anon namespace
+
+int TestCellArrayDefaultStorage(int, char*[])
+{
+  const bool originalDefault = vtkCellArray::GetDefaultStorageIs64Bit();
+  int status = EXIT_SUCCESS;
+
+  vtkCellArray::SetDefaultStorageIs64Bit(true);
+  auto grid64 = MakeGrid(64);
+  if (!grid64->GetCells()->IsStorage64Bit())
+  {
+    std::cerr << "Expected 64-bit storage with a 64-bit default.\n";
+    status = EXIT_FAILURE;
+  }
+
+  vtkCellArray::SetDefaultStorageIs64Bit(false);
+  auto grid32 = MakeGrid(64);
+  vtkCellArray* cells32 = grid32->GetCells();
+  if (cells32->IsStorage64Bit())
+  {
+    std::cerr << "Expected 32-bit storage with a 32-bit default.\n";
+    status = EXIT_FAILURE;
+  }
+
+  std::cout << "Connectivity memory, 64-bit storage: "
+            << grid64->GetCells()->GetActualMemorySize() << " kb\n";
+  std::cout << "Connectivity memory, 32-bit storage: " << cells32->GetActualMemorySize()
+            << " kb\n";
+  std::cout << "Grid memory, 64-bit storage: " << grid64->GetActualMemorySize() << " kb\n";
+  std::cout << "Grid memory, 32-bit storage: " << grid32->GetActualMemorySize() << " kb\n";
+  if (2 * cells32->GetActualMemorySize() > grid64->GetCells()->GetActualMemorySize() + 2)
+  {
+    std::cerr << "32-bit storage should use about half the memory.\n";
+    status = EXIT_FAILURE;
+  }
+
+  // Copies keep the storage of their source.
+  vtkNew<vtkCellArray> deepCopy;
+  deepCopy->Use64BitStorage();
+  deepCopy->DeepCopy(cells32);
+  vtkNew<vtkCellArray> shallowCopy;
+  shallowCopy->ShallowCopy(cells32);
+  if (deepCopy->IsStorage64Bit() || shallowCopy->IsStorage64Bit())
+  {
+    std::cerr << "Copies did not preserve 32-bit storage.\n";
+    status = EXIT_FAILURE;
+  }
+
+  // The default-storage methods follow the runtime setting.
+  vtkNew<vtkCellArray> converted;
+  converted->DeepCopy(grid64->GetCells());
+  if (!converted->ConvertToDefaultStorage() || converted->IsStorage64Bit() ||
+    converted->GetNumberOfCells() != cells32->GetNumberOfCells())
+  {
+    std::cerr << "ConvertToDefaultStorage did not produce 32-bit storage.\n";
+    status = EXIT_FAILURE;
+  }
+
+#ifdef VTK_USE_64BIT_IDS
+  // Appending with a point offset beyond the 32-bit range promotes storage.
+  vtkNew<vtkCellArray> appended;
+  appended->DeepCopy(cells32);
+  appended->Append(cells32, static_cast<vtkIdType>(VTK_TYPE_INT32_MAX) + 1);
+  if (!appended->IsStorage64Bit() ||
+    appended->GetNumberOfCells() != 2 * cells32->GetNumberOfCells())
+  {
+    std::cerr << "Append did not promote to 64-bit storage.\n";
+    status = EXIT_FAILURE;
+  }
+#endif
+
+  vtkCellArray::SetDefaultStorageIs64Bit(originalDefault);
+  return status;
+}
@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLinksCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that cell links are shared between datasets with the same topology
+// and invalidated when the topology changes.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+#define TEST_ASSERT(cond)                                                                          \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    std::cerr << "Failure at line " << __LINE__ << ": " #cond "\n";                                \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+
+void MakeQuads(vtkPoints* points, vtkCellArray* quads)
+{
+  const int dim = 10;
+  for (int j = 0; j < dim; ++j)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+    }
+  }
+  for (int j = 0; j < dim - 1; ++j)
+  {
+    for (int i = 0; i < dim - 1; ++i)
+    {
+      const vtkIdType p0 = i + dim * j;
+      const vtkIdType quad[4] = { p0, p0 + 1, p0 + 1 + dim, p0 + dim };
+      quads->InsertNextCell(4, quad);
+    }
+  }
+}
+
+int TestPolyData()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> quads;
+  MakeQuads(points, quads);
+
+  vtkNew<vtkPolyData> source;
+  source->SetPoints(points);
+  source->SetPolys(quads);
+  TEST_ASSERT(source->NeedToBuildLinks());
+  source->BuildLinks();
+  TEST_ASSERT(!source->NeedToBuildLinks());
+
+  // Shallow copies reuse the links, structure copies do not.
+  vtkNew<vtkPolyData> shallow;
+  shallow->ShallowCopy(source);
+  TEST_ASSERT(!shallow->NeedToBuildLinks());
+  vtkNew<vtkPolyData> structure;
+  structure->CopyStructure(source);
+  TEST_ASSERT(structure->NeedToBuildLinks());
+
+  // Modifying the connectivity invalidates the links.
+  quads->Modified();
+  TEST_ASSERT(source->NeedToBuildLinks());
+  TEST_ASSERT(shallow->NeedToBuildLinks());
+  source->BuildLinks();
+  TEST_ASSERT(!source->NeedToBuildLinks());
+
+  // So does adding a cell or replacing the cell arrays.
+  const vtkIdType tri[3] = { 0, 1, 10 };
+  source->InsertNextCell(VTK_TRIANGLE, 3, tri);
+  TEST_ASSERT(source->NeedToBuildLinks());
+  source->BuildLinks();
+  vtkNew<vtkCellArray> other;
+  other->DeepCopy(quads);
+  source->SetPolys(other);
+  TEST_ASSERT(source->NeedToBuildLinks());
+
+  return EXIT_SUCCESS;
+}
+
+int TestUnstructuredGrid()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> quads;
+  MakeQuads(points, quads);
+
+  vtkNew<vtkUnstructuredGrid> source;
+  source->SetPoints(points);
+  source->SetCells(VTK_QUAD, quads);
+  TEST_ASSERT(source->NeedToBuildLinks());
+  source->BuildLinks();
+  TEST_ASSERT(!source->NeedToBuildLinks());
+
+  vtkNew<vtkUnstructuredGrid> shallow;
+  shallow->ShallowCopy(source);
+  TEST_ASSERT(!shallow->NeedToBuildLinks());
+  TEST_ASSERT(shallow->GetCellLinks() == source->GetCellLinks());
+
+  // Editable grids need vtkCellLinks rather than static links.
+  shallow->SetEditable(true);
+  TEST_ASSERT(shallow->NeedToBuildLinks());
+
+  quads->Modified();
+  TEST_ASSERT(source->NeedToBuildLinks());
+  source->BuildLinks();
+  TEST_ASSERT(!source->NeedToBuildLinks());
+
+  vtkNew<vtkCellArray> other;
+  other->DeepCopy(quads);
+  source->SetCells(VTK_QUAD, other);
+  TEST_ASSERT(source->GetCellLinks() == nullptr);
+  TEST_ASSERT(source->NeedToBuildLinks());
+
+  return EXIT_SUCCESS;
+}
+
+} // end anon namespace
+
+int TestCellLinksCache(int, char*[])
+{
+  if (TestPolyData() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return TestUnstructuredGrid();
+}
@@ -22,6 +22,9 @@ vtkAbstractCellLinks::vtkAbstractCellLinks()
 {
   this->SequentialProcessing = false;
   this->Type = vtkAbstractCellLinks::LINKS_NOT_DEFINED;
+  this->BuildConnectivityMTime = 0;
+  this->BuildNumberOfPoints = -1;
+  this->BuildNumberOfCells = -1;
 }
 
 //----------------------------------------------------------------------------
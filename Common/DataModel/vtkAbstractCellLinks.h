@@ -142,6 +142,29 @@ public:
   vtkBooleanMacro(SequentialProcessing, bool);
   //@}
 
+  //@{
+  /**
+   * Record, and later compare against, the topology these links were built
+   * from: the modification time of the dataset connectivity and the number
+   * of points and cells. Datasets use this to reuse cached links (which are
+   * shared through ShallowCopy() and CopyStructure()) across pipeline stages
+   * until the topology changes. See vtkPolyData::NeedToBuildLinks() and
+   * vtkUnstructuredGrid::NeedToBuildLinks().
+   */
+  void SetBuildState(vtkMTimeType connectivityMTime, vtkIdType numPts, vtkIdType numCells)
+  {
+    this->BuildConnectivityMTime = connectivityMTime;
+    this->BuildNumberOfPoints = numPts;
+    this->BuildNumberOfCells = numCells;
+  }
+  bool IsBuildStateCurrent(
+    vtkMTimeType connectivityMTime, vtkIdType numPts, vtkIdType numCells) const
+  {
+    return this->BuildNumberOfPoints == numPts && this->BuildNumberOfCells == numCells &&
+      connectivityMTime <= this->BuildConnectivityMTime;
+  }
+  //@}
+
 protected:
   vtkAbstractCellLinks();
   ~vtkAbstractCellLinks() override;
@@ -149,6 +172,11 @@ protected:
   bool SequentialProcessing; // control whether to thread or not
   int Type;                  // derived classes set this instance variable when constructed
 
+  // Topology the links were built from, see SetBuildState().
+  vtkMTimeType BuildConnectivityMTime;
+  vtkIdType BuildNumberOfPoints;
+  vtkIdType BuildNumberOfCells;
+
 private:
   vtkAbstractCellLinks(const vtkAbstractCellLinks&) = delete;
   void operator=(const vtkAbstractCellLinks&) = delete;
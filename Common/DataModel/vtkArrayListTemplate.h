@@ -33,6 +33,13 @@
  * assigned. The operations on these array pairs (e.g., interpolation) occur
  * using a typeless, virtual dispatch base class.
  *
+ * Once built, an ArrayList acts as a copy plan: the array pairs and their
+ * typed kernels are resolved once. Besides the per-tuple operations, batched
+ * operations process many tuples per virtual call (gathering by id lists,
+ * scattering through a point map, interpolating edges or weighted stencils).
+ * All operations only write the given output tuples, so disjoint output
+ * ranges may be processed concurrently, e.g. from vtkSMPTools::For().
+ *
  * @sa
  * vtkFieldData vtkDataSetAttributes vtkPointData vtkCellData
  */
@@ -70,8 +77,121 @@ struct BaseArrayPair
   virtual void InterpolateEdge(vtkIdType v0, vtkIdType v1, double t, vtkIdType outId) = 0;
   virtual void AssignNullValue(vtkIdType outId) = 0;
   virtual void Realloc(vtkIdType sze) = 0;
+
+  // Batched operations. Subclasses override them with typed loops; these
+  // defaults fall back to the per-tuple methods.
+  // Copy input tuples inIds[i] to output tuples outStart + i.
+  virtual void Copy(vtkIdType num, const vtkIdType* inIds, vtkIdType outStart)
+  {
+    for (vtkIdType i = 0; i < num; ++i)
+    {
+      this->Copy(inIds[i], outStart + i);
+    }
+  }
+  // Copy input tuples [inStart, inEnd) to output tuples map[inId]; negative
+  // entries in the map are skipped.
+  virtual void CopyMapped(vtkIdType inStart, vtkIdType inEnd, const vtkIdType* map)
+  {
+    for (vtkIdType inId = inStart; inId < inEnd; ++inId)
+    {
+      if (map[inId] >= 0)
+      {
+        this->Copy(inId, map[inId]);
+      }
+    }
+  }
+  // Interpolate output tuple outStart + i along the edge (v0[i], v1[i]).
+  virtual void InterpolateEdge(
+    vtkIdType num, const vtkIdType* v0, const vtkIdType* v1, const double* t, vtkIdType outStart)
+  {
+    for (vtkIdType i = 0; i < num; ++i)
+    {
+      this->InterpolateEdge(v0[i], v1[i], t[i], outStart + i);
+    }
+  }
+  // Interpolate output tuple outStart + i from the numWeights ids and
+  // weights starting at ids + i * numWeights and weights + i * numWeights.
+  virtual void Interpolate(vtkIdType num, int numWeights, const vtkIdType* ids,
+    const double* weights, vtkIdType outStart)
+  {
+    for (vtkIdType i = 0; i < num; ++i)
+    {
+      this->Interpolate(numWeights, ids + i * numWeights, weights + i * numWeights, outStart + i);
+    }
+  }
 };
 
+// Typed kernels shared by the batched operations of the array pairs below.
+template <typename TInput, typename TOutput>
+void ArrayPairCopy(const TInput* input, TOutput* output, int numComp, vtkIdType num,
+  const vtkIdType* inIds, vtkIdType outStart)
+{
+  TOutput* out = output + outStart * numComp;
+  for (vtkIdType i = 0; i < num; ++i)
+  {
+    const TInput* in = input + inIds[i] * numComp;
+    for (int j = 0; j < numComp; ++j)
+    {
+      *out++ = static_cast<TOutput>(in[j]);
+    }
+  }
+}
+
+template <typename TInput, typename TOutput>
+void ArrayPairCopyMapped(const TInput* input, TOutput* output, int numComp, vtkIdType inStart,
+  vtkIdType inEnd, const vtkIdType* map)
+{
+  for (vtkIdType inId = inStart; inId < inEnd; ++inId)
+  {
+    const vtkIdType outId = map[inId];
+    if (outId >= 0)
+    {
+      const TInput* in = input + inId * numComp;
+      TOutput* out = output + outId * numComp;
+      for (int j = 0; j < numComp; ++j)
+      {
+        out[j] = static_cast<TOutput>(in[j]);
+      }
+    }
+  }
+}
+
+template <typename TInput, typename TOutput>
+void ArrayPairInterpolateEdge(const TInput* input, TOutput* output, int numComp, vtkIdType num,
+  const vtkIdType* v0, const vtkIdType* v1, const double* t, vtkIdType outStart)
+{
+  TOutput* out = output + outStart * numComp;
+  for (vtkIdType i = 0; i < num; ++i)
+  {
+    const TInput* in0 = input + v0[i] * numComp;
+    const TInput* in1 = input + v1[i] * numComp;
+    for (int j = 0; j < numComp; ++j)
+    {
+      const double a = static_cast<double>(in0[j]);
+      *out++ = static_cast<TOutput>(a + t[i] * (static_cast<double>(in1[j]) - a));
+    }
+  }
+}
+
+template <typename TInput, typename TOutput>
+void ArrayPairInterpolate(const TInput* input, TOutput* output, int numComp, vtkIdType num,
+  int numWeights, const vtkIdType* ids, const double* weights, vtkIdType outStart)
+{
+  TOutput* out = output + outStart * numComp;
+  for (vtkIdType i = 0; i < num; ++i, ids += numWeights, weights += numWeights)
+  {
+    for (int j = 0; j < numComp; ++j)
+    {
+      double v = 0.0;
+      for (int k = 0; k < numWeights; ++k)
+      {
+        v += weights[k] * static_cast<double>(input[ids[k] * numComp + j]);
+      }
+      *out++ = static_cast<TOutput>(v);
+    }
+  }
+}
+
 // Type specific interpolation on a matched pair of data arrays
 template <typename T>
 struct ArrayPair : public BaseArrayPair
@@ -91,6 +211,10 @@ struct ArrayPair : public BaseArrayPair
   {
   }
 
+  using BaseArrayPair::Copy;
+  using BaseArrayPair::Interpolate;
+  using BaseArrayPair::InterpolateEdge;
+
   void Copy(vtkIdType inId, vtkIdType outId) override
   {
     for (int j = 0; j < this->NumComp; ++j)
@@ -138,6 +262,28 @@ struct ArrayPair : public BaseArrayPair
     this->OutputArray->WriteVoidPointer(0, sze * this->NumComp);
     this->Output = static_cast<T*>(this->OutputArray->GetVoidPointer(0));
   }
+  void Copy(vtkIdType num, const vtkIdType* inIds, vtkIdType outStart) override
+  {
+    ArrayPairCopy(this->Input, this->Output, this->NumComp, num, inIds, outStart);
+  }
+
+  void CopyMapped(vtkIdType inStart, vtkIdType inEnd, const vtkIdType* map) override
+  {
+    ArrayPairCopyMapped(this->Input, this->Output, this->NumComp, inStart, inEnd, map);
+  }
+
+  void InterpolateEdge(vtkIdType num, const vtkIdType* v0, const vtkIdType* v1, const double* t,
+    vtkIdType outStart) override
+  {
+    ArrayPairInterpolateEdge(this->Input, this->Output, this->NumComp, num, v0, v1, t, outStart);
+  }
+
+  void Interpolate(vtkIdType num, int numWeights, const vtkIdType* ids, const double* weights,
+    vtkIdType outStart) override
+  {
+    ArrayPairInterpolate(
+      this->Input, this->Output, this->NumComp, num, numWeights, ids, weights, outStart);
+  }
 };
 
 // Type specific interpolation on a pair of data arrays with different types, where the
@@ -161,6 +307,10 @@ struct RealArrayPair : public BaseArrayPair
   {
   }
 
+  using BaseArrayPair::Copy;
+  using BaseArrayPair::Interpolate;
+  using BaseArrayPair::InterpolateEdge;
+
   void Copy(vtkIdType inId, vtkIdType outId) override
   {
     for (int j = 0; j < this->NumComp; ++j)
@@ -209,6 +359,28 @@ struct RealArrayPair : public BaseArrayPair
     this->OutputArray->WriteVoidPointer(0, sze * this->NumComp);
     this->Output = static_cast<TOutput*>(this->OutputArray->GetVoidPointer(0));
   }
+  void Copy(vtkIdType num, const vtkIdType* inIds, vtkIdType outStart) override
+  {
+    ArrayPairCopy(this->Input, this->Output, this->NumComp, num, inIds, outStart);
+  }
+
+  void CopyMapped(vtkIdType inStart, vtkIdType inEnd, const vtkIdType* map) override
+  {
+    ArrayPairCopyMapped(this->Input, this->Output, this->NumComp, inStart, inEnd, map);
+  }
+
+  void InterpolateEdge(vtkIdType num, const vtkIdType* v0, const vtkIdType* v1, const double* t,
+    vtkIdType outStart) override
+  {
+    ArrayPairInterpolateEdge(this->Input, this->Output, this->NumComp, num, v0, v1, t, outStart);
+  }
+
+  void Interpolate(vtkIdType num, int numWeights, const vtkIdType* ids, const double* weights,
+    vtkIdType outStart) override
+  {
+    ArrayPairInterpolate(
+      this->Input, this->Output, this->NumComp, num, numWeights, ids, weights, outStart);
+  }
 };
 
 // Forward declarations. This makes working with vtkTemplateMacro easier.
@@ -271,6 +443,42 @@ struct ArrayList
     }
   }
 
+  // Batched versions of Copy(), Interpolate() and InterpolateEdge(); see
+  // BaseArrayPair for the meaning of the arguments.
+  void Copy(vtkIdType num, const vtkIdType* inIds, vtkIdType outStart)
+  {
+    for (BaseArrayPair* pair : this->Arrays)
+    {
+      pair->Copy(num, inIds, outStart);
+    }
+  }
+
+  void CopyMapped(vtkIdType inStart, vtkIdType inEnd, const vtkIdType* map)
+  {
+    for (BaseArrayPair* pair : this->Arrays)
+    {
+      pair->CopyMapped(inStart, inEnd, map);
+    }
+  }
+
+  void InterpolateEdge(
+    vtkIdType num, const vtkIdType* v0, const vtkIdType* v1, const double* t, vtkIdType outStart)
+  {
+    for (BaseArrayPair* pair : this->Arrays)
+    {
+      pair->InterpolateEdge(num, v0, v1, t, outStart);
+    }
+  }
+
+  void Interpolate(vtkIdType num, int numWeights, const vtkIdType* ids, const double* weights,
+    vtkIdType outStart)
+  {
+    for (BaseArrayPair* pair : this->Arrays)
+    {
+      pair->Interpolate(num, numWeights, ids, weights, outStart);
+    }
+  }
+
   // Loop over the arrays and assign the null value
   void AssignNullValue(vtkIdType outId)
   {
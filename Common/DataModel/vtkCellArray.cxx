@@ -521,10 +521,41 @@ struct AppendImpl
 
 } // end anon namespace
 
-vtkCellArray::vtkCellArray() = default;
+#if defined(VTK_USE_64BIT_IDS) && !defined(VTK_CELL_ARRAY_DEFAULT_32BIT_STORAGE)
+bool vtkCellArray::DefaultStorageIs64Bit = true;
+#else
+bool vtkCellArray::DefaultStorageIs64Bit = false;
+#endif
+
+//----------------------------------------------------------------------------
+vtkCellArray::vtkCellArray()
+{
+  // Storage is constructed to match vtkIdType; honor the runtime default.
+  if (vtkCellArray::DefaultStorageIs64Bit)
+  {
+    this->Storage.Use64BitStorage();
+  }
+  else
+  {
+    this->Storage.Use32BitStorage();
+  }
+}
+
 vtkCellArray::~vtkCellArray() = default;
 vtkStandardNewMacro(vtkCellArray);
 
+//----------------------------------------------------------------------------
+bool vtkCellArray::GetDefaultStorageIs64Bit()
+{
+  return vtkCellArray::DefaultStorageIs64Bit;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetDefaultStorageIs64Bit(bool is64Bit)
+{
+  vtkCellArray::DefaultStorageIs64Bit = is64Bit;
+}
+
 //=================== Begin Legacy Methods ===================================
 // These should be deprecated at some point as they are confusing or very slow
 
@@ -715,6 +746,14 @@ void vtkCellArray::Append(vtkCellArray* src, vtkIdType pointOffset)
 {
   if (src->GetNumberOfCells() > 0)
   {
+    // Promote 32-bit storage if the combined arrays would overflow it.
+    if (!this->Storage.Is64Bit() &&
+      (pointOffset > VTK_TYPE_INT32_MAX ||
+        this->GetNumberOfConnectivityIds() + src->GetNumberOfConnectivityIds() >
+          VTK_TYPE_INT32_MAX))
+    {
+      this->ConvertTo64BitStorage();
+    }
     this->Visit(AppendImpl{}, src, pointOffset);
   }
 }
@@ -929,11 +968,14 @@ void vtkCellArray::Use64BitStorage()
 //----------------------------------------------------------------------------
 void vtkCellArray::UseDefaultStorage()
 {
-#ifdef VTK_USE_64BIT_IDS
-  this->Use64BitStorage();
-#else  // VTK_USE_64BIT_IDS
-  this->Use32BitStorage();
-#endif // VTK_USE_64BIT_IDS
+  if (vtkCellArray::DefaultStorageIs64Bit)
+  {
+    this->Use64BitStorage();
+  }
+  else
+  {
+    this->Use32BitStorage();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -955,11 +997,8 @@ bool vtkCellArray::CanConvertTo64BitStorage() const
 //----------------------------------------------------------------------------
 bool vtkCellArray::CanConvertToDefaultStorage() const
 {
-#ifdef VTK_USE_64BIT_IDS
-  return this->CanConvertTo64BitStorage();
-#else  // VTK_USE_64BIT_IDS
-  return this->CanConvertTo32BitStorage();
-#endif // VTK_USE_64BIT_IDS
+  return vtkCellArray::DefaultStorageIs64Bit ? this->CanConvertTo64BitStorage()
+                                             : this->CanConvertTo32BitStorage();
 }
 
 //----------------------------------------------------------------------------
@@ -1001,11 +1040,8 @@ bool vtkCellArray::ConvertTo64BitStorage()
 //----------------------------------------------------------------------------
 bool vtkCellArray::ConvertToDefaultStorage()
 {
-#ifdef VTK_USE_64BIT_IDS
-  return this->ConvertTo64BitStorage();
-#else  // VTK_USE_64BIT_IDS
-  return this->ConvertTo32BitStorage();
-#endif // VTK_USE_64BIT_IDS
+  return vtkCellArray::DefaultStorageIs64Bit ? this->ConvertTo64BitStorage()
+                                             : this->ConvertTo32BitStorage();
 }
 
 //----------------------------------------------------------------------------
@@ -1022,12 +1058,20 @@ bool vtkCellArray::ConvertToSmallestStorage()
 //----------------------------------------------------------------------------
 bool vtkCellArray::AllocateExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
+  if (!this->Storage.Is64Bit() && connectivitySize > VTK_TYPE_INT32_MAX)
+  {
+    this->Storage.Use64BitStorage();
+  }
   return this->Visit(AllocateExactImpl{}, numCells, connectivitySize);
 }
 
 //----------------------------------------------------------------------------
 bool vtkCellArray::ResizeExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
+  if (!this->Storage.Is64Bit() && connectivitySize > VTK_TYPE_INT32_MAX)
+  {
+    this->ConvertTo64BitStorage();
+  }
   return this->Visit(ResizeExactImpl{}, numCells, connectivitySize);
 }
 
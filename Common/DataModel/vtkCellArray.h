@@ -87,15 +87,25 @@
  * - `bool IsStorageShareable() // Can pointers to internal storage be shared`
  * - `void Use32BitStorage()`
  * - `void Use64BitStorage()`
- * - `void UseDefaultStorage() // Depends on vtkIdType`
+ * - `void UseDefaultStorage() // Depends on GetDefaultStorageIs64Bit()`
  * - `bool CanConvertTo32BitStorage()`
  * - `bool CanConvertTo64BitStorage()`
- * - `bool CanConvertToDefaultStorage() // Depends on vtkIdType`
+ * - `bool CanConvertToDefaultStorage() // Depends on GetDefaultStorageIs64Bit()`
  * - `bool ConvertTo32BitStorage()`
  * - `bool ConvertTo64BitStorage()`
- * - `bool ConvertToDefaultStorage() // Depends on vtkIdType`
+ * - `bool ConvertToDefaultStorage() // Depends on GetDefaultStorageIs64Bit()`
  * - `bool ConvertToSmallestStorage() // Depends on current values in arrays`
  *
+ * Newly constructed cell arrays use the default storage, which follows
+ * vtkIdType unless VTK is configured with VTK_CELL_ARRAY_DEFAULT_32BIT_STORAGE
+ * or SetDefaultStorageIs64Bit(false) is called. With 32-bit default storage,
+ * readers convert the arrays they load to the smallest storage and filters
+ * keep producing 32-bit cell arrays, which halves the connectivity memory of
+ * unstructured grids and polydata. Allocation and Append() switch to 64-bit
+ * storage when the requested connectivity size does not fit in 32 bits;
+ * point ids themselves are not checked, so datasets with more than 2^31 points
+ * must request 64-bit storage explicitly.
+ *
  * Note that some legacy methods are still available that reflect the
  * previous storage format of this data, which embedded the cell sizes into
  * the Connectivity array:
@@ -424,8 +434,8 @@ public:
 
   /**
    * Initialize internal data structures to use 32- or 64-bit storage.
-   * If selecting default storage, the storage depends on the VTK_USE_64BIT_IDS
-   * setting.
+   * If selecting default storage, the storage depends on
+   * GetDefaultStorageIs64Bit().
    *
    * All existing data is erased.
    * @{
@@ -435,12 +445,23 @@ public:
   void UseDefaultStorage();
   /**@}*/
 
+  /**
+   * Control the storage used by newly constructed cell arrays and by the
+   * *DefaultStorage methods. The initial value is true when vtkIdType is
+   * 64-bit, unless VTK was built with VTK_CELL_ARRAY_DEFAULT_32BIT_STORAGE.
+   * Changing the default does not affect existing cell arrays.
+   * @{
+   */
+  static bool GetDefaultStorageIs64Bit();
+  static void SetDefaultStorageIs64Bit(bool is64Bit);
+  /**@}*/
+
   /**
    * Check if the existing data can safely be converted to use 32- or 64- bit
    * storage. Ensures that all values can be converted to the target storage
    * without truncating.
-   * If selecting default storage, the storage depends on the VTK_USE_64BIT_IDS
-   * setting.
+   * If selecting default storage, the storage depends on
+   * GetDefaultStorageIs64Bit().
    * @{
    */
   bool CanConvertTo32BitStorage() const;
@@ -451,8 +472,8 @@ public:
   /**
    * Convert internal data structures to use 32- or 64-bit storage.
    *
-   * If selecting default storage, the storage depends on the VTK_USE_64BIT_IDS
-   * setting.
+   * If selecting default storage, the storage depends on
+   * GetDefaultStorageIs64Bit().
    *
    * If selecting smallest storage, the data is checked to see what the smallest
    * safe storage for the existing data is, and then converts to it.
@@ -1226,6 +1247,8 @@ protected:
 
   vtkNew<vtkIdTypeArray> LegacyData; // For GetData().
 
+  static bool DefaultStorageIs64Bit;
+
 private:
   vtkCellArray(const vtkCellArray&) = delete;
   void operator=(const vtkCellArray&) = delete;
@@ -574,8 +574,9 @@ void vtkPolyData::SetVerts(vtkCellArray* v)
   {
     this->Verts = v;
 
-    // Reset the cell table:
+    // Reset the cell table and links:
     this->Cells = nullptr;
+    this->Links = nullptr;
 
     this->Modified();
   }
@@ -609,8 +610,9 @@ void vtkPolyData::SetLines(vtkCellArray* l)
   {
     this->Lines = l;
 
-    // Reset the cell table:
+    // Reset the cell table and links:
     this->Cells = nullptr;
+    this->Links = nullptr;
 
     this->Modified();
   }
@@ -644,8 +646,9 @@ void vtkPolyData::SetPolys(vtkCellArray* p)
   {
     this->Polys = p;
 
-    // Reset the cell table:
+    // Reset the cell table and links:
     this->Cells = nullptr;
+    this->Links = nullptr;
 
     this->Modified();
   }
@@ -679,8 +682,9 @@ void vtkPolyData::SetStrips(vtkCellArray* s)
   {
     this->Strips = s;
 
-    // Reset the cell table:
+    // Reset the cell table and links:
     this->Cells = nullptr;
+    this->Links = nullptr;
 
     this->Modified();
   }
@@ -988,6 +992,39 @@ void vtkPolyData::BuildLinks(int initialSize)
   }
 
   this->Links->BuildLinks(this);
+  this->Links->SetBuildState(
+    this->GetTopologyMTime(), this->GetNumberOfPoints(), this->GetNumberOfCells());
+}
+
+//----------------------------------------------------------------------------
+bool vtkPolyData::NeedToBuildLinks()
+{
+  return !this->Links ||
+    !this->Links->IsBuildStateCurrent(
+      this->GetTopologyMTime(), this->GetNumberOfPoints(), this->GetNumberOfCells());
+}
+
+//----------------------------------------------------------------------------
+vtkMTimeType vtkPolyData::GetTopologyMTime()
+{
+  vtkMTimeType time = 0;
+  if (this->Verts)
+  {
+    time = vtkMath::Max(this->Verts->GetMTime(), time);
+  }
+  if (this->Lines)
+  {
+    time = vtkMath::Max(this->Lines->GetMTime(), time);
+  }
+  if (this->Polys)
+  {
+    time = vtkMath::Max(this->Polys->GetMTime(), time);
+  }
+  if (this->Strips)
+  {
+    time = vtkMath::Max(this->Strips->GetMTime(), time);
+  }
+  return time;
 }
 
 //----------------------------------------------------------------------------
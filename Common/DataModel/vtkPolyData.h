@@ -350,6 +350,17 @@ public:
    */
   void BuildLinks(int initialSize = 0);
 
+  /**
+   * Check if BuildLinks is needed. Links are shared with other datasets
+   * through ShallowCopy(), so filters that only query
+   * the links can call BuildLinks() when this returns true and reuse links
+   * built upstream otherwise. Links are considered out of date when the
+   * cell arrays have been replaced or modified, or the number of points or
+   * cells has changed. Filters that edit the links in place should always
+   * call BuildLinks() to get their own copy.
+   */
+  bool NeedToBuildLinks();
+
   /**
    * Release data structure that allows random access of the cells. This must
    * be done before a 2nd call to BuildLinks(). DeleteCells implicitly deletes
@@ -674,6 +685,9 @@ protected:
   vtkSmartPointer<CellMap> Cells;
   vtkSmartPointer<vtkCellLinks> Links;
 
+  // Modification time of the verts, lines, polys and strips cell arrays.
+  vtkMTimeType GetTopologyMTime();
+
   vtkNew<vtkIdList> LegacyBuffer;
 
   // dummy static member below used as a trick to simplify traversal
@@ -1399,6 +1399,11 @@ void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray* cellTypes, vtkCellArray
 void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray* cellTypes, vtkCellArray* cells,
   vtkIdTypeArray* faceLocations, vtkIdTypeArray* faces)
 {
+  if (cells != this->Connectivity)
+  {
+    // Links built for the previous connectivity are no longer valid.
+    this->Links = nullptr;
+  }
   this->Connectivity = cells;
   this->Types = cellTypes;
   this->DistinctCellTypes = nullptr;
@@ -1426,6 +1431,28 @@ void vtkUnstructuredGrid::BuildLinks()
   }
 
   this->Links->BuildLinks(this);
+  this->Links->SetBuildState(
+    this->Connectivity ? this->Connectivity->GetMTime() : 0, numPts, this->GetNumberOfCells());
+}
+
+//----------------------------------------------------------------------------
+bool vtkUnstructuredGrid::NeedToBuildLinks()
+{
+  if (!this->Links)
+  {
+    return true;
+  }
+
+  // The links type must match the one BuildLinks() would create, since
+  // GetPointCells() and friends cast according to Editable.
+  const bool isStatic = this->Links->IsA("vtkStaticCellLinks") != 0;
+  if (isStatic == this->Editable)
+  {
+    return true;
+  }
+
+  return !this->Links->IsBuildStateCurrent(this->Connectivity ? this->Connectivity->GetMTime() : 0,
+    this->GetNumberOfPoints(), this->GetNumberOfCells());
 }
 
 //----------------------------------------------------------------------------
@@ -241,6 +241,16 @@ public:
    */
   void BuildLinks();
 
+  /**
+   * Check if BuildLinks is needed. Links are shared with other grids through
+   * ShallowCopy() and CopyStructure(), so filters that only query the links
+   * can call BuildLinks() when this returns true and reuse links built
+   * upstream otherwise. Links are considered out of date when the
+   * connectivity has been replaced or modified, the number of points or cells
+   * has changed, or the Editable flag no longer matches the links type.
+   */
+  bool NeedToBuildLinks();
+
   /**
    * Get the cell links. The cell links will be one of nullptr=0;
    * vtkCellLinks=1; vtkStaticCellLinksTemplate<VTK_UNSIGNED_SHORT>=2;
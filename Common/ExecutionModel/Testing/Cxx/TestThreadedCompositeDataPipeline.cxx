@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedCompositeDataPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Run a chain of simple filters over a multiblock dataset with both the
+// serial and the threaded composite executive, compare the results and
+// report timings. Pass "--blocks N" and "--depth D" to use it as a
+// benchmark, e.g. with 10000 blocks.
+
+#include "vtkCompositeDataPipeline.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkThreadedCompositeDataPipeline.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+vtkSmartPointer<vtkMultiBlockDataSet> RunChain(
+  vtkMultiBlockDataSet* input, int depth, bool threaded, double& seconds)
+{
+  std::vector<vtkSmartPointer<vtkElevationFilter>> chain;
+  for (int i = 0; i < depth; ++i)
+  {
+    auto filter = vtkSmartPointer<vtkElevationFilter>::New();
+    if (threaded)
+    {
+      vtkNew<vtkThreadedCompositeDataPipeline> executive;
+      filter->SetExecutive(executive);
+    }
+    else
+    {
+      vtkNew<vtkCompositeDataPipeline> executive;
+      filter->SetExecutive(executive);
+    }
+    filter->SetLowPoint(0.0, 0.0, -i);
+    filter->SetHighPoint(0.0, 0.0, i + 1.0);
+    if (i == 0)
+    {
+      filter->SetInputData(input);
+    }
+    else
+    {
+      filter->SetInputConnection(chain.back()->GetOutputPort());
+    }
+    chain.push_back(filter);
+  }
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  chain.back()->Update();
+  timer->StopTimer();
+  seconds = timer->GetElapsedTime();
+
+  auto output = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  output->ShallowCopy(chain.back()->GetOutputDataObject(0));
+  return output;
+}
+
+} // end anon namespace
+
+int TestThreadedCompositeDataPipeline(int argc, char* argv[])
+{
+  unsigned int numBlocks = 500;
+  int depth = 4;
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    if (strcmp(argv[i], "--blocks") == 0)
+    {
+      numBlocks = static_cast<unsigned int>(atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "--depth") == 0)
+    {
+      depth = atoi(argv[++i]);
+    }
+  }
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(16);
+  sphere->SetPhiResolution(16);
+  sphere->Update();
+
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(numBlocks);
+  for (unsigned int i = 0; i < numBlocks; ++i)
+  {
+    vtkNew<vtkPolyData> block;
+    block->ShallowCopy(sphere->GetOutput());
+    input->SetBlock(i, block);
+  }
+
+  double serialTime = 0.0;
+  double threadedTime = 0.0;
+  auto serial = RunChain(input, depth, false, serialTime);
+  auto threaded = RunChain(input, depth, true, threadedTime);
+
+  std::cout << numBlocks << " blocks, " << depth << " filters, "
+            << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+  std::cout << "Serial composite pipeline:   " << serialTime << " s\n";
+  std::cout << "Threaded composite pipeline: " << threadedTime << " s\n";
+
+  if (serial->GetNumberOfBlocks() != numBlocks || threaded->GetNumberOfBlocks() != numBlocks)
+  {
+    std::cerr << "Unexpected number of output blocks.\n";
+    return EXIT_FAILURE;
+  }
+  for (unsigned int i = 0; i < numBlocks; ++i)
+  {
+    auto a = vtkPolyData::SafeDownCast(serial->GetBlock(i));
+    auto b = vtkPolyData::SafeDownCast(threaded->GetBlock(i));
+    if (!a || !b || a->GetNumberOfPoints() != b->GetNumberOfPoints())
+    {
+      std::cerr << "Block " << i << " differs in structure.\n";
+      return EXIT_FAILURE;
+    }
+    vtkDataArray* ea = a->GetPointData()->GetArray("Elevation");
+    vtkDataArray* eb = b->GetPointData()->GetArray("Elevation");
+    if (!ea || !eb)
+    {
+      std::cerr << "Block " << i << " is missing the elevation array.\n";
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType j = 0; j < ea->GetNumberOfTuples(); ++j)
+    {
+      if (ea->GetComponent(j, 0) != eb->GetComponent(j, 0))
+      {
+        std::cerr << "Block " << i << " differs at point " << j << ".\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -29,6 +29,7 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDebugLeaks.h"
+#include "vtkGarbageCollector.h"
 #include "vtkImageData.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -239,6 +240,17 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
   std::vector<vtkDataObject*> outObjs;
   outObjs.resize(indices.size() * outInfoVec->GetNumberOfInformationObjects(), nullptr);
 
+  // Port information is filled in lazily on first access. Make sure this
+  // happens here rather than concurrently from the threads.
+  for (int port = 0; port < this->Algorithm->GetNumberOfInputPorts(); ++port)
+  {
+    this->Algorithm->GetInputPortInformation(port);
+  }
+  for (int port = 0; port < this->Algorithm->GetNumberOfOutputPorts(); ++port)
+  {
+    this->Algorithm->GetOutputPortInformation(port);
+  }
+
   // create the parallel task processBlock
   ProcessBlock processBlock(
     this, inInfoVec, outInfoVec, compositePort, connection, request, inObjs, outObjs);
@@ -246,7 +258,21 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
   vtkSmartPointer<vtkProgressObserver> origPo(this->Algorithm->GetProgressObserver());
   vtkNew<vtkSMPProgressObserver> po;
   this->Algorithm->SetProgressObserver(po);
+
+  // The blocks share executives, algorithms and information objects. A
+  // garbage collection check started by one thread would walk references
+  // that other threads are modifying, so defer collection until all
+  // blocks are done.
+  const bool deferCollection = vtkGarbageCollector::IsMainThread();
+  if (deferCollection)
+  {
+    vtkGarbageCollector::DeferredCollectionPush();
+  }
   vtkSMPTools::For(0, static_cast<vtkIdType>(inObjs.size()), processBlock);
+  if (deferCollection)
+  {
+    vtkGarbageCollector::DeferredCollectionPop();
+  }
   this->Algorithm->SetProgressObserver(origPo);
 
   int i = 0;
@@ -0,0 +1,272 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAppendConcurrent.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the concurrent paths of vtkAppendFilter and vtkAppendPolyData: cells
+// and attributes land at the right offsets, sort-based point merging matches
+// the point locator, and a single non-empty input is passed through.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond)                                                                          \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    std::cerr << "Failure at line " << __LINE__ << ": " #cond "\n";                                \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+
+// A row of unit hexahedra starting at x = origin. Point and cell data hold
+// the piece number.
+vtkSmartPointer<vtkUnstructuredGrid> MakeHexRow(int numHexes, double origin, int piece)
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i <= numHexes; ++i)
+  {
+    for (int k = 0; k < 2; ++k)
+    {
+      for (int j = 0; j < 2; ++j)
+      {
+        points->InsertNextPoint(origin + i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->AllocateExact(numHexes, 8 * numHexes);
+  for (int i = 0; i < numHexes; ++i)
+  {
+    const vtkIdType p = 4 * i;
+    const vtkIdType hex[8] = { p, p + 4, p + 5, p + 1, p + 2, p + 6, p + 7, p + 3 };
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+  }
+
+  vtkNew<vtkIntArray> pointPiece;
+  pointPiece->SetName("piece");
+  pointPiece->SetNumberOfValues(grid->GetNumberOfPoints());
+  pointPiece->FillValue(piece);
+  grid->GetPointData()->AddArray(pointPiece);
+  vtkNew<vtkIntArray> cellPiece;
+  cellPiece->SetName("piece");
+  cellPiece->SetNumberOfValues(numHexes);
+  cellPiece->FillValue(piece);
+  grid->GetCellData()->AddArray(cellPiece);
+  return grid;
+}
+
+// Compare the cells of two grids by the coordinates of their points.
+bool SameGeometry(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells() ||
+    a->GetNumberOfPoints() != b->GetNumberOfPoints())
+  {
+    return false;
+  }
+  vtkNew<vtkIdList> idsA;
+  vtkNew<vtkIdList> idsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellPoints(cellId, idsA);
+    b->GetCellPoints(cellId, idsB);
+    if (a->GetCellType(cellId) != b->GetCellType(cellId) ||
+      idsA->GetNumberOfIds() != idsB->GetNumberOfIds())
+    {
+      return false;
+    }
+    for (vtkIdType i = 0; i < idsA->GetNumberOfIds(); ++i)
+    {
+      double pa[3], pb[3];
+      a->GetPoint(idsA->GetId(i), pa);
+      b->GetPoint(idsB->GetId(i), pb);
+      if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int TestAppendFilterPaths()
+{
+  std::vector<vtkSmartPointer<vtkUnstructuredGrid>> grids;
+  for (int piece = 0; piece < 8; ++piece)
+  {
+    // Neighboring rows share their end faces.
+    grids.push_back(MakeHexRow(3 + piece, 3 * piece + piece * (piece - 1) / 2.0, piece));
+  }
+  vtkIdType numPts = 0;
+  vtkIdType numCells = 0;
+  for (auto& grid : grids)
+  {
+    numPts += grid->GetNumberOfPoints();
+    numCells += grid->GetNumberOfCells();
+  }
+
+  vtkNew<vtkAppendFilter> append;
+  for (auto& grid : grids)
+  {
+    append->AddInputData(grid);
+  }
+  append->Update();
+  vtkUnstructuredGrid* output = append->GetOutput();
+  TEST_ASSERT(output->GetNumberOfPoints() == numPts);
+  TEST_ASSERT(output->GetNumberOfCells() == numCells);
+  auto cellPiece = vtkIntArray::SafeDownCast(output->GetCellData()->GetArray("piece"));
+  TEST_ASSERT(cellPiece != nullptr);
+  vtkIdType cellId = 0;
+  for (int piece = 0; piece < 8; ++piece)
+  {
+    for (vtkIdType i = 0; i < grids[piece]->GetNumberOfCells(); ++i, ++cellId)
+    {
+      TEST_ASSERT(cellPiece->GetValue(cellId) == piece);
+      TEST_ASSERT(output->GetCellType(cellId) == VTK_HEXAHEDRON);
+    }
+  }
+
+  // Exact merging by sorting gives the same result as the point locator.
+  append->MergePointsOn();
+  append->SetTolerance(0.0);
+  append->Update();
+  vtkNew<vtkUnstructuredGrid> sorted;
+  sorted->DeepCopy(append->GetOutput());
+  append->SetTolerance(1e-6);
+  append->Update();
+  vtkUnstructuredGrid* located = append->GetOutput();
+  TEST_ASSERT(sorted->GetNumberOfPoints() == located->GetNumberOfPoints());
+  TEST_ASSERT(sorted->GetNumberOfPoints() < numPts);
+  TEST_ASSERT(SameGeometry(sorted, located));
+
+  return EXIT_SUCCESS;
+}
+
+int TestAppendPolyDataPaths()
+{
+  std::vector<vtkSmartPointer<vtkPolyData>> inputs;
+  for (int piece = 0; piece < 6; ++piece)
+  {
+    auto pd = vtkSmartPointer<vtkPolyData>::New();
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    vtkNew<vtkCellArray> polys;
+    for (int i = 0; i <= piece; ++i)
+    {
+      points->InsertNextPoint(piece, i, 0.0);
+      points->InsertNextPoint(piece, i, 1.0);
+      points->InsertNextPoint(piece + 1, i, 0.0);
+      const vtkIdType tri[3] = { 3 * i, 3 * i + 1, 3 * i + 2 };
+      polys->InsertNextCell(3, tri);
+      verts->InsertNextCell(1, tri);
+    }
+    pd->SetPoints(points);
+    pd->SetVerts(verts);
+    pd->SetPolys(polys);
+
+    vtkNew<vtkIntArray> cellPiece;
+    cellPiece->SetName("piece");
+    cellPiece->SetNumberOfComponents(2);
+    cellPiece->SetNumberOfTuples(pd->GetNumberOfCells());
+    for (vtkIdType cellId = 0; cellId < pd->GetNumberOfCells(); ++cellId)
+    {
+      cellPiece->SetTypedComponent(cellId, 0, piece);
+      cellPiece->SetTypedComponent(cellId, 1, pd->GetCellType(cellId));
+    }
+    pd->GetCellData()->AddArray(cellPiece);
+    inputs.push_back(pd);
+  }
+
+  vtkNew<vtkAppendPolyData> append;
+  for (auto& pd : inputs)
+  {
+    append->AddInputData(pd);
+  }
+  append->Update();
+  vtkPolyData* output = append->GetOutput();
+  auto cellPiece = vtkIntArray::SafeDownCast(output->GetCellData()->GetArray("piece"));
+  TEST_ASSERT(cellPiece != nullptr);
+  TEST_ASSERT(output->GetNumberOfVerts() == 21 && output->GetNumberOfPolys() == 21);
+
+  // Verts come first, then polys, each in input order; the point ids of every
+  // cell are shifted by the points of the preceding inputs.
+  vtkNew<vtkIdList> ids;
+  vtkIdType cellId = 0;
+  for (int type : { VTK_VERTEX, VTK_TRIANGLE })
+  {
+    for (int piece = 0; piece < 6; ++piece)
+    {
+      for (int i = 0; i <= piece; ++i, ++cellId)
+      {
+        TEST_ASSERT(output->GetCellType(cellId) == type);
+        TEST_ASSERT(cellPiece->GetTypedComponent(cellId, 0) == piece);
+        TEST_ASSERT(cellPiece->GetTypedComponent(cellId, 1) == type);
+        output->GetCellPoints(cellId, ids);
+        double x[3];
+        output->GetPoint(ids->GetId(0), x);
+        TEST_ASSERT(x[0] == piece && x[1] == i && x[2] == 0.0);
+      }
+    }
+  }
+
+  // A single non-empty input is passed through without copying, but its
+  // field data is dropped as when the inputs are appended.
+  vtkNew<vtkIntArray> fieldArray;
+  fieldArray->SetName("field");
+  inputs[3]->GetFieldData()->AddArray(fieldArray);
+  vtkNew<vtkPolyData> empty;
+  vtkNew<vtkAppendPolyData> passThrough;
+  passThrough->AddInputData(empty);
+  passThrough->AddInputData(inputs[3]);
+  passThrough->Update();
+  TEST_ASSERT(passThrough->GetOutput()->GetPoints() == inputs[3]->GetPoints());
+  TEST_ASSERT(passThrough->GetOutput()->GetPolys() == inputs[3]->GetPolys());
+  TEST_ASSERT(passThrough->GetOutput()->GetCellData()->GetArray("piece") ==
+    inputs[3]->GetCellData()->GetArray("piece"));
+  TEST_ASSERT(passThrough->GetOutput()->GetFieldData()->GetNumberOfArrays() == 0);
+
+  // Unless the points have to change precision.
+  passThrough->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+  passThrough->Update();
+  TEST_ASSERT(passThrough->GetOutput()->GetPoints()->GetDataType() == VTK_DOUBLE);
+  TEST_ASSERT(passThrough->GetOutput()->GetNumberOfCells() == inputs[3]->GetNumberOfCells());
+
+  return EXIT_SUCCESS;
+}
+
+} // end anon namespace
+
+int TestAppendConcurrent(int, char*[])
+{
+  if (TestAppendFilterPaths() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return TestAppendPolyDataPaths();
+}
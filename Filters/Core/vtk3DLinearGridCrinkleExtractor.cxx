@@ -492,10 +492,7 @@ struct CopyCellAttributes
 
   void operator()(vtkIdType cellId, vtkIdType endCellId)
   {
-    for (; cellId < endCellId; ++cellId)
-    {
-      this->Arrays->Copy(this->CellMap[cellId], cellId);
-    }
+    this->Arrays->Copy(endCellId - cellId, this->CellMap + cellId, cellId);
   }
 };
 
@@ -547,14 +544,7 @@ struct CopyPointAttributes
 
   void operator()(vtkIdType ptId, vtkIdType endPtId)
   {
-    const vtkIdType* ptMap = this->PointMap;
-    for (; ptId < endPtId; ++ptId)
-    {
-      if (ptMap[ptId] >= 0)
-      {
-        this->Arrays->Copy(ptId, ptMap[ptId]);
-      }
-    }
+    this->Arrays->CopyMapped(ptId, endPtId, this->PointMap);
   }
 };
 
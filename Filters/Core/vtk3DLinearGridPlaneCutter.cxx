@@ -425,17 +425,24 @@ struct ProduceAttributes
 
   void operator()(vtkIdType ptId, vtkIdType endPtId)
   {
-    const MergeTuple<TIds, float>* mergeTuple;
-    TIds v0, v1;
-    float t;
+    // Gather the edges in chunks so that each attribute array is
+    // interpolated with one batched call per chunk.
+    const vtkIdType chunkSize = 512;
+    vtkIdType v0[chunkSize], v1[chunkSize];
+    double t[chunkSize];
 
-    for (; ptId < endPtId; ++ptId)
+    while (ptId < endPtId)
     {
-      mergeTuple = this->Edges + ptId;
-      v0 = mergeTuple->V0;
-      v1 = mergeTuple->V1;
-      t = mergeTuple->T;
-      this->Arrays->InterpolateEdge(v0, v1, t, ptId);
+      const vtkIdType num = std::min(chunkSize, endPtId - ptId);
+      for (vtkIdType i = 0; i < num; ++i)
+      {
+        const MergeTuple<TIds, float>* mergeTuple = this->Edges + ptId + i;
+        v0[i] = mergeTuple->V0;
+        v1[i] = mergeTuple->V1;
+        t[i] = mergeTuple->T;
+      }
+      this->Arrays->InterpolateEdge(num, v0, v1, t, ptId);
+      ptId += num;
     }
   }
 };
@@ -576,17 +583,24 @@ struct ProduceMergedAttributes
 
   void operator()(vtkIdType ptId, vtkIdType endPtId)
   {
-    const MergeTuple<TIds, float>* mergeTuple;
-    TIds v0, v1;
-    float t;
+    // Gather the edges in chunks so that each attribute array is
+    // interpolated with one batched call per chunk.
+    const vtkIdType chunkSize = 512;
+    vtkIdType v0[chunkSize], v1[chunkSize];
+    double t[chunkSize];
 
-    for (; ptId < endPtId; ++ptId)
+    while (ptId < endPtId)
     {
-      mergeTuple = this->Edges + this->Offsets[ptId];
-      v0 = mergeTuple->V0;
-      v1 = mergeTuple->V1;
-      t = mergeTuple->T;
-      this->Arrays->InterpolateEdge(v0, v1, t, ptId);
+      const vtkIdType num = std::min(chunkSize, endPtId - ptId);
+      for (vtkIdType i = 0; i < num; ++i)
+      {
+        const MergeTuple<TIds, float>* mergeTuple = this->Edges + this->Offsets[ptId + i];
+        v0[i] = mergeTuple->V0;
+        v1[i] = mergeTuple->V1;
+        t[i] = mergeTuple->T;
+      }
+      this->Arrays->InterpolateEdge(num, v0, v1, t, ptId);
+      ptId += num;
     }
   }
 };
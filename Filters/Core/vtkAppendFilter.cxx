@@ -14,9 +14,12 @@
 =========================================================================*/
 #include "vtkAppendFilter.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkBoundingBox.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSetCollection.h"
 #include "vtkExecutive.h"
 #include "vtkIncrementalOctreePointLocator.h"
@@ -25,14 +28,123 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <string>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendFilter);
 
+namespace
+{
+// Copy the points of src into dst starting at point dstStart. The value types
+// of the two arrays may differ.
+struct CopyPointsWorker
+{
+  vtkIdType DstStart;
+
+  template <typename DstArrayT, typename SrcArrayT>
+  void operator()(DstArrayT* dst, SrcArrayT* src)
+  {
+    const auto srcValues = vtk::DataArrayValueRange<3>(src);
+    auto dstValues = vtk::DataArrayValueRange<3>(
+      dst, 3 * this->DstStart, 3 * this->DstStart + srcValues.size());
+    std::copy(srcValues.cbegin(), srcValues.cend(), dstValues.begin());
+  }
+};
+
+// NaN sorts after every number so that the ordering stays strict and weak.
+bool CoordinateLess(double a, double b)
+{
+  if (std::isnan(a))
+  {
+    return false;
+  }
+  return std::isnan(b) || a < b;
+}
+
+// Orders point ids by their coordinates, breaking ties by id so that the
+// first occurrence of a point comes first among its duplicates.
+struct CompareCoordinates
+{
+  const double* Coords;
+
+  bool SameCoordinates(vtkIdType a, vtkIdType b) const
+  {
+    const double* pa = this->Coords + 3 * a;
+    const double* pb = this->Coords + 3 * b;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (CoordinateLess(pa[i], pb[i]) || CoordinateLess(pb[i], pa[i]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    const double* pa = this->Coords + 3 * a;
+    const double* pb = this->Coords + 3 * b;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (CoordinateLess(pa[i], pb[i]))
+      {
+        return true;
+      }
+      if (CoordinateLess(pb[i], pa[i]))
+      {
+        return false;
+      }
+    }
+    return a < b;
+  }
+};
+
+// Write the cells of src into a cell array that was sized with ResizeExact,
+// starting at the given cell and connectivity positions. Point ids are mapped
+// through pointMap.
+struct AppendMappedCellsImpl
+{
+  template <typename DstCellStateT>
+  void operator()(DstCellStateT& dst, vtkCellArray* src, vtkIdType cellOffset,
+    vtkIdType connOffset, const vtkIdType* pointMap) const
+  {
+    src->Visit(*this, dst, cellOffset, connOffset, pointMap);
+  }
+
+  template <typename SrcCellStateT, typename DstCellStateT>
+  void operator()(SrcCellStateT& src, DstCellStateT& dst, vtkIdType cellOffset,
+    vtkIdType connOffset, const vtkIdType* pointMap) const
+  {
+    using DstValueType = typename DstCellStateT::ValueType;
+
+    const auto srcOffsets = vtk::DataArrayValueRange<1>(src.GetOffsets(), 1);
+    auto dstOffsets = vtk::DataArrayValueRange<1>(
+      dst.GetOffsets(), cellOffset + 1, cellOffset + 1 + srcOffsets.size());
+    const DstValueType dConnOffset = static_cast<DstValueType>(connOffset);
+    std::transform(srcOffsets.cbegin(), srcOffsets.cend(), dstOffsets.begin(),
+      [&](vtkIdType x) -> DstValueType { return static_cast<DstValueType>(x) + dConnOffset; });
+
+    const auto srcConn = vtk::DataArrayValueRange<1>(src.GetConnectivity());
+    auto dstConn = vtk::DataArrayValueRange<1>(
+      dst.GetConnectivity(), connOffset, connOffset + srcConn.size());
+    std::transform(srcConn.cbegin(), srcConn.cend(), dstConn.begin(),
+      [&](vtkIdType x) -> DstValueType { return static_cast<DstValueType>(pointMap[x]); });
+  }
+};
+} // end anon namespace
+
 //----------------------------------------------------------------------------
 vtkAppendFilter::vtkAppendFilter()
 {
@@ -175,8 +287,41 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // Now we can allocate memory
-  output->Allocate(totalNumCells);
+  // Unstructured grids without polyhedra are appended by copying their cell
+  // arrays concurrently; other inputs go through the generic cell API.
+  bool fastCells = true;
+  vtkIdType totalConnectivity = 0;
+  inputs->InitTraversal(iter);
+  while (fastCells && (dataSet = inputs->GetNextDataSet(iter)))
+  {
+    vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
+    fastCells = ug != nullptr && ug->GetFaces() == nullptr &&
+      (ug->GetNumberOfCells() == 0 || ug->GetCells() != nullptr);
+    if (fastCells && ug->GetNumberOfCells() > 0)
+    {
+      totalConnectivity += ug->GetCells()->GetNumberOfConnectivityIds();
+    }
+  }
+
+  // Now we can allocate memory. Point ids past the 32-bit range need 64-bit
+  // cell storage even when compact storage is the default, so the storage is
+  // chosen before the cells are allocated.
+  if (!fastCells)
+  {
+    if (totalNumPts > VTK_TYPE_INT32_MAX && !vtkCellArray::GetDefaultStorageIs64Bit())
+    {
+      vtkNew<vtkCellArray> cells;
+      cells->Use64BitStorage();
+      cells->AllocateExact(totalNumCells, totalNumCells);
+      vtkNew<vtkUnsignedCharArray> types;
+      types->Allocate(totalNumCells);
+      output->SetCells(types, cells);
+    }
+    else
+    {
+      output->Allocate(totalNumCells);
+    }
+  }
 
   vtkSmartPointer<vtkPoints> newPts = vtkSmartPointer<vtkPoints>::New();
 
@@ -211,12 +356,6 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  // If we aren't merging points, we need to allocate the points here.
-  if (!reallyMergePoints)
-  {
-    newPts->SetNumberOfPoints(totalNumPts);
-  }
-
   vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
   ptIds->Allocate(VTK_CELL_SIZE);
   vtkSmartPointer<vtkIdList> newPtIds = vtkSmartPointer<vtkIdList>::New();
@@ -227,7 +366,14 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // For optionally merging duplicate points
   vtkIdType* globalIndices = new vtkIdType[totalNumPts];
   vtkSmartPointer<vtkIncrementalOctreePointLocator> ptInserter;
-  if (reallyMergePoints)
+  bool pointsDone = false;
+  if (reallyMergePoints && this->Tolerance == 0.0)
+  {
+    // Coincident points can be found exactly by sorting; no locator needed.
+    this->MergeCoincidentPoints(inputs, newPts, globalIndices);
+    pointsDone = true;
+  }
+  else if (reallyMergePoints)
   {
     vtkBoundingBox outputBB;
 
@@ -256,6 +402,18 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
     ptInserter->InitPointInsertion(newPts, outputBounds);
   }
+  else
+  {
+    // If we aren't merging points, we need to allocate the points here.
+    newPts->SetNumberOfPoints(totalNumPts);
+    pointsDone = this->CopyPoints(inputs, newPts);
+    if (pointsDone)
+    {
+      vtkSMPTools::For(0, totalNumPts, [&](vtkIdType begin, vtkIdType end) {
+        std::iota(globalIndices + begin, globalIndices + end, begin);
+      });
+    }
+  }
 
   // append the blocks / pieces in terms of the geometry and topology
   vtkIdType count = 0;
@@ -266,10 +424,10 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   while (!abort && (dataSet = inputs->GetNextDataSet(iter)))
   {
     vtkIdType dataSetNumPts = dataSet->GetNumberOfPoints();
-    vtkIdType dataSetNumCells = dataSet->GetNumberOfCells();
+    vtkIdType dataSetNumCells = fastCells ? 0 : dataSet->GetNumberOfCells();
 
     // copy points
-    for (vtkIdType ptId = 0; ptId < dataSetNumPts && !abort; ++ptId)
+    for (vtkIdType ptId = 0; ptId < dataSetNumPts && !abort && !pointsDone; ++ptId)
     {
       if (reallyMergePoints)
       {
@@ -338,6 +496,12 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     ptOffset += dataSetNumPts;
   }
 
+  if (fastCells && !abort)
+  {
+    this->AppendUnstructuredCells(inputs, globalIndices, totalNumPts, totalNumCells,
+      totalConnectivity, output);
+  }
+
   // this filter can copy global ids except for global point ids when merging
   // points (see paraview/paraview#18666).
   // Note, not copying global ids is the default behavior.
@@ -389,6 +553,189 @@ vtkDataSetCollection* vtkAppendFilter::GetNonEmptyInputs(vtkInformationVector**
   return collection;
 }
 
+//----------------------------------------------------------------------------
+bool vtkAppendFilter::CopyPoints(vtkDataSetCollection* inputs, vtkPoints* newPts)
+{
+  std::vector<vtkPointSet*> pointSets;
+  std::vector<vtkIdType> offsets;
+  vtkIdType offset = 0;
+  vtkCollectionSimpleIterator iter;
+  vtkDataSet* dataSet;
+  for (inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
+  {
+    vtkPointSet* ps = vtkPointSet::SafeDownCast(dataSet);
+    if (ps == nullptr || (ps->GetNumberOfPoints() > 0 && ps->GetPoints() == nullptr))
+    {
+      return false;
+    }
+    pointSets.push_back(ps);
+    offsets.push_back(offset);
+    offset += ps->GetNumberOfPoints();
+  }
+
+  vtkDataArray* dst = newPts->GetData();
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pointSets.size()), 1,
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        if (pointSets[i]->GetNumberOfPoints() == 0)
+        {
+          continue;
+        }
+        vtkDataArray* src = pointSets[i]->GetPoints()->GetData();
+        CopyPointsWorker worker{ offsets[i] };
+        using Dispatcher =
+          vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals, vtkArrayDispatch::Reals>;
+        if (!Dispatcher::Execute(dst, src, worker))
+        {
+          worker(dst, src);
+        }
+      }
+    });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkAppendFilter::MergeCoincidentPoints(
+  vtkDataSetCollection* inputs, vtkPoints* newPts, vtkIdType* globalIndices)
+{
+  // Gather the coordinates of all input points.
+  std::vector<double> coords;
+  vtkCollectionSimpleIterator iter;
+  vtkDataSet* dataSet;
+  for (inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
+  {
+    const vtkIdType numPts = dataSet->GetNumberOfPoints();
+    if (numPts == 0)
+    {
+      continue;
+    }
+    const std::size_t offset = coords.size();
+    coords.resize(offset + 3 * numPts);
+    double* x = coords.data() + offset;
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(dataSet);
+    if (pointSet)
+    {
+      // Reading the points array concurrently is safe, it has no lazily
+      // built state.
+      vtkPoints* points = pointSet->GetPoints();
+      vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          points->GetPoint(ptId, x + 3 * ptId);
+        }
+      });
+      continue;
+    }
+    // Other datasets may set up the state that GetPoint() uses on its first
+    // call, so make that call here, on this thread.  vtkDataSet::GetPoint()
+    // is then thread safe as long as the dataset is not modified, which
+    // holds while this filter executes.
+    dataSet->GetPoint(0, x);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        dataSet->GetPoint(ptId, x + 3 * ptId);
+      }
+    });
+  }
+  const vtkIdType totalNumPts = static_cast<vtkIdType>(coords.size() / 3);
+
+  // Sorting brings coincident points together; the first point of each run
+  // is the one that occurs first in the inputs.
+  CompareCoordinates compare{ coords.data() };
+  std::vector<vtkIdType> order(totalNumPts);
+  std::iota(order.begin(), order.end(), 0);
+  vtkSMPTools::Sort(order.begin(), order.end(), compare);
+
+  std::vector<vtkIdType> representative(totalNumPts);
+  for (vtkIdType i = 0; i < totalNumPts;)
+  {
+    const vtkIdType first = order[i];
+    for (; i < totalNumPts && compare.SameCoordinates(order[i], first); ++i)
+    {
+      representative[order[i]] = first;
+    }
+  }
+
+  // Number the unique points in order of first occurrence, which is the order
+  // a point locator would insert them in.
+  vtkIdType numUniquePts = 0;
+  for (vtkIdType ptId = 0; ptId < totalNumPts; ++ptId)
+  {
+    const vtkIdType rep = representative[ptId];
+    globalIndices[ptId] = rep == ptId ? numUniquePts++ : globalIndices[rep];
+  }
+
+  newPts->SetNumberOfPoints(numUniquePts);
+  vtkSMPTools::For(0, totalNumPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (representative[ptId] == ptId)
+      {
+        newPts->SetPoint(globalIndices[ptId], coords.data() + 3 * ptId);
+      }
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+void vtkAppendFilter::AppendUnstructuredCells(vtkDataSetCollection* inputs,
+  const vtkIdType* globalIndices, vtkIdType totalNumPts, vtkIdType totalNumCells,
+  vtkIdType totalConnectivity, vtkUnstructuredGrid* output)
+{
+  // Lay out the inputs in the output so that they can be copied concurrently.
+  std::vector<vtkUnstructuredGrid*> grids;
+  std::vector<vtkIdType> ptOffsets, cellOffsets, connOffsets;
+  vtkIdType ptOffset = 0, cellOffset = 0, connOffset = 0;
+  vtkCollectionSimpleIterator iter;
+  vtkDataSet* dataSet;
+  for (inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
+  {
+    vtkUnstructuredGrid* ug = static_cast<vtkUnstructuredGrid*>(dataSet);
+    if (ug->GetNumberOfCells() > 0)
+    {
+      grids.push_back(ug);
+      ptOffsets.push_back(ptOffset);
+      cellOffsets.push_back(cellOffset);
+      connOffsets.push_back(connOffset);
+      cellOffset += ug->GetNumberOfCells();
+      connOffset += ug->GetCells()->GetNumberOfConnectivityIds();
+    }
+    ptOffset += ug->GetNumberOfPoints();
+  }
+
+  vtkNew<vtkCellArray> cells;
+  if (totalNumPts > VTK_TYPE_INT32_MAX)
+  {
+    cells->Use64BitStorage();
+  }
+  if (!cells->ResizeExact(totalNumCells, totalConnectivity))
+  {
+    vtkErrorMacro(<< "Memory allocation failed in append filter");
+    return;
+  }
+  cells->GetOffsetsArray()->SetTuple1(0, 0);
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(totalNumCells);
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(grids.size()), 1,
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        vtkUnstructuredGrid* ug = grids[i];
+        cells->Visit(AppendMappedCellsImpl{}, ug->GetCells(), cellOffsets[i], connOffsets[i],
+          globalIndices + ptOffsets[i]);
+        const auto srcTypes = vtk::DataArrayValueRange<1>(ug->GetCellTypesArray());
+        auto dstTypes = vtk::DataArrayValueRange<1>(
+          types, cellOffsets[i], cellOffsets[i] + srcTypes.size());
+        std::copy(srcTypes.cbegin(), srcTypes.cend(), dstTypes.begin());
+      }
+    });
+
+  output->SetCells(types, cells);
+}
+
 //----------------------------------------------------------------------------
 void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** inputVector,
   vtkIdType* globalIds, vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements)
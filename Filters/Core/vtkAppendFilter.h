@@ -23,6 +23,11 @@
  * (For example, if one dataset has scalars but another does not, scalars will
  * not be appended.)
  *
+ * Points of point sets and the cells of unstructured grids without polyhedra
+ * are copied into the output concurrently (see vtkSMPTools). When points are
+ * merged with a zero tolerance, coincident points are found by sorting rather
+ * than with a point locator.
+ *
  * @sa
  * vtkAppendPolyData
  */
@@ -35,6 +40,7 @@
 
 class vtkDataSetAttributes;
 class vtkDataSetCollection;
+class vtkPoints;
 
 class VTKFILTERSCORE_EXPORT vtkAppendFilter : public vtkUnstructuredGridAlgorithm
 {
@@ -140,6 +146,22 @@ private:
 
   void AppendArrays(int attributesType, vtkInformationVector** inputVector, vtkIdType* globalIds,
     vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements);
+
+  // Copy the points of all inputs into newPts, which is already sized.
+  // Returns false, without copying, if an input is not a vtkPointSet.
+  bool CopyPoints(vtkDataSetCollection* inputs, vtkPoints* newPts);
+
+  // Merge exactly coincident points. newPts receives the unique points in
+  // order of first occurrence and globalIndices the output id of each input
+  // point.
+  void MergeCoincidentPoints(
+    vtkDataSetCollection* inputs, vtkPoints* newPts, vtkIdType* globalIndices);
+
+  // Build the output cells from unstructured grid inputs without polyhedra,
+  // mapping their point ids through globalIndices.
+  void AppendUnstructuredCells(vtkDataSetCollection* inputs, const vtkIdType* globalIndices,
+    vtkIdType totalNumPts, vtkIdType totalNumCells, vtkIdType totalConnectivity,
+    vtkUnstructuredGrid* output);
 };
 
 #endif
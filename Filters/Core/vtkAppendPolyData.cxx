@@ -25,12 +25,16 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendPolyData);
 
@@ -119,18 +123,142 @@ void vtkAppendPolyData::SetInputConnectionByNumber(int num, vtkAlgorithmOutput*
   this->SetNthInputConnection(0, num, input);
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Where one input lands in the output.
+struct AppendPiece
+{
+  vtkPolyData* Input = nullptr;
+  int PointListIndex = -1;
+  int CellListIndex = -1;
+  vtkIdType PointOffset = 0;
+  vtkIdType VertOffset = 0;
+  vtkIdType LineOffset = 0;
+  vtkIdType PolyOffset = 0;
+  vtkIdType StripOffset = 0;
+  vtkIdType VertConnOffset = 0;
+  vtkIdType LineConnOffset = 0;
+  vtkIdType PolyConnOffset = 0;
+  vtkIdType StripConnOffset = 0;
+};
+
+// Copy a range of tuples into an array that is already large enough. Unlike
+// InsertTuples this never touches the array size, so disjoint ranges of the
+// same array may be written from several threads.
+struct CopyRangeWorker
+{
+  vtkIdType SrcStart;
+  vtkIdType DstStart;
+  vtkIdType NumTuples;
+
+  template <typename Array1T, typename Array2T>
+  void operator()(Array1T* dest, Array2T* src)
+  {
+    VTK_ASSUME(src->GetNumberOfComponents() == dest->GetNumberOfComponents());
+    const auto srcTuples =
+      vtk::DataArrayTupleRange(src, this->SrcStart, this->SrcStart + this->NumTuples);
+    auto dstTuples =
+      vtk::DataArrayTupleRange(dest, this->DstStart, this->DstStart + this->NumTuples);
+    std::copy(srcTuples.cbegin(), srcTuples.cend(), dstTuples.begin());
+  }
+};
+
+void CopyDataRange(
+  vtkDataArray* dest, vtkDataArray* src, vtkIdType srcStart, vtkIdType dstStart, vtkIdType n)
+{
+  if (n <= 0 || src->GetNumberOfComponents() != dest->GetNumberOfComponents())
+  {
+    return;
+  }
+  CopyRangeWorker worker{ srcStart, dstStart, n };
+  if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(dest, src, worker))
+  {
+    // Use vtkDataArray API when fast-path dispatch fails.
+    worker(dest, src);
+  }
+}
+
+// Copy the vtkDataArrays of a field list; other arrays are skipped.
+void CopyAttributesRange(const vtkDataSetAttributes::FieldList& list, int listIndex,
+  vtkDataSetAttributes* input, vtkDataSetAttributes* output, vtkIdType srcStart,
+  vtkIdType dstStart, vtkIdType n)
+{
+  list.TransformData(listIndex, input, output, [&](vtkAbstractArray* src, vtkAbstractArray* dst) {
+    auto srcDA = vtkDataArray::SafeDownCast(src);
+    auto dstDA = vtkDataArray::SafeDownCast(dst);
+    if (srcDA && dstDA)
+    {
+      CopyDataRange(dstDA, srcDA, srcStart, dstStart, n);
+    }
+  });
+}
+
+// Copy the arrays of a field list that CopyAttributesRange skipped.
+void CopyAbstractAttributesRange(const vtkDataSetAttributes::FieldList& list, int listIndex,
+  vtkDataSetAttributes* input, vtkDataSetAttributes* output, vtkIdType srcStart,
+  vtkIdType dstStart, vtkIdType n)
+{
+  if (n <= 0)
+  {
+    return;
+  }
+  list.TransformData(listIndex, input, output, [&](vtkAbstractArray* src, vtkAbstractArray* dst) {
+    if (!vtkDataArray::SafeDownCast(src) || !vtkDataArray::SafeDownCast(dst))
+    {
+      dst->InsertTuples(dstStart, n, srcStart, src);
+    }
+  });
+}
+
+// Write the cells of src into a cell array that was sized with ResizeExact,
+// starting at the given cell and connectivity positions.
+struct AppendCellsAtImpl
+{
+  template <typename DstCellStateT>
+  void operator()(DstCellStateT& dst, vtkCellArray* src, vtkIdType cellOffset,
+    vtkIdType connOffset, vtkIdType pointOffset) const
+  {
+    if (src->GetNumberOfCells() > 0)
+    {
+      src->Visit(*this, dst, cellOffset, connOffset, pointOffset);
+    }
+  }
+
+  template <typename SrcCellStateT, typename DstCellStateT>
+  void operator()(SrcCellStateT& src, DstCellStateT& dst, vtkIdType cellOffset,
+    vtkIdType connOffset, vtkIdType pointOffset) const
+  {
+    using DstValueType = typename DstCellStateT::ValueType;
+
+    const auto srcOffsets = vtk::DataArrayValueRange<1>(src.GetOffsets(), 1);
+    auto dstOffsets = vtk::DataArrayValueRange<1>(
+      dst.GetOffsets(), cellOffset + 1, cellOffset + 1 + srcOffsets.size());
+    const DstValueType dConnOffset = static_cast<DstValueType>(connOffset);
+    std::transform(srcOffsets.cbegin(), srcOffsets.cend(), dstOffsets.begin(),
+      [&](vtkIdType x) -> DstValueType { return static_cast<DstValueType>(x) + dConnOffset; });
+
+    const auto srcConn = vtk::DataArrayValueRange<1>(src.GetConnectivity());
+    auto dstConn = vtk::DataArrayValueRange<1>(
+      dst.GetConnectivity(), connOffset, connOffset + srcConn.size());
+    const DstValueType dPointOffset = static_cast<DstValueType>(pointOffset);
+    std::transform(srcConn.cbegin(), srcConn.cend(), dstConn.begin(),
+      [&](vtkIdType x) -> DstValueType { return static_cast<DstValueType>(x) + dPointOffset; });
+  }
+};
+} // end anon namespace
+
 //----------------------------------------------------------------------------
 int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[], int numInputs)
 {
   int idx;
   vtkPolyData* ds;
-  vtkPoints* inPts;
   vtkPoints* newPts;
-  vtkCellArray *inVerts, *newVerts;
-  vtkCellArray *inLines, *newLines;
-  vtkCellArray *inPolys, *newPolys;
+  vtkCellArray* newVerts;
+  vtkCellArray* newLines;
+  vtkCellArray* newPolys;
   vtkIdType sizePolys, numPolys;
-  vtkCellArray *inStrips, *newStrips;
+  vtkCellArray* newStrips;
   vtkIdType numPts, numCells;
   vtkPointData* inPD = nullptr;
   vtkCellData* inCD = nullptr;
@@ -287,8 +415,16 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
 
   newPts->SetNumberOfPoints(numPts);
 
+  // Point ids past the 32-bit range need 64-bit cell storage even when compact
+  // storage is the default.
+  const bool useLargeIds = numPts > VTK_TYPE_INT32_MAX;
+
   newVerts = vtkCellArray::New();
-  bool allocated = newVerts->AllocateExact(numVerts, sizeVerts);
+  if (useLargeIds)
+  {
+    newVerts->Use64BitStorage();
+  }
+  bool allocated = newVerts->ResizeExact(numVerts, sizeVerts);
 
   if (sizeVerts > 0 && !allocated)
   {
@@ -297,7 +433,11 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   }
 
   newLines = vtkCellArray::New();
-  allocated = newLines->AllocateExact(numLines, sizeLines);
+  if (useLargeIds)
+  {
+    newLines->Use64BitStorage();
+  }
+  allocated = newLines->ResizeExact(numLines, sizeLines);
 
   if (sizeLines > 0 && !allocated)
   {
@@ -306,7 +446,11 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   }
 
   newPolys = vtkCellArray::New();
-  allocated = newPolys->AllocateExact(numPolys, sizePolys);
+  if (useLargeIds)
+  {
+    newPolys->Use64BitStorage();
+  }
+  allocated = newPolys->ResizeExact(numPolys, sizePolys);
 
   if (sizePolys > 0 && !allocated)
   {
@@ -315,7 +459,11 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   }
 
   newStrips = vtkCellArray::New();
-  allocated = newStrips->AllocateExact(numStrips, sizeStrips);
+  if (useLargeIds)
+  {
+    newStrips->Use64BitStorage();
+  }
+  allocated = newStrips->ResizeExact(numStrips, sizeStrips);
 
   if (sizeStrips > 0 && !allocated)
   {
@@ -332,73 +480,120 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   outputPD->CopyAllocate(ptList, numPts);
   outputCD->CopyAllocate(cellList, numCells);
 
-  // loop over all input sets
-  vtkIdType ptOffset = 0;
-  vtkIdType vertOffset = 0;
-  vtkIdType linesOffset = numVerts;
-  vtkIdType polysOffset = numVerts + numLines;
-  vtkIdType stripsOffset = numVerts + numLines + numPolys;
+  // Lay out the inputs in the output. Every input owns a disjoint range of
+  // points, cells and connectivity, so the inputs can then be copied
+  // concurrently without further synchronization.
+  std::vector<AppendPiece> pieces;
+  pieces.reserve(numInputs);
+  AppendPiece next;
+  next.LineOffset = numVerts;
+  next.PolyOffset = numVerts + numLines;
+  next.StripOffset = numVerts + numLines + numPolys;
   countPD = countCD = 0;
   for (idx = 0; idx < numInputs; ++idx)
   {
-    this->UpdateProgress(0.2 + 0.8 * idx / numInputs);
     ds = inputs[idx];
-    // this check is not necessary, but I'll put it in anyway
-    if (ds != nullptr)
+    if (ds == nullptr || (ds->GetNumberOfPoints() <= 0 && ds->GetNumberOfCells() <= 0))
     {
-      numPts = ds->GetNumberOfPoints();
-      numCells = ds->GetNumberOfCells();
-      if (numPts <= 0 && numCells <= 0)
-      {
-        continue; // no input, just skip
-      }
+      continue; // no input, just skip
+    }
 
-      inPD = ds->GetPointData();
-      inCD = ds->GetCellData();
+    AppendPiece piece = next;
+    piece.Input = ds;
+    piece.PointListIndex = ds->GetNumberOfPoints() > 0 ? countPD++ : -1;
+    piece.CellListIndex = ds->GetNumberOfCells() > 0 ? countCD++ : -1;
+    pieces.push_back(piece);
 
-      inPts = ds->GetPoints();
-      inVerts = ds->GetVerts();
-      inLines = ds->GetLines();
-      inPolys = ds->GetPolys();
-      inStrips = ds->GetStrips();
+    next.PointOffset += ds->GetNumberOfPoints();
+    if (piece.CellListIndex >= 0)
+    {
+      next.VertOffset += ds->GetNumberOfVerts();
+      next.LineOffset += ds->GetNumberOfLines();
+      next.PolyOffset += ds->GetNumberOfPolys();
+      next.StripOffset += ds->GetNumberOfStrips();
+      next.VertConnOffset += ds->GetVerts()->GetNumberOfConnectivityIds();
+      next.LineConnOffset += ds->GetLines()->GetNumberOfConnectivityIds();
+      next.PolyConnOffset += ds->GetPolys()->GetNumberOfConnectivityIds();
+      next.StripConnOffset += ds->GetStrips()->GetNumberOfConnectivityIds();
+    }
+  }
 
-      if (ds->GetNumberOfPoints() > 0)
+  // The attribute arrays are sized up front; the copies below then only
+  // write values and never grow the arrays.
+  outputPD->SetNumberOfTuples(numPts);
+  outputCD->SetNumberOfTuples(numCells);
+  newVerts->GetOffsetsArray()->SetTuple1(0, 0);
+  newLines->GetOffsetsArray()->SetTuple1(0, 0);
+  newPolys->GetOffsetsArray()->SetTuple1(0, 0);
+  newStrips->GetOffsetsArray()->SetTuple1(0, 0);
+  this->UpdateProgress(0.20);
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pieces.size()), 1,
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType pieceId = begin; pieceId < end; ++pieceId)
       {
-        // copy points directly
-        this->AppendData(newPts->GetData(), inPts->GetData(), ptOffset);
-        outputPD->CopyData(ptList, inPD, countPD, ptOffset, numPts, 0);
-        ++countPD;
+        const AppendPiece& piece = pieces[pieceId];
+        vtkPolyData* input = piece.Input;
+        if (piece.PointListIndex >= 0)
+        {
+          this->AppendData(newPts->GetData(), input->GetPoints()->GetData(), piece.PointOffset);
+          CopyAttributesRange(ptList, piece.PointListIndex, input->GetPointData(), outputPD, 0,
+            piece.PointOffset, input->GetNumberOfPoints());
+        }
+        if (piece.CellListIndex >= 0)
+        {
+          newVerts->Visit(AppendCellsAtImpl{}, input->GetVerts(), piece.VertOffset,
+            piece.VertConnOffset, piece.PointOffset);
+          newLines->Visit(AppendCellsAtImpl{}, input->GetLines(), piece.LineOffset - numVerts,
+            piece.LineConnOffset, piece.PointOffset);
+          newPolys->Visit(AppendCellsAtImpl{}, input->GetPolys(),
+            piece.PolyOffset - numVerts - numLines, piece.PolyConnOffset, piece.PointOffset);
+          newStrips->Visit(AppendCellsAtImpl{}, input->GetStrips(),
+            piece.StripOffset - numVerts - numLines - numPolys, piece.StripConnOffset,
+            piece.PointOffset);
+
+          // Cell data is ordered verts, lines, polys, strips in both the input
+          // and the output.
+          vtkCellData* inCellData = input->GetCellData();
+          const vtkIdType nVerts = input->GetNumberOfVerts();
+          const vtkIdType nLines = input->GetNumberOfLines();
+          const vtkIdType nPolys = input->GetNumberOfPolys();
+          CopyAttributesRange(
+            cellList, piece.CellListIndex, inCellData, outputCD, 0, piece.VertOffset, nVerts);
+          CopyAttributesRange(
+            cellList, piece.CellListIndex, inCellData, outputCD, nVerts, piece.LineOffset, nLines);
+          CopyAttributesRange(cellList, piece.CellListIndex, inCellData, outputCD,
+            nVerts + nLines, piece.PolyOffset, nPolys);
+          CopyAttributesRange(cellList, piece.CellListIndex, inCellData, outputCD,
+            nVerts + nLines + nPolys, piece.StripOffset, input->GetNumberOfStrips());
+        }
       }
+    });
 
-      if (ds->GetNumberOfCells() > 0)
-      {
-        // These are the cellIDs at which each of the cell types start.
-        vtkIdType vertsIndex = 0;
-        vtkIdType linesIndex = ds->GetNumberOfVerts();
-        vtkIdType polysIndex = linesIndex + ds->GetNumberOfLines();
-        vtkIdType stripsIndex = polysIndex + ds->GetNumberOfPolys();
-
-        // copy the cells
-        this->AppendCells(newVerts, inVerts, ptOffset);
-        this->AppendCells(newLines, inLines, ptOffset);
-        this->AppendCells(newPolys, inPolys, ptOffset);
-        this->AppendCells(newStrips, inStrips, ptOffset);
-
-        // copy cell data
-        outputCD->CopyData(cellList, inCD, countCD, vertOffset, ds->GetNumberOfVerts(), vertsIndex);
-        vertOffset += ds->GetNumberOfVerts();
-        outputCD->CopyData(
-          cellList, inCD, countCD, linesOffset, ds->GetNumberOfLines(), linesIndex);
-        linesOffset += ds->GetNumberOfLines();
-        outputCD->CopyData(
-          cellList, inCD, countCD, polysOffset, ds->GetNumberOfPolys(), polysIndex);
-        polysOffset += ds->GetNumberOfPolys();
-        outputCD->CopyData(
-          cellList, inCD, countCD, stripsOffset, ds->GetNumberOfStrips(), stripsIndex);
-        stripsOffset += ds->GetNumberOfStrips();
-        ++countCD;
-      }
-      ptOffset += numPts;
+  // Arrays that are not vtkDataArrays (e.g. strings) are not safe to write
+  // concurrently; copy them now.
+  for (const AppendPiece& piece : pieces)
+  {
+    vtkPolyData* input = piece.Input;
+    if (piece.PointListIndex >= 0)
+    {
+      CopyAbstractAttributesRange(ptList, piece.PointListIndex, input->GetPointData(), outputPD, 0,
+        piece.PointOffset, input->GetNumberOfPoints());
+    }
+    if (piece.CellListIndex >= 0)
+    {
+      vtkCellData* inCellData = input->GetCellData();
+      const vtkIdType nVerts = input->GetNumberOfVerts();
+      const vtkIdType nLines = input->GetNumberOfLines();
+      const vtkIdType nPolys = input->GetNumberOfPolys();
+      CopyAbstractAttributesRange(
+        cellList, piece.CellListIndex, inCellData, outputCD, 0, piece.VertOffset, nVerts);
+      CopyAbstractAttributesRange(
+        cellList, piece.CellListIndex, inCellData, outputCD, nVerts, piece.LineOffset, nLines);
+      CopyAbstractAttributesRange(cellList, piece.CellListIndex, inCellData, outputCD,
+        nVerts + nLines, piece.PolyOffset, nPolys);
+      CopyAbstractAttributesRange(cellList, piece.CellListIndex, inCellData, outputCD,
+        nVerts + nLines + nPolys, piece.StripOffset, input->GetNumberOfStrips());
     }
   }
 
@@ -456,15 +651,50 @@ int vtkAppendPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   vtkPolyData** inputs = new vtkPolyData*[numInputs];
+  vtkPolyData* nonEmptyInput = nullptr;
+  int numNonEmptyInputs = 0;
   for (int idx = 0; idx < numInputs; ++idx)
   {
     inputs[idx] = vtkPolyData::GetData(inputVector[0], idx);
+    if (inputs[idx] &&
+      (inputs[idx]->GetNumberOfPoints() > 0 || inputs[idx]->GetNumberOfCells() > 0))
+    {
+      nonEmptyInput = inputs[idx];
+      ++numNonEmptyInputs;
+    }
+  }
+
+  // When a single input has data, the output is that input: pass its points,
+  // cells and attributes through without copying, unless its points must be
+  // converted to another precision.  Like the append, this drops field data.
+  if (numNonEmptyInputs == 1 && this->CanPassThrough(nonEmptyInput))
+  {
+    output->CopyStructure(nonEmptyInput);
+    output->GetPointData()->PassData(nonEmptyInput->GetPointData());
+    output->GetCellData()->PassData(nonEmptyInput->GetCellData());
+    delete[] inputs;
+    return 1;
   }
   int retVal = this->ExecuteAppend(output, inputs, numInputs);
   delete[] inputs;
   return retVal;
 }
 
+//----------------------------------------------------------------------------
+bool vtkAppendPolyData::CanPassThrough(vtkPolyData* input)
+{
+  vtkPoints* points = input->GetPoints();
+  switch (this->OutputPointsPrecision)
+  {
+    case vtkAlgorithm::SINGLE_PRECISION:
+      return points == nullptr || points->GetDataType() == VTK_FLOAT;
+    case vtkAlgorithm::DOUBLE_PRECISION:
+      return points == nullptr || points->GetDataType() == VTK_DOUBLE;
+    default:
+      return true;
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkAppendPolyData::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -588,10 +818,13 @@ void vtkAppendPolyData::AppendData(vtkDataArray* dest, vtkDataArray* src, vtkIdT
 }
 
 //----------------------------------------------------------------------------
+#ifndef VTK_LEGACY_REMOVE
 void vtkAppendPolyData::AppendCells(vtkCellArray* dst, vtkCellArray* src, vtkIdType offset)
 {
+  VTK_LEGACY_BODY(vtkAppendPolyData::AppendCells, "VTK 9.0");
   dst->Append(src, offset);
 }
+#endif
 
 //----------------------------------------------------------------------------
 int vtkAppendPolyData::FillInputPortInformation(int port, vtkInformation* info)
@@ -24,6 +24,10 @@
  * attributes available.  (For example, if one dataset has point scalars but
  * another does not, point scalars will not be appended.)
  *
+ * The inputs are copied into disjoint ranges of the output concurrently
+ * (see vtkSMPTools). When only one input contains data it is passed through
+ * to the output without copying.
+ *
  * @sa
  * vtkAppendFilter
  */
@@ -135,7 +139,14 @@ protected:
   void AppendData(vtkDataArray* dest, vtkDataArray* src, vtkIdType offset);
 
   // An efficient way to append cells.
-  void AppendCells(vtkCellArray* dest, vtkCellArray* src, vtkIdType offset);
+  // @deprecated As of VTK 9.0, the inputs are copied concurrently, each to
+  // its own range of the output cells, and this method is no longer used.
+#ifndef VTK_LEGACY_REMOVE
+  VTK_LEGACY(void AppendCells(vtkCellArray* dest, vtkCellArray* src, vtkIdType offset));
+#endif
+
+  // Whether the output may share the arrays of a single non-empty input.
+  bool CanPassThrough(vtkPolyData* input);
 
 private:
   // hide the superclass' AddInput() from the user and the compiler
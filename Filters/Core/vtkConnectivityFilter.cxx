@@ -28,6 +28,7 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <map>
@@ -171,6 +172,35 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // The point-to-cell queries below need links. The links already built on
+  // the input are only read, otherwise they are built on a shallow copy so
+  // that the input is left untouched.
+  vtkSmartPointer<vtkDataSet> linkedInput;
+  if (vtkUnstructuredGrid* ugInput = vtkUnstructuredGrid::SafeDownCast(input))
+  {
+    if (ugInput->NeedToBuildLinks())
+    {
+      vtkUnstructuredGrid* copy = vtkUnstructuredGrid::New();
+      copy->ShallowCopy(ugInput);
+      copy->BuildLinks();
+      linkedInput.TakeReference(copy);
+    }
+  }
+  else if (vtkPolyData* pdInput = vtkPolyData::SafeDownCast(input))
+  {
+    if (pdInput->NeedToBuildLinks())
+    {
+      vtkPolyData* copy = vtkPolyData::New();
+      copy->ShallowCopy(pdInput);
+      copy->BuildLinks();
+      linkedInput.TakeReference(copy);
+    }
+  }
+  if (linkedInput)
+  {
+    input = linkedInput;
+  }
+
   // Initialize.  Keep track of points and cells visited.
   //
   this->RegionSizes->Reset();
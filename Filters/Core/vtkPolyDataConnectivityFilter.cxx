@@ -129,11 +129,19 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     }
   }
 
-  // Build cell structure
+  // Build cell structure. The links are only queried, so the links already
+  // built on the input are shared, and otherwise built on the copy.
   //
   this->Mesh = vtkPolyData::New();
-  this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  if (input->NeedToBuildLinks())
+  {
+    this->Mesh->CopyStructure(input);
+    this->Mesh->BuildLinks();
+  }
+  else
+  {
+    this->Mesh->ShallowCopy(input);
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
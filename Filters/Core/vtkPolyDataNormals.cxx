@@ -170,12 +170,22 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     polys->Delete();
     numPolys = polys->GetNumberOfCells(); // added some new triangles
   }
+  else if (numVerts == 0 && numLines == 0 && !input->NeedToBuildLinks())
+  {
+    // The mesh has the topology of the input, so the links already built on
+    // the input are shared. They are only read here.
+    this->OldMesh->ShallowCopy(input);
+    polys = inPolys;
+  }
   else
   {
     this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
   }
-  this->OldMesh->BuildLinks();
+  if (this->OldMesh->NeedToBuildLinks())
+  {
+    this->OldMesh->BuildLinks();
+  }
   this->UpdateProgress(0.10);
 
   pd = input->GetPointData();
@@ -67,6 +67,9 @@ struct CopyPointsAlgorithm
     const auto inPoints = vtk::DataArrayTupleRange<3>(this->InPts);
     auto outPoints = vtk::DataArrayTupleRange<3>(this->OutPts);
 
+    // Point data is copied per array in one batch for the whole range,
+    // before the points.
+    this->Arrays.CopyMapped(ptId, endPtId, ptMap);
     for (; ptId < endPtId; ++ptId)
     {
       const vtkIdType outPtId = ptMap[ptId];
@@ -77,7 +80,6 @@ struct CopyPointsAlgorithm
         outP[0] = static_cast<OutValueT>(inP[0]);
         outP[1] = static_cast<OutValueT>(inP[1]);
         outP[2] = static_cast<OutValueT>(inP[2]);
-        this->Arrays.Copy(ptId, outPtId);
       }
     }
   }
@@ -15,17 +15,21 @@
 #include "vtkThreshold.h"
 
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <numeric>
 
 vtkStandardNewMacro(vtkThreshold);
 
@@ -117,7 +121,7 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   vtkUnstructuredGrid* output =
     vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType cellId, newCellId;
+  vtkIdType cellId;
   vtkIdList *cellPts, *pointMap;
   vtkIdList* newCellPts;
   vtkCell* cell;
@@ -152,7 +156,22 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   outCD->CopyAllocate(cd);
 
   numPts = input->GetNumberOfPoints();
-  output->Allocate(input->GetNumberOfCells());
+
+  // Point ids past the 32-bit range need 64-bit cell storage even when
+  // compact storage is the default.
+  if (numPts > VTK_TYPE_INT32_MAX && !vtkCellArray::GetDefaultStorageIs64Bit())
+  {
+    vtkNew<vtkCellArray> cells;
+    cells->Use64BitStorage();
+    cells->AllocateExact(input->GetNumberOfCells(), input->GetNumberOfCells());
+    vtkNew<vtkUnsignedCharArray> types;
+    types->Allocate(input->GetNumberOfCells());
+    output->SetCells(types, cells);
+  }
+  else
+  {
+    output->Allocate(input->GetNumberOfCells());
+  }
 
   newPoints = vtkPoints::New();
 
@@ -189,6 +208,13 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
 
   newCellPts = vtkIdList::New();
 
+  // Input ids of the kept points and cells, in output order. Their attributes
+  // are copied in one batch per array once all cells have been visited.
+  vtkNew<vtkIdList> keptPointIds;
+  keptPointIds->Allocate(numPts);
+  vtkNew<vtkIdList> keptCellIds;
+  keptCellIds->Allocate(input->GetNumberOfCells());
+
   // are we using pointScalars?
   int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
   bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
@@ -247,7 +273,7 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
           input->GetPoint(ptId, x);
           newId = newPoints->InsertNextPoint(x);
           pointMap->SetId(ptId, newId);
-          outPD->CopyData(pd, ptId, newId);
+          keptPointIds->InsertNextId(ptId);
         }
         newCellPts->InsertId(i, newId);
       }
@@ -258,12 +284,20 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
         vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, newCellPts);
         vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap->GetPointer(0));
       }
-      newCellId = output->InsertNextCell(cell->GetCellType(), newCellPts);
-      outCD->CopyData(cd, cellId, newCellId);
+      output->InsertNextCell(cell->GetCellType(), newCellPts);
+      keptCellIds->InsertNextId(cellId);
       newCellPts->Reset();
     } // satisfied thresholding
   }   // for all cells
 
+  vtkNew<vtkIdList> outIds;
+  outIds->SetNumberOfIds(std::max(keptPointIds->GetNumberOfIds(), keptCellIds->GetNumberOfIds()));
+  std::iota(outIds->begin(), outIds->end(), 0);
+  outIds->SetNumberOfIds(keptPointIds->GetNumberOfIds());
+  outPD->CopyData(pd, keptPointIds, outIds);
+  outIds->SetNumberOfIds(keptCellIds->GetNumberOfIds());
+  outCD->CopyData(cd, keptCellIds, outIds);
+
   vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " number of cells.");
 
   // now clean up / update ourselves
@@ -148,6 +148,49 @@ private:
     return -1;
   }
 };
+
+// Fill the offsets and connectivity of the listed cells of ugrid, with their
+// point ids mapped to the output, and hand them to cellArray. Cells past the
+// end of ugrid are skipped.
+template <typename ArrayT, typename IteratorT>
+void ExtractConnectivity(vtkUnstructuredGrid* ugrid, IteratorT first, IteratorT last,
+  FastPointMap& pointMap, vtkIdType numCells, vtkIdType connectivitySize, vtkCellArray* cellArray)
+{
+  using ValueType = typename ArrayT::ValueType;
+  vtkNew<ArrayT> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkNew<ArrayT> connectivity;
+  connectivity->SetNumberOfValues(connectivitySize);
+  ValueType* offsetPtr = offsets->GetPointer(0);
+  ValueType* connectivityPtr = connectivity->GetPointer(0);
+
+  const vtkIdType maxid = ugrid->GetNumberOfCells();
+  vtkIdType cellId = 0;
+  vtkIdType connectivityId = 0;
+  offsetPtr[0] = 0;
+  for (IteratorT iter = first; iter != last; ++iter)
+  {
+    if (*iter >= maxid)
+    {
+      continue;
+    }
+
+    vtkIdType npts;
+    const vtkIdType* pts;
+    ugrid->GetCellPoints(*iter, npts, pts);
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      vtkIdType newId = pointMap.LookUp(pts[i]);
+      assert("Old id exists in map." && newId >= 0);
+      connectivityPtr[connectivityId++] = static_cast<ValueType>(newId);
+    }
+    offsetPtr[++cellId] = static_cast<ValueType>(connectivityId);
+  }
+
+  offsets->SetNumberOfValues(cellId + 1);
+  connectivity->SetNumberOfValues(connectivityId);
+  cellArray->SetData(offsets, connectivity);
+}
 } // end anonymous namespace
 
 class vtkExtractCellsSTLCloak
@@ -582,10 +625,21 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkDataSet* input, vtkUnstructur
   const auto& range = this->CellList->CellIdsRange;
   const auto numCells = static_cast<vtkIdType>(std::distance(range.first, range.second));
 
+  // Write the connectivity straight into the storage of the output cell
+  // array, 32-bit unless the default or the ids call for 64 bits.
   vtkNew<vtkCellArray> cellArray; // output
-  vtkNew<vtkIdTypeArray> newcells;
-  newcells->SetNumberOfValues(this->SubSetUGridCellArraySize);
-  vtkIdType cellArrayIdx = 0;
+  const vtkIdType connectivitySize = this->SubSetUGridCellArraySize - numCells;
+  if (vtkCellArray::GetDefaultStorageIs64Bit() || connectivitySize > VTK_TYPE_INT32_MAX ||
+    this->CellList->PointMap.Map->GetNumberOfIds() > VTK_TYPE_INT32_MAX)
+  {
+    ExtractConnectivity<vtkCellArray::ArrayType64>(ugrid, range.first, range.second,
+      this->CellList->PointMap, numCells, connectivitySize, cellArray);
+  }
+  else
+  {
+    ExtractConnectivity<vtkCellArray::ArrayType32>(ugrid, range.first, range.second,
+      this->CellList->PointMap, numCells, connectivitySize, cellArray);
+  }
 
   vtkNew<vtkIdTypeArray> facesLocationArray;
   facesLocationArray->SetNumberOfValues(numCells);
@@ -611,20 +665,6 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkDataSet* input, vtkUnstructur
     unsigned char cellType = ugrid->GetCellType(oldCellId);
     typeArray->SetValue(nextCellId, cellType);
 
-    vtkIdType npts;
-    const vtkIdType* pts;
-    ugrid->GetCellPoints(oldCellId, npts, pts);
-
-    newcells->SetValue(cellArrayIdx++, npts);
-
-    for (vtkIdType i = 0; i < npts; i++)
-    {
-      vtkIdType oldId = pts[i];
-      vtkIdType newId = this->CellList->PointMap.LookUp(oldId);
-      assert("Old id exists in map." && newId >= 0);
-      newcells->SetValue(cellArrayIdx++, newId);
-    }
-
     if (cellType == VTK_POLYHEDRON)
     {
       havePolyhedron = true;
@@ -661,9 +701,6 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkDataSet* input, vtkUnstructur
     nextCellId++;
   }
 
-  cellArray->AllocateExact(numCells, newcells->GetNumberOfValues() - numCells);
-  cellArray->ImportLegacyFormat(newcells);
-
   if (havePolyhedron)
   {
     output->SetCells(typeArray, cellArray, facesLocationArray, facesArray);
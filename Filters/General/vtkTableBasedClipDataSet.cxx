@@ -1516,7 +1516,13 @@ void vtkTableBasedClipperVolumeFromVolume::ConstructDataSet(
     }
   }
 
+  // Point ids past the 32-bit range need 64-bit cell storage even when
+  // compact storage is the default.
   vtkCellArray* cells = vtkCellArray::New();
+  if (output->GetNumberOfPoints() > VTK_TYPE_INT32_MAX)
+  {
+    cells->Use64BitStorage();
+  }
   cells->AllocateExact(ncells, nlist->GetNumberOfValues() - ncells);
   cells->ImportLegacyFormat(nlist);
   nlist->Delete();
@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTemporalPrefetchFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Play a temporal source forward through vtkTemporalPrefetchFilter and check
+// that the steps after the first come from the prefetch source.
+
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemporalPrefetchFilter.h"
+
+#include <iostream>
+#include <vector>
+
+#define TEST_ASSERT(cond)                                                                          \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    std::cerr << "Failure at line " << __LINE__ << ": " #cond "\n";                                \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+
+// A source with ten time steps whose output records the time it was
+// produced for in a field data array.
+class vtkTimeStampSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTimeStampSource* New();
+  vtkTypeMacro(vtkTimeStampSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions = 0;
+
+protected:
+  vtkTimeStampSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    std::vector<double> steps;
+    for (int i = 0; i < 10; ++i)
+    {
+      steps.push_back(0.5 * i);
+    }
+    double range[2] = { steps.front(), steps.back() };
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps.data(),
+      static_cast<int>(steps.size()));
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkNew<vtkDoubleArray> stamp;
+    stamp->SetName("Time");
+    stamp->InsertNextValue(time);
+    output->GetFieldData()->AddArray(stamp);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    ++this->NumberOfExecutions;
+    return 1;
+  }
+
+private:
+  vtkTimeStampSource(const vtkTimeStampSource&) = delete;
+  void operator=(const vtkTimeStampSource&) = delete;
+};
+
+vtkStandardNewMacro(vtkTimeStampSource);
+
+double GetStamp(vtkTemporalPrefetchFilter* filter)
+{
+  vtkDataArray* stamp = filter->GetOutputDataObject(0)->GetFieldData()->GetArray("Time");
+  return stamp ? stamp->GetTuple1(0) : -1.0;
+}
+
+} // end anon namespace
+
+int TestTemporalPrefetchFilter(int, char*[])
+{
+  vtkNew<vtkTimeStampSource> source;
+  vtkNew<vtkTimeStampSource> prefetchSource;
+  vtkNew<vtkTemporalPrefetchFilter> prefetch;
+  prefetch->SetInputConnection(source->GetOutputPort());
+  prefetch->SetPrefetchAlgorithm(prefetchSource);
+  prefetch->SetNumberOfStepsAhead(3);
+
+  // Play forward: only the first step needs the input.
+  for (int i = 0; i < 10; ++i)
+  {
+    prefetch->UpdateTimeStep(0.5 * i);
+    TEST_ASSERT(GetStamp(prefetch) == 0.5 * i);
+    prefetch->WaitForPrefetch();
+    TEST_ASSERT(prefetch->GetNumberOfPrefetchedTimeSteps() == std::min(3, 9 - i));
+  }
+  TEST_ASSERT(source->NumberOfExecutions == 1);
+  TEST_ASSERT(prefetchSource->NumberOfExecutions == 9);
+
+  // Jumping back and times between steps go to the input.
+  prefetch->UpdateTimeStep(1.0);
+  TEST_ASSERT(GetStamp(prefetch) == 1.0);
+  prefetch->UpdateTimeStep(1.25);
+  TEST_ASSERT(GetStamp(prefetch) == 1.25);
+  TEST_ASSERT(source->NumberOfExecutions == 3);
+
+  // Modifying the pipeline discards the prefetched steps.
+  prefetch->WaitForPrefetch();
+  TEST_ASSERT(prefetch->GetNumberOfPrefetchedTimeSteps() == 3);
+  source->Modified();
+  prefetch->UpdateTimeStep(1.5);
+  TEST_ASSERT(GetStamp(prefetch) == 1.5);
+  TEST_ASSERT(source->NumberOfExecutions == 4);
+
+  prefetch->CancelPrefetch();
+  TEST_ASSERT(prefetch->GetNumberOfPrefetchedTimeSteps() == 0);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,336 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTemporalPrefetchFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTemporalPrefetchFilter.h"
+
+#include "vtkDataObject.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// The state shared with the background thread, protected by Mutex.
+class vtkTemporalPrefetchFilter::vtkInternals
+{
+public:
+  typedef std::map<double, vtkSmartPointer<vtkDataObject> > ReadyType;
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::thread Worker;
+  bool Stop = false;
+
+  vtkAlgorithm* Algorithm = nullptr;
+  // The steps to keep, those still to produce and those produced.
+  std::set<double> Wanted;
+  std::deque<double> Pending;
+  ReadyType Ready;
+  // Whether the worker is producing BusyTime.
+  bool Busy = false;
+  double BusyTime = 0.0;
+
+  // The pipeline time of the input the prefetched steps match.
+  vtkMTimeType PipelineMTime = 0;
+
+  ~vtkInternals()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stop = true;
+    }
+    this->Condition.notify_all();
+    if (this->Worker.joinable())
+    {
+      this->Worker.join();
+    }
+  }
+
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Stop || !this->Pending.empty(); });
+      if (this->Stop)
+      {
+        return;
+      }
+      double time = this->Pending.front();
+      this->Pending.pop_front();
+      vtkAlgorithm* algorithm = this->Algorithm;
+      if (!algorithm)
+      {
+        continue;
+      }
+      this->Busy = true;
+      this->BusyTime = time;
+      lock.unlock();
+
+      vtkSmartPointer<vtkDataObject> result;
+      if (algorithm->UpdateTimeStep(time))
+      {
+        vtkDataObject* output = algorithm->GetOutputDataObject(0);
+        if (output)
+        {
+          result.TakeReference(output->NewInstance());
+          result->ShallowCopy(output);
+          result->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+        }
+      }
+
+      lock.lock();
+      this->Busy = false;
+      if (result && this->Wanted.count(time))
+      {
+        this->Ready[time] = result;
+      }
+      this->Condition.notify_all();
+    }
+  }
+
+  // Drop the pending steps, wait for the busy one and return the ready
+  // ones so that the caller releases them outside of the lock.
+  ReadyType Cancel()
+  {
+    ReadyType dropped;
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Wanted.clear();
+    this->Pending.clear();
+    this->Condition.wait(lock, [this]() { return !this->Busy; });
+    dropped.swap(this->Ready);
+    return dropped;
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [this]() { return !this->Busy && this->Pending.empty(); });
+  }
+
+  // Whether the step at time is ready, waiting for it if it is being produced.
+  bool WaitForTime(double time)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [this, time]() { return !this->Busy || this->BusyTime != time; });
+    return this->Ready.count(time) != 0;
+  }
+
+  vtkSmartPointer<vtkDataObject> Find(double time)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    ReadyType::iterator pos = this->Ready.find(time);
+    return pos != this->Ready.end() ? pos->second : nullptr;
+  }
+
+  // Keep the steps at times, produce those not ready yet and return the
+  // ready steps that are no longer wanted.
+  ReadyType Schedule(const std::vector<double>& times)
+  {
+    ReadyType dropped;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Wanted = std::set<double>(times.begin(), times.end());
+      for (ReadyType::iterator pos = this->Ready.begin(); pos != this->Ready.end();)
+      {
+        if (this->Wanted.count(pos->first))
+        {
+          ++pos;
+        }
+        else
+        {
+          dropped.insert(*pos);
+          this->Ready.erase(pos++);
+        }
+      }
+      this->Pending.clear();
+      for (double time : times)
+      {
+        if (!this->Ready.count(time) && !(this->Busy && this->BusyTime == time))
+        {
+          this->Pending.push_back(time);
+        }
+      }
+      if (!this->Pending.empty() && !this->Worker.joinable())
+      {
+        this->Worker = std::thread([this]() { this->Run(); });
+      }
+    }
+    this->Condition.notify_all();
+    return dropped;
+  }
+};
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkTemporalPrefetchFilter);
+
+//----------------------------------------------------------------------------
+vtkTemporalPrefetchFilter::vtkTemporalPrefetchFilter()
+{
+  this->NumberOfStepsAhead = 2;
+  this->PrefetchAlgorithm = nullptr;
+  this->Internals = new vtkInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkTemporalPrefetchFilter::~vtkTemporalPrefetchFilter()
+{
+  delete this->Internals;
+  if (this->PrefetchAlgorithm)
+  {
+    this->PrefetchAlgorithm->UnRegister(this);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetchFilter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfStepsAhead: " << this->NumberOfStepsAhead << endl;
+  os << indent << "PrefetchAlgorithm: " << this->PrefetchAlgorithm << endl;
+  os << indent << "NumberOfPrefetchedTimeSteps: " << this->GetNumberOfPrefetchedTimeSteps()
+     << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetchFilter::SetPrefetchAlgorithm(vtkAlgorithm* algorithm)
+{
+  if (this->PrefetchAlgorithm == algorithm)
+  {
+    return;
+  }
+  this->CancelPrefetch();
+  if (this->PrefetchAlgorithm)
+  {
+    this->PrefetchAlgorithm->UnRegister(this);
+  }
+  this->PrefetchAlgorithm = algorithm;
+  if (this->PrefetchAlgorithm)
+  {
+    this->PrefetchAlgorithm->Register(this);
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    this->Internals->Algorithm = algorithm;
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetchFilter::CancelPrefetch()
+{
+  this->Internals->Cancel();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetchFilter::WaitForPrefetch()
+{
+  this->Internals->Wait();
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalPrefetchFilter::GetNumberOfPrefetchedTimeSteps()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<int>(this->Internals->Ready.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalPrefetchFilter::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+
+  // Prefetched steps are stale once the pipeline has been modified.
+  vtkDemandDrivenPipeline* ddp = vtkDemandDrivenPipeline::SafeDownCast(this->GetExecutive());
+  if (ddp && ddp->GetPipelineMTime() > this->Internals->PipelineMTime)
+  {
+    this->CancelPrefetch();
+    this->Internals->PipelineMTime = ddp->GetPipelineMTime();
+  }
+
+  if (!outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+  {
+    return 1;
+  }
+  double upTime = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+  if (!this->Internals->WaitForTime(upTime))
+  {
+    return 1;
+  }
+
+  // The step is ready: leave the input with what it already has.
+  vtkDataObject* dobj = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (dobj && dobj->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+  {
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(),
+      dobj->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()));
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalPrefetchFilter::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* input = vtkDataObject::GetData(inInfo);
+  vtkDataObject* output = vtkDataObject::GetData(outInfo);
+
+  if (!outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+  {
+    output->ShallowCopy(input);
+    return 1;
+  }
+  double upTime = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+
+  vtkSmartPointer<vtkDataObject> prefetched = this->Internals->Find(upTime);
+  if (prefetched)
+  {
+    output->ShallowCopy(prefetched);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), upTime);
+  }
+  else
+  {
+    output->ShallowCopy(input);
+  }
+
+  // Schedule the steps following this one.
+  if (!this->PrefetchAlgorithm || !inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    return 1;
+  }
+  const double* steps = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  int numSteps = inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  const double* next = std::upper_bound(steps, steps + numSteps, upTime);
+  const double* last =
+    next + std::min<std::ptrdiff_t>(this->NumberOfStepsAhead, steps + numSteps - next);
+  this->Internals->Schedule(std::vector<double>(next, last));
+
+  return 1;
+}
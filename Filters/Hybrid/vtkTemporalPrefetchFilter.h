@@ -0,0 +1,107 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTemporalPrefetchFilter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkTemporalPrefetchFilter
+ * @brief   produce the next time steps ahead of the pipeline
+ *
+ * vtkTemporalPrefetchFilter passes its input through. Each time it delivers
+ * a time step, it starts updating a second pipeline, the prefetch
+ * algorithm, for the following NumberOfStepsAhead time steps on a
+ * background thread and keeps the results. When one of these steps is
+ * requested next, it is returned by a shallow copy and the input is not
+ * updated, so that playing a transient dataset forward runs at the speed of
+ * the reader rather than stalling on each frame. Only requests for the
+ * exact time values of the input's time steps are served from the
+ * prefetched steps.
+ *
+ * A pipeline cannot be updated from two threads at once, so the input
+ * itself is never updated in the background. The prefetch algorithm must
+ * produce the same data as the input, typically a second instance of the
+ * reader with the same settings. When the input pipeline is modified the
+ * prefetched steps are discarded; call CancelPrefetch() before modifying
+ * the prefetch algorithm so that its background update is not running.
+ *
+ * @sa
+ * vtkTemporalDataSetCache
+ */
+
+#ifndef vtkTemporalPrefetchFilter_h
+#define vtkTemporalPrefetchFilter_h
+
+#include "vtkFiltersHybridModule.h" // For export macro
+#include "vtkPassInputTypeAlgorithm.h"
+
+class VTKFILTERSHYBRID_EXPORT vtkTemporalPrefetchFilter : public vtkPassInputTypeAlgorithm
+{
+public:
+  static vtkTemporalPrefetchFilter* New();
+  vtkTypeMacro(vtkTemporalPrefetchFilter, vtkPassInputTypeAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * The number of time steps following the delivered one that are produced
+   * in the background and kept. It defaults to 2.
+   */
+  vtkSetClampMacro(NumberOfStepsAhead, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfStepsAhead, int);
+  //@}
+
+  //@{
+  /**
+   * The algorithm updated in the background. Its first output port must
+   * produce the same data as the input of this filter. When it is not set,
+   * the filter only passes its input through.
+   */
+  void SetPrefetchAlgorithm(vtkAlgorithm* algorithm);
+  vtkGetObjectMacro(PrefetchAlgorithm, vtkAlgorithm);
+  //@}
+
+  /**
+   * Stop prefetching: drop the steps that are waiting to be produced, wait
+   * for the one being produced and discard the steps kept so far.
+   */
+  void CancelPrefetch();
+
+  /**
+   * Wait until the time steps scheduled by the last update have been
+   * produced.
+   */
+  void WaitForPrefetch();
+
+  /**
+   * Return the number of prefetched time steps kept.
+   */
+  int GetNumberOfPrefetchedTimeSteps();
+
+protected:
+  vtkTemporalPrefetchFilter();
+  ~vtkTemporalPrefetchFilter() override;
+
+  int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  int NumberOfStepsAhead;
+  vtkAlgorithm* PrefetchAlgorithm;
+
+private:
+  vtkTemporalPrefetchFilter(const vtkTemporalPrefetchFilter&) = delete;
+  void operator=(const vtkTemporalPrefetchFilter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
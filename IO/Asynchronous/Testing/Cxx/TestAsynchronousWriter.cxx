@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAsynchronousWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write a sequence of polydata with vtkAsynchronousWriter, replacing the
+// point data array of the input after each write, and check that each file
+// holds the array that was current when it was written.
+
+#include "vtkAsynchronousWriter.h"
+#include "vtkCommand.h"
+#include "vtkExecutive.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+const int NumberOfSteps = 6;
+const vtkIdType NumberOfPoints = 100000;
+
+std::string StepFileName(const std::string& directory, int step)
+{
+  return directory + "/TestAsynchronousWriter_" + std::to_string(step) + ".vtp";
+}
+
+} // end anon namespace
+
+int TestAsynchronousWriter(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string directory = tempDir;
+  delete[] tempDir;
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->SetPoint(i, i, 0.5 * i, 0.0);
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+
+  vtkNew<vtkXMLPolyDataWriter> xmlWriter;
+  xmlWriter->SetDataModeToAppended();
+  vtkNew<vtkAsynchronousWriter> writer;
+  writer->SetWriter(xmlWriter);
+  writer->SetMaximumNumberOfPendingWrites(2);
+  writer->SetInputData(polyData);
+
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    vtkNew<vtkFloatArray> values;
+    values->SetName("Step");
+    values->SetNumberOfTuples(NumberOfPoints);
+    values->FillValue(static_cast<float>(step));
+    polyData->GetPointData()->AddArray(values);
+    polyData->Modified();
+
+    writer->SetFileName(StepFileName(directory, step).c_str());
+    writer->Write();
+    if (writer->GetNumberOfPendingWrites() > 2)
+    {
+      std::cerr << "Too many pending writes.\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (writer->Flush() != 0 || writer->GetNumberOfPendingWrites() != 0)
+  {
+    std::cerr << "Some writes failed.\n";
+    return EXIT_FAILURE;
+  }
+
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    vtkNew<vtkXMLPolyDataReader> reader;
+    reader->SetFileName(StepFileName(directory, step).c_str());
+    reader->Update();
+    vtkPolyData* output = reader->GetOutput();
+    vtkDataArray* values = output->GetPointData()->GetArray("Step");
+    if (output->GetNumberOfPoints() != NumberOfPoints || !values ||
+      values->GetNumberOfTuples() != NumberOfPoints)
+    {
+      std::cerr << "Step " << step << " was not written.\n";
+      return EXIT_FAILURE;
+    }
+    double range[2];
+    values->GetRange(range);
+    if (range[0] != step || range[1] != step)
+    {
+      std::cerr << "Step " << step << " has the values of another step.\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A write to a file that cannot be opened is reported by Flush(), and
+  // the errors of the XML writer and its executive are caught here rather
+  // than printed.
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  xmlWriter->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  xmlWriter->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  writer->SetFileName((directory + "/missing/directory/file.vtp").c_str());
+  writer->Write();
+  if (writer->Flush() != 1 || errorObserver->CheckErrorMessage("Error"))
+  {
+    std::cerr << "The failed write was not reported.\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
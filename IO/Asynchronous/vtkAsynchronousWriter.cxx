@@ -0,0 +1,268 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAsynchronousWriter.h"
+
+#include "vtkDataObject.h"
+#include "vtkDataWriter.h"
+#include "vtkErrorCode.h"
+#include "vtkImageWriter.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedTaskQueue.h"
+#include "vtkXMLWriter.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace
+{
+// Write data with writer and return whether it succeeded.
+bool WriteWith(vtkAlgorithm* writer, vtkDataObject* data, const std::string& fileName)
+{
+  vtkXMLWriter* xmlWriter = vtkXMLWriter::SafeDownCast(writer);
+  vtkDataWriter* dataWriter = vtkDataWriter::SafeDownCast(writer);
+  vtkImageWriter* imageWriter = vtkImageWriter::SafeDownCast(writer);
+  if (!fileName.empty())
+  {
+    if (xmlWriter)
+    {
+      xmlWriter->SetFileName(fileName.c_str());
+    }
+    else if (dataWriter)
+    {
+      dataWriter->SetFileName(fileName.c_str());
+    }
+    else if (imageWriter)
+    {
+      imageWriter->SetFileName(fileName.c_str());
+    }
+  }
+
+  writer->SetInputDataObject(0, data);
+  bool success = true;
+  if (xmlWriter)
+  {
+    success = xmlWriter->Write() != 0;
+  }
+  else if (vtkWriter* genericWriter = vtkWriter::SafeDownCast(writer))
+  {
+    success = genericWriter->Write() != 0;
+  }
+  else if (imageWriter)
+  {
+    imageWriter->Write();
+  }
+  else
+  {
+    // Other writers write when they execute.
+    writer->Modified();
+    writer->UpdateWholeExtent();
+  }
+  success = success && writer->GetErrorCode() == vtkErrorCode::NoError;
+  // Release the data as soon as it is written.
+  writer->SetInputDataObject(0, nullptr);
+  return success;
+}
+}
+
+//----------------------------------------------------------------------------
+class vtkAsynchronousWriter::vtkInternals
+{
+public:
+  using TaskQueueType = vtkThreadedTaskQueue<void, vtkSmartPointer<vtkDataObject>, std::string>;
+
+  std::unique_ptr<TaskQueueType> Queue;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  int NumberOfPendingWrites = 0;
+  int NumberOfFailedWrites = 0;
+  vtkAlgorithm* Writer = nullptr;
+
+  ~vtkInternals()
+  {
+    this->Wait();
+    this->Queue.reset();
+  }
+
+  void Write(const vtkSmartPointer<vtkDataObject>& data, const std::string& fileName)
+  {
+    vtkAlgorithm* writer;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      writer = this->Writer;
+    }
+    const bool success = writer && ::WriteWith(writer, data, fileName);
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    --this->NumberOfPendingWrites;
+    if (!success)
+    {
+      ++this->NumberOfFailedWrites;
+    }
+    this->Condition.notify_all();
+  }
+
+  // Wait until fewer than maximum writes are pending and count one more.
+  void Reserve(int maximum)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [this, maximum]() { return this->NumberOfPendingWrites < maximum; });
+    ++this->NumberOfPendingWrites;
+  }
+
+  void Push(vtkSmartPointer<vtkDataObject>&& data, std::string&& fileName)
+  {
+    if (!this->Queue)
+    {
+      // A single worker keeps the writes in order and the writer on one
+      // thread at a time.
+      this->Queue.reset(new TaskQueueType(
+        [this](vtkSmartPointer<vtkDataObject> task, std::string name) { this->Write(task, name); },
+        /*strict_ordering=*/true,
+        /*buffer_size=*/-1,
+        /*max_concurrent_tasks=*/1));
+    }
+    this->Queue->Push(std::move(data), std::move(fileName));
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [this]() { return this->NumberOfPendingWrites == 0; });
+  }
+};
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkAsynchronousWriter);
+
+//----------------------------------------------------------------------------
+vtkAsynchronousWriter::vtkAsynchronousWriter()
+{
+  this->Writer = nullptr;
+  this->FileName = nullptr;
+  this->DeepCopyInput = false;
+  this->MaximumNumberOfPendingWrites = 2;
+  this->Internals = new vtkInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkAsynchronousWriter::~vtkAsynchronousWriter()
+{
+  delete this->Internals;
+  if (this->Writer)
+  {
+    this->Writer->UnRegister(this);
+  }
+  this->SetFileName(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Writer: " << this->Writer << endl;
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << endl;
+  os << indent << "DeepCopyInput: " << this->DeepCopyInput << endl;
+  os << indent << "MaximumNumberOfPendingWrites: " << this->MaximumNumberOfPendingWrites << endl;
+  os << indent << "NumberOfPendingWrites: " << this->GetNumberOfPendingWrites() << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousWriter::SetWriter(vtkAlgorithm* writer)
+{
+  if (this->Writer == writer)
+  {
+    return;
+  }
+  this->Wait();
+  if (this->Writer)
+  {
+    this->Writer->UnRegister(this);
+  }
+  this->Writer = writer;
+  if (this->Writer)
+  {
+    this->Writer->Register(this);
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    this->Internals->Writer = writer;
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousWriter::Wait()
+{
+  this->Internals->Wait();
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousWriter::Flush()
+{
+  this->Internals->Wait();
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  int failed = this->Internals->NumberOfFailedWrites;
+  this->Internals->NumberOfFailedWrites = 0;
+  return failed;
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousWriter::GetNumberOfPendingWrites()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfPendingWrites;
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousWriter::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousWriter::WriteData()
+{
+  vtkDataObject* input = this->GetInput();
+  if (!input)
+  {
+    vtkErrorMacro(<< "No input provided!");
+    return;
+  }
+  if (!this->Writer)
+  {
+    vtkErrorMacro(<< "No writer is set.");
+    return;
+  }
+
+  // Wait for room in the queue before copying the input.
+  this->Internals->Reserve(this->MaximumNumberOfPendingWrites);
+  vtkSmartPointer<vtkDataObject> copy;
+  copy.TakeReference(input->NewInstance());
+  if (this->DeepCopyInput)
+  {
+    copy->DeepCopy(input);
+  }
+  else
+  {
+    copy->ShallowCopy(input);
+  }
+  this->Internals->Push(std::move(copy), std::string(this->FileName ? this->FileName : ""));
+}
@@ -0,0 +1,128 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAsynchronousWriter
+ * @brief   write data with another writer on a background thread
+ *
+ * vtkAsynchronousWriter wraps a writer, such as vtkXMLUnstructuredGridWriter
+ * or vtkXMLPolyDataWriter, so that Write() returns as soon as its input has
+ * been updated and copied. The copies are queued and written in order by
+ * the wrapped writer on a background thread, so that a simulation does not
+ * wait while its output is serialized, compressed and written.
+ *
+ * By default the copy is shallow: the arrays are shared with the input, and
+ * replacing an array of the input with a new one leaves the queued copy
+ * with the old one. The values of an array must not be modified in place
+ * until the writes referencing it are done, see Wait(). Turn DeepCopyInput
+ * on to write a deep copy of the input instead.
+ *
+ * At most MaximumNumberOfPendingWrites copies are queued or being written;
+ * Write() blocks until the oldest one is written when there are more. The
+ * wrapped writer is used from the background thread, so it must not be
+ * used nor modified while writes are pending.
+ *
+ * @sa
+ * vtkThreadedImageWriter
+ */
+
+#ifndef vtkAsynchronousWriter_h
+#define vtkAsynchronousWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkWriter.h"
+
+class VTKIOASYNCHRONOUS_EXPORT vtkAsynchronousWriter : public vtkWriter
+{
+public:
+  static vtkAsynchronousWriter* New();
+  vtkTypeMacro(vtkAsynchronousWriter, vtkWriter);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * The writer that writes the copies of the input. Setting it waits for
+   * the pending writes.
+   */
+  void SetWriter(vtkAlgorithm* writer);
+  vtkGetObjectMacro(Writer, vtkAlgorithm);
+  //@}
+
+  //@{
+  /**
+   * The name of the file that the next Write() writes. When it is set, it is
+   * passed to the writer along with the copy of the input; this is supported
+   * for subclasses of vtkXMLWriter, vtkDataWriter and vtkImageWriter.
+   * Otherwise the file name of the writer is used.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+  //@{
+  /**
+   * Whether Write() makes a deep copy of the input rather than a shallow
+   * one. It is off by default.
+   */
+  vtkSetMacro(DeepCopyInput, bool);
+  vtkGetMacro(DeepCopyInput, bool);
+  vtkBooleanMacro(DeepCopyInput, bool);
+  //@}
+
+  //@{
+  /**
+   * The number of writes that may be queued or in progress before Write()
+   * blocks. It defaults to 2.
+   */
+  vtkSetClampMacro(MaximumNumberOfPendingWrites, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPendingWrites, int);
+  //@}
+
+  /**
+   * Wait until the writes queued so far are done.
+   */
+  void Wait();
+
+  /**
+   * Wait until the writes queued so far are done, and return the number of
+   * writes that failed since the last call to Flush().
+   */
+  int Flush();
+
+  /**
+   * Return the number of writes queued or in progress.
+   */
+  int GetNumberOfPendingWrites();
+
+protected:
+  vtkAsynchronousWriter();
+  ~vtkAsynchronousWriter() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  void WriteData() override;
+
+  vtkAlgorithm* Writer;
+  char* FileName;
+  bool DeepCopyInput;
+  int MaximumNumberOfPendingWrites;
+
+private:
+  vtkAsynchronousWriter(const vtkAsynchronousWriter&) = delete;
+  void operator=(const vtkAsynchronousWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
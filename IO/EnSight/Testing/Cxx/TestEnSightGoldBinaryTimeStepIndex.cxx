@@ -0,0 +1,322 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEnSightGoldBinaryTimeStepIndex.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write a transient binary EnSight Gold case whose time steps are all in
+// one geometry file and one variable file, and read it with UseMemoryMapping
+// and UseTimeStepIndexFiles on.  Every time step is compared with the output
+// of a reader that copies the data through a stream and scans the files.
+// The ".vtkidx" sidecar files must be written, reused by a new reader, and
+// ignored once the size or the modification time of the data files no
+// longer matches them.
+
+#include "vtkDataArray.h"
+#include "vtkDirectory.h"
+#include "vtkGenericEnSightReader.h"
+#include "vtkIdList.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const int NumberOfSteps = 5;
+
+void WriteLine(std::ofstream& file, const char* text)
+{
+  char line[80];
+  memset(line, 0, sizeof(line));
+  strncpy(line, text, sizeof(line) - 1);
+  file.write(line, sizeof(line));
+}
+
+void WriteInt(std::ofstream& file, int value)
+{
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void WriteFloat(std::ofstream& file, float value)
+{
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// A strip of quads moving along z, with a scalar per node.  The readers
+// skip the values of a variable with the number of points of the current
+// geometry, so the strip keeps its size over time.  The files are written in
+// the byte order of this machine so that the mapped path does not copy them.
+bool WriteCase(const std::string& dir, int numQuads)
+{
+  std::ofstream caseFile((dir + "/strip.case").c_str());
+  caseFile << "FORMAT\ntype: ensight gold\n\n"
+           << "GEOMETRY\nmodel: 1 1 strip.geo\n\n"
+           << "VARIABLE\nscalar per node: 1 1 pressure strip.pressure\n\n"
+           << "TIME\ntime set: 1\nnumber of steps: " << NumberOfSteps << "\ntime values:";
+  for (int t = 0; t < NumberOfSteps; ++t)
+  {
+    caseFile << " " << t;
+  }
+  caseFile << "\n\nFILE\nfile set: 1\nnumber of steps: " << NumberOfSteps << "\n";
+
+  std::ofstream geo((dir + "/strip.geo").c_str(), std::ios::out | std::ios::binary);
+  std::ofstream pressure((dir + "/strip.pressure").c_str(), std::ios::out | std::ios::binary);
+  WriteLine(geo, "C Binary");
+  for (int t = 0; t < NumberOfSteps; ++t)
+  {
+    int numPoints = 2 * (numQuads + 1);
+
+    WriteLine(geo, "BEGIN TIME STEP");
+    WriteLine(geo, "strip");
+    WriteLine(geo, "of quads");
+    WriteLine(geo, "node id off");
+    WriteLine(geo, "element id off");
+    WriteLine(geo, "part");
+    WriteInt(geo, 1);
+    WriteLine(geo, "strip");
+    WriteLine(geo, "coordinates");
+    WriteInt(geo, numPoints);
+    for (int i = 0; i < numPoints; ++i)
+    {
+      WriteFloat(geo, static_cast<float>(i / 2));
+    }
+    for (int i = 0; i < numPoints; ++i)
+    {
+      WriteFloat(geo, static_cast<float>(i % 2));
+    }
+    for (int i = 0; i < numPoints; ++i)
+    {
+      WriteFloat(geo, 0.5f * t);
+    }
+    WriteLine(geo, "quad4");
+    WriteInt(geo, numQuads);
+    for (int q = 0; q < numQuads; ++q)
+    {
+      WriteInt(geo, 2 * q + 1);
+      WriteInt(geo, 2 * q + 3);
+      WriteInt(geo, 2 * q + 4);
+      WriteInt(geo, 2 * q + 2);
+    }
+    WriteLine(geo, "END TIME STEP");
+
+    WriteLine(pressure, "BEGIN TIME STEP");
+    WriteLine(pressure, "pressure");
+    WriteLine(pressure, "part");
+    WriteInt(pressure, 1);
+    WriteLine(pressure, "coordinates");
+    for (int i = 0; i < numPoints; ++i)
+    {
+      WriteFloat(pressure, 100.0f * t + i);
+    }
+    WriteLine(pressure, "END TIME STEP");
+  }
+  return caseFile.good() && geo.good() && pressure.good();
+}
+
+bool FileExists(const std::string& name)
+{
+  std::ifstream file(name.c_str());
+  return file.good();
+}
+
+// Keep the size in the stamp of a sidecar but move its modification time,
+// and point its offsets at the start of the file, as if the data file had
+// been rewritten with the same size after the sidecar was saved.
+bool MakeStale(const std::string& sidecar)
+{
+  std::ifstream in(sidecar.c_str());
+  std::string magic, version;
+  long long size, mtime;
+  if (!(in >> magic >> version >> size >> mtime))
+  {
+    return false;
+  }
+  in.close();
+  std::ofstream out(sidecar.c_str());
+  out << magic << " " << version << " " << size << " " << (mtime - 1000) << "\n";
+  out << "steps 1\n";
+  for (int t = 0; t < NumberOfSteps; ++t)
+  {
+    out << t << " 80\n";
+  }
+  return out.good();
+}
+
+vtkUnstructuredGrid* GetStrip(vtkGenericEnSightReader* reader)
+{
+  vtkMultiBlockDataSet* output = reader->GetOutput();
+  return output && output->GetNumberOfBlocks() == 1
+    ? vtkUnstructuredGrid::SafeDownCast(output->GetBlock(0))
+    : nullptr;
+}
+
+bool Compare(vtkGenericEnSightReader* expected, vtkGenericEnSightReader* actual,
+  int numberOfQuads, const char* name, int step)
+{
+  vtkUnstructuredGrid* a = GetStrip(expected);
+  vtkUnstructuredGrid* b = GetStrip(actual);
+  if (!a || !b || a->GetNumberOfCells() != numberOfQuads ||
+    b->GetNumberOfCells() != numberOfQuads || a->GetNumberOfPoints() != b->GetNumberOfPoints())
+  {
+    std::cerr << name << ": time step " << step << " has the wrong mesh.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double pa[3], pb[3];
+    a->GetPoints()->GetPoint(i, pa);
+    b->GetPoints()->GetPoint(i, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2] || pa[2] != 0.5 * step)
+    {
+      std::cerr << name << ": time step " << step << " point " << i << " differs.\n";
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> ia, ib;
+  for (vtkIdType c = 0; c < a->GetNumberOfCells(); ++c)
+  {
+    a->GetCellPoints(c, ia);
+    b->GetCellPoints(c, ib);
+    if (ia->GetNumberOfIds() != 4 || ib->GetNumberOfIds() != 4 ||
+      memcmp(ia->GetPointer(0), ib->GetPointer(0), 4 * sizeof(vtkIdType)) != 0)
+    {
+      std::cerr << name << ": time step " << step << " cell " << c << " differs.\n";
+      return false;
+    }
+  }
+  vtkDataArray* sa = a->GetPointData()->GetArray("pressure");
+  vtkDataArray* sb = b->GetPointData()->GetArray("pressure");
+  if (!sa || !sb || sa->GetNumberOfTuples() != a->GetNumberOfPoints() ||
+    sb->GetNumberOfTuples() != a->GetNumberOfPoints())
+  {
+    std::cerr << name << ": time step " << step << " has no pressure.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < sa->GetNumberOfTuples(); ++i)
+  {
+    if (sa->GetComponent(i, 0) != sb->GetComponent(i, 0) ||
+      sa->GetComponent(i, 0) != 100.0 * step + i)
+    {
+      std::cerr << name << ": time step " << step << " pressure " << i << " differs.\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+// Read every time step with a new reader of each kind, in the given order.
+bool CheckCase(const std::string& caseFileName, int numberOfQuads, const std::vector<int>& steps,
+  const char* name)
+{
+  vtkNew<vtkGenericEnSightReader> copying;
+  copying->SetCaseFileName(caseFileName.c_str());
+  vtkNew<vtkGenericEnSightReader> indexed;
+  indexed->SetCaseFileName(caseFileName.c_str());
+  indexed->UseMemoryMappingOn();
+  indexed->UseTimeStepIndexFilesOn();
+
+  for (int step : steps)
+  {
+    copying->UpdateTimeStep(step);
+    indexed->UpdateTimeStep(step);
+    if (!Compare(copying, indexed, numberOfQuads, name, step))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestEnSightGoldBinaryTimeStepIndex(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string dir = std::string(tempDir) + "/TestEnSightGoldBinaryTimeStepIndex";
+  delete[] tempDir;
+  vtkDirectory::MakeDirectory(dir.c_str());
+  const std::string caseFileName = dir + "/strip.case";
+  const std::string geoIndex = dir + "/strip.geo.vtkidx";
+  const std::string pressureIndex = dir + "/strip.pressure.vtkidx";
+  remove(geoIndex.c_str());
+  remove(pressureIndex.c_str());
+
+  const int quads = 4;
+  if (!WriteCase(dir, quads))
+  {
+    std::cerr << "Could not write the case in " << dir << ".\n";
+    return EXIT_FAILURE;
+  }
+  const std::vector<int> forward = { 0, 1, 2, 3, 4 };
+  const std::vector<int> backward = { 4, 2, 3, 1, 0 };
+
+  // Without sidecars, then with the sidecars saved by the first reader.
+  if (!CheckCase(caseFileName, quads, forward, "Scanning"))
+  {
+    return EXIT_FAILURE;
+  }
+  if (!FileExists(geoIndex) || !FileExists(pressureIndex))
+  {
+    std::cerr << "The time step index files were not written.\n";
+    return EXIT_FAILURE;
+  }
+  if (!CheckCase(caseFileName, quads, backward, "Indexed"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Sidecars whose modification time does not match the data files.
+  if (!MakeStale(geoIndex) || !MakeStale(pressureIndex))
+  {
+    std::cerr << "Could not rewrite the time step index files.\n";
+    return EXIT_FAILURE;
+  }
+  if (!CheckCase(caseFileName, quads, backward, "Stale modification time"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Data files rewritten with another size, next to the sidecars of the
+  // previous ones.
+  const int otherQuads = 6;
+  if (!WriteCase(dir, otherQuads))
+  {
+    std::cerr << "Could not rewrite the case in " << dir << ".\n";
+    return EXIT_FAILURE;
+  }
+  if (!CheckCase(caseFileName, otherQuads, backward, "Stale size"))
+  {
+    return EXIT_FAILURE;
+  }
+  if (!CheckCase(caseFileName, otherQuads, forward, "Indexed after rewrite"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
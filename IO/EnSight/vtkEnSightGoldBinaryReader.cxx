@@ -25,17 +25,32 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSOADataArrayTemplate.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 
 #include <cctype>
+#include <istream>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <streambuf>
 #include <string>
 #include <sys/stat.h>
 #include <vector>
 
+#if defined(_WIN32)
+#include "vtkWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #if defined(_WIN32)
 #define VTK_STAT_STRUCT struct _stat64
 #define VTK_STAT_FUNC _stat64
@@ -51,6 +66,197 @@
 #define VTK_STAT_FUNC stat64
 #endif
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+// A whole file mapped in memory. The mapping is private (copy-on-write) so
+// that the arrays pointing into it may be modified without touching the
+// file.
+class vtkEnSightMappedFile
+{
+public:
+  // Returns nullptr when the file cannot be mapped.
+  static std::shared_ptr<vtkEnSightMappedFile> Map(const char* filename, vtkTypeUInt64 size)
+  {
+    if (size == 0 || size > static_cast<vtkTypeUInt64>(static_cast<size_t>(-1)))
+    {
+      return nullptr;
+    }
+    std::shared_ptr<vtkEnSightMappedFile> file(new vtkEnSightMappedFile);
+    file->Size = static_cast<size_t>(size);
+#if defined(_WIN32)
+    HANDLE handle = CreateFileW(vtksys::Encoding::ToWide(filename).c_str(), GENERIC_READ,
+      FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+      return nullptr;
+    }
+    HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(handle);
+    if (!mapping)
+    {
+      return nullptr;
+    }
+    file->Data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, file->Size));
+    CloseHandle(mapping);
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      return nullptr;
+    }
+    void* data = mmap(nullptr, file->Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    file->Data = data != MAP_FAILED ? static_cast<char*>(data) : nullptr;
+#endif
+    return file->Data ? file : nullptr;
+  }
+
+  ~vtkEnSightMappedFile()
+  {
+    if (this->Data)
+    {
+#if defined(_WIN32)
+      UnmapViewOfFile(this->Data);
+#else
+      munmap(this->Data, this->Size);
+#endif
+    }
+  }
+
+  char* Data = nullptr;
+  size_t Size = 0;
+
+private:
+  vtkEnSightMappedFile() = default;
+};
+
+//----------------------------------------------------------------------------
+// The mapped files referenced by the arrays created without a copy, keyed
+// by the component pointers handed to vtkSOADataArrayTemplate.
+std::mutex MappedArraysMutex;
+std::multimap<void*, std::shared_ptr<vtkEnSightMappedFile> > MappedArrays;
+
+void KeepMapped(void* pointer, const std::shared_ptr<vtkEnSightMappedFile>& file)
+{
+  std::lock_guard<std::mutex> lock(MappedArraysMutex);
+  MappedArrays.insert(std::make_pair(pointer, file));
+}
+
+void ReleaseMapped(void* pointer)
+{
+  std::shared_ptr<vtkEnSightMappedFile> file;
+  std::lock_guard<std::mutex> lock(MappedArraysMutex);
+  auto pos = MappedArrays.find(pointer);
+  if (pos != MappedArrays.end())
+  {
+    // Unmap after the lock is released.
+    file.swap(pos->second);
+    MappedArrays.erase(pos);
+  }
+}
+
+//----------------------------------------------------------------------------
+// A stream reading a mapped file, so that the reader code is the same
+// whether or not the file is mapped.
+class vtkEnSightMappedBuffer : public std::streambuf
+{
+public:
+  explicit vtkEnSightMappedBuffer(const std::shared_ptr<vtkEnSightMappedFile>& file)
+    : File(file)
+  {
+    this->setg(file->Data, file->Data, file->Data + file->Size);
+  }
+
+  const std::shared_ptr<vtkEnSightMappedFile>& GetFile() const { return this->File; }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+  {
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+    {
+      base = this->gptr() - this->eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      base = static_cast<off_type>(this->File->Size);
+    }
+    return this->seekpos(pos_type(base + off), std::ios_base::in);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode) override
+  {
+    off_type offset = pos;
+    if (offset < 0 || offset > static_cast<off_type>(this->File->Size))
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->eback(), this->eback() + offset, this->egptr());
+    return pos;
+  }
+
+private:
+  std::shared_ptr<vtkEnSightMappedFile> File;
+};
+
+class vtkEnSightMappedStream : public std::istream
+{
+public:
+  explicit vtkEnSightMappedStream(const std::shared_ptr<vtkEnSightMappedFile>& file)
+    : std::istream(nullptr)
+    , Buffer(file)
+  {
+    this->rdbuf(&this->Buffer);
+  }
+
+  const std::shared_ptr<vtkEnSightMappedFile>& GetFile() const { return this->Buffer.GetFile(); }
+
+private:
+  vtkEnSightMappedBuffer Buffer;
+};
+
+//----------------------------------------------------------------------------
+// The path of a file of the case, as the readers build it.
+std::string GetFullFileName(const char* filePath, const char* fileName)
+{
+  std::string sfilename;
+  if (filePath)
+  {
+    sfilename = filePath;
+    if (sfilename.at(sfilename.length() - 1) != '/')
+    {
+      sfilename += "/";
+    }
+  }
+  sfilename += fileName;
+  return sfilename;
+}
+
+// The sidecar file holding the time step offsets of a file.
+std::string GetTimeStepIndexFileName(const std::string& fileName)
+{
+  return fileName + ".vtkidx";
+}
+
+// The size and modification time a sidecar file must match, empty when the
+// file cannot be found.
+std::string GetTimeStepIndexStamp(const std::string& fileName)
+{
+  VTK_STAT_STRUCT fs;
+  if (VTK_STAT_FUNC(fileName.c_str(), &fs))
+  {
+    return std::string();
+  }
+  std::ostringstream stamp;
+  stamp << "vtkEnSightTimeStepIndex 1 " << static_cast<vtkTypeUInt64>(fs.st_size) << " "
+        << static_cast<vtkTypeInt64>(fs.st_mtime);
+  return stamp.str();
+}
+
+} // end anon namespace
+
 vtkStandardNewMacro(vtkEnSightGoldBinaryReader);
 class vtkEnSightGoldBinaryReader::FileOffsetMapInternal
 {
@@ -62,6 +268,17 @@ public:
   typedef std::map<MapKey, MapValue>::value_type value_type;
 
   std::map<MapKey, MapValue> Map;
+
+  // The number of time steps of the files that have been counted.
+  std::map<MapKey, int> NumberOfTimeSteps;
+  // The files whose sidecar index has been looked for.
+  std::set<MapKey> IndexFilesRead;
+  // The files whose sidecar index holds the cache, but for the offsets
+  // added since, which are saved by WriteTimeStepIndexFiles().
+  std::set<MapKey> IndexFilesSaved;
+  std::map<MapKey, MapValue> UnsavedOffsets;
+  // The offset of the last time step skipped by SkipTimeStep().
+  vtkTypeInt64 LastTimeStepAddress = 0;
 };
 
 // This is half the precision of an int.
@@ -108,11 +325,23 @@ int vtkEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = static_cast<vtkTypeUInt64>(fs.st_size);
 
-    std::ios_base::openmode mode = ios::in;
+    std::shared_ptr<vtkEnSightMappedFile> mapped;
+    if (this->UseMemoryMapping)
+    {
+      mapped = vtkEnSightMappedFile::Map(filename, this->FileSize);
+    }
+    if (mapped)
+    {
+      this->GoldIFile = new vtkEnSightMappedStream(mapped);
+    }
+    else
+    {
+      std::ios_base::openmode mode = ios::in;
 #ifdef _WIN32
-    mode |= ios::binary;
+      mode |= ios::binary;
 #endif
-    this->GoldIFile = new vtksys::ifstream(filename, mode);
+      this->GoldIFile = new vtksys::ifstream(filename, mode);
+    }
   }
   else
   {
@@ -260,7 +489,7 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(
   }
 
   // this will close the file, so we need to reinitialize it
-  int numberOfTimeStepsInFile = this->CountTimeSteps();
+  int numberOfTimeStepsInFile = this->CountTimeSteps(fileName);
 
   if (!this->InitializeFile(fileName))
   {
@@ -418,14 +647,27 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(
 }
 
 //----------------------------------------------------------------------------
-int vtkEnSightGoldBinaryReader::CountTimeSteps()
+int vtkEnSightGoldBinaryReader::CountTimeSteps(const char* fileName)
 {
+  bool indexed = fileName && this->UseTimeStepIndexFiles;
+  if (indexed)
+  {
+    this->ReadTimeStepIndexFile(fileName);
+    auto known = this->FileOffsets->NumberOfTimeSteps.find(fileName);
+    if (known != this->FileOffsets->NumberOfTimeSteps.end())
+    {
+      return known->second;
+    }
+  }
+
   int count = 0;
+  std::map<int, vtkTypeInt64> offsets;
   while (1)
   {
     int result = this->SkipTimeStep();
     if (result)
     {
+      offsets[count] = this->FileOffsets->LastTimeStepAddress;
       count++;
     }
     else
@@ -433,6 +675,18 @@ int vtkEnSightGoldBinaryReader::CountTimeSteps()
       break;
     }
   }
+
+  if (indexed)
+  {
+    // Keep the offsets found on the way so that no time step is searched
+    // for again.
+    this->FileOffsets->NumberOfTimeSteps[fileName] = count;
+    if (count > 1)
+    {
+      this->FileOffsets->Map[fileName].insert(offsets.begin(), offsets.end());
+    }
+    this->WriteTimeStepIndexFile(fileName);
+  }
   return count;
 }
 
@@ -450,6 +704,7 @@ int vtkEnSightGoldBinaryReader::SkipTimeStep()
       return 0;
     }
   }
+  this->FileOffsets->LastTimeStepAddress = this->GoldIFile->tellg();
 
   // Skip the 2 description lines.
   this->ReadLine(line);
@@ -1405,39 +1660,55 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const c
     }
     else
     {
-      if (component == 0)
+      // Complex scalars are filled one component at a time.
+      vtkDataArray* mappedScalars =
+        numberOfComponents == 1 ? this->ReadMappedFloatArrays(1, numPts) : nullptr;
+      if (mappedScalars)
       {
-        scalars = vtkFloatArray::New();
-        scalars->SetNumberOfComponents(numberOfComponents);
-        scalars->SetNumberOfTuples(numPts);
+        mappedScalars->SetName(description);
+        output->GetPointData()->AddArray(mappedScalars);
+        if (!output->GetPointData()->GetScalars())
+        {
+          output->GetPointData()->SetScalars(mappedScalars);
+        }
+        mappedScalars->Delete();
       }
       else
       {
-        scalars = (vtkFloatArray*)(output->GetPointData()->GetArray(description));
-      }
+        if (component == 0)
+        {
+          scalars = vtkFloatArray::New();
+          scalars->SetNumberOfComponents(numberOfComponents);
+          scalars->SetNumberOfTuples(numPts);
+        }
+        else
+        {
+          scalars = (vtkFloatArray*)(output->GetPointData()->GetArray(description));
+        }
 
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
+        scalarsRead = new float[numPts];
+        this->ReadFloatArray(scalarsRead, numPts);
 
-      for (i = 0; i < numPts; i++)
-      {
-        scalars->SetComponent(i, component, scalarsRead[i]);
-      }
-      if (component == 0)
-      {
-        scalars->SetName(description);
-        output->GetPointData()->AddArray(scalars);
-        if (!output->GetPointData()->GetScalars())
+        for (i = 0; i < numPts; i++)
         {
-          output->GetPointData()->SetScalars(scalars);
+          scalars->SetComponent(i, component, scalarsRead[i]);
         }
-        scalars->Delete();
-      }
-      else
-      {
-        output->GetPointData()->AddArray(scalars);
+        if (component == 0)
+        {
+          scalars->SetName(description);
+          output->GetPointData()->AddArray(scalars);
+          if (!output->GetPointData()->GetScalars())
+          {
+            output->GetPointData()->SetScalars(scalars);
+          }
+          scalars->Delete();
+        }
+        else
+        {
+          output->GetPointData()->AddArray(scalars);
+        }
+        delete[] scalarsRead;
       }
-      delete[] scalarsRead;
     }
 
     this->GoldIFile->peek();
@@ -1609,32 +1880,46 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const c
     }
     else
     {
-      vectors = vtkFloatArray::New();
-      vectors->SetNumberOfComponents(3);
-      vectors->SetNumberOfTuples(numPts);
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
+      vtkDataArray* mappedVectors = this->ReadMappedFloatArrays(3, numPts);
+      if (mappedVectors)
       {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        vectors->SetTuple(i, tuple);
+        mappedVectors->SetName(description);
+        output->GetPointData()->AddArray(mappedVectors);
+        if (!output->GetPointData()->GetVectors())
+        {
+          output->GetPointData()->SetVectors(mappedVectors);
+        }
+        mappedVectors->Delete();
       }
-      vectors->SetName(description);
-      output->GetPointData()->AddArray(vectors);
-      if (!output->GetPointData()->GetVectors())
+      else
       {
-        output->GetPointData()->SetVectors(vectors);
+        vectors = vtkFloatArray::New();
+        vectors->SetNumberOfComponents(3);
+        vectors->SetNumberOfTuples(numPts);
+        comp1 = new float[numPts];
+        comp2 = new float[numPts];
+        comp3 = new float[numPts];
+        this->ReadFloatArray(comp1, numPts);
+        this->ReadFloatArray(comp2, numPts);
+        this->ReadFloatArray(comp3, numPts);
+        for (i = 0; i < numPts; i++)
+        {
+          tuple[0] = comp1[i];
+          tuple[1] = comp2[i];
+          tuple[2] = comp3[i];
+          vectors->SetTuple(i, tuple);
+        }
+        vectors->SetName(description);
+        output->GetPointData()->AddArray(vectors);
+        if (!output->GetPointData()->GetVectors())
+        {
+          output->GetPointData()->SetVectors(vectors);
+        }
+        vectors->Delete();
+        delete[] comp1;
+        delete[] comp2;
+        delete[] comp3;
       }
-      vectors->Delete();
-      delete[] comp1;
-      delete[] comp2;
-      delete[] comp3;
     }
 
     this->GoldIFile->peek();
@@ -2571,23 +2856,32 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
         this->GoldIFile->seekg(sizeof(int) * numPts, ios::cur);
       }
 
-      xCoords = new float[numPts];
-      yCoords = new float[numPts];
-      zCoords = new float[numPts];
-      this->ReadFloatArray(xCoords, numPts);
-      this->ReadFloatArray(yCoords, numPts);
-      this->ReadFloatArray(zCoords, numPts);
-
-      for (i = 0; i < numPts; i++)
+      vtkDataArray* mappedCoords = this->ReadMappedFloatArrays(3, numPts);
+      if (mappedCoords)
+      {
+        points->SetData(mappedCoords);
+        mappedCoords->Delete();
+      }
+      else
       {
-        points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
+        xCoords = new float[numPts];
+        yCoords = new float[numPts];
+        zCoords = new float[numPts];
+        this->ReadFloatArray(xCoords, numPts);
+        this->ReadFloatArray(yCoords, numPts);
+        this->ReadFloatArray(zCoords, numPts);
+
+        for (i = 0; i < numPts; i++)
+        {
+          points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
+        }
+        delete[] xCoords;
+        delete[] yCoords;
+        delete[] zCoords;
       }
 
       output->SetPoints(points);
       points->Delete();
-      delete[] xCoords;
-      delete[] yCoords;
-      delete[] zCoords;
     }
     else if (strncmp(line, "point", 5) == 0)
     {
@@ -3657,16 +3951,26 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
   output->SetDimensions(dimensions);
   points->Allocate(numPts);
 
-  xCoords = new float[numPts];
-  yCoords = new float[numPts];
-  zCoords = new float[numPts];
-  this->ReadFloatArray(xCoords, numPts);
-  this->ReadFloatArray(yCoords, numPts);
-  this->ReadFloatArray(zCoords, numPts);
-
-  for (i = 0; i < numPts; i++)
+  vtkDataArray* mappedCoords = this->ReadMappedFloatArrays(3, numPts);
+  if (mappedCoords)
   {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
+    points->SetData(mappedCoords);
+    mappedCoords->Delete();
+    xCoords = yCoords = zCoords = nullptr;
+  }
+  else
+  {
+    xCoords = new float[numPts];
+    yCoords = new float[numPts];
+    zCoords = new float[numPts];
+    this->ReadFloatArray(xCoords, numPts);
+    this->ReadFloatArray(yCoords, numPts);
+    this->ReadFloatArray(zCoords, numPts);
+
+    for (i = 0; i < numPts; i++)
+    {
+      points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
+    }
   }
   output->SetPoints(points);
   if (iblanked)
@@ -4144,6 +4448,49 @@ int vtkEnSightGoldBinaryReader::ReadFloatArray(float* result, int numFloats)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkDataArray* vtkEnSightGoldBinaryReader::ReadMappedFloatArrays(int numArrays, int numFloats)
+{
+  vtkEnSightMappedStream* stream = dynamic_cast<vtkEnSightMappedStream*>(this->GoldIFile);
+  if (!stream || numArrays <= 0 || numFloats <= 0)
+  {
+    return nullptr;
+  }
+#ifdef VTK_WORDS_BIGENDIAN
+  if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+#else
+  if (this->ByteOrder != FILE_LITTLE_ENDIAN)
+#endif
+  {
+    return nullptr;
+  }
+
+  // Each array is a record of its own in Fortran files.
+  const std::shared_ptr<vtkEnSightMappedFile>& file = stream->GetFile();
+  const vtkTypeInt64 marker = this->Fortran ? 4 : 0;
+  const vtkTypeInt64 length = static_cast<vtkTypeInt64>(sizeof(float)) * numFloats;
+  vtkTypeInt64 start = static_cast<vtkTypeInt64>(stream->tellg());
+  if (start < 0 || start % sizeof(float) != 0 ||
+    start + numArrays * (length + 2 * marker) > static_cast<vtkTypeInt64>(file->Size))
+  {
+    return nullptr;
+  }
+
+  vtkSOADataArrayTemplate<float>* array = vtkSOADataArrayTemplate<float>::New();
+  array->SetNumberOfComponents(numArrays);
+  for (int comp = 0; comp < numArrays; ++comp)
+  {
+    float* values = reinterpret_cast<float*>(file->Data + start + marker);
+    KeepMapped(values, file);
+    array->SetArray(comp, values, numFloats, true, false,
+      vtkSOADataArrayTemplate<float>::VTK_DATA_ARRAY_USER_DEFINED);
+    array->SetArrayFreeFunction(comp, ReleaseMapped);
+    start += length + 2 * marker;
+  }
+  stream->seekg(start, ios::beg);
+  return array;
+}
+
 //----------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -4194,12 +4541,22 @@ void vtkEnSightGoldBinaryReader::AddTimeStepToCache(
     std::map<int, vtkTypeInt64> tsMap;
     this->FileOffsets->Map[fileName] = tsMap;
   }
-  this->FileOffsets->Map[fileName][realTimeStep] = address;
+  vtkTypeInt64& cached = this->FileOffsets->Map[fileName][realTimeStep];
+  if (cached != address)
+  {
+    cached = address;
+    if (this->UseTimeStepIndexFiles)
+    {
+      this->FileOffsets->UnsavedOffsets[fileName][realTimeStep] = address;
+    }
+  }
 }
 
 //----------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::AddFileIndexToCache(const char* fileName)
 {
+  this->ReadTimeStepIndexFile(fileName);
+
   // only read the file index if we have not searched for the file index before
   if (this->FileOffsets->Map.find(fileName) == this->FileOffsets->Map.end())
   {
@@ -4236,3 +4593,108 @@ void vtkEnSightGoldBinaryReader::AddFileIndexToCache(const char* fileName)
   }
   this->GoldIFile->seekg(0l, ios::beg);
 }
+
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReader::ReadTimeStepIndexFile(const char* fileName)
+{
+  if (!this->UseTimeStepIndexFiles || !this->FileOffsets->IndexFilesRead.insert(fileName).second)
+  {
+    return;
+  }
+
+  std::string fullName = GetFullFileName(this->FilePath, fileName);
+  vtksys::ifstream index(GetTimeStepIndexFileName(fullName).c_str());
+  std::string stamp;
+  if (!index || !std::getline(index, stamp) || stamp != GetTimeStepIndexStamp(fullName))
+  {
+    return;
+  }
+
+  std::string key;
+  vtkTypeInt64 value;
+  while (index >> key >> value)
+  {
+    if (key == "steps")
+    {
+      this->FileOffsets->NumberOfTimeSteps[fileName] = static_cast<int>(value);
+    }
+    else
+    {
+      this->FileOffsets->Map[fileName][atoi(key.c_str())] = value;
+    }
+  }
+  this->FileOffsets->IndexFilesSaved.insert(fileName);
+  vtkDebugMacro("Read the time step index of " << fullName);
+}
+
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReader::WriteTimeStepIndexFile(const char* fileName)
+{
+  if (!this->UseTimeStepIndexFiles)
+  {
+    return;
+  }
+
+  std::string fullName = GetFullFileName(this->FilePath, fileName);
+  std::string stamp = GetTimeStepIndexStamp(fullName);
+  if (stamp.empty())
+  {
+    return;
+  }
+  vtksys::ofstream index(GetTimeStepIndexFileName(fullName).c_str());
+  if (!index)
+  {
+    // The directory of the case may be read-only.
+    vtkDebugMacro("Cannot write the time step index of " << fullName);
+    return;
+  }
+
+  index << stamp << "\n";
+  auto count = this->FileOffsets->NumberOfTimeSteps.find(fileName);
+  if (count != this->FileOffsets->NumberOfTimeSteps.end())
+  {
+    index << "steps " << count->second << "\n";
+  }
+  auto offsets = this->FileOffsets->Map.find(fileName);
+  if (offsets != this->FileOffsets->Map.end())
+  {
+    for (const auto& offset : offsets->second)
+    {
+      index << offset.first << " " << offset.second << "\n";
+    }
+  }
+  this->FileOffsets->IndexFilesSaved.insert(fileName);
+  this->FileOffsets->UnsavedOffsets.erase(fileName);
+}
+
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReader::WriteTimeStepIndexFiles()
+{
+  // Appending keeps the cost of saving linear in the number of time steps
+  // when they are found one update at a time.
+  auto unsaved = this->FileOffsets->UnsavedOffsets;
+  for (const auto& file : unsaved)
+  {
+    if (!this->FileOffsets->IndexFilesSaved.count(file.first))
+    {
+      this->WriteTimeStepIndexFile(file.first.c_str());
+      continue;
+    }
+    std::string fullName = GetFullFileName(this->FilePath, file.first.c_str());
+    vtksys::ofstream index(GetTimeStepIndexFileName(fullName).c_str(), ios::out | ios::app);
+    for (const auto& offset : file.second)
+    {
+      index << offset.first << " " << offset.second << "\n";
+    }
+  }
+  this->FileOffsets->UnsavedOffsets.clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  int result = this->Superclass::RequestData(request, inputVector, outputVector);
+  this->WriteTimeStepIndexFiles();
+  return result;
+}
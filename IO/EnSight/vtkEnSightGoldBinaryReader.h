@@ -43,6 +43,7 @@
 #include "vtkEnSightReader.h"
 #include "vtkIOEnSightModule.h" // For export macro
 
+class vtkDataArray;
 class vtkMultiBlockDataSet;
 
 class VTKIOENSIGHT_EXPORT vtkEnSightGoldBinaryReader : public vtkEnSightReader
@@ -56,6 +57,12 @@ protected:
   vtkEnSightGoldBinaryReader();
   ~vtkEnSightGoldBinaryReader() override;
 
+  /**
+   * Read the data, then save the time step offsets found while reading
+   * to the sidecar files.
+   */
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
   // Returns 1 if successful.  Sets file size as a side action.
   int OpenFile(const char* filename);
 
@@ -182,13 +189,25 @@ protected:
    */
   int ReadFloatArray(float* result, int numFloats);
 
+  /**
+   * Internal function to expose numArrays consecutive float arrays of
+   * numFloats values each as the components of a new
+   * vtkSOADataArrayTemplate<float> pointing into the memory mapped file.
+   * Returns nullptr without reading anything if the file is not mapped or
+   * the values need swapping; the caller then uses ReadFloatArray().
+   */
+  vtkDataArray* ReadMappedFloatArrays(int numArrays, int numFloats);
+
   /**
    * Counts the number of timesteps in the geometry file
    * This function assumes the file is already open and returns the
    * number of timesteps remaining in the file
    * The file will be closed after calling this method
+   * When fileName is given and UseTimeStepIndexFiles is on, the number of
+   * time steps and their offsets are looked up in, or added to, the time
+   * step cache and its sidecar file.
    */
-  int CountTimeSteps();
+  int CountTimeSteps(const char* fileName = nullptr);
 
   //@{
   /**
@@ -216,6 +235,22 @@ protected:
    */
   void AddFileIndexToCache(const char* fileName);
 
+  //@{
+  /**
+   * Read or write the sidecar file holding the time step cache of a file
+   * when UseTimeStepIndexFiles is on.
+   */
+  void ReadTimeStepIndexFile(const char* fileName);
+  void WriteTimeStepIndexFile(const char* fileName);
+  //@}
+
+  /**
+   * Save the offsets added to the time step cache since the sidecar files
+   * were last read or written.  They are appended to a sidecar that holds
+   * the rest of the cache, and other sidecars are rewritten.
+   */
+  void WriteTimeStepIndexFiles();
+
   int NodeIdsListed;
   int ElementIdsListed;
   int Fortran;
@@ -92,6 +92,8 @@ vtkGenericEnSightReader::vtkGenericEnSightReader()
   this->ByteOrder = FILE_UNKNOWN_ENDIAN;
 
   this->ParticleCoordinatesByIndex = 0;
+  this->UseMemoryMapping = 0;
+  this->UseTimeStepIndexFiles = 0;
 
   this->EnSightVersion = -1;
 
@@ -198,6 +200,8 @@ int vtkGenericEnSightReader::RequestData(vtkInformation* vtkNotUsed(request),
   this->SetReaderDataArraySelectionSetsFromSelf();
 
   this->Reader->SetTimeValue(this->GetTimeValue());
+  this->Reader->SetUseMemoryMapping(this->UseMemoryMapping);
+  this->Reader->SetUseTimeStepIndexFiles(this->UseTimeStepIndexFiles);
   this->Reader->UpdateInformation();
   vtkInformation* tmpOutInfo = this->Reader->GetExecutive()->GetOutputInformation(0);
   if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
@@ -823,6 +827,8 @@ int vtkGenericEnSightReader::RequestInformation(
   this->ByteOrder = FILE_UNKNOWN_ENDIAN;
 
   this->Reader->SetByteOrder(this->ByteOrder);
+  this->Reader->SetUseMemoryMapping(this->UseMemoryMapping);
+  this->Reader->SetUseTimeStepIndexFiles(this->UseTimeStepIndexFiles);
   this->Reader->RequestInformation(request, inputVector, outputVector);
   this->Reader->SetParticleCoordinatesByIndex(this->ParticleCoordinatesByIndex);
 
@@ -1393,6 +1399,8 @@ void vtkGenericEnSightReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ReadAllVariables: " << this->ReadAllVariables << endl;
   os << indent << "ByteOrder: " << this->ByteOrder << endl;
   os << indent << "ParticleCoordinatesByIndex: " << this->ParticleCoordinatesByIndex << endl;
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << endl;
+  os << indent << "UseTimeStepIndexFiles: " << this->UseTimeStepIndexFiles << endl;
   os << indent << "CellDataArraySelection: " << this->CellDataArraySelection << endl;
   os << indent << "PointDataArraySelection: " << this->PointDataArraySelection << endl;
   os << indent
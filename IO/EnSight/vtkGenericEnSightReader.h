@@ -265,6 +265,36 @@ public:
   vtkBooleanMacro(ParticleCoordinatesByIndex, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Only used for binary EnSight Gold files. When UseMemoryMapping is on,
+   * the geometry and variable files are mapped in memory instead of being
+   * read through a stream, and the per-node float coordinates, scalars and
+   * vectors stored in the byte order of this machine are exposed without a
+   * copy as vtkSOADataArrayTemplate<float> arrays that keep the file mapped.
+   * The files must not be truncated or modified while they are mapped.
+   * It is off by default.
+   */
+  vtkSetMacro(UseMemoryMapping, vtkTypeBool);
+  vtkGetMacro(UseMemoryMapping, vtkTypeBool);
+  vtkBooleanMacro(UseMemoryMapping, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Only used for binary EnSight Gold files. When UseTimeStepIndexFiles is
+   * on, the offsets of the time steps found while reading a transient file
+   * that has no FILE_INDEX are saved to a sidecar file named after it with
+   * a ".vtkidx" extension, next to it, and read back the next time the file
+   * is opened so that seeking to a time step does not rescan the file. The
+   * sidecar file is ignored when the size or modification time of the file
+   * changed. It is off by default.
+   */
+  vtkSetMacro(UseTimeStepIndexFiles, vtkTypeBool);
+  vtkGetMacro(UseTimeStepIndexFiles, vtkTypeBool);
+  vtkBooleanMacro(UseTimeStepIndexFiles, vtkTypeBool);
+  //@}
+
   /**
    * Returns true if the file pointed to by casefilename appears to be a
    * valid EnSight case file.
@@ -411,6 +441,8 @@ protected:
 
   int ByteOrder;
   vtkTypeBool ParticleCoordinatesByIndex;
+  vtkTypeBool UseMemoryMapping;
+  vtkTypeBool UseTimeStepIndexFiles;
 
   // The EnSight file version being read.  Valid after
   // UpdateInformation.  Value is -1 for unknown version.
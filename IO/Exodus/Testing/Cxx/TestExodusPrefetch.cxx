@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusPrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Step through the time steps of can.ex2 with and without prefetching the
+// next time step and check that both readers produce the same point data.
+// Then change the array selection and displacements while a prefetch runs.
+
+#include "vtkDataArray.h"
+#include "vtkExodusIICache.h"
+#include "vtkExodusIIReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+vtkDataArray* GetVelocity(vtkExodusIIReader* reader)
+{
+  auto elementBlocks = vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  auto grid =
+    elementBlocks ? vtkUnstructuredGrid::SafeDownCast(elementBlocks->GetBlock(0)) : nullptr;
+  return grid ? grid->GetPointData()->GetArray("VEL") : nullptr;
+}
+
+bool CompareVelocity(vtkExodusIIReader* serial, vtkExodusIIReader* prefetched, int step)
+{
+  vtkDataArray* a = GetVelocity(serial);
+  vtkDataArray* b = GetVelocity(prefetched);
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples())
+  {
+    std::cerr << "Missing or mismatched velocity at time step " << step << ".\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        std::cerr << "Velocity differs at time step " << step << ", point " << i << ".\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestExodusPrefetch(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/can.ex2");
+  if (!fname)
+  {
+    std::cout << "Could not obtain filename for test data.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = fname;
+  delete[] fname;
+
+  vtkNew<vtkExodusIIReader> serial;
+  vtkNew<vtkExodusIIReader> prefetched;
+  for (vtkExodusIIReader* reader : { serial.GetPointer(), prefetched.GetPointer() })
+  {
+    reader->SetFileName(fileName.c_str());
+    reader->UpdateInformation();
+    reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+    reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+    reader->SetCacheSize(64.0);
+  }
+  prefetched->PrefetchNextTimeStepOn();
+  vtkExodusIIReader::SetGlobalCacheSize(100.0);
+
+  int numSteps = serial->GetNumberOfTimeSteps();
+  if (numSteps < 3)
+  {
+    std::cerr << "Expected several time steps, got " << numSteps << ".\n";
+    return EXIT_FAILURE;
+  }
+  for (int step = 0; step < numSteps; ++step)
+  {
+    serial->SetTimeStep(step);
+    serial->Update();
+    prefetched->SetTimeStep(step);
+    prefetched->Update();
+
+    if (!CompareVelocity(serial, prefetched, step))
+    {
+      return EXIT_FAILURE;
+    }
+    if (vtkExodusIICache::GetGlobalCacheSize() > 100.0 + 16.0)
+    {
+      std::cerr << "The caches exceed the global budget.\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Each update starts the prefetch of the next time step, so these setters
+  // run while it reads the arrays of step 1 into the cache.
+  prefetched->SetTimeStep(0);
+  prefetched->Update();
+  prefetched->SetObjectArrayStatus(vtkExodusIIReader::NODAL, "VEL", 0);
+  prefetched->SetApplyDisplacements(0);
+  prefetched->SetTimeStep(1);
+  prefetched->Update();
+  if (GetVelocity(prefetched))
+  {
+    std::cerr << "The deselected velocity was read.\n";
+    return EXIT_FAILURE;
+  }
+  prefetched->SetObjectArrayStatus(vtkExodusIIReader::NODAL, "VEL", 1);
+  prefetched->SetApplyDisplacements(1);
+  prefetched->SetDisplacementMagnitude(2.0);
+  prefetched->SetTimeStep(2);
+  prefetched->Update();
+  serial->SetDisplacementMagnitude(2.0);
+  serial->SetTimeStep(2);
+  serial->Update();
+  if (!CompareVelocity(serial, prefetched, 2))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkExodusIIReader::SetGlobalCacheSize(0.0);
+  return EXIT_SUCCESS;
+}
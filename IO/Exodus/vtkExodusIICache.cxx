@@ -3,6 +3,9 @@
 #include "vtkDataArray.h"
 #include "vtkObjectFactory.h"
 
+#include <algorithm>
+#include <mutex>
+
 // Define VTK_EXO_DBG_CACHE to print cache adds, drops, and replacements.
 //#undef VTK_EXO_DBG_CACHE
 
@@ -67,11 +70,20 @@ void printLRUBack( vtkExodusIICacheRef& cit )
 
 // ============================================================================
 
+namespace
+{
+// The memory budget shared by all caches and their total size, in MiB.
+std::mutex GlobalCacheMutex;
+double GlobalCacheCapacity = 0.;
+double GlobalCacheSize = 0.;
+}
+
 vtkStandardNewMacro(vtkExodusIICache);
 
 vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
+  this->GlobalSize = 0.;
   this->Capacity = 2.;
 }
 
@@ -85,10 +97,48 @@ void vtkExodusIICache::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Capacity: " << this->Capacity << " MiB\n";
   os << indent << "Size: " << this->Size << " MiB\n";
+  os << indent << "GlobalCacheCapacity: " << vtkExodusIICache::GetGlobalCacheCapacity()
+     << " MiB\n";
+  os << indent << "GlobalCacheSize: " << vtkExodusIICache::GetGlobalCacheSize() << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
 }
 
+void vtkExodusIICache::SetGlobalCacheCapacity(double sizeInMiB)
+{
+  std::lock_guard<std::mutex> lock(GlobalCacheMutex);
+  GlobalCacheCapacity = sizeInMiB < 0 ? 0 : sizeInMiB;
+}
+
+double vtkExodusIICache::GetGlobalCacheCapacity()
+{
+  std::lock_guard<std::mutex> lock(GlobalCacheMutex);
+  return GlobalCacheCapacity;
+}
+
+double vtkExodusIICache::GetGlobalCacheSize()
+{
+  std::lock_guard<std::mutex> lock(GlobalCacheMutex);
+  return GlobalCacheSize;
+}
+
+double vtkExodusIICache::GetGlobalSpaceLeft()
+{
+  std::lock_guard<std::mutex> lock(GlobalCacheMutex);
+  return GlobalCacheCapacity > 0 ? GlobalCacheCapacity - GlobalCacheSize : VTK_DOUBLE_MAX;
+}
+
+void vtkExodusIICache::UpdateGlobalSize()
+{
+  std::lock_guard<std::mutex> lock(GlobalCacheMutex);
+  GlobalCacheSize += this->Size - this->GlobalSize;
+  this->GlobalSize = this->Size;
+  if (GlobalCacheSize < 0)
+  {
+    GlobalCacheSize = 0.; // FP roundoff
+  }
+}
+
 void vtkExodusIICache::Clear()
 {
   // printCache( this->Cache, this->LRU );
@@ -147,6 +197,7 @@ int vtkExodusIICache::ReduceToSize(double newSize)
   {
     this->Size = 0;
   }
+  this->UpdateGlobalSize();
 
   return deletedSomething;
 }
@@ -154,6 +205,9 @@ int vtkExodusIICache::ReduceToSize(double newSize)
 void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
 {
   double vsize = value ? value->GetActualMemorySize() / 1024. : 0.;
+  // Only our own entries can be dropped to stay within the shared budget.
+  double limit =
+    std::min(this->Capacity, this->Size + vtkExodusIICache::GetGlobalSpaceLeft()) - vsize;
 
   vtkExodusIICacheRef it = this->Cache.find(key);
   if (it != this->Cache.end())
@@ -167,7 +221,7 @@ void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
     {
       this->RecomputeSize();
     }
-    this->ReduceToSize(this->Capacity - vsize);
+    this->ReduceToSize(limit);
     it->second->Value->Delete();
     it->second->Value = value;
     it->second->Value->Register(
@@ -181,7 +235,7 @@ void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
   }
   else
   {
-    this->ReduceToSize(this->Capacity - vsize);
+    this->ReduceToSize(limit);
     std::pair<const vtkExodusIICacheKey, vtkExodusIICacheEntry*> entry(
       key, new vtkExodusIICacheEntry(value));
     std::pair<vtkExodusIICacheSet::iterator, bool> iret = this->Cache.insert(entry);
@@ -191,6 +245,7 @@ void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
 #endif // VTK_EXO_DBG_CACHE
     iret.first->second->LRUEntry = this->LRU.insert(this->LRU.begin(), iret.first);
   }
+  this->UpdateGlobalSize();
   // printCache( this->Cache, this->LRU );
 }
 
@@ -233,6 +288,7 @@ int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key)
       else
         this->RecomputeSize(); // oops, FP roundoff
     }
+    this->UpdateGlobalSize();
 
     return 1;
   }
@@ -274,6 +330,7 @@ int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key, const vtkExodus
 
     ++nDropped;
   }
+  this->UpdateGlobalSize();
   return nDropped;
 }
 
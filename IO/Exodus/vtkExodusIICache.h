@@ -144,6 +144,24 @@ public:
    */
   double GetSpaceLeft() { return this->Capacity - this->Size; }
 
+  //@{
+  /** Set/get a memory budget in MiB shared by all the caches in the process.
+   * When it is exceeded, the cache being inserted into drops its own least
+   * recently used entries until the total fits. A value of 0 (the default)
+   * means there is no shared budget and only each cache's capacity applies.
+   */
+  static void SetGlobalCacheCapacity(double sizeInMiB);
+  static double GetGlobalCacheCapacity();
+  //@}
+
+  /// The total size in MiB of all the caches in the process.
+  static double GetGlobalCacheSize();
+
+  /** See how much of the shared budget is left in MiB.
+   * This returns VTK_DOUBLE_MAX when there is no shared budget.
+   */
+  static double GetGlobalSpaceLeft();
+
   /** Remove cache entries until the size of the cache is at or below the given size.
    * Returns a nonzero value if deletions were required.
    */
@@ -184,6 +202,9 @@ protected:
   /// Avoid (some) FP problems
   void RecomputeSize();
 
+  /// Report changes of Size to the process-wide total.
+  void UpdateGlobalSize();
+
   /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in MiB.
   double Capacity;
 
@@ -191,6 +212,9 @@ protected:
   /// MiB.
   double Size;
 
+  /// The part of Size currently counted in the process-wide total, in MiB.
+  double GlobalSize;
+
   /** A least-recently-used (LRU) cache to hold arrays.
    * During RequestData the cache may contain more than its maximum size since
    * the user may request more data than the cache can hold. However, the cache
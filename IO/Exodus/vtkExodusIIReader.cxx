@@ -314,6 +314,10 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
 
+  this->PrefetchNextTimeStep = 0;
+  this->PrefetchTimeStep = -1;
+  this->CancelPrefetch = false;
+
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
   this->AnimateModeShapes = 1;
@@ -344,6 +348,7 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 //-----------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
+  this->WaitForPrefetch(true);
   this->CloseFile();
   this->Cache->Delete();
   this->CacheSize = 0;
@@ -3843,6 +3848,7 @@ void vtkExodusIIReaderPrivate::PrintData(ostream& os, vtkIndent indent)
   this->Cache->PrintSelf(os, inden2);
 
   os << indent << "SqueezePoints: " << this->SqueezePoints << "\n";
+  os << indent << "PrefetchNextTimeStep: " << this->PrefetchNextTimeStep << "\n";
   os << indent << "ApplyDisplacements: " << this->ApplyDisplacements << "\n";
   os << indent << "DisplacementMagnitude: " << this->DisplacementMagnitude << "\n";
   os << indent << "GenerateObjectIdArray: " << this->GenerateObjectIdArray << "\n";
@@ -4614,9 +4620,141 @@ int vtkExodusIIReaderPrivate::RequestData(vtkIdType timeStep, vtkMultiBlockDataS
 
   this->CloseFile();
 
+  if (this->PrefetchNextTimeStep && !this->HasModeShapes && this->CacheSize > 0 &&
+    timeStep + 1 < this->GetNumberOfTimeSteps())
+  {
+    this->StartPrefetch(static_cast<int>(timeStep + 1));
+  }
+
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+// The size in MiB that vtkExodusIICache accounts for an array, from the
+// rounded up size in KiB that vtkDataArray::GetActualMemorySize() reports.
+static double vtkExodusIICacheArraySize(vtkIdType numTuples, int numComps, int storageType)
+{
+  double bytes =
+    static_cast<double>(numTuples) * numComps * vtkDataArray::GetDataTypeSize(storageType);
+  return (std::ceil(bytes / 1024.) + 1.) / 1024.;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::StartPrefetch(int timeStep)
+{
+  this->WaitForPrefetch(true);
+
+  // Collect the keys and sizes on this thread so that the prefetch does not
+  // depend on the selections, which may change while it runs.
+  std::vector<std::pair<vtkExodusIICacheKey, double> > keys;
+  std::map<int, std::vector<ArrayInfoType> >::iterator ami =
+    this->ArrayInfo.find(vtkExodusIIReader::NODAL);
+  if (ami != this->ArrayInfo.end())
+  {
+    for (int aidx = 0; aidx < static_cast<int>(ami->second.size()); ++aidx)
+    {
+      const ArrayInfoType& ainfo = ami->second[aidx];
+      bool displacements = this->ApplyDisplacements &&
+        ainfo.Components == this->ModelParameters.num_dim &&
+        vtksys::SystemTools::UpperCase(ainfo.Name.substr(0, 3)) == "DIS";
+      if (ainfo.Status || displacements)
+      {
+        int ncomps =
+          (this->ModelParameters.num_dim == 2 && ainfo.Components == 2) ? 3 : ainfo.Components;
+        keys.push_back(std::make_pair(
+          vtkExodusIICacheKey(timeStep, vtkExodusIIReader::NODAL, 0, aidx),
+          vtkExodusIICacheArraySize(this->ModelParameters.num_nodes, ncomps, ainfo.StorageType)));
+      }
+    }
+  }
+  for (int conntypidx = 0; conntypidx < num_conn_types; ++conntypidx)
+  {
+    int otypidx = conn_obj_idx_cvt[conntypidx];
+    int otyp = obj_types[otypidx];
+    ami = this->ArrayInfo.find(otyp);
+    if (ami == this->ArrayInfo.end())
+    {
+      continue;
+    }
+    int numObj = this->GetNumberOfObjectsOfType(otyp);
+    for (int obj = 0; obj < numObj; ++obj)
+    {
+      BlockSetInfoType* bsinfop = static_cast<BlockSetInfoType*>(this->GetObjectInfo(otypidx, obj));
+      if (!bsinfop->Status)
+      {
+        continue;
+      }
+      for (int aidx = 0; aidx < static_cast<int>(ami->second.size()); ++aidx)
+      {
+        const ArrayInfoType& ainfo = ami->second[aidx];
+        if (ainfo.Status && ainfo.ObjectTruth[obj])
+        {
+          keys.push_back(std::make_pair(vtkExodusIICacheKey(timeStep, otyp, obj, aidx),
+            vtkExodusIICacheArraySize(bsinfop->Size, ainfo.Components, ainfo.StorageType)));
+        }
+      }
+    }
+  }
+  if (keys.empty())
+  {
+    return;
+  }
+
+  this->PrefetchTimeStep = timeStep;
+  this->CancelPrefetch = false;
+  this->PrefetchThread = std::thread([this, keys]() { this->PrefetchArrays(keys); });
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::WaitForPrefetch(bool cancel)
+{
+  if (this->PrefetchThread.joinable())
+  {
+    if (cancel)
+    {
+      this->CancelPrefetch = true;
+    }
+    this->PrefetchThread.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::PrefetchArrays(
+  const std::vector<std::pair<vtkExodusIICacheKey, double> >& keys)
+{
+  for (const auto& key : keys)
+  {
+    std::lock_guard<std::recursive_mutex> lock(vtkExodusIIReaderPrivate::GetLibraryMutex());
+    if (this->CancelPrefetch)
+    {
+      break;
+    }
+    // Only read the arrays that fit in the space left, so that inserting
+    // them never pushes out the arrays of the time step being served, from
+    // this cache or from the budget shared with the other caches.
+    if (key.second > this->Cache->GetSpaceLeft() ||
+      key.second > vtkExodusIICache::GetGlobalSpaceLeft())
+    {
+      continue;
+    }
+    if (this->Exoid < 0 && !this->OpenFile(this->Parent->GetFileName()))
+    {
+      break;
+    }
+    this->GetCacheOrRead(key.first);
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(vtkExodusIIReaderPrivate::GetLibraryMutex());
+  this->CloseFile();
+}
+
+//-----------------------------------------------------------------------------
+std::recursive_mutex& vtkExodusIIReaderPrivate::GetLibraryMutex()
+{
+  static std::recursive_mutex libraryMutex;
+  return libraryMutex;
+}
+
 int vtkExodusIIReaderPrivate::SetUpEmptyGrid(vtkMultiBlockDataSet* output)
 {
   if (!output)
@@ -4750,6 +4888,7 @@ int vtkExodusIIReaderPrivate::SetUpEmptyGrid(vtkMultiBlockDataSet* output)
 
 void vtkExodusIIReaderPrivate::Reset()
 {
+  this->WaitForPrefetch(true);
   this->CloseFile();
   this->ResetCache(); // must come before BlockInfo and SetInfo are cleared.
   this->BlockInfo.clear();
@@ -4797,6 +4936,7 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
+  this->WaitForPrefetch(true);
   this->Cache->Clear();
   this->Cache->SetCacheCapacity(
     this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
@@ -4807,6 +4947,7 @@ void vtkExodusIIReaderPrivate::SetCacheSize(double size)
 {
   if (this->CacheSize != size)
   {
+    this->WaitForPrefetch(true);
     this->CacheSize = size;
     this->Cache->SetCacheCapacity(this->CacheSize);
     this->Modified();
@@ -4849,6 +4990,7 @@ void vtkExodusIIReaderPrivate::SetSqueezePoints(int sp)
   if (this->SqueezePoints == sp)
     return;
 
+  this->WaitForPrefetch(true);
   this->SqueezePoints = sp;
   this->Modified();
 
@@ -5070,6 +5212,8 @@ void vtkExodusIIReaderPrivate::GetInitialObjectArrayStatus(int otyp, ArrayInfoTy
 
 void vtkExodusIIReaderPrivate::SetObjectArrayStatus(int otyp, int i, int stat)
 {
+  // The prefetch thread reads the statuses and fills the cache.
+  this->WaitForPrefetch(true);
   stat = (stat != 0); // Force stat to be either 0 or 1
   std::map<int, std::vector<ArrayInfoType> >::iterator it = this->ArrayInfo.find(otyp);
   if (it != this->ArrayInfo.end())
@@ -5261,6 +5405,7 @@ void vtkExodusIIReaderPrivate::SetObjectAttributeStatus(int otyp, int oi, int ai
 
 void vtkExodusIIReaderPrivate::SetApplyDisplacements(vtkTypeBool d)
 {
+  this->WaitForPrefetch(true);
   if (this->ApplyDisplacements == d)
     return;
 
@@ -5274,6 +5419,7 @@ void vtkExodusIIReaderPrivate::SetApplyDisplacements(vtkTypeBool d)
 
 void vtkExodusIIReaderPrivate::SetDisplacementMagnitude(double s)
 {
+  this->WaitForPrefetch(true);
   if (this->DisplacementMagnitude == s)
     return;
 
@@ -5467,6 +5613,9 @@ int vtkExodusIIReader::RequestInformation(vtkInformation* vtkNotUsed(request),
   int newMetadata = 0;
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
+  this->Metadata->WaitForPrefetch(true);
+  std::lock_guard<std::recursive_mutex> lock(vtkExodusIIReaderPrivate::GetLibraryMutex());
+
   // If the metadata is older than the filename
   if (this->GetMetadataMTime() < this->FileNameMTime)
   {
@@ -5533,13 +5682,6 @@ int vtkExodusIIReader::RequestInformation(vtkInformation* vtkNotUsed(request),
 int vtkExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
 {
-  if (!this->FileName || !this->Metadata->OpenFile(this->FileName))
-  {
-    vtkErrorMacro("Unable to open file \"" << (this->FileName ? this->FileName : "(null)")
-                                           << "\" to read data");
-    return 0;
-  }
-
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   vtkMultiBlockDataSet* output =
     vtkMultiBlockDataSet::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
@@ -5593,6 +5735,17 @@ int vtkExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // A prefetch of the step we are about to read is allowed to finish.
+  this->Metadata->WaitForPrefetch(this->Metadata->GetPrefetchTimeStep() != this->TimeStep);
+  std::lock_guard<std::recursive_mutex> lock(vtkExodusIIReaderPrivate::GetLibraryMutex());
+
+  if (!this->FileName || !this->Metadata->OpenFile(this->FileName))
+  {
+    vtkErrorMacro("Unable to open file \"" << (this->FileName ? this->FileName : "(null)")
+                                           << "\" to read data");
+    return 0;
+  }
+
   this->Metadata->RequestData(this->TimeStep, output);
 
   return 1;
@@ -6734,6 +6887,26 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+void vtkExodusIIReader::SetPrefetchNextTimeStep(bool prefetch)
+{
+  this->Metadata->SetPrefetchNextTimeStep(prefetch ? 1 : 0);
+}
+
+bool vtkExodusIIReader::GetPrefetchNextTimeStep()
+{
+  return this->Metadata->GetPrefetchNextTimeStep() != 0;
+}
+
+void vtkExodusIIReader::SetGlobalCacheSize(double sizeInMiB)
+{
+  vtkExodusIICache::SetGlobalCacheCapacity(sizeInMiB);
+}
+
+double vtkExodusIIReader::GetGlobalCacheSize()
+{
+  return vtkExodusIICache::GetGlobalCacheCapacity();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
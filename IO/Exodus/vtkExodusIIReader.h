@@ -790,6 +790,28 @@ public:
    */
   double GetCacheSize();
 
+  //@{
+  /**
+   * When on, each update starts reading the selected arrays of the next time
+   * step into the cache on a background thread, so that stepping forward in
+   * time finds them there. The prefetch stops when the cache (see
+   * SetCacheSize) or the global cache budget is full. Off by default.
+   */
+  void SetPrefetchNextTimeStep(bool prefetch);
+  bool GetPrefetchNextTimeStep();
+  vtkBooleanMacro(PrefetchNextTimeStep, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/get a cache memory budget in MiB shared by all the Exodus readers in
+   * the process. 0 (the default) means each reader is only limited by its
+   * own cache size.
+   */
+  static void SetGlobalCacheSize(double sizeInMiB);
+  static double GetGlobalCacheSize();
+  //@}
+
   //@{
   /**
    * Should the reader output only points used by elements in the output mesh,
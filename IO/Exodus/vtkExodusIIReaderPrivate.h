@@ -12,7 +12,11 @@
 #include "vtkToolkits.h" // make sure VTK_USE_PARALLEL is properly set
 #include "vtksys/RegularExpression.hxx"
 
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "vtkIOExodusModule.h" // For export macro
@@ -260,6 +264,32 @@ public:
 
   vtkDataArray* FindDisplacementVectors(int timeStep);
 
+  /// Set/get whether RequestData() starts reading the arrays of the next
+  /// time step into the cache in the background.
+  vtkSetMacro(PrefetchNextTimeStep, vtkTypeBool);
+  vtkGetMacro(PrefetchNextTimeStep, vtkTypeBool);
+
+  /** Start reading the selected result arrays of \a timeStep into the cache
+   * on a background thread. This returns immediately.
+   */
+  void StartPrefetch(int timeStep);
+
+  /** Wait for a background prefetch to finish. When \a cancel is true the
+   * prefetch stops after the array it is reading. This must be called
+   * before the file, the cache or the array and object selections are used
+   * or changed from the calling thread.
+   */
+  void WaitForPrefetch(bool cancel);
+
+  /// The time step being (or last) prefetched, or -1.
+  int GetPrefetchTimeStep() const { return this->PrefetchTimeStep; }
+
+  /** The Exodus library is not thread safe. Readers hold this mutex while
+   * they call into it so that prefetch threads of other readers do not
+   * run at the same time.
+   */
+  static std::recursive_mutex& GetLibraryMutex();
+
   const struct ex_init_params* GetModelParams() const { return &this->ModelParameters; }
 
   /// A struct to hold information about time-varying arrays
@@ -628,6 +658,11 @@ protected:
    */
   vtkDataArray* GetCacheOrRead(vtkExodusIICacheKey);
 
+  /** Read the arrays of \a keys into the cache, each paired with its size
+   * in MiB. This runs on PrefetchThread.
+   */
+  void PrefetchArrays(const std::vector<std::pair<vtkExodusIICacheKey, double> >& keys);
+
   /** Return the index of an object type (in a private list of all object types).
    * This returns a 0-based index if the object type was found and -1 if it
    * was not.
@@ -814,6 +849,12 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /// Read the arrays of the next time step in the background after RequestData.
+  vtkTypeBool PrefetchNextTimeStep;
+  int PrefetchTimeStep;
+  std::thread PrefetchThread;
+  std::atomic<bool> CancelPrefetch;
+
   vtkTypeBool ApplyDisplacements;
   float DisplacementMagnitude;
   vtkTypeBool HasModeShapes;
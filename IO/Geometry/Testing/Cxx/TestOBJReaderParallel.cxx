@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOBJReaderParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write OBJ files of a few megabytes, which vtkOBJReader tokenizes in
+// parallel pieces, and compare the output with the same files ending with a
+// line element, which only the serial parser reads.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkOBJReader.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkTesting.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+const int NumberOfVertices = 40000;
+
+// Faces use the same vertex, texture coordinate and normal indices unless
+// shiftTCoords is set, in which case the vertices are duplicated.
+void WriteOBJ(const std::string& fileName, bool shiftTCoords, bool serial)
+{
+  std::ofstream file(fileName.c_str());
+  file << "# A generated mesh\n  #\twith a second comment line\n\n";
+  file << "mtllib unused.mtl\ng first\n";
+  for (int i = 0; i < NumberOfVertices; ++i)
+  {
+    file << "v " << 0.001f * i << " " << -0.5f * (i % 100) << " " << 1e-5f * i << "\n";
+    file << "vt " << (i % 10) * 0.1f << " " << (i % 7) * 0.125f << "\n";
+    file << "vn 0 " << (i % 2 ? "1" : "-1.0e0") << " 0\r\n";
+    if (i == NumberOfVertices / 2)
+    {
+      file << "g second third\ns 1\no object\n";
+    }
+    if (i >= 3 && i % 3 == 0)
+    {
+      const int t = shiftTCoords ? (i + 1) % NumberOfVertices + 1 : i + 1;
+      // Absolute and relative indices.
+      file << "f " << i + 1 << "/" << t << "/" << i + 1 << " -2/-2/-2 " << i - 1 << "/" << i - 1
+           << "/" << i - 1 << "\n";
+      file << "f\t" << i << "//" << i << " -3//-3 -2//-2\n";
+      file << "f " << i - 2 << " " << i - 1 << " " << i << " -1\n";
+    }
+  }
+  if (serial)
+  {
+    file << "l 1 2\n";
+  }
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a && !b)
+  {
+    return true;
+  }
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    std::cerr << "Array " << name << " is missing or has a different size.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        std::cerr << "Array " << name << " differs at " << i << ".\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameCells(vtkCellArray* a, vtkCellArray* b)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    std::cerr << "Different number of cells.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfCells(); ++i)
+  {
+    vtkIdType nA, nB;
+    const vtkIdType* ptsA;
+    const vtkIdType* ptsB;
+    a->GetCellAtId(i, nA, ptsA);
+    b->GetCellAtId(i, nB, ptsB);
+    if (nA != nB || !std::equal(ptsA, ptsA + nA, ptsB))
+    {
+      std::cerr << "Cell " << i << " differs.\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Compare(const std::string& directory, bool shiftTCoords)
+{
+  const std::string parallelName = directory + "/TestOBJReaderParallel.obj";
+  const std::string serialName = directory + "/TestOBJReaderSerial.obj";
+  WriteOBJ(parallelName, shiftTCoords, false);
+  WriteOBJ(serialName, shiftTCoords, true);
+
+  vtkNew<vtkOBJReader> parallel;
+  parallel->SetFileName(parallelName.c_str());
+  parallel->Update();
+  vtkNew<vtkOBJReader> serial;
+  serial->SetFileName(serialName.c_str());
+  serial->Update();
+  vtkPolyData* a = parallel->GetOutput();
+  vtkPolyData* b = serial->GetOutput();
+
+  // Lines are dropped when vertices are duplicated.
+  if (a->GetNumberOfPolys() == 0 || a->GetNumberOfLines() != 0 ||
+    b->GetNumberOfLines() != (shiftTCoords ? 0 : 1))
+  {
+    std::cerr << "Unexpected cells.\n";
+    return false;
+  }
+  if (!parallel->GetComment() || !serial->GetComment() ||
+    strcmp(parallel->GetComment(), serial->GetComment()) != 0)
+  {
+    std::cerr << "The comments differ.\n";
+    return false;
+  }
+  if (!SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData(), "Points") ||
+    !SameArrays(a->GetPointData()->GetNormals(), b->GetPointData()->GetNormals(), "Normals") ||
+    !SameArrays(a->GetPointData()->GetTCoords(), b->GetPointData()->GetTCoords(), "TCoords") ||
+    !SameArrays(
+      a->GetCellData()->GetArray("GroupIds"), b->GetCellData()->GetArray("GroupIds"), "GroupIds") ||
+    !SameCells(a->GetPolys(), b->GetPolys()))
+  {
+    std::cerr << "The outputs differ with shifted texture coordinates " << shiftTCoords << ".\n";
+    return false;
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestOBJReaderParallel(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string directory = testing->GetTempDirectory();
+  if (!Compare(directory, false) || !Compare(directory, true))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,457 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOpenFOAMReaderConcurrent.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write a small OpenFOAM case with several vol and point fields, which
+// vtkOpenFOAMReader decodes concurrently, and check the output against the
+// values that were written.  The fields read together in concurrent batches
+// are also compared with the same fields read one at a time, each by its
+// own reader.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDirectory.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkOpenFOAMReader.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const int NX = 6, NY = 5, NZ = 4;
+const int NumberOfPoints = (NX + 1) * (NY + 1) * (NZ + 1);
+const int NumberOfCells = NX * NY * NZ;
+const char* ScalarFields[] = { "p", "T", "k", "nut", "alpha" };
+
+int PointId(int i, int j, int k)
+{
+  return i + (NX + 1) * (j + (NY + 1) * k);
+}
+
+int CellId(int i, int j, int k)
+{
+  return i + NX * (j + NY * k);
+}
+
+double CellValue(int field, int cellId)
+{
+  return 0.5 * cellId + 100.0 * field;
+}
+
+double PointValue(int pointId)
+{
+  return 0.25 * pointId - 3.0;
+}
+
+void WriteHeader(std::ofstream& file, const char* className, const char* objectName)
+{
+  file << "FoamFile\n{\n    version 2.0;\n    format ascii;\n    class " << className
+       << ";\n    object " << objectName << ";\n}\n\n";
+}
+
+struct Face
+{
+  int Points[4];
+  int Owner;
+  int Neighbour;
+};
+
+// The faces of a block of hexahedra: the internal faces in the order of
+// their owners, then the faces of the inlet (x = 0), outlet (x = NX) and
+// walls patches.  Face normals point out of the owner.
+void MakeFaces(std::vector<Face>& faces, int patchStart[3], int patchSize[3])
+{
+  auto xFace = [](int i, int j, int k, bool flip) {
+    Face f = { { PointId(i, j, k), PointId(i, j + 1, k), PointId(i, j + 1, k + 1),
+                 PointId(i, j, k + 1) },
+      0, -1 };
+    if (flip)
+    {
+      std::swap(f.Points[1], f.Points[3]);
+    }
+    return f;
+  };
+  auto yFace = [](int i, int j, int k, bool flip) {
+    Face f = { { PointId(i, j, k), PointId(i, j, k + 1), PointId(i + 1, j, k + 1),
+                 PointId(i + 1, j, k) },
+      0, -1 };
+    if (flip)
+    {
+      std::swap(f.Points[1], f.Points[3]);
+    }
+    return f;
+  };
+  auto zFace = [](int i, int j, int k, bool flip) {
+    Face f = { { PointId(i, j, k), PointId(i + 1, j, k), PointId(i + 1, j + 1, k),
+                 PointId(i, j + 1, k) },
+      0, -1 };
+    if (flip)
+    {
+      std::swap(f.Points[1], f.Points[3]);
+    }
+    return f;
+  };
+  auto add = [&faces](Face f, int owner, int neighbour) {
+    f.Owner = owner;
+    f.Neighbour = neighbour;
+    faces.push_back(f);
+  };
+
+  for (int k = 0; k < NZ; ++k)
+  {
+    for (int j = 0; j < NY; ++j)
+    {
+      for (int i = 0; i < NX; ++i)
+      {
+        if (i + 1 < NX)
+        {
+          add(xFace(i + 1, j, k, false), CellId(i, j, k), CellId(i + 1, j, k));
+        }
+        if (j + 1 < NY)
+        {
+          add(yFace(i, j + 1, k, false), CellId(i, j, k), CellId(i, j + 1, k));
+        }
+        if (k + 1 < NZ)
+        {
+          add(zFace(i, j, k + 1, false), CellId(i, j, k), CellId(i, j, k + 1));
+        }
+      }
+    }
+  }
+  patchStart[0] = static_cast<int>(faces.size());
+  for (int k = 0; k < NZ; ++k)
+  {
+    for (int j = 0; j < NY; ++j)
+    {
+      add(xFace(0, j, k, true), CellId(0, j, k), -1);
+    }
+  }
+  patchStart[1] = static_cast<int>(faces.size());
+  for (int k = 0; k < NZ; ++k)
+  {
+    for (int j = 0; j < NY; ++j)
+    {
+      add(xFace(NX, j, k, false), CellId(NX - 1, j, k), -1);
+    }
+  }
+  patchStart[2] = static_cast<int>(faces.size());
+  for (int k = 0; k < NZ; ++k)
+  {
+    for (int i = 0; i < NX; ++i)
+    {
+      add(yFace(i, 0, k, true), CellId(i, 0, k), -1);
+      add(yFace(i, NY, k, false), CellId(i, NY - 1, k), -1);
+    }
+  }
+  for (int j = 0; j < NY; ++j)
+  {
+    for (int i = 0; i < NX; ++i)
+    {
+      add(zFace(i, j, 0, true), CellId(i, j, 0), -1);
+      add(zFace(i, j, NZ, false), CellId(i, j, NZ - 1), -1);
+    }
+  }
+  patchSize[0] = patchStart[1] - patchStart[0];
+  patchSize[1] = patchStart[2] - patchStart[1];
+  patchSize[2] = static_cast<int>(faces.size()) - patchStart[2];
+}
+
+void WriteBoundaryField(std::ofstream& file)
+{
+  file << "boundaryField\n{\n"
+       << "    inlet { type zeroGradient; }\n"
+       << "    outlet { type zeroGradient; }\n"
+       << "    walls { type zeroGradient; }\n}\n";
+}
+
+bool WriteCase(const std::string& caseDir)
+{
+  vtkDirectory::MakeDirectory((caseDir + "/constant/polyMesh").c_str());
+  vtkDirectory::MakeDirectory((caseDir + "/system").c_str());
+  vtkDirectory::MakeDirectory((caseDir + "/1").c_str());
+  std::ofstream(caseDir + "/case.foam");
+
+  std::ofstream controlDict(caseDir + "/system/controlDict");
+  WriteHeader(controlDict, "dictionary", "controlDict");
+  controlDict << "startTime 0;\nendTime 1;\ndeltaT 1;\nwriteInterval 1;\n";
+
+  std::ofstream points(caseDir + "/constant/polyMesh/points");
+  WriteHeader(points, "vectorField", "points");
+  points << NumberOfPoints << "\n(\n";
+  for (int k = 0; k <= NZ; ++k)
+  {
+    for (int j = 0; j <= NY; ++j)
+    {
+      for (int i = 0; i <= NX; ++i)
+      {
+        points << "(" << 0.5 * i << " " << 0.25 * j << " " << 2.0 * k << ")\n";
+      }
+    }
+  }
+  points << ")\n";
+
+  std::vector<Face> faces;
+  int patchStart[3], patchSize[3];
+  MakeFaces(faces, patchStart, patchSize);
+  std::ofstream facesFile(caseDir + "/constant/polyMesh/faces");
+  WriteHeader(facesFile, "faceList", "faces");
+  std::ofstream owner(caseDir + "/constant/polyMesh/owner");
+  WriteHeader(owner, "labelList", "owner");
+  std::ofstream neighbour(caseDir + "/constant/polyMesh/neighbour");
+  WriteHeader(neighbour, "labelList", "neighbour");
+  facesFile << faces.size() << "\n(\n";
+  owner << faces.size() << "\n(\n";
+  neighbour << patchStart[0] << "\n(\n";
+  for (const Face& f : faces)
+  {
+    facesFile << "4(" << f.Points[0] << " " << f.Points[1] << " " << f.Points[2] << " "
+              << f.Points[3] << ")\n";
+    owner << f.Owner << "\n";
+    if (f.Neighbour >= 0)
+    {
+      neighbour << f.Neighbour << "\n";
+    }
+  }
+  facesFile << ")\n";
+  owner << ")\n";
+  neighbour << ")\n";
+
+  std::ofstream boundary(caseDir + "/constant/polyMesh/boundary");
+  WriteHeader(boundary, "polyBoundaryMesh", "boundary");
+  const char* patchNames[3] = { "inlet", "outlet", "walls" };
+  boundary << "3\n(\n";
+  for (int patch = 0; patch < 3; ++patch)
+  {
+    boundary << patchNames[patch] << "\n{\n    type patch;\n    nFaces " << patchSize[patch]
+             << ";\n    startFace " << patchStart[patch] << ";\n}\n";
+  }
+  boundary << ")\n";
+
+  for (int field = 0; field < 5; ++field)
+  {
+    std::ofstream file(caseDir + "/1/" + ScalarFields[field]);
+    WriteHeader(file, "volScalarField", ScalarFields[field]);
+    file << "dimensions [0 0 0 0 0 0 0];\n\ninternalField nonuniform List<scalar>\n"
+         << NumberOfCells << "\n(\n";
+    for (int cellId = 0; cellId < NumberOfCells; ++cellId)
+    {
+      file << CellValue(field, cellId) << "\n";
+    }
+    file << ");\n\n";
+    WriteBoundaryField(file);
+  }
+
+  std::ofstream velocity(caseDir + "/1/U");
+  WriteHeader(velocity, "volVectorField", "U");
+  velocity << "dimensions [0 1 -1 0 0 0 0];\n\ninternalField nonuniform List<vector>\n"
+           << NumberOfCells << "\n(\n";
+  for (int cellId = 0; cellId < NumberOfCells; ++cellId)
+  {
+    velocity << "(" << cellId << " " << -cellId << " 0.5)\n";
+  }
+  velocity << ");\n\n";
+  WriteBoundaryField(velocity);
+
+  std::ofstream pointField(caseDir + "/1/pointMotion");
+  WriteHeader(pointField, "pointScalarField", "pointMotion");
+  pointField << "dimensions [0 1 0 0 0 0 0];\n\ninternalField nonuniform List<scalar>\n"
+             << NumberOfPoints << "\n(\n";
+  for (int pointId = 0; pointId < NumberOfPoints; ++pointId)
+  {
+    pointField << PointValue(pointId) << "\n";
+  }
+  pointField << ");\n\n";
+  WriteBoundaryField(pointField);
+
+  return static_cast<bool>(pointField);
+}
+
+vtkUnstructuredGrid* GetInternalMesh(vtkOpenFOAMReader* reader)
+{
+  return vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    std::cerr << "Array " << name << " is missing or has a different size.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    const int nc = a->GetNumberOfComponents();
+    if (a->GetComponent(i / nc, i % nc) != b->GetComponent(i / nc, i % nc))
+    {
+      std::cerr << "Array " << name << " differs at value " << i << ".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+void SetUpReader(vtkOpenFOAMReader* reader, const std::string& fileName)
+{
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  reader->EnableAllPatchArrays();
+  reader->EnableAllCellArrays();
+  reader->EnableAllPointArrays();
+}
+
+} // end anon namespace
+
+int TestOpenFOAMReaderConcurrent(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string caseDir = std::string(tempDir) + "/TestOpenFOAMReaderConcurrent";
+  delete[] tempDir;
+  if (!WriteCase(caseDir))
+  {
+    std::cerr << "Could not write the case to " << caseDir << ".\n";
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = caseDir + "/case.foam";
+
+  vtkNew<vtkOpenFOAMReader> reader;
+  SetUpReader(reader, fileName);
+  reader->Update();
+  vtkUnstructuredGrid* mesh = GetInternalMesh(reader);
+  if (!mesh || mesh->GetNumberOfPoints() != NumberOfPoints ||
+    mesh->GetNumberOfCells() != NumberOfCells)
+  {
+    std::cerr << "The internal mesh was not read.\n";
+    return EXIT_FAILURE;
+  }
+  for (int k = 0; k <= NZ; ++k)
+  {
+    for (int j = 0; j <= NY; ++j)
+    {
+      for (int i = 0; i <= NX; ++i)
+      {
+        double x[3];
+        mesh->GetPoint(PointId(i, j, k), x);
+        if (x[0] != 0.5 * i || x[1] != 0.25 * j || x[2] != 2.0 * k)
+        {
+          std::cerr << "Point " << PointId(i, j, k) << " is wrong.\n";
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  for (vtkIdType cellId = 0; cellId < NumberOfCells; ++cellId)
+  {
+    if (mesh->GetCellType(cellId) != VTK_HEXAHEDRON)
+    {
+      std::cerr << "Cell " << cellId << " is not a hexahedron.\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // the values that were written
+  for (int field = 0; field < 5; ++field)
+  {
+    vtkDataArray* values = mesh->GetCellData()->GetArray(ScalarFields[field]);
+    if (!values || values->GetNumberOfTuples() != NumberOfCells)
+    {
+      std::cerr << "Field " << ScalarFields[field] << " was not read.\n";
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType cellId = 0; cellId < NumberOfCells; ++cellId)
+    {
+      if (values->GetComponent(cellId, 0) != CellValue(field, cellId))
+      {
+        std::cerr << "Field " << ScalarFields[field] << " differs at cell " << cellId << ".\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  vtkDataArray* velocity = mesh->GetCellData()->GetArray("U");
+  if (!velocity || velocity->GetNumberOfComponents() != 3 ||
+    velocity->GetComponent(NumberOfCells - 1, 1) != -(NumberOfCells - 1))
+  {
+    std::cerr << "Field U was not read.\n";
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* motion = mesh->GetPointData()->GetArray("pointMotion");
+  if (!motion || motion->GetNumberOfTuples() != NumberOfPoints)
+  {
+    std::cerr << "Field pointMotion was not read.\n";
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType pointId = 0; pointId < NumberOfPoints; ++pointId)
+  {
+    if (motion->GetComponent(pointId, 0) != PointValue(pointId))
+    {
+      std::cerr << "Field pointMotion differs at point " << pointId << ".\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // each field read alone is the same as in the concurrent batches
+  const int numCellArrays = reader->GetNumberOfCellArrays();
+  const int numPointArrays = reader->GetNumberOfPointArrays();
+  if (numCellArrays != 6 || numPointArrays != 1)
+  {
+    std::cerr << "Expected 6 cell and 1 point fields, got " << numCellArrays << " and "
+              << numPointArrays << ".\n";
+    return EXIT_FAILURE;
+  }
+  for (int idx = 0; idx < numCellArrays + numPointArrays; ++idx)
+  {
+    vtkNew<vtkOpenFOAMReader> single;
+    SetUpReader(single, fileName);
+    single->DisableAllCellArrays();
+    single->DisableAllPointArrays();
+    std::string name;
+    if (idx < numCellArrays)
+    {
+      name = reader->GetCellArrayName(idx);
+      single->SetCellArrayStatus(name.c_str(), 1);
+    }
+    else
+    {
+      name = reader->GetPointArrayName(idx - numCellArrays);
+      single->SetPointArrayStatus(name.c_str(), 1);
+    }
+    single->Update();
+    vtkUnstructuredGrid* singleMesh = GetInternalMesh(single);
+    if (!singleMesh ||
+      !SameArrays(mesh->GetPointData()->GetArray(name.c_str()),
+        singleMesh->GetPointData()->GetArray(name.c_str()), name.c_str()) ||
+      (idx < numCellArrays &&
+        !SameArrays(mesh->GetCellData()->GetArray(name.c_str()),
+          singleMesh->GetCellData()->GetArray(name.c_str()), name.c_str())))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderMerging.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write a binary STL file of a triangulated grid, with degenerate facets
+// and signed zeros, and check that merging its points with the default
+// locator gives the same output as with a vtkPointLocator.
+
+#include "vtkCellArray.h"
+#include "vtkNew.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkTesting.h"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+void WriteFacet(FILE* fp, const float (&v)[3][3])
+{
+  float values[12] = { 0.0f, 0.0f, 1.0f };
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      values[3 + 3 * i + j] = v[i][j];
+    }
+  }
+  // The test assumes a little endian host, as the file format.
+  fwrite(values, sizeof(float), 12, fp);
+  unsigned short attributes = 0;
+  fwrite(&attributes, 2, 1, fp);
+}
+
+float Z(int i, int j)
+{
+  return 0.001f * ((i * 7 + j * 3) % 11);
+}
+
+bool WriteGrid(const std::string& fileName, int n)
+{
+  FILE* fp = fopen(fileName.c_str(), "wb");
+  if (!fp)
+  {
+    return false;
+  }
+  char header[80] = "TestSTLReaderMerging";
+  fwrite(header, 1, 80, fp);
+  unsigned int numFacets = 2 * n * n + 1;
+  fwrite(&numFacets, 4, 1, fp);
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      // Zeros of both signs on the first row.
+      const float x0 = i == 0 ? (j % 2 ? -0.0f : 0.0f) : 0.5f * i;
+      const float x1 = 0.5f * (i + 1);
+      const float y0 = 0.25f * j;
+      const float y1 = 0.25f * (j + 1);
+      const float a[3][3] = { { x0, y0, Z(i, j) }, { x1, y0, Z(i + 1, j) },
+        { x1, y1, Z(i + 1, j + 1) } };
+      const float b[3][3] = { { x0, y0, Z(i, j) }, { x1, y1, Z(i + 1, j + 1) },
+        { x0, y1, Z(i, j + 1) } };
+      WriteFacet(fp, a);
+      WriteFacet(fp, b);
+    }
+  }
+  // A degenerate facet, whose points are still merged.
+  const float d[3][3] = { { -1.0f, -1.0f, 0.0f }, { -1.0f, -1.0f, 0.0f }, { -2.0f, -1.0f, 0.0f } };
+  WriteFacet(fp, d);
+  fclose(fp);
+  return true;
+}
+
+} // end anon namespace
+
+int TestSTLReaderMerging(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string fileName =
+    std::string(testing->GetTempDirectory()) + "/TestSTLReaderMerging.stl";
+  const int n = 200;
+  if (!WriteGrid(fileName, n))
+  {
+    std::cerr << "Cannot write " << fileName << "\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkPolyData* merged = reader->GetOutput();
+
+  vtkNew<vtkSTLReader> locatorReader;
+  vtkNew<vtkPointLocator> locator;
+  locatorReader->SetFileName(fileName.c_str());
+  locatorReader->SetLocator(locator);
+  locatorReader->Update();
+  vtkPolyData* expected = locatorReader->GetOutput();
+
+  vtkNew<vtkSTLReader> rawReader;
+  rawReader->SetFileName(fileName.c_str());
+  rawReader->MergingOff();
+  rawReader->Update();
+
+  if (rawReader->GetOutput()->GetNumberOfPoints() != 3 * (2 * n * n + 1) ||
+    merged->GetNumberOfPoints() != (n + 1) * (n + 1) + 2 ||
+    merged->GetNumberOfPolys() != 2 * n * n)
+  {
+    std::cerr << "Unexpected output size: " << merged->GetNumberOfPoints() << " points, "
+              << merged->GetNumberOfPolys() << " triangles.\n";
+    return EXIT_FAILURE;
+  }
+  if (merged->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    merged->GetNumberOfPolys() != expected->GetNumberOfPolys())
+  {
+    std::cerr << "Merging differs from the point locator.\n";
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < merged->GetNumberOfPoints(); ++i)
+  {
+    double a[3];
+    double b[3];
+    merged->GetPoint(i, a);
+    expected->GetPoint(i, b);
+    if (a[0] != b[0] || a[1] != b[1] || a[2] != b[2])
+    {
+      std::cerr << "Point " << i << " differs.\n";
+      return EXIT_FAILURE;
+    }
+  }
+  vtkCellArray* polys = merged->GetPolys();
+  vtkCellArray* expectedPolys = expected->GetPolys();
+  for (vtkIdType i = 0; i < polys->GetNumberOfCells(); ++i)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkIdType expectedNpts;
+    const vtkIdType* expectedPts;
+    polys->GetCellAtId(i, npts, pts);
+    expectedPolys->GetCellAtId(i, expectedNpts, expectedPts);
+    if (npts != 3 || expectedNpts != 3 || pts[0] != expectedPts[0] || pts[1] != expectedPts[1] ||
+      pts[2] != expectedPts[2])
+    {
+      std::cerr << "Triangle " << i << " differs.\n";
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
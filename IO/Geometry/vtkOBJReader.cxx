@@ -16,14 +16,23 @@
 
 #include "vtkCellArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cerrno>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <unordered_map>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 #include "vtkCellData.h"
@@ -31,6 +40,487 @@
 
 vtkStandardNewMacro(vtkOBJReader);
 
+namespace
+{
+// The serial parser reads lines of up to this length.
+const int vtkOBJMaxLine = 1024 * 256;
+
+// The parallel parser reads the file in blocks of whole lines, each split in
+// pieces tokenized by different threads.
+const size_t vtkOBJBlockSize = 64 << 20;
+const size_t vtkOBJPieceSize = 1 << 20;
+
+inline bool vtkOBJIsSpace(char c)
+{
+  return isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+/**
+ * The records of a piece of a file that only has vertices, texture
+ * coordinates, normals, faces, groups and lines that are ignored. Indices
+ * are 0-based. Negative indices in the file are relative to the records
+ * counted from the start of the piece, and their positions are kept to
+ * shift them by the records before the piece.
+ */
+struct vtkOBJPiece
+{
+  std::vector<float> Points;
+  std::vector<float> TCoords;
+  std::vector<float> Normals;
+  std::vector<int> FaceSizes;
+  std::vector<unsigned char> FaceHasTCoords;
+  std::vector<unsigned char> FaceHasNormals;
+  // The number of "g" lines in the piece before each face.
+  std::vector<vtkIdType> FaceGroups;
+  std::vector<vtkIdType> VertIds;
+  std::vector<vtkIdType> TCoordIds;
+  std::vector<vtkIdType> NormalIds;
+  std::vector<size_t> RelativeVertIds;
+  std::vector<size_t> RelativeTCoordIds;
+  std::vector<size_t> RelativeNormalIds;
+  vtkIdType NumberOfGroups = 0;
+  bool TCoordsSameAsVerts = true;
+  bool NormalsSameAsVerts = true;
+  // Whether the serial parser is needed for the piece.
+  bool Unsupported = false;
+
+  // Stop as soon as this piece or any other piece of the file sets
+  // anyUnsupported, since the whole file then goes to the serial parser.
+  void Parse(const char* begin, const char* end, std::atomic<bool>& anyUnsupported)
+  {
+    for (const char* line = begin; line < end && !this->Unsupported;)
+    {
+      if (anyUnsupported.load(std::memory_order_relaxed))
+      {
+        return;
+      }
+      const char* next = static_cast<const char*>(memchr(line, '\n', end - line));
+      next = next ? next + 1 : end;
+      if (next - line >= vtkOBJMaxLine - 1)
+      {
+        this->Unsupported = true;
+        break;
+      }
+      this->ParseLine(line, next);
+      line = next;
+    }
+    if (this->Unsupported)
+    {
+      anyUnsupported.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  void ParseLine(const char* p, const char* end)
+  {
+    while (p < end && vtkOBJIsSpace(*p))
+    {
+      ++p;
+    }
+    const char* cmd = p;
+    while (p < end && !vtkOBJIsSpace(*p))
+    {
+      ++p;
+    }
+    const std::string command(cmd, p);
+    if (command == "v")
+    {
+      this->ParseFloats(p, end, 3, this->Points);
+    }
+    else if (command == "vt")
+    {
+      this->ParseFloats(p, end, 2, this->TCoords);
+    }
+    else if (command == "vn")
+    {
+      this->ParseFloats(p, end, 3, this->Normals);
+    }
+    else if (command == "f")
+    {
+      this->ParseFace(p, end);
+    }
+    else if (command == "g")
+    {
+      ++this->NumberOfGroups;
+    }
+    else if (command == "usemtl" || command == "p" || command == "l")
+    {
+      this->Unsupported = true;
+    }
+  }
+
+  // Read the floats the way a stream in the classic locale does, leaving
+  // anything unusual to the serial parser.
+  void ParseFloats(const char* p, const char* end, int n, std::vector<float>& values)
+  {
+    for (int k = 0; k < n; ++k)
+    {
+      while (p < end && vtkOBJIsSpace(*p))
+      {
+        ++p;
+      }
+      const char* token = p;
+      while (p < end && !vtkOBJIsSpace(*p))
+      {
+        if (!strchr("0123456789+-.eE", *p))
+        {
+          this->Unsupported = true;
+          return;
+        }
+        ++p;
+      }
+      char word[64];
+      const size_t length = static_cast<size_t>(p - token);
+      if (length == 0 || length >= sizeof(word))
+      {
+        this->Unsupported = true;
+        return;
+      }
+      memcpy(word, token, length);
+      word[length] = '\0';
+      char* wordEnd;
+      errno = 0;
+      const float value = strtof(word, &wordEnd);
+      if (wordEnd != word + length || errno == ERANGE)
+      {
+        this->Unsupported = true;
+        return;
+      }
+      values.push_back(value);
+    }
+  }
+
+  static bool ParseInt(const char*& p, const char* end, int& value)
+  {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+      negative = *p == '-';
+      ++p;
+    }
+    const char* digits = p;
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9' && p - digits < 9)
+    {
+      value = 10 * value + (*p - '0');
+      ++p;
+    }
+    value = negative ? -value : value;
+    return p > digits && (p == end || *p < '0' || *p > '9');
+  }
+
+  void AddIndex(int index, vtkIdType count, std::vector<vtkIdType>& ids,
+    std::vector<size_t>& relativeIds)
+  {
+    if (index < 0)
+    {
+      relativeIds.push_back(ids.size());
+      ids.push_back(count + index);
+    }
+    else
+    {
+      ids.push_back(index - 1);
+    }
+  }
+
+  void ParseFace(const char* p, const char* end)
+  {
+    int nVerts = 0, nTCoords = 0, nNormals = 0;
+    while (true)
+    {
+      while (p < end && vtkOBJIsSpace(*p))
+      {
+        ++p;
+      }
+      if (p == end)
+      {
+        break;
+      }
+      const char* tokenEnd = p;
+      while (tokenEnd < end && !vtkOBJIsSpace(*tokenEnd))
+      {
+        ++tokenEnd;
+      }
+      // One of v, v/t, v//n and v/t/n.
+      int iVert, iTCoord = 0, iNormal = 0;
+      bool hasTCoord = false, hasNormal = false;
+      bool valid = ParseInt(p, tokenEnd, iVert);
+      if (valid && p < tokenEnd)
+      {
+        valid = *p++ == '/';
+        if (valid && p < tokenEnd && *p == '/')
+        {
+          ++p;
+          valid = hasNormal = ParseInt(p, tokenEnd, iNormal);
+        }
+        else if (valid)
+        {
+          valid = hasTCoord = ParseInt(p, tokenEnd, iTCoord);
+          if (valid && p < tokenEnd)
+          {
+            valid = *p++ == '/' && (hasNormal = ParseInt(p, tokenEnd, iNormal));
+          }
+        }
+      }
+      if (!valid || p != tokenEnd)
+      {
+        this->Unsupported = true;
+        return;
+      }
+
+      this->AddIndex(iVert, static_cast<vtkIdType>(this->Points.size() / 3), this->VertIds,
+        this->RelativeVertIds);
+      ++nVerts;
+      if (hasTCoord)
+      {
+        this->AddIndex(iTCoord, static_cast<vtkIdType>(this->TCoords.size() / 2),
+          this->TCoordIds, this->RelativeTCoordIds);
+        this->TCoordsSameAsVerts &= iTCoord == iVert;
+        ++nTCoords;
+      }
+      if (hasNormal)
+      {
+        this->AddIndex(iNormal, static_cast<vtkIdType>(this->Normals.size() / 3),
+          this->NormalIds, this->RelativeNormalIds);
+        this->NormalsSameAsVerts &= iNormal == iVert;
+        ++nNormals;
+      }
+    }
+    // The serial parser reports the errors.
+    if (nVerts < 3 || (nTCoords > 0 && nTCoords != nVerts) ||
+      (nNormals > 0 && nNormals != nVerts))
+    {
+      this->Unsupported = true;
+      return;
+    }
+    this->FaceSizes.push_back(nVerts);
+    this->FaceHasTCoords.push_back(nTCoords > 0);
+    this->FaceHasNormals.push_back(nNormals > 0);
+    this->FaceGroups.push_back(this->NumberOfGroups);
+  }
+};
+
+/**
+ * The records of the whole file, assembled from its pieces in order, with
+ * the same cells and group ids as the serial parser.
+ */
+struct vtkOBJRecords
+{
+  std::vector<float> Points;
+  std::vector<float> TCoords;
+  std::vector<float> Normals;
+  std::vector<vtkIdType> FaceOffsets = std::vector<vtkIdType>(1, 0);
+  std::vector<vtkIdType> TCoordOffsets = std::vector<vtkIdType>(1, 0);
+  std::vector<vtkIdType> NormalOffsets = std::vector<vtkIdType>(1, 0);
+  std::vector<vtkIdType> VertIds;
+  std::vector<vtkIdType> TCoordIds;
+  std::vector<vtkIdType> NormalIds;
+  std::vector<float> GroupIds;
+  vtkIdType NumberOfGroups = 0;
+  // Whether the first face comes before the first group, which numbers the
+  // groups from 1.
+  bool FaceBeforeGroup = false;
+  bool TCoordsSameAsVerts = true;
+  bool NormalsSameAsVerts = true;
+  bool HasTCoords = false;
+
+  static void AppendIds(std::vector<vtkIdType>& ids, const std::vector<vtkIdType>& pieceIds,
+    const std::vector<size_t>& relativeIds, vtkIdType count)
+  {
+    const size_t first = ids.size();
+    ids.insert(ids.end(), pieceIds.begin(), pieceIds.end());
+    for (size_t pos : relativeIds)
+    {
+      ids[first + pos] += count;
+    }
+  }
+
+  void Append(const vtkOBJPiece& piece)
+  {
+    AppendIds(this->VertIds, piece.VertIds, piece.RelativeVertIds,
+      static_cast<vtkIdType>(this->Points.size() / 3));
+    AppendIds(this->TCoordIds, piece.TCoordIds, piece.RelativeTCoordIds,
+      static_cast<vtkIdType>(this->TCoords.size() / 2));
+    AppendIds(this->NormalIds, piece.NormalIds, piece.RelativeNormalIds,
+      static_cast<vtkIdType>(this->Normals.size() / 3));
+    this->Points.insert(this->Points.end(), piece.Points.begin(), piece.Points.end());
+    this->TCoords.insert(this->TCoords.end(), piece.TCoords.begin(), piece.TCoords.end());
+    this->Normals.insert(this->Normals.end(), piece.Normals.begin(), piece.Normals.end());
+
+    for (size_t k = 0; k < piece.FaceSizes.size(); ++k)
+    {
+      const int size = piece.FaceSizes[k];
+      this->FaceOffsets.push_back(this->FaceOffsets.back() + size);
+      this->TCoordOffsets.push_back(this->TCoordOffsets.back() + size * piece.FaceHasTCoords[k]);
+      this->NormalOffsets.push_back(this->NormalOffsets.back() + size * piece.FaceHasNormals[k]);
+      const vtkIdType groups = this->NumberOfGroups + piece.FaceGroups[k];
+      if (this->GroupIds.empty())
+      {
+        this->FaceBeforeGroup = groups == 0;
+      }
+      this->GroupIds.push_back(static_cast<float>(this->FaceBeforeGroup ? groups : groups - 1));
+      this->HasTCoords |= piece.FaceHasTCoords[k] != 0;
+    }
+    this->NumberOfGroups += piece.NumberOfGroups;
+    this->TCoordsSameAsVerts &= piece.TCoordsSameAsVerts;
+    this->NormalsSameAsVerts &= piece.NormalsSameAsVerts;
+  }
+
+  // The group id after the last line, as counted by the serial parser.
+  vtkIdType GetGroupId() const
+  {
+    return this->FaceBeforeGroup ? this->NumberOfGroups : this->NumberOfGroups - 1;
+  }
+};
+
+/**
+ * Read the first comment the way the serial parser does from the lines of
+ * the first block. Return false if it may continue past the block.
+ */
+bool vtkOBJReadFirstComment(const char* begin, const char* end, std::string& comment)
+{
+  for (const char* line = begin; line < end;)
+  {
+    const char* next = static_cast<const char*>(memchr(line, '\n', end - line));
+    next = next ? next + 1 : end;
+    const char* p = line;
+    while (p < next && vtkOBJIsSpace(*p))
+    {
+      ++p;
+    }
+    if (p == next || *p != '#')
+    {
+      while (!comment.empty() && (comment.back() == '\r' || comment.back() == '\n'))
+      {
+        comment.pop_back();
+      }
+      return true;
+    }
+    ++p;
+    while (p < next && vtkOBJIsSpace(*p))
+    {
+      ++p;
+    }
+    comment.append(p, next);
+    line = next;
+  }
+  return false;
+}
+
+/**
+ * Parse a file that only has vertices, texture coordinates, normals, faces
+ * and groups, reading it in blocks whose pieces are tokenized in parallel.
+ * Return false when the file needs the serial parser.
+ */
+bool vtkOBJParseInParallel(FILE* in, vtkOBJRecords& records, std::string& comment)
+{
+  const char* decimalPoint = localeconv()->decimal_point;
+  if (!decimalPoint || strcmp(decimalPoint, ".") != 0)
+  {
+    return false;
+  }
+
+  std::vector<char> buffer;
+  size_t carry = 0;
+  bool firstBlock = true;
+  std::atomic<bool> unsupported(false);
+  while (true)
+  {
+    buffer.resize(carry + vtkOBJBlockSize);
+    const size_t count = fread(buffer.data() + carry, 1, vtkOBJBlockSize, in);
+    if (ferror(in) || memchr(buffer.data() + carry, '\0', count))
+    {
+      return false;
+    }
+    const bool lastBlock = count < vtkOBJBlockSize;
+    const size_t size = carry + count;
+    size_t cut = size;
+    if (!lastBlock)
+    {
+      while (cut > 0 && buffer[cut - 1] != '\n')
+      {
+        --cut;
+      }
+      if (cut == 0)
+      {
+        return false;
+      }
+    }
+    if (firstBlock && !vtkOBJReadFirstComment(buffer.data(), buffer.data() + cut, comment) &&
+      !lastBlock)
+    {
+      return false;
+    }
+    firstBlock = false;
+
+    // Split the block in pieces of whole lines.
+    std::vector<size_t> starts;
+    for (size_t start = 0; start < cut;)
+    {
+      starts.push_back(start);
+      size_t stop = std::min(start + vtkOBJPieceSize, cut);
+      while (stop < cut && buffer[stop - 1] != '\n')
+      {
+        ++stop;
+      }
+      start = stop;
+    }
+    starts.push_back(cut);
+    std::vector<vtkOBJPiece> pieces(starts.size() - 1);
+    vtkSMPTools::For(
+      0, static_cast<vtkIdType>(pieces.size()), [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          pieces[i].Parse(buffer.data() + starts[i], buffer.data() + starts[i + 1], unsupported);
+        }
+      });
+    if (unsupported)
+    {
+      return false;
+    }
+    for (const vtkOBJPiece& piece : pieces)
+    {
+      records.Append(piece);
+    }
+
+    if (lastBlock)
+    {
+      break;
+    }
+    carry = size - cut;
+    memmove(buffer.data(), buffer.data() + cut, carry);
+  }
+
+  // The serial parser needs all the texture coordinates referenced.
+  const vtkIdType numTCoords = static_cast<vtkIdType>(records.TCoords.size() / 2);
+  for (vtkIdType id : records.TCoordIds)
+  {
+    if (id < 0 || id >= numTCoords)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkIdTypeArray* vtkOBJNewIdArray(const std::vector<vtkIdType>& ids)
+{
+  vtkIdTypeArray* array = vtkIdTypeArray::New();
+  array->SetNumberOfValues(static_cast<vtkIdType>(ids.size()));
+  std::copy(ids.begin(), ids.end(), array->GetPointer(0));
+  return array;
+}
+
+void vtkOBJSetCells(vtkCellArray* cells, const std::vector<vtkIdType>& offsets,
+  const std::vector<vtkIdType>& ids)
+{
+  vtkIdTypeArray* offsetArray = vtkOBJNewIdArray(offsets);
+  vtkIdTypeArray* idArray = vtkOBJNewIdArray(ids);
+  cells->SetData(offsetArray, idArray);
+  offsetArray->Delete();
+  idArray->Delete();
+}
+}
+
 //----------------------------------------------------------------------------
 vtkOBJReader::vtkOBJReader()
 {
@@ -171,8 +661,54 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
   bool everything_ok = true; // (use of this flag avoids early return and associated memory leak)
 
+  // -- files with only vertices, faces and groups are tokenized in parallel pieces --
+
+  vtkOBJRecords records;
+  std::string parallelComment;
+  const bool parsedInParallel = vtkOBJParseInParallel(in, records, parallelComment);
+  if (parsedInParallel)
+  {
+    this->SetComment(parallelComment.c_str());
+
+    points->SetNumberOfPoints(static_cast<vtkIdType>(records.Points.size() / 3));
+    std::copy(records.Points.begin(), records.Points.end(),
+      vtkArrayDownCast<vtkFloatArray>(points->GetData())->GetPointer(0));
+    normals->SetNumberOfTuples(static_cast<vtkIdType>(records.Normals.size() / 3));
+    std::copy(records.Normals.begin(), records.Normals.end(), normals->GetPointer(0));
+
+    // Only the texture coordinates referenced by faces are set.
+    vtkFloatArray* tcoords = vtkFloatArray::New();
+    tcoords->SetNumberOfComponents(2);
+    tcoords->SetName("TCoords");
+    tcoords->SetNumberOfTuples(static_cast<vtkIdType>(records.TCoords.size() / 2));
+    tcoords->FillValue(-1.0f);
+    for (vtkIdType id : records.TCoordIds)
+    {
+      tcoords->SetTypedComponent(id, 0, records.TCoords[2 * id]);
+      tcoords->SetTypedComponent(id, 1, records.TCoords[2 * id + 1]);
+    }
+    tcoords_map.emplace("TCoords", tcoords);
+
+    vtkOBJSetCells(polys, records.FaceOffsets, records.VertIds);
+    vtkOBJSetCells(tcoord_polys, records.TCoordOffsets, records.TCoordIds);
+    vtkOBJSetCells(normal_polys, records.NormalOffsets, records.NormalIds);
+    faceScalars->SetNumberOfValues(static_cast<vtkIdType>(records.GroupIds.size()));
+    std::copy(records.GroupIds.begin(), records.GroupIds.end(), faceScalars->GetPointer(0));
+
+    groupId = records.GetGroupId();
+    hasTCoords = records.HasTCoords;
+    hasNormals = !records.Normals.empty() || !records.NormalIds.empty();
+    tcoords_same_as_verts = records.TCoordsSameAsVerts;
+    normals_same_as_verts = records.NormalsSameAsVerts;
+  }
+  else
+  {
+    fseek(in, 0, SEEK_SET);
+  }
+
   // -- work through the file line by line, assigning into the above 7 structures as appropriate --
 
+  if (!parsedInParallel)
   { // (make a local scope section to emphasise that the variables below are only used here)
 
     const int MAX_LINE = 1024 * 256;
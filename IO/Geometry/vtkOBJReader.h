@@ -18,6 +18,10 @@
  *
  * vtkOBJReader is a source object that reads Wavefront .obj
  * files. The output of this source object is polygonal data.
+ *
+ * Files that only have vertices, texture coordinates, normals, faces and
+ * groups are read in blocks whose lines are tokenized by several threads.
+ * Files with materials, points or lines are parsed line by line.
  * @sa
  * vtkOBJImporter
  */
@@ -84,6 +84,7 @@
 #include "vtkPolygon.h"
 #include "vtkPyramid.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -110,6 +111,7 @@
 // for isalnum() / isspace() / isdigit()
 #include <cctype>
 
+#include <algorithm>
 #include <typeinfo>
 #include <vector>
 
@@ -265,6 +267,7 @@ struct vtkFoamReadValue;
 struct vtkFoamEntryValue;
 struct vtkFoamEntry;
 struct vtkFoamDict;
+struct vtkFoamFieldFile;
 
 //-----------------------------------------------------------------------------
 // class vtkOpenFOAMReaderPrivate
@@ -410,8 +413,8 @@ private:
   bool ListTimeDirectoriesByInstances();
 
   // read mesh files
-  vtkFloatArray* ReadPointsFile();
-  vtkFoamLabelVectorVector* ReadFacesFile(const vtkStdString&);
+  vtkFloatArray* ReadPointsFile(vtkFoamError&);
+  vtkFoamLabelVectorVector* ReadFacesFile(const vtkStdString&, vtkFoamError&);
   vtkFoamLabelVectorVector* ReadOwnerNeighborFiles(const vtkStdString&, vtkFoamLabelVectorVector*);
   bool CheckFacePoints(vtkFoamLabelVectorVector*);
 
@@ -438,10 +441,12 @@ private:
 
   // read and create cell/point fields
   void ConstructDimensions(vtkStdString*, vtkFoamDict*);
-  bool ReadFieldFile(vtkFoamIOobject*, vtkFoamDict*, const vtkStdString&, vtkDataArraySelection*);
+  bool ReadFieldFile(
+    vtkFoamIOobject*, vtkFoamDict*, const vtkStdString&, vtkDataArraySelection*, vtkFoamError&);
   vtkFloatArray* FillField(vtkFoamEntry*, vtkIdType, vtkFoamIOobject*, const vtkStdString&);
-  void GetVolFieldAtTimeStep(vtkUnstructuredGrid*, vtkMultiBlockDataSet*, const vtkStdString&);
-  void GetPointFieldAtTimeStep(vtkUnstructuredGrid*, vtkMultiBlockDataSet*, const vtkStdString&);
+  void ReadFieldFiles(int, int, vtkFoamFieldFile**);
+  void GetVolFieldAtTimeStep(vtkUnstructuredGrid*, vtkMultiBlockDataSet*, vtkFoamFieldFile*);
+  void GetPointFieldAtTimeStep(vtkUnstructuredGrid*, vtkMultiBlockDataSet*, vtkFoamFieldFile*);
   void AddArrayToFieldData(vtkDataSetAttributes*, vtkDataArray*, const vtkStdString&);
 
   // create lagrangian mesh/fields
@@ -5112,8 +5117,9 @@ void vtkOpenFOAMReaderPrivate::PopulatePolyMeshDirArrays()
 }
 
 //-----------------------------------------------------------------------------
-// read the points file into a vtkFloatArray
-vtkFloatArray* vtkOpenFOAMReaderPrivate::ReadPointsFile()
+// read the points file into a vtkFloatArray. It may run on a worker
+// thread, so errors are returned in error rather than reported.
+vtkFloatArray* vtkOpenFOAMReaderPrivate::ReadPointsFile(vtkFoamError& error)
 {
   // path to points file
   const vtkStdString pointPath =
@@ -5122,7 +5128,7 @@ vtkFloatArray* vtkOpenFOAMReaderPrivate::ReadPointsFile()
   vtkFoamIOobject io(this->CasePath, this->Parent);
   if (!(io.Open(pointPath) || io.Open(pointPath + ".gz")))
   {
-    vtkErrorMacro(<< "Error opening " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
+    error << "Error opening " << io.GetFileName().c_str() << ": " << io.GetError().c_str();
     return nullptr;
   }
 
@@ -5147,9 +5153,9 @@ vtkFloatArray* vtkOpenFOAMReaderPrivate::ReadPointsFile()
   }
   catch (vtkFoamError& e)
   { // Something is horribly wrong.
-    vtkErrorMacro("Mesh points data are neither 32 nor 64 bit, or some other "
-                  "parse error occurred while reading points. Failed at line "
-      << io.GetLineNumber() << " of " << io.GetFileName().c_str() << ": " << e.c_str());
+    error << "Mesh points data are neither 32 nor 64 bit, or some other "
+             "parse error occurred while reading points. Failed at line "
+          << io.GetLineNumber() << " of " << io.GetFileName().c_str() << ": " << e.c_str();
     return nullptr;
   }
 
@@ -5162,17 +5168,19 @@ vtkFloatArray* vtkOpenFOAMReaderPrivate::ReadPointsFile()
 }
 
 //-----------------------------------------------------------------------------
-// read the faces into a vtkFoamLabelVectorVector
-vtkFoamLabelVectorVector* vtkOpenFOAMReaderPrivate::ReadFacesFile(const vtkStdString& facePathIn)
+// read the faces into a vtkFoamLabelVectorVector. It may run on a worker
+// thread, so errors are returned in error rather than reported.
+vtkFoamLabelVectorVector* vtkOpenFOAMReaderPrivate::ReadFacesFile(
+  const vtkStdString& facePathIn, vtkFoamError& error)
 {
   const vtkStdString facePath(facePathIn + "faces");
 
   vtkFoamIOobject io(this->CasePath, this->Parent);
   if (!(io.Open(facePath) || io.Open(facePath + ".gz")))
   {
-    vtkErrorMacro(<< "Error opening " << io.GetFileName().c_str() << ": " << io.GetError().c_str()
-                  << ". If you are trying to read a parallel "
-                     "decomposed case, set Case Type to Decomposed Case.");
+    error << "Error opening " << io.GetFileName().c_str() << ": " << io.GetError().c_str()
+          << ". If you are trying to read a parallel "
+             "decomposed case, set Case Type to Decomposed Case.";
     return nullptr;
   }
 
@@ -5191,8 +5199,8 @@ vtkFoamLabelVectorVector* vtkOpenFOAMReaderPrivate::ReadFacesFile(const vtkStdSt
   }
   catch (vtkFoamError& e)
   {
-    vtkErrorMacro(<< "Error reading line " << io.GetLineNumber() << " of "
-                  << io.GetFileName().c_str() << ": " << e.c_str());
+    error << "Error reading line " << io.GetLineNumber() << " of " << io.GetFileName().c_str()
+          << ": " << e.c_str();
     return nullptr;
   }
   return static_cast<vtkFoamLabelVectorVector*>(dict.Ptr());
@@ -5209,57 +5217,72 @@ vtkFoamLabelVectorVector* vtkOpenFOAMReaderPrivate::ReadOwnerNeighborFiles(
   vtkStdString ownerPath(ownerNeighborPath + "owner");
   if (io.Open(ownerPath) || io.Open(ownerPath + ".gz"))
   {
-    vtkFoamEntryValue ownerDict(nullptr);
-    ownerDict.SetLabelType(use64BitLabels ? vtkFoamToken::INT64 : vtkFoamToken::INT32);
-    try
-    {
-      if (use64BitLabels)
+    // Decode the owner and neighbour files concurrently, each through its
+    // own stream.
+    auto readLabelList = [use64BitLabels](
+                           vtkFoamIOobject& listIO, vtkFoamEntryValue& dict, vtkFoamError& error) {
+      try
       {
-        ownerDict.ReadNonuniformList<vtkFoamEntryValue::LABELLIST,
-          vtkFoamEntryValue::listTraits<vtkTypeInt64Array, vtkTypeInt64> >(io);
+        if (use64BitLabels)
+        {
+          dict.ReadNonuniformList<vtkFoamEntryValue::LABELLIST,
+            vtkFoamEntryValue::listTraits<vtkTypeInt64Array, vtkTypeInt64> >(listIO);
+        }
+        else
+        {
+          dict.ReadNonuniformList<vtkFoamEntryValue::LABELLIST,
+            vtkFoamEntryValue::listTraits<vtkTypeInt32Array, vtkTypeInt32> >(listIO);
+        }
       }
-      else
+      catch (vtkFoamError& e)
       {
-        ownerDict.ReadNonuniformList<vtkFoamEntryValue::LABELLIST,
-          vtkFoamEntryValue::listTraits<vtkTypeInt32Array, vtkTypeInt32> >(io);
+        error = e;
+        return false;
       }
-    }
-    catch (vtkFoamError& e)
+      return true;
+    };
+
+    const vtkStdString neighborPath(ownerNeighborPath + "neighbour");
+    vtkFoamIOobject neighborIO(this->CasePath, this->Parent);
+    vtkFoamEntryValue ownerDict(nullptr);
+    ownerDict.SetLabelType(use64BitLabels ? vtkFoamToken::INT64 : vtkFoamToken::INT32);
+    vtkFoamEntryValue neighborDict(nullptr);
+    neighborDict.SetLabelType(use64BitLabels ? vtkFoamToken::INT64 : vtkFoamToken::INT32);
+    bool ownerRead = false, neighborOpened = false, neighborRead = false;
+    vtkFoamError ownerError, neighborError;
+    vtkSMPTools::For(0, 2, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType task = begin; task < end; task++)
+      {
+        if (task == 0)
+        {
+          ownerRead = readLabelList(io, ownerDict, ownerError);
+        }
+        else
+        {
+          neighborOpened = neighborIO.Open(neighborPath) || neighborIO.Open(neighborPath + ".gz");
+          neighborRead = neighborOpened && readLabelList(neighborIO, neighborDict, neighborError);
+        }
+      }
+    });
+
+    if (!ownerRead)
     {
       vtkErrorMacro(<< "Error reading line " << io.GetLineNumber() << " of "
-                    << io.GetFileName().c_str() << ": " << e.c_str());
+                    << io.GetFileName().c_str() << ": " << ownerError.c_str());
       return nullptr;
     }
-
     io.Close();
 
-    const vtkStdString neighborPath(ownerNeighborPath + "neighbour");
-    if (!(io.Open(neighborPath) || io.Open(neighborPath + ".gz")))
+    if (!neighborOpened)
     {
-      vtkErrorMacro(<< "Error opening " << io.GetFileName().c_str() << ": "
-                    << io.GetError().c_str());
+      vtkErrorMacro(<< "Error opening " << neighborIO.GetFileName().c_str() << ": "
+                    << neighborIO.GetError().c_str());
       return nullptr;
     }
-
-    vtkFoamEntryValue neighborDict(nullptr);
-    neighborDict.SetLabelType(use64BitLabels ? vtkFoamToken::INT64 : vtkFoamToken::INT32);
-    try
+    if (!neighborRead)
     {
-      if (use64BitLabels)
-      {
-        neighborDict.ReadNonuniformList<vtkFoamEntryValue::LABELLIST,
-          vtkFoamEntryValue::listTraits<vtkTypeInt64Array, vtkTypeInt64> >(io);
-      }
-      else
-      {
-        neighborDict.ReadNonuniformList<vtkFoamEntryValue::LABELLIST,
-          vtkFoamEntryValue::listTraits<vtkTypeInt32Array, vtkTypeInt32> >(io);
-      }
-    }
-    catch (vtkFoamError& e)
-    {
-      vtkErrorMacro(<< "Error reading line " << io.GetLineNumber() << " of "
-                    << io.GetFileName().c_str() << ": " << e.c_str());
+      vtkErrorMacro(<< "Error reading line " << neighborIO.GetLineNumber() << " of "
+                    << neighborIO.GetFileName().c_str() << ": " << neighborError.c_str());
       return nullptr;
     }
 
@@ -5554,6 +5577,95 @@ bool vtkOpenFOAMReaderPrivate::CheckFacePoints(vtkFoamLabelVectorVector* facePoi
   return true;
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+
+// Determine the VTK type of a cell from the number of points of its faces.
+int DetermineCellType(const vtkFoamLabelVectorVector::CellType& cellFaces,
+  const vtkFoamLabelVectorVector& facePoints)
+{
+  // cf. src/OpenFOAM/meshes/meshShapes/cellMatcher/{hex|prism|pyr|tet}-
+  // Matcher.C
+  int cellType = VTK_POLYHEDRON; // Fallback value
+  if (cellFaces.size() == 6)
+  {
+    size_t j = 0;
+    for (; j < cellFaces.size(); j++)
+    {
+      if (facePoints.GetSize(cellFaces[j]) != 4)
+      {
+        break;
+      }
+    }
+    if (j == cellFaces.size())
+    {
+      cellType = VTK_HEXAHEDRON;
+    }
+  }
+  else if (cellFaces.size() == 5)
+  {
+    int nTris = 0, nQuads = 0;
+    for (size_t j = 0; j < cellFaces.size(); j++)
+    {
+      vtkIdType nPoints = facePoints.GetSize(cellFaces[j]);
+      if (nPoints == 3)
+      {
+        nTris++;
+      }
+      else if (nPoints == 4)
+      {
+        nQuads++;
+      }
+      else
+      {
+        break;
+      }
+    }
+    if (nTris == 2 && nQuads == 3)
+    {
+      cellType = VTK_WEDGE;
+    }
+    else if (nTris == 4 && nQuads == 1)
+    {
+      cellType = VTK_PYRAMID;
+    }
+  }
+  else if (cellFaces.size() == 4)
+  {
+    size_t j = 0;
+    for (; j < cellFaces.size(); j++)
+    {
+      if (facePoints.GetSize(cellFaces[j]) != 3)
+      {
+        break;
+      }
+    }
+    if (j == cellFaces.size())
+    {
+      cellType = VTK_TETRA;
+    }
+  }
+
+  // Not a known (standard) primitive mesh-shape
+  if (cellType == VTK_POLYHEDRON)
+  {
+    size_t nPoints = 0;
+    for (size_t j = 0; j < cellFaces.size(); j++)
+    {
+      nPoints += facePoints.GetSize(cellFaces[j]);
+    }
+    if (nPoints == 0)
+    {
+      cellType = VTK_EMPTY_CELL;
+    }
+  }
+
+  return cellType;
+}
+
+} // end anon namespace
+
 //-----------------------------------------------------------------------------
 // determine cell shape and insert the cell into the mesh
 // hexahedron, prism, pyramid, tetrahedron and decompose polyhedron
@@ -5580,6 +5692,22 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(vtkUnstructuredGrid* internalMe
 
   vtkFoamLabelVectorVector::CellType cellFaces;
 
+  // Classifying the cells only reads the faces, so do it for the whole mesh
+  // in parallel before the cells are inserted in order.
+  std::vector<unsigned char> cellTypes;
+  if (cellList == nullptr)
+  {
+    cellTypes.resize(nCells);
+    vtkSMPTools::For(0, nCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkFoamLabelVectorVector::CellType faces;
+      for (vtkIdType cellI = begin; cellI < end; cellI++)
+      {
+        cellsFaces->GetCell(cellI, faces);
+        cellTypes[cellI] = static_cast<unsigned char>(DetermineCellType(faces, facePoints));
+      }
+    });
+  }
+
   vtkSmartPointer<vtkIdTypeArray> arrayId;
   if (cellList)
   {
@@ -5613,81 +5741,8 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(vtkUnstructuredGrid* internalMe
     cellsFaces->GetCell(cellId, cellFaces);
 
     // determine type of the cell
-    // cf. src/OpenFOAM/meshes/meshShapes/cellMatcher/{hex|prism|pyr|tet}-
-    // Matcher.C
-    int cellType = VTK_POLYHEDRON; // Fallback value
-    if (cellFaces.size() == 6)
-    {
-      size_t j = 0;
-      for (; j < cellFaces.size(); j++)
-      {
-        if (facePoints.GetSize(cellFaces[j]) != 4)
-        {
-          break;
-        }
-      }
-      if (j == cellFaces.size())
-      {
-        cellType = VTK_HEXAHEDRON;
-      }
-    }
-    else if (cellFaces.size() == 5)
-    {
-      int nTris = 0, nQuads = 0;
-      for (size_t j = 0; j < cellFaces.size(); j++)
-      {
-        vtkIdType nPoints = facePoints.GetSize(cellFaces[j]);
-        if (nPoints == 3)
-        {
-          nTris++;
-        }
-        else if (nPoints == 4)
-        {
-          nQuads++;
-        }
-        else
-        {
-          break;
-        }
-      }
-      if (nTris == 2 && nQuads == 3)
-      {
-        cellType = VTK_WEDGE;
-      }
-      else if (nTris == 4 && nQuads == 1)
-      {
-        cellType = VTK_PYRAMID;
-      }
-    }
-    else if (cellFaces.size() == 4)
-    {
-      size_t j = 0;
-      for (; j < cellFaces.size(); j++)
-      {
-        if (facePoints.GetSize(cellFaces[j]) != 3)
-        {
-          break;
-        }
-      }
-      if (j == cellFaces.size())
-      {
-        cellType = VTK_TETRA;
-      }
-    }
-
-    // Not a known (standard) primitive mesh-shape
-    if (cellType == VTK_POLYHEDRON)
-    {
-      size_t nPoints = 0;
-      for (size_t j = 0; j < cellFaces.size(); j++)
-      {
-        nPoints += facePoints.GetSize(cellFaces[j]);
-      }
-      if (nPoints == 0)
-      {
-        cellType = VTK_EMPTY_CELL;
-      }
-    }
+    int cellType =
+      cellTypes.empty() ? DetermineCellType(cellFaces, facePoints) : cellTypes[cellI];
 
     // Cell shape constructor based on the one implementd by Terry
     // Jordan, with lots of improvements. Not as elegant as the one in
@@ -7105,8 +7160,10 @@ void vtkOpenFOAMReaderPrivate::InterpolateCellToPoint(vtkFloatArray* pData, vtkF
 }
 
 //-----------------------------------------------------------------------------
+// It may run on a worker thread, so errors are returned in error rather
+// than reported.
 bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject* ioPtr, vtkFoamDict* dictPtr,
-  const vtkStdString& varName, vtkDataArraySelection* selection)
+  const vtkStdString& varName, vtkDataArraySelection* selection, vtkFoamError& error)
 {
   const vtkStdString varPath(this->CurrentTimeRegionPath() + "/" + varName);
 
@@ -7114,7 +7171,7 @@ bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject* ioPtr, vtkFoamDict
   vtkFoamIOobject& io = *ioPtr;
   if (!io.Open(varPath))
   {
-    vtkErrorMacro(<< "Error opening " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
+    error << "Error opening " << io.GetFileName().c_str() << ": " << io.GetError().c_str();
     return false;
   }
 
@@ -7129,19 +7186,67 @@ bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject* ioPtr, vtkFoamDict
   vtkFoamDict& dict = *dictPtr;
   if (!dict.Read(io))
   {
-    vtkErrorMacro(<< "Error reading line " << io.GetLineNumber() << " of "
-                  << io.GetFileName().c_str() << ": " << io.GetError().c_str());
+    error << "Error reading line " << io.GetLineNumber() << " of " << io.GetFileName().c_str()
+          << ": " << io.GetError().c_str();
     return false;
   }
 
   if (dict.GetType() != vtkFoamToken::DICTIONARY)
   {
-    vtkErrorMacro(<< "File " << io.GetFileName().c_str() << "is not valid as a field file");
+    error << "File " << io.GetFileName().c_str() << "is not valid as a field file";
     return false;
   }
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// a field file decoded ahead of being added to the meshes
+struct vtkFoamFieldFile
+{
+  vtkStdString Name;
+  vtkFoamIOobject IO;
+  vtkFoamDict Dict;
+  bool Valid;
+  vtkFoamError Error; // reported when the file is added to the meshes
+
+  vtkFoamFieldFile(const vtkStdString& casePath, vtkOpenFOAMReader* reader)
+    : Name()
+    , IO(casePath, reader)
+    , Dict()
+    , Valid(false)
+    , Error()
+  {
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Decode the vol and point field files [begin, end) concurrently. Indices
+// below the number of vol fields refer to VolFieldFiles, the others to
+// PointFieldFiles. Each file has its own stream and dictionary.
+void vtkOpenFOAMReaderPrivate::ReadFieldFiles(int begin, int end, vtkFoamFieldFile** files)
+{
+  const int nVolFields = static_cast<int>(this->VolFieldFiles->GetNumberOfValues());
+  vtkSMPTools::For(begin, end, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; i++)
+    {
+      vtkFoamFieldFile* file = new vtkFoamFieldFile(this->CasePath, this->Parent);
+      if (i < nVolFields)
+      {
+        file->Name = this->VolFieldFiles->GetValue(i);
+        file->Valid = this->ReadFieldFile(&file->IO, &file->Dict, file->Name,
+          this->Parent->CellDataArraySelection, file->Error);
+      }
+      else
+      {
+        file->Name = this->PointFieldFiles->GetValue(i - nVolFields);
+        file->Valid = this->ReadFieldFile(&file->IO, &file->Dict, file->Name,
+          this->Parent->PointDataArraySelection, file->Error);
+      }
+      files[i - begin] = file;
+    }
+  });
+}
+
 //-----------------------------------------------------------------------------
 vtkFloatArray* vtkOpenFOAMReaderPrivate::FillField(vtkFoamEntry* entryPtr, vtkIdType nElements,
   vtkFoamIOobject* ioPtr, const vtkStdString& fieldType)
@@ -7375,15 +7480,20 @@ void vtkOpenFOAMReaderPrivate::ConstructDimensions(vtkStdString* dimString, vtkF
 
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(vtkUnstructuredGrid* internalMesh,
-  vtkMultiBlockDataSet* boundaryMesh, const vtkStdString& varName)
+  vtkMultiBlockDataSet* boundaryMesh, vtkFoamFieldFile* file)
 {
   bool use64BitLabels = this->Parent->GetUse64BitLabels();
-  vtkFoamIOobject io(this->CasePath, this->Parent);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName, this->Parent->CellDataArraySelection))
+  if (!file->Valid)
   {
+    if (!file->Error.empty())
+    {
+      vtkErrorMacro(<< file->Error.c_str());
+    }
     return;
   }
+  const vtkStdString& varName = file->Name;
+  vtkFoamIOobject& io = file->IO;
+  vtkFoamDict& dict = file->Dict;
 
   if (io.GetClassName().substr(0, 3) != "vol")
   {
@@ -7717,15 +7827,19 @@ void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(vtkUnstructuredGrid* intern
 //-----------------------------------------------------------------------------
 // read point field at a timestep
 void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(vtkUnstructuredGrid* internalMesh,
-  vtkMultiBlockDataSet* boundaryMesh, const vtkStdString& varName)
+  vtkMultiBlockDataSet* boundaryMesh, vtkFoamFieldFile* file)
 {
   bool use64BitLabels = this->Parent->GetUse64BitLabels();
-  vtkFoamIOobject io(this->CasePath, this->Parent);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName, this->Parent->PointDataArraySelection))
+  if (!file->Valid)
   {
+    if (!file->Error.empty())
+    {
+      vtkErrorMacro(<< file->Error.c_str());
+    }
     return;
   }
+  vtkFoamIOobject& io = file->IO;
+  vtkFoamDict& dict = file->Dict;
 
   if (io.GetClassName().substr(0, 5) != "point")
   {
@@ -8355,17 +8469,47 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet* output, bool rec
     this->ClearBoundaryMeshes();
   }
 
-  vtkFoamLabelVectorVector* facePoints = nullptr;
+  const bool readFaces = createEulerians && (recreateInternalMesh || recreateBoundaryMesh);
+  const bool readPoints = createEulerians &&
+    (recreateInternalMesh ||
+      (recreateBoundaryMesh && !recreateInternalMesh && this->InternalMesh == nullptr) ||
+      moveInternalPoints || moveBoundaryPoints);
+
+  // create paths to polyMesh files
   vtkStdString meshDir;
-  if (createEulerians && (recreateInternalMesh || recreateBoundaryMesh))
+  if (readFaces)
   {
-    // create paths to polyMesh files
     meshDir = this->CurrentTimeRegionMeshPath(this->PolyMeshFacesDir);
+  }
+
+  // The faces and points files are independent, so decode them concurrently,
+  // each through its own stream. Their errors are reported from this thread.
+  vtkFoamLabelVectorVector* facePoints = nullptr;
+  vtkFloatArray* pointArray = nullptr;
+  vtkFoamError facesError, pointsError;
+  vtkSMPTools::For(0, 2, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType task = begin; task < end; task++)
+    {
+      if (task == 0 && readFaces)
+      {
+        facePoints = this->ReadFacesFile(meshDir, facesError);
+      }
+      else if (task == 1 && readPoints)
+      {
+        pointArray = this->ReadPointsFile(pointsError);
+      }
+    }
+  });
 
-    // create the faces vector
-    facePoints = this->ReadFacesFile(meshDir);
+  if (readFaces)
+  {
     if (facePoints == nullptr)
     {
+      vtkErrorMacro(<< facesError.c_str());
+      if (pointArray != nullptr)
+      {
+        pointArray->Delete();
+      }
       return 0;
     }
     this->Parent->UpdateProgress(0.2);
@@ -8379,24 +8523,30 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet* output, bool rec
     if (cellFaces == nullptr)
     {
       delete facePoints;
+      if (pointArray != nullptr)
+      {
+        pointArray->Delete();
+      }
       return 0;
     }
     this->Parent->UpdateProgress(0.3);
   }
 
-  vtkFloatArray* pointArray = nullptr;
-  if (createEulerians &&
-    (recreateInternalMesh ||
-      (recreateBoundaryMesh && !recreateInternalMesh && this->InternalMesh == nullptr) ||
-      moveInternalPoints || moveBoundaryPoints))
+  if (readPoints)
   {
-    // get the points
-    pointArray = this->ReadPointsFile();
+    if (pointArray == nullptr && !pointsError.empty())
+    {
+      vtkErrorMacro(<< pointsError.c_str());
+    }
     if ((pointArray == nullptr && recreateInternalMesh) ||
       (facePoints != nullptr && !this->CheckFacePoints(facePoints)))
     {
       delete cellFaces;
       delete facePoints;
+      if (pointArray != nullptr)
+      {
+        pointArray->Delete();
+      }
       return 0;
     }
     this->Parent->UpdateProgress(0.4);
@@ -8615,20 +8765,36 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet* output, bool rec
           bm->GetPointData()->Initialize();
         }
       }
-      // read field data variables into Internal/Boundary meshes
-      for (int i = 0; i < (int)this->VolFieldFiles->GetNumberOfValues(); i++)
+      // read field data variables into Internal/Boundary meshes. The files
+      // are decoded concurrently in batches of about one per thread, which
+      // bounds the number of parsed files held in memory, then added to the
+      // meshes in order.
+      const int nVolFields = (int)this->VolFieldFiles->GetNumberOfValues();
+      const int nPointFields = (int)this->PointFieldFiles->GetNumberOfValues();
+      const int nFields = nVolFields + nPointFields;
+      const int batchSize = std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads());
+      std::vector<vtkFoamFieldFile*> files(batchSize);
+      for (int batchBegin = 0; batchBegin < nFields; batchBegin += batchSize)
       {
-        this->GetVolFieldAtTimeStep(
-          this->InternalMesh, this->BoundaryMesh, this->VolFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.5 +
-          0.25 * ((float)(i + 1) / ((float)this->VolFieldFiles->GetNumberOfValues() + 0.0001)));
-      }
-      for (int i = 0; i < (int)this->PointFieldFiles->GetNumberOfValues(); i++)
-      {
-        this->GetPointFieldAtTimeStep(
-          this->InternalMesh, this->BoundaryMesh, this->PointFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.75 +
-          0.125 * ((float)(i + 1) / ((float)this->PointFieldFiles->GetNumberOfValues() + 0.0001)));
+        const int batchEnd = std::min(nFields, batchBegin + batchSize);
+        this->ReadFieldFiles(batchBegin, batchEnd, files.data());
+        for (int i = batchBegin; i < batchEnd; i++)
+        {
+          vtkFoamFieldFile* file = files[i - batchBegin];
+          if (i < nVolFields)
+          {
+            this->GetVolFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh, file);
+            this->Parent->UpdateProgress(
+              0.5 + 0.25 * ((float)(i + 1) / ((float)nVolFields + 0.0001)));
+          }
+          else
+          {
+            this->GetPointFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh, file);
+            this->Parent->UpdateProgress(
+              0.75 + 0.125 * ((float)(i - nVolFields + 1) / ((float)nPointFields + 0.0001)));
+          }
+          delete file;
+        }
       }
     }
     // read lagrangian mesh and fields
@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,6 +27,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -33,7 +35,10 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
+#include <numeric>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -44,6 +49,207 @@ vtkStandardNewMacro(vtkSTLReader);
 vtkCxxSetObjectMacro(vtkSTLReader, Locator, vtkIncrementalPointLocator);
 vtkCxxSetObjectMacro(vtkSTLReader, BinaryHeader, vtkUnsignedCharArray);
 
+namespace
+{
+// Number of facets read from binary files at once.
+const vtkIdType stlBinaryBlockSize = 65536;
+
+// Blocks of items processed by one task when numbering a selection of them.
+const vtkIdType stlBlockSize = 65536;
+
+// Return the number of selected items in the blocks before each block of
+// [0, n), the last entry being the total, counting them in parallel.
+template <typename CountT>
+std::vector<vtkIdType> stlBlockOffsets(vtkIdType n, CountT count)
+{
+  const vtkIdType numBlocks = (n + stlBlockSize - 1) / stlBlockSize;
+  std::vector<vtkIdType> offsets(numBlocks + 1, 0);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType b = first; b < last; ++b)
+    {
+      offsets[b + 1] = count(b * stlBlockSize, std::min(n, (b + 1) * stlBlockSize));
+    }
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  return offsets;
+}
+
+// Call functor(first, last, offset) for the blocks of [0, n) in parallel.
+template <typename FunctorT>
+void stlForBlocks(vtkIdType n, const std::vector<vtkIdType>& offsets, FunctorT functor)
+{
+  const vtkIdType numBlocks = static_cast<vtkIdType>(offsets.size()) - 1;
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType b = first; b < last; ++b)
+    {
+      functor(b * stlBlockSize, std::min(n, (b + 1) * stlBlockSize), offsets[b]);
+    }
+  });
+}
+
+// Merge the vertices of the facets with identical coordinates. The vertices
+// of facet i are the points 3i, 3i+1 and 3i+2, as both file formats store
+// them. This gives the same points, in the same order, and the same facets
+// as inserting the vertices one after another in a vtkMergePoints: the
+// coordinates are compared as floats and a vertex gets the id of the first
+// vertex with the same coordinates. Instead of a hash table filled
+// serially, the vertices are sorted by coordinates in parallel.
+void stlMergeVertices(vtkPoints* points, vtkFloatArray* scalars, vtkPoints* mergedPts,
+  vtkCellArray* mergedPolys, vtkFloatArray* mergedScalars)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  const vtkIdType numFacets = numPts / 3;
+  const float* x = static_cast<vtkFloatArray*>(points->GetData())->GetPointer(0);
+
+  // Sort keys: the bits of the coordinates, with -0 as +0 since they compare
+  // equal. Vertices with a NaN coordinate never compare equal to another.
+  struct Key
+  {
+    vtkTypeUInt32 X[3];
+    bool IsNaN() const
+    {
+      return (this->X[0] & 0x7fffffff) > 0x7f800000 || (this->X[1] & 0x7fffffff) > 0x7f800000 ||
+        (this->X[2] & 0x7fffffff) > 0x7f800000;
+    }
+  };
+  std::vector<Key> keys(numPts);
+  std::vector<vtkIdType> order(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      std::memcpy(keys[i].X, x + 3 * i, sizeof(keys[i].X));
+      for (int c = 0; c < 3; ++c)
+      {
+        if (keys[i].X[c] == 0x80000000)
+        {
+          keys[i].X[c] = 0;
+        }
+      }
+      order[i] = i;
+    }
+  });
+  vtkSMPTools::Sort(order.begin(), order.end(), [&keys](vtkIdType a, vtkIdType b) {
+    const Key& ka = keys[a];
+    const Key& kb = keys[b];
+    if (ka.X[0] != kb.X[0])
+    {
+      return ka.X[0] < kb.X[0];
+    }
+    if (ka.X[1] != kb.X[1])
+    {
+      return ka.X[1] < kb.X[1];
+    }
+    if (ka.X[2] != kb.X[2])
+    {
+      return ka.X[2] < kb.X[2];
+    }
+    return a < b;
+  });
+  auto same = [&keys](vtkIdType a, vtkIdType b) {
+    return std::memcmp(keys[a].X, keys[b].X, sizeof(keys[a].X)) == 0 && !keys[a].IsNaN();
+  };
+
+  // Each vertex refers to the first vertex with its coordinates, which
+  // starts its run in the sorted order.
+  std::vector<vtkIdType> ids(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType k = first; k < last; ++k)
+    {
+      if (k > 0 && same(order[k - 1], order[k]))
+      {
+        continue;
+      }
+      const vtkIdType representative = order[k];
+      ids[representative] = representative;
+      for (vtkIdType m = k + 1; m < numPts && same(representative, order[m]); ++m)
+      {
+        ids[order[m]] = representative;
+      }
+    }
+  });
+  std::vector<Key>().swap(keys);
+
+  // Number the first vertices in order and point the others to them. The
+  // sorted order is not needed anymore and holds the new ids.
+  std::vector<vtkIdType>& newIds = order;
+  std::vector<vtkIdType> offsets = stlBlockOffsets(numPts, [&](vtkIdType first, vtkIdType last) {
+    vtkIdType count = 0;
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      if (ids[i] == i)
+      {
+        newIds[i] = count++;
+      }
+    }
+    return count;
+  });
+  stlForBlocks(numPts, offsets, [&](vtkIdType first, vtkIdType last, vtkIdType offset) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      if (ids[i] == i)
+      {
+        newIds[i] += offset;
+      }
+    }
+  });
+  const vtkIdType numMerged = offsets.back();
+  mergedPts->SetNumberOfPoints(numMerged);
+  float* mergedX = static_cast<vtkFloatArray*>(mergedPts->GetData())->GetPointer(0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      const vtkIdType id = newIds[ids[i]];
+      if (ids[i] == i)
+      {
+        std::copy(x + 3 * i, x + 3 * i + 3, mergedX + 3 * id);
+      }
+      ids[i] = id;
+    }
+  });
+  std::vector<vtkIdType>().swap(order);
+
+  // Keep the facets whose vertices are distinct.
+  auto keep = [&ids](vtkIdType facet) {
+    const vtkIdType* nodes = ids.data() + 3 * facet;
+    return nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2];
+  };
+  offsets = stlBlockOffsets(numFacets, [&](vtkIdType first, vtkIdType last) {
+    vtkIdType count = 0;
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      count += keep(i) ? 1 : 0;
+    }
+    return count;
+  });
+  const vtkIdType numKept = offsets.back();
+  vtkNew<vtkIdTypeArray> cellOffsets;
+  vtkNew<vtkIdTypeArray> connectivity;
+  cellOffsets->SetNumberOfValues(numKept + 1);
+  connectivity->SetNumberOfValues(3 * numKept);
+  if (mergedScalars)
+  {
+    mergedScalars->SetNumberOfValues(numKept);
+  }
+  stlForBlocks(numFacets, offsets, [&](vtkIdType first, vtkIdType last, vtkIdType cell) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      if (keep(i))
+      {
+        std::copy(ids.data() + 3 * i, ids.data() + 3 * i + 3, connectivity->GetPointer(3 * cell));
+        cellOffsets->SetValue(cell, 3 * cell);
+        if (mergedScalars)
+        {
+          mergedScalars->SetValue(cell, scalars->GetValue(i));
+        }
+        ++cell;
+      }
+    }
+  });
+  cellOffsets->SetValue(numKept, 3 * numKept);
+  mergedPolys->SetData(cellOffsets, connectivity);
+}
+} // end anonymous namespace
+
 //------------------------------------------------------------------------------
 // Construct object with merging set to true.
 vtkSTLReader::vtkSTLReader()
@@ -185,12 +391,24 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
     {
       locator.TakeReference(this->NewDefaultLocator());
     }
-    locator->InitPointInsertion(mergedPts, newPts->GetBounds());
+
+    // vtkMergePoints only merges points with the same coordinates, which is
+    // done faster by sorting them.
+    if (vtkMergePoints::SafeDownCast(locator) &&
+      newPts->GetNumberOfPoints() == 3 * newPolys->GetNumberOfCells())
+    {
+      stlMergeVertices(newPts, newScalars, mergedPts, mergedPolys, mergedScalars);
+      locator = nullptr;
+    }
+    else
+    {
+      locator->InitPointInsertion(mergedPts, newPts->GetBounds());
+    }
 
     int nextCell = 0;
     const vtkIdType* pts = nullptr;
     vtkIdType npts;
-    for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
+    for (newPolys->InitTraversal(); locator && newPolys->GetNextCell(npts, pts);)
     {
       vtkIdType nodes[3];
       for (int i = 0; i < 3; i++)
@@ -220,11 +438,19 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
                   << mergedPolys->GetNumberOfCells() << " triangles");
   }
 
+  // Without merging, the points and triangles are still owned by newPts and
+  // newPolys.
   output->SetPoints(mergedPts);
-  mergedPts->Delete();
+  if (mergedPts != newPts)
+  {
+    mergedPts->Delete();
+  }
 
   output->SetPolys(mergedPolys);
-  mergedPolys->Delete();
+  if (mergedPolys != newPolys)
+  {
+    mergedPolys->Delete();
+  }
 
   if (mergedScalars)
   {
@@ -246,11 +472,6 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
 //------------------------------------------------------------------------------
 bool vtkSTLReader::ReadBinarySTL(FILE* fp, vtkPoints* newPts, vtkCellArray* newPolys)
 {
-  typedef struct
-  {
-    float n[3], v1[3], v2[3], v3[3];
-  } facet_t;
-
   vtkDebugMacro(<< "Reading BINARY STL file");
 
   //  File is read to obtain raw information as well as bounding box
@@ -302,50 +523,73 @@ bool vtkSTLReader::ReadBinarySTL(FILE* fp, vtkPoints* newPts, vtkCellArray* newP
     numTris = static_cast<int>(ulFileLength);
   }
 
-  // now we can allocate the memory we need for this STL file
-  newPts->Allocate(numTris * 3);
-  newPolys->AllocateEstimate(numTris, 3);
-
-  facet_t facet;
-  for (int i = 0; fread(&facet, 48, 1, fp) > 0; i++)
+  // Read the facets by blocks and decode them in parallel.
+  vtkFloatArray* pointData = vtkArrayDownCast<vtkFloatArray>(newPts->GetData());
+  if (!pointData)
   {
-    unsigned short ibuff2;
-    if (fread(&ibuff2, 2, 1, fp) != 1) // read extra junk
+    newPts->SetDataTypeToFloat();
+    pointData = vtkArrayDownCast<vtkFloatArray>(newPts->GetData());
+  }
+  // Size the points from the file length rather than from a bogus count.
+  pointData->SetNumberOfTuples(3 * static_cast<vtkIdType>(ulFileLength));
+  std::vector<char> block(50 * stlBinaryBlockSize);
+  vtkIdType numFacets = 0;
+  bool trailingFacet = false;
+  while (true)
+  {
+    const size_t numRead = fread(block.data(), 1, block.size(), fp);
+    vtkIdType numBlockFacets = static_cast<vtkIdType>(numRead / 50);
+    if (numRead % 50 >= 48)
     {
-      vtkErrorMacro("STLReader error reading file: " << this->FileName
-                                                     << " Premature EOF while reading extra junk.");
-      return false;
+      // A facet without its attribute byte count.
+      trailingFacet = true;
     }
-
-    vtkByteSwap::Swap4LE(facet.n);
-    vtkByteSwap::Swap4LE(facet.n + 1);
-    vtkByteSwap::Swap4LE(facet.n + 2);
-
-    vtkByteSwap::Swap4LE(facet.v1);
-    vtkByteSwap::Swap4LE(facet.v1 + 1);
-    vtkByteSwap::Swap4LE(facet.v1 + 2);
-
-    vtkByteSwap::Swap4LE(facet.v2);
-    vtkByteSwap::Swap4LE(facet.v2 + 1);
-    vtkByteSwap::Swap4LE(facet.v2 + 2);
-
-    vtkByteSwap::Swap4LE(facet.v3);
-    vtkByteSwap::Swap4LE(facet.v3 + 1);
-    vtkByteSwap::Swap4LE(facet.v3 + 2);
-
-    vtkIdType pts[3];
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3, pts);
-
-    if ((i % 5000) == 0 && i != 0)
+    if (numFacets + numBlockFacets > pointData->GetNumberOfTuples() / 3)
+    {
+      pointData->Resize(3 * (numFacets + numBlockFacets));
+      pointData->SetNumberOfTuples(3 * (numFacets + numBlockFacets));
+    }
+    float* x = pointData->GetPointer(9 * numFacets);
+    const char* facets = block.data();
+    vtkSMPTools::For(0, numBlockFacets, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        // Skip the normal and the attribute byte count.
+        float* v = x + 9 * i;
+        std::memcpy(v, facets + 50 * i + 12, 36);
+        vtkByteSwap::Swap4LERange(v, 9);
+      }
+    });
+    numFacets += numBlockFacets;
+    if (numRead < block.size() || trailingFacet)
     {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i) / numTris);
+      break;
     }
+    this->UpdateProgress(static_cast<double>(numFacets) / numTris);
   }
+  pointData->SetNumberOfTuples(3 * numFacets);
+  if (trailingFacet)
+  {
+    vtkErrorMacro("STLReader error reading file: " << this->FileName
+                                                   << " Premature EOF while reading extra junk.");
+    return false;
+  }
+
+  // The vertices of the facets are stored in order.
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> connectivity;
+  offsets->SetNumberOfValues(numFacets + 1);
+  connectivity->SetNumberOfValues(3 * numFacets);
+  vtkSMPTools::For(0, numFacets + 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      offsets->SetValue(i, 3 * i);
+    }
+  });
+  vtkSMPTools::For(0, 3 * numFacets, [&](vtkIdType first, vtkIdType last) {
+    std::iota(connectivity->GetPointer(first), connectivity->GetPointer(last), first);
+  });
+  newPolys->SetData(offsets, connectivity);
 
   return true;
 }
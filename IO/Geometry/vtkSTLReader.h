@@ -25,7 +25,9 @@
  * definitions. By setting the Merging boolean you can control whether the
  * point data is merged after reading. Merging is performed by default,
  * however, merging requires a large amount of temporary storage since a
- * 3D hash table must be constructed.
+ * 3D hash table must be constructed. With the default locator, a
+ * vtkMergePoints, the points with identical coordinates are merged by
+ * sorting them in parallel instead, which gives the same output.
  *
  * @warning
  * Binary files written on one system may not be readable on other systems.
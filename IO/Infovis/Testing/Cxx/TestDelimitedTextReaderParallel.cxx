@@ -0,0 +1,145 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelimitedTextReaderParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Read a generated input of a few megabytes with both the serial and the
+// parallel parser of vtkDelimitedTextReader and compare the tables.
+
+#include "vtkAbstractArray.h"
+#include "vtkDataArray.h"
+#include "vtkDelimitedTextReader.h"
+#include "vtkNew.h"
+#include "vtkTable.h"
+#include "vtkVariant.h"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+std::string MakeInput()
+{
+  std::ostringstream input;
+  input << "id,value,mixed,label,quoted,late\n";
+  const int numRows = 60000;
+  for (int i = 0; i < numRows; ++i)
+  {
+    input << i << ',';
+    input << (i % 7 == 0 ? "" : std::to_string(i * 0.25)) << ',';
+    // An integer column that gets a real value in the middle of the input.
+    input << (i == numRows / 2 ? std::string("2.5") : std::to_string(i % 1000)) << ',';
+    input << "label" << (i % 13) << "\xc3\xa9,";
+    // Quoted field delimiters and escapes.
+    input << "\"a,b " << i << "\" \\t" << (i % 17 == 0 ? "\\" : "") << ',';
+    // A column that only turns out not to be numeric at the very end, and an
+    // escape before the record delimiter, which applies to the first
+    // character of the next record.
+    input << (i == numRows - 1 ? std::string("end") : std::to_string(i % 5))
+          << (i % 2 == 0 ? "\\" : "") << "\r\n";
+  }
+  return input.str();
+}
+
+bool SameTables(vtkTable* a, vtkTable* b)
+{
+  if (a->GetNumberOfColumns() != b->GetNumberOfColumns() ||
+    a->GetNumberOfRows() != b->GetNumberOfRows() || a->GetNumberOfRows() == 0)
+  {
+    std::cerr << "Tables differ in size: " << a->GetNumberOfColumns() << "x"
+              << a->GetNumberOfRows() << " and " << b->GetNumberOfColumns() << "x"
+              << b->GetNumberOfRows() << "\n";
+    return false;
+  }
+  for (vtkIdType j = 0; j < a->GetNumberOfColumns(); ++j)
+  {
+    vtkAbstractArray* ca = a->GetColumn(j);
+    vtkAbstractArray* cb = b->GetColumn(j);
+    if (strcmp(ca->GetClassName(), cb->GetClassName()) != 0 ||
+      strcmp(ca->GetName(), cb->GetName()) != 0 ||
+      ca->GetNumberOfTuples() != cb->GetNumberOfTuples())
+    {
+      std::cerr << "Column " << j << " differs: " << ca->GetClassName() << " " << ca->GetName()
+                << " and " << cb->GetClassName() << " " << cb->GetName() << "\n";
+      return false;
+    }
+    vtkDataArray* da = vtkDataArray::SafeDownCast(ca);
+    vtkDataArray* db = vtkDataArray::SafeDownCast(cb);
+    for (vtkIdType i = 0; i < ca->GetNumberOfTuples(); ++i)
+    {
+      if (da ? da->GetComponent(i, 0) != db->GetComponent(i, 0)
+             : ca->GetVariantValue(i).ToString() != cb->GetVariantValue(i).ToString())
+      {
+        std::cerr << "Column " << ca->GetName() << " differs at row " << i << ": "
+                  << ca->GetVariantValue(i).ToString() << " and "
+                  << cb->GetVariantValue(i).ToString() << "\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool Compare(const std::string& input, bool haveHeaders, bool detectNumeric, bool forceDouble)
+{
+  vtkNew<vtkDelimitedTextReader> readers[2];
+  for (int k = 0; k < 2; ++k)
+  {
+    readers[k]->SetReadFromInputString(true);
+    readers[k]->SetInputString(input.c_str(), static_cast<int>(input.size()));
+    readers[k]->SetHaveHeaders(haveHeaders);
+    readers[k]->SetDetectNumericColumns(detectNumeric);
+    readers[k]->SetForceDouble(forceDouble);
+    readers[k]->SetDefaultDoubleValue(-1.0);
+    readers[k]->SetUseParallelParser(k == 1);
+    readers[k]->Update();
+  }
+  if (!SameTables(readers[0]->GetOutput(), readers[1]->GetOutput()))
+  {
+    std::cerr << "Parsers differ with HaveHeaders " << haveHeaders << ", DetectNumericColumns "
+              << detectNumeric << ", ForceDouble " << forceDouble << "\n";
+    return false;
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestDelimitedTextReaderParallel(int, char*[])
+{
+  const std::string input = MakeInput();
+  if (!Compare(input, true, true, false) || !Compare(input, true, true, true) ||
+    !Compare(input, true, false, false) || !Compare(input, false, true, false))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Records with fewer fields are padded.
+  vtkNew<vtkDelimitedTextReader> reader;
+  reader->SetReadFromInputString(true);
+  reader->SetInputString("a,b,c\n1,2,3\n4\n");
+  reader->SetHaveHeaders(true);
+  reader->SetDetectNumericColumns(true);
+  reader->SetUseParallelParser(true);
+  reader->Update();
+  vtkTable* table = reader->GetOutput();
+  if (table->GetNumberOfRows() != 2 || table->GetValueByName(1, "a").ToInt() != 4 ||
+    table->GetValueByName(1, "c").ToInt() != 0)
+  {
+    std::cerr << "Short records are not padded.\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -21,24 +21,33 @@
 #include "vtkDelimitedTextReader.h"
 #include "vtkCommand.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStringToNumeric.h"
 #include "vtkTable.h"
 #include "vtkUnicodeStringArray.h"
+#include "vtkVariant.h"
 
 #include "vtkTextCodec.h"
 #include "vtkTextCodecFactory.h"
 #include "vtksys/FStream.hxx"
 
 #include <algorithm>
+#include <cerrno>
+#include <clocale>
+#include <cstdlib>
 #include <iostream>
 #include <iterator>
+#include <locale>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -343,6 +352,511 @@ private:
   vtkUnicodeString::value_type WithinString;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// Parallel parsing
+
+/// The delimiters used by DelimitedTextIterator, as tables indexed by byte.
+/// The parallel parser only handles ASCII delimiters so that UTF-8 text can be
+/// scanned byte by byte: the bytes of multi-byte characters never match them.
+struct DelimitedTextSyntax
+{
+  bool Record[256] = {};
+  bool Field[256] = {};
+  bool String[256] = {};
+  bool Whitespace[256] = {};
+  bool Escape[256] = {};
+  bool MergeConsecutiveDelimiters = false;
+  bool UseStringDelimiter = true;
+
+  // Returns false if one of the characters is not ASCII.
+  static bool Set(bool table[256], const vtkUnicodeString& characters)
+  {
+    for (vtkUnicodeString::const_iterator c = characters.begin(); c != characters.end(); ++c)
+    {
+      if (*c > 0x7f)
+      {
+        return false;
+      }
+      table[*c] = true;
+    }
+    return true;
+  }
+};
+
+/// Appends the character following an escape character, as
+/// DelimitedTextIterator does.
+void AppendEscaped(std::string& field, char c)
+{
+  switch (c)
+  {
+    case '0':
+      // vtkUnicodeString::from_utf8("\0") is empty.
+      break;
+    case 'a':
+      field += '\a';
+      break;
+    case 'b':
+      field += '\b';
+      break;
+    case 't':
+      field += '\t';
+      break;
+    case 'n':
+      field += '\n';
+      break;
+    case 'v':
+      field += '\v';
+      break;
+    case 'f':
+      field += '\f';
+      break;
+    case 'r':
+      field += '\r';
+      break;
+    default:
+      field += c;
+      break;
+  }
+}
+
+/// Splits [begin, end) into records and fields following the rules of
+/// DelimitedTextIterator byte by byte, calling sink.Field(index, value) for
+/// each field and sink.EndRecord(numberOfFields) for each record. Parsing
+/// starts at the beginning of a record and stops after maxRecords records
+/// when it is not 0. escapePending holds whether an escape character is
+/// waiting for the character it applies to, on input and on output, since it
+/// carries over record delimiters. Returns where parsing stopped.
+template <typename SinkT>
+const char* ParseRecords(const DelimitedTextSyntax& syntax, const char* begin, const char* end,
+  bool endOfInput, vtkIdType maxRecords, bool& escapePending, SinkT& sink)
+{
+  std::string field;
+  vtkIdType fieldIndex = 0;
+  vtkIdType numberOfRecords = 0;
+  bool recordAdjacent = true;
+  char withinString = 0;
+
+  for (const char* p = begin; p != end; ++p)
+  {
+    const unsigned char c = static_cast<unsigned char>(*p);
+    if (recordAdjacent)
+    {
+      if (syntax.Record[c] || syntax.Whitespace[c])
+      {
+        continue;
+      }
+      recordAdjacent = false;
+    }
+
+    if (syntax.Record[c])
+    {
+      sink.Field(fieldIndex, field);
+      sink.EndRecord(fieldIndex + 1);
+      fieldIndex = 0;
+      field.clear();
+      recordAdjacent = true;
+      withinString = 0;
+      if (maxRecords && ++numberOfRecords == maxRecords)
+      {
+        return p + 1;
+      }
+      continue;
+    }
+
+    if (!withinString && syntax.Field[c])
+    {
+      if (!(field.empty() && syntax.MergeConsecutiveDelimiters))
+      {
+        sink.Field(fieldIndex, field);
+        ++fieldIndex;
+        field.clear();
+      }
+      continue;
+    }
+
+    if (!escapePending && syntax.Escape[c])
+    {
+      escapePending = true;
+      continue;
+    }
+
+    if (escapePending)
+    {
+      AppendEscaped(field, *p);
+      escapePending = false;
+      continue;
+    }
+
+    if (syntax.UseStringDelimiter)
+    {
+      if (!withinString && syntax.String[c])
+      {
+        withinString = *p;
+        field.clear();
+        continue;
+      }
+      if (withinString && withinString == *p)
+      {
+        withinString = 0;
+        continue;
+      }
+    }
+
+    field += *p;
+  }
+
+  // See DelimitedTextIterator::ReachedEndOfInput().
+  if (endOfInput && !recordAdjacent)
+  {
+    const unsigned char last = field.empty() ? 0 : static_cast<unsigned char>(field.back());
+    if (!field.empty() && !syntax.Record[last] && !syntax.Whitespace[last])
+    {
+      sink.Field(fieldIndex, field);
+      ++fieldIndex;
+    }
+    if (fieldIndex)
+    {
+      sink.EndRecord(fieldIndex);
+    }
+  }
+  return end;
+}
+
+/// Whether [begin, end) is valid UTF-8 without nul characters, that is text
+/// vtkTextCodecFactory hands to the US-ASCII or the UTF-8 codec and that
+/// DelimitedTextIterator would store unchanged.
+bool IsPlainUTF8(const char* begin, const char* end)
+{
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(begin);
+  const unsigned char* last = reinterpret_cast<const unsigned char*>(end);
+  while (p != last)
+  {
+    const unsigned char c = *p++;
+    if (c < 0x80)
+    {
+      if (c == 0)
+      {
+        return false;
+      }
+      continue;
+    }
+    int length;
+    vtkTypeUInt32 codePoint;
+    if ((c & 0xe0) == 0xc0)
+    {
+      length = 1;
+      codePoint = c & 0x1f;
+    }
+    else if ((c & 0xf0) == 0xe0)
+    {
+      length = 2;
+      codePoint = c & 0x0f;
+    }
+    else if ((c & 0xf8) == 0xf0)
+    {
+      length = 3;
+      codePoint = c & 0x07;
+    }
+    else
+    {
+      return false;
+    }
+    if (last - p < length)
+    {
+      return false;
+    }
+    for (int i = 0; i < length; ++i, ++p)
+    {
+      if ((*p & 0xc0) != 0x80)
+      {
+        return false;
+      }
+      codePoint = (codePoint << 6) | (*p & 0x3f);
+    }
+    // Reject overlong sequences, surrogates and values past the last code point.
+    static const vtkTypeUInt32 minimum[4] = { 0, 0x80, 0x800, 0x10000 };
+    if (codePoint < minimum[length] || (codePoint >= 0xd800 && codePoint <= 0xdfff) ||
+      codePoint > 0x10ffff)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// The conversions vtkStringToNumeric applies to the columns.
+struct DelimitedTextConversion
+{
+  bool DetectNumericColumns;
+  bool ForceDouble;
+  bool TrimWhitespace;
+  int DefaultIntegerValue;
+  double DefaultDoubleValue;
+  // Whether strtod() parses like the C++ streams used by vtkVariant.
+  bool UseStrtod;
+};
+
+inline bool IsStreamSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+/// vtkVariant(str).ToInt(&ok) without a string stream for plain integers.
+int ToInt(const std::string& str, bool& ok)
+{
+  const char* p = str.c_str();
+  const char* end = p + str.size();
+  while (p != end && IsStreamSpace(*p))
+  {
+    ++p;
+  }
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-'))
+  {
+    negative = *p == '-';
+    ++p;
+  }
+  // Up to 9 digits cannot overflow an int.
+  const char* digits = p;
+  int value = 0;
+  while (p != end && *p >= '0' && *p <= '9' && p - digits < 9)
+  {
+    value = 10 * value + (*p - '0');
+    ++p;
+  }
+  const char* last = p;
+  while (p != end && IsStreamSpace(*p))
+  {
+    ++p;
+  }
+  if (last == digits || p != end)
+  {
+    return vtkVariant(vtkStdString(str)).ToInt(&ok);
+  }
+  ok = true;
+  return negative ? -value : value;
+}
+
+/// vtkVariant(str).ToDouble(&ok) without a string stream for plain decimal
+/// numbers.
+double ToDouble(const std::string& str, bool useStrtod, bool& ok)
+{
+  const char* p = str.c_str();
+  const char* end = p + str.size();
+  while (p != end && IsStreamSpace(*p))
+  {
+    ++p;
+  }
+  const char* start = p;
+  if (p != end && (*p == '+' || *p == '-'))
+  {
+    ++p;
+  }
+  int digits = 0;
+  for (; p != end && *p >= '0' && *p <= '9'; ++p)
+  {
+    ++digits;
+  }
+  if (p != end && *p == '.')
+  {
+    for (++p; p != end && *p >= '0' && *p <= '9'; ++p)
+    {
+      ++digits;
+    }
+  }
+  bool plain = digits > 0;
+  if (plain && p != end && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    if (p != end && (*p == '+' || *p == '-'))
+    {
+      ++p;
+    }
+    const char* exponent = p;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p)
+    {
+    }
+    plain = p != exponent;
+  }
+  const char* last = p;
+  while (p != end && IsStreamSpace(*p))
+  {
+    ++p;
+  }
+  if (plain && p == end && useStrtod)
+  {
+    char* stop;
+    errno = 0;
+    double value = strtod(start, &stop);
+    // Out of range values make the streams fail.
+    if (stop == last && errno == 0)
+    {
+      ok = true;
+      return value;
+    }
+  }
+  return vtkVariant(vtkStdString(str)).ToDouble(&ok);
+}
+
+enum DelimitedTextColumnKind
+{
+  IntColumn,
+  DoubleColumn,
+  StringColumn,
+  IgnoredColumn
+};
+
+/// A parser sink storing the fields of a range of records as typed values.
+/// A column starts with the kind it is given and widens as needed, the way
+/// vtkStringToNumeric decides on the type of an array. A column that turns
+/// out not to be numeric after some values were converted is marked with
+/// NeedsStrings, and its strings are collected by parsing the range again.
+class DelimitedTextColumns
+{
+public:
+  struct Column
+  {
+    int Kind;
+    bool NeedsStrings;
+    std::vector<int> Ints;
+    std::vector<double> Doubles;
+    std::vector<std::string> Strings;
+    // The rows of Ints holding the default value of an empty string.
+    std::vector<vtkIdType> EmptyRows;
+
+    int GetFinalKind() const { return this->NeedsStrings ? StringColumn : this->Kind; }
+  };
+
+  DelimitedTextColumns(const DelimitedTextConversion& conversion, const std::vector<int>& kinds)
+    : Conversion(conversion)
+    , NumberOfRecords(0)
+  {
+    this->Columns.resize(kinds.size());
+    for (size_t i = 0; i < kinds.size(); ++i)
+    {
+      this->Columns[i].Kind = kinds[i];
+      this->Columns[i].NeedsStrings = false;
+    }
+  }
+
+  void Field(vtkIdType index, const std::string& value)
+  {
+    if (index < static_cast<vtkIdType>(this->Columns.size()))
+    {
+      this->Add(this->Columns[index], value);
+    }
+  }
+
+  void EndRecord(vtkIdType numberOfFields)
+  {
+    // Missing fields are empty.
+    for (size_t i = numberOfFields; i < this->Columns.size(); ++i)
+    {
+      this->Add(this->Columns[i], std::string());
+    }
+    ++this->NumberOfRecords;
+  }
+
+  static void ConvertToDouble(Column& column, double defaultValue)
+  {
+    column.Doubles.assign(column.Ints.begin(), column.Ints.end());
+    for (vtkIdType row : column.EmptyRows)
+    {
+      column.Doubles[row] = defaultValue;
+    }
+    std::vector<int>().swap(column.Ints);
+    std::vector<vtkIdType>().swap(column.EmptyRows);
+    column.Kind = DoubleColumn;
+  }
+
+  const DelimitedTextConversion& Conversion;
+  vtkIdType NumberOfRecords;
+  std::vector<Column> Columns;
+
+private:
+  void Add(Column& column, const std::string& value)
+  {
+    if (column.NeedsStrings || column.Kind == IgnoredColumn)
+    {
+      return;
+    }
+    if (column.Kind == StringColumn)
+    {
+      column.Strings.push_back(value);
+      return;
+    }
+
+    const std::string* str = &value;
+    std::string trimmed;
+    if (this->Conversion.TrimWhitespace)
+    {
+      size_t first = value.find_first_not_of(" \n\t\r");
+      size_t last = value.find_last_not_of(" \n\t\r");
+      if (first != 0 || last + 1 != value.size())
+      {
+        if (first != std::string::npos)
+        {
+          trimmed = value.substr(first, last - first + 1);
+        }
+        str = &trimmed;
+      }
+    }
+
+    bool ok;
+    if (column.Kind == IntColumn)
+    {
+      if (str->empty())
+      {
+        column.EmptyRows.push_back(static_cast<vtkIdType>(column.Ints.size()));
+        column.Ints.push_back(this->Conversion.DefaultIntegerValue);
+        return;
+      }
+      int intValue = ToInt(*str, ok);
+      if (ok)
+      {
+        column.Ints.push_back(intValue);
+        return;
+      }
+      ConvertToDouble(column, this->Conversion.DefaultDoubleValue);
+    }
+
+    if (str->empty())
+    {
+      column.Doubles.push_back(this->Conversion.DefaultDoubleValue);
+      return;
+    }
+    double doubleValue = ToDouble(*str, this->Conversion.UseStrtod, ok);
+    if (ok)
+    {
+      column.Doubles.push_back(doubleValue);
+      return;
+    }
+    column.NeedsStrings = true;
+    std::vector<double>().swap(column.Doubles);
+  }
+};
+
+/// A parser sink collecting the fields of the first record.
+class DelimitedTextHeader
+{
+public:
+  void Field(vtkIdType, const std::string& value) { this->Names.push_back(value); }
+  void EndRecord(vtkIdType) {}
+
+  std::vector<std::string> Names;
+};
+
+/// A range of records parsed by one task.
+struct DelimitedTextChunk
+{
+  const char* Begin;
+  const char* End;
+  bool StartEscapePending;
+  bool EndEscapePending;
+  bool Valid;
+  std::unique_ptr<DelimitedTextColumns> Columns;
+};
+
 } // End anonymous namespace
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -384,6 +898,7 @@ vtkDelimitedTextReader::vtkDelimitedTextReader()
   this->DefaultIntegerValue = 0;
   this->DefaultDoubleValue = 0.0;
   this->TrimWhitespacePriorToNumericConversion = false;
+  this->UseParallelParser = false;
 }
 
 vtkDelimitedTextReader::~vtkDelimitedTextReader()
@@ -438,6 +953,7 @@ void vtkDelimitedTextReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OutputPedigreeIds: " << (this->OutputPedigreeIds ? "true" : "false") << endl;
   os << indent << "AddTabFieldDelimiter: " << (this->AddTabFieldDelimiter ? "true" : "false")
      << endl;
+  os << indent << "UseParallelParser: " << (this->UseParallelParser ? "true" : "false") << endl;
 }
 
 void vtkDelimitedTextReader::SetInputString(const char* in)
@@ -610,6 +1126,8 @@ int vtkDelimitedTextReader::ReadData(vtkTable* const output_table)
 
     vtkStdString character_set;
     vtkTextCodec* transCodec = nullptr;
+    // The parallel parser converts the numeric columns itself.
+    bool parsedInParallel = false;
 
     if (this->UnicodeCharacterSet)
     {
@@ -632,25 +1150,35 @@ int vtkDelimitedTextReader::ReadData(vtkTable* const output_table)
       this->UnicodeFieldDelimiters = vtkUnicodeString::from_utf8(fieldDelimiterCharacters);
       this->UnicodeStringDelimiters = vtkUnicodeString::from_utf8(tstring);
       this->UnicodeOutputArrays = false;
-      transCodec = vtkTextCodecFactory::CodecToHandle(*input_stream_pt);
+      if (this->UseParallelParser)
+      {
+        parsedInParallel = this->ReadDataInParallel(*input_stream_pt, output_table);
+      }
+      if (!parsedInParallel)
+      {
+        transCodec = vtkTextCodecFactory::CodecToHandle(*input_stream_pt);
+      }
     }
 
-    if (nullptr == transCodec)
+    if (!parsedInParallel)
     {
-      // should this use the locale instead??
-      return 1;
-    }
+      if (nullptr == transCodec)
+      {
+        // should this use the locale instead??
+        return 1;
+      }
 
-    DelimitedTextIterator iterator(this->MaxRecords, this->UnicodeRecordDelimiters,
-      this->UnicodeFieldDelimiters, this->UnicodeStringDelimiters, this->UnicodeWhitespace,
-      this->UnicodeEscapeCharacter, this->HaveHeaders, this->UnicodeOutputArrays,
-      this->MergeConsecutiveDelimiters, this->UseStringDelimiter, output_table);
+      DelimitedTextIterator iterator(this->MaxRecords, this->UnicodeRecordDelimiters,
+        this->UnicodeFieldDelimiters, this->UnicodeStringDelimiters, this->UnicodeWhitespace,
+        this->UnicodeEscapeCharacter, this->HaveHeaders, this->UnicodeOutputArrays,
+        this->MergeConsecutiveDelimiters, this->UseStringDelimiter, output_table);
 
-    vtkTextCodec::OutputIterator& outIter = iterator;
+      vtkTextCodec::OutputIterator& outIter = iterator;
 
-    transCodec->ToUnicode(*input_stream_pt, outIter);
-    iterator.ReachedEndOfInput();
-    transCodec->Delete();
+      transCodec->ToUnicode(*input_stream_pt, outIter);
+      iterator.ReachedEndOfInput();
+      transCodec->Delete();
+    }
 
     if (this->OutputPedigreeIds)
     {
@@ -681,7 +1209,7 @@ int vtkDelimitedTextReader::ReadData(vtkTable* const output_table)
       }
     }
 
-    if (this->DetectNumericColumns && !this->UnicodeOutputArrays)
+    if (this->DetectNumericColumns && !this->UnicodeOutputArrays && !parsedInParallel)
     {
       vtkStringToNumeric* converter = vtkStringToNumeric::New();
       converter->SetForceDouble(this->ForceDouble);
@@ -713,3 +1241,291 @@ int vtkDelimitedTextReader::ReadData(vtkTable* const output_table)
 
   return 1;
 }
+
+bool vtkDelimitedTextReader::ReadDataInParallel(istream& input_stream, vtkTable* const output_table)
+{
+  DelimitedTextSyntax syntax;
+  if (!DelimitedTextSyntax::Set(syntax.Record, this->UnicodeRecordDelimiters) ||
+    !DelimitedTextSyntax::Set(syntax.Field, this->UnicodeFieldDelimiters) ||
+    !DelimitedTextSyntax::Set(syntax.String, this->UnicodeStringDelimiters) ||
+    !DelimitedTextSyntax::Set(syntax.Whitespace, this->UnicodeWhitespace) ||
+    !DelimitedTextSyntax::Set(syntax.Escape, this->UnicodeEscapeCharacter))
+  {
+    return false;
+  }
+  syntax.MergeConsecutiveDelimiters = this->MergeConsecutiveDelimiters;
+  syntax.UseStringDelimiter = this->UseStringDelimiter;
+
+  // Load the whole input, then restore the stream for the serial parser.
+  const istream::pos_type start = input_stream.tellg();
+  input_stream.seekg(0, ios::end);
+  const istream::pos_type stop = input_stream.tellg();
+  input_stream.seekg(start);
+  if (start == istream::pos_type(-1) || stop == istream::pos_type(-1))
+  {
+    input_stream.clear();
+    input_stream.seekg(start);
+    return false;
+  }
+  std::vector<char> buffer(static_cast<size_t>(stop - start));
+  input_stream.read(buffer.data(), buffer.size());
+  const bool complete = input_stream.gcount() == static_cast<std::streamsize>(buffer.size());
+  input_stream.clear();
+  input_stream.seekg(start);
+  if (!complete)
+  {
+    return false;
+  }
+  const char* begin = buffer.data();
+  const char* end = begin + buffer.size();
+
+  // A byte order mark is left to the text codecs.
+  if (buffer.size() >= 3 && static_cast<unsigned char>(begin[0]) == 0xef &&
+    static_cast<unsigned char>(begin[1]) == 0xbb && static_cast<unsigned char>(begin[2]) == 0xbf)
+  {
+    return false;
+  }
+
+  // The first record gives the columns.
+  bool escapePending = false;
+  DelimitedTextHeader header;
+  const char* dataBegin = ParseRecords(syntax, begin, end, true, 1, escapePending, header);
+  if (header.Names.empty() || !IsPlainUTF8(begin, dataBegin))
+  {
+    return false;
+  }
+  std::vector<std::string> names(header.Names.size());
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    if (this->HaveHeaders)
+    {
+      names[i] = header.Names[i];
+    }
+    else
+    {
+      std::ostringstream buffer_name;
+      buffer_name << "Field " << i;
+      names[i] = buffer_name.str();
+    }
+  }
+  if (this->HaveHeaders)
+  {
+    // vtkTable looks columns up by name.
+    if (std::set<std::string>(names.begin(), names.end()).size() != names.size())
+    {
+      return false;
+    }
+  }
+  else
+  {
+    dataBegin = begin;
+    escapePending = false;
+  }
+  const bool dataEscapePending = escapePending;
+
+  DelimitedTextConversion conversion;
+  conversion.DetectNumericColumns = this->DetectNumericColumns;
+  conversion.ForceDouble = this->ForceDouble;
+  conversion.TrimWhitespace = this->TrimWhitespacePriorToNumericConversion;
+  conversion.DefaultIntegerValue = this->DefaultIntegerValue;
+  conversion.DefaultDoubleValue = this->DefaultDoubleValue;
+  conversion.UseStrtod = std::locale() == std::locale::classic() &&
+    std::string(localeconv()->decimal_point) == ".";
+
+  // Infer the kind of the columns from a sample so that the ranges do not
+  // convert values of string columns.
+  const int numColumns = static_cast<int>(names.size());
+  std::vector<int> kinds(numColumns, this->DetectNumericColumns ? IntColumn : StringColumn);
+  if (this->DetectNumericColumns)
+  {
+    DelimitedTextColumns sample(conversion, kinds);
+    ParseRecords(syntax, dataBegin, end, true, 1000, escapePending, sample);
+    for (int i = 0; i < numColumns; ++i)
+    {
+      kinds[i] = sample.Columns[i].GetFinalKind();
+    }
+  }
+
+  // Split the records into ranges. Quoted strings end with the record, so a
+  // range can start after any record delimiter; only a pending escape
+  // carries over, which is fixed once all ranges are parsed.
+  std::vector<DelimitedTextChunk> chunks;
+  const size_t dataSize = static_cast<size_t>(end - dataBegin);
+  size_t chunkSize = dataSize;
+  if (!this->MaxRecords)
+  {
+    const size_t numThreads =
+      static_cast<size_t>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+    chunkSize = std::max<size_t>(dataSize / (4 * numThreads), 1 << 20);
+  }
+  for (const char* chunkBegin = dataBegin; chunkBegin != end || chunks.empty();)
+  {
+    const char* chunkEnd = end;
+    if (static_cast<size_t>(end - chunkBegin) > chunkSize)
+    {
+      chunkEnd = chunkBegin + chunkSize;
+      while (chunkEnd != end && !syntax.Record[static_cast<unsigned char>(*chunkEnd)])
+      {
+        ++chunkEnd;
+      }
+      if (chunkEnd != end)
+      {
+        ++chunkEnd;
+      }
+    }
+    DelimitedTextChunk chunk;
+    chunk.Begin = chunkBegin;
+    chunk.End = chunkEnd;
+    chunk.StartEscapePending = chunks.empty() ? dataEscapePending : false;
+    chunk.EndEscapePending = false;
+    chunk.Valid = true;
+    chunks.push_back(std::move(chunk));
+    chunkBegin = chunkEnd;
+  }
+
+  const vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+  const vtkIdType maxRecords = this->MaxRecords;
+  auto parseChunk = [&](DelimitedTextChunk& chunk) {
+    chunk.EndEscapePending = chunk.StartEscapePending;
+    chunk.Columns.reset(new DelimitedTextColumns(conversion, kinds));
+    ParseRecords(syntax, chunk.Begin, chunk.End, chunk.End == end, maxRecords,
+      chunk.EndEscapePending, *chunk.Columns);
+  };
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      chunks[i].Valid = IsPlainUTF8(chunks[i].Begin, chunks[i].End);
+      if (chunks[i].Valid)
+      {
+        parseChunk(chunks[i]);
+      }
+    }
+  });
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    if (!chunks[i].Valid)
+    {
+      return false;
+    }
+    if (i > 0 && chunks[i].StartEscapePending != chunks[i - 1].EndEscapePending)
+    {
+      chunks[i].StartEscapePending = chunks[i - 1].EndEscapePending;
+      parseChunk(chunks[i]);
+    }
+  }
+
+  // Settle on the kind of each column and bring the ranges to it.
+  vtkIdType numRows = 0;
+  std::vector<vtkIdType> offsets(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    offsets[i] = numRows;
+    numRows += chunks[i].Columns->NumberOfRecords;
+  }
+  for (int j = 0; j < numColumns; ++j)
+  {
+    kinds[j] = IntColumn;
+    for (const DelimitedTextChunk& chunk : chunks)
+    {
+      kinds[j] = std::max(kinds[j], chunk.Columns->Columns[j].GetFinalKind());
+    }
+    if (!this->DetectNumericColumns)
+    {
+      kinds[j] = StringColumn;
+    }
+    else if (kinds[j] == IntColumn && (this->ForceDouble || numRows == 0))
+    {
+      kinds[j] = DoubleColumn;
+    }
+  }
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      DelimitedTextChunk& chunk = chunks[i];
+      std::vector<int> stringKinds(numColumns, IgnoredColumn);
+      bool needStrings = false;
+      for (int j = 0; j < numColumns; ++j)
+      {
+        DelimitedTextColumns::Column& column = chunk.Columns->Columns[j];
+        if (kinds[j] == StringColumn && column.Kind != StringColumn)
+        {
+          stringKinds[j] = StringColumn;
+          needStrings = true;
+        }
+        else if (kinds[j] == DoubleColumn && column.Kind == IntColumn)
+        {
+          DelimitedTextColumns::ConvertToDouble(column, conversion.DefaultDoubleValue);
+        }
+      }
+      if (needStrings)
+      {
+        DelimitedTextColumns strings(conversion, stringKinds);
+        bool pending = chunk.StartEscapePending;
+        ParseRecords(
+          syntax, chunk.Begin, chunk.End, chunk.End == end, maxRecords, pending, strings);
+        for (int j = 0; j < numColumns; ++j)
+        {
+          if (stringKinds[j] == StringColumn)
+          {
+            chunk.Columns->Columns[j].Strings.swap(strings.Columns[j].Strings);
+          }
+        }
+      }
+    }
+  });
+
+  // Gather the ranges into the output columns.
+  std::vector<vtkSmartPointer<vtkAbstractArray> > arrays(numColumns);
+  for (int j = 0; j < numColumns; ++j)
+  {
+    if (kinds[j] == IntColumn)
+    {
+      arrays[j] = vtkSmartPointer<vtkIntArray>::New();
+    }
+    else if (kinds[j] == DoubleColumn)
+    {
+      arrays[j] = vtkSmartPointer<vtkDoubleArray>::New();
+    }
+    else
+    {
+      arrays[j] = vtkSmartPointer<vtkStringArray>::New();
+    }
+    arrays[j]->SetName(names[j].c_str());
+    arrays[j]->SetNumberOfTuples(numRows);
+  }
+  vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      for (int j = 0; j < numColumns; ++j)
+      {
+        DelimitedTextColumns::Column& column = chunks[i].Columns->Columns[j];
+        if (kinds[j] == IntColumn)
+        {
+          int* values = vtkArrayDownCast<vtkIntArray>(arrays[j])->GetPointer(offsets[i]);
+          std::copy(column.Ints.begin(), column.Ints.end(), values);
+        }
+        else if (kinds[j] == DoubleColumn)
+        {
+          double* values = vtkArrayDownCast<vtkDoubleArray>(arrays[j])->GetPointer(offsets[i]);
+          std::copy(column.Doubles.begin(), column.Doubles.end(), values);
+        }
+        else
+        {
+          vtkStdString* values =
+            vtkArrayDownCast<vtkStringArray>(arrays[j])->GetPointer(offsets[i]);
+          for (size_t k = 0; k < column.Strings.size(); ++k)
+          {
+            values[k].swap(column.Strings[k]);
+          }
+        }
+      }
+      chunks[i].Columns.reset();
+    }
+  });
+
+  for (int j = 0; j < numColumns; ++j)
+  {
+    output_table->AddColumn(arrays[j]);
+  }
+  return true;
+}
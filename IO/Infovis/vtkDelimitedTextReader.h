@@ -273,6 +273,22 @@ public:
   vtkGetMacro(DefaultDoubleValue, double);
   //@}
 
+  //@{
+  /**
+   * When set to true, UTF-8 and ASCII input is split into ranges of records
+   * that are parsed concurrently with vtkSMPTools, storing the values of
+   * numeric columns directly in typed arrays rather than converting a table
+   * of strings afterwards. The output is the same as with the serial parser,
+   * except that records with fewer fields than the first one are padded with
+   * empty values. Input the parallel parser does not handle (other character
+   * sets, non-ASCII delimiters, duplicate column names) is read serially.
+   * Default is off.
+   */
+  vtkSetMacro(UseParallelParser, bool);
+  vtkGetMacro(UseParallelParser, bool);
+  vtkBooleanMacro(UseParallelParser, bool);
+  //@}
+
   //@{
   /**
    * The name of the array for generating or assigning pedigree ids
@@ -338,6 +354,10 @@ protected:
   // Read the content of the input file.
   int ReadData(vtkTable* const output_table);
 
+  // Read UTF-8 input with the parallel parser. Returns false, leaving the
+  // output untouched, if the input must be read by the serial parser.
+  bool ReadDataInParallel(istream& input_stream, vtkTable* const output_table);
+
   char* FileName;
   vtkTypeBool ReadFromInputString;
   char* InputString;
@@ -364,6 +384,7 @@ protected:
   bool GeneratePedigreeIds;
   bool OutputPedigreeIds;
   bool AddTabFieldDelimiter;
+  bool UseParallelParser;
   vtkStdString LastError;
   vtkTypeUInt32 ReplacementCharacter;
 
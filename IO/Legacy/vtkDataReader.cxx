@@ -3198,6 +3198,13 @@ int vtkDataReader::ReadCells(vtkSmartPointer<vtkCellArray>& cellArray)
     return 0;
   }
 
+  // Honor compact 32-bit storage when it is the default, regardless of the
+  // type the arrays were written with.
+  if (!vtkCellArray::GetDefaultStorageIs64Bit())
+  {
+    cellArray->ConvertToSmallestStorage();
+  }
+
   return 1;
 }
 
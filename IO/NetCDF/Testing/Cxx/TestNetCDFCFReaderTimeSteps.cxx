@@ -0,0 +1,247 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNetCDFCFReaderTimeSteps.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write a small CF file with spherical coordinates and two time steps, and
+// check that vtkNetCDFCFReader reuses its points and cells between time steps,
+// builds them again when the coordinate settings change, and reads the same
+// pieces and values as a new reader.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkInformation.h"
+#include "vtkMath.h"
+#include "vtkNetCDFCFReader.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtk_netcdf.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const size_t NumberOfLevels = 4;
+const size_t NumberOfLatitudes = 15;
+const size_t NumberOfLongitudes = 20;
+const float FillValue = -999.0f;
+
+#define CHECK_NETCDF(call)                                                                         \
+  if ((call) != NC_NOERR)                                                                          \
+  {                                                                                                \
+    std::cerr << "netCDF error in " #call "\n";                                                    \
+    return false;                                                                                  \
+  }
+
+bool WriteFile(const std::string& fileName)
+{
+  int nc, timeDim, levDim, latDim, lonDim;
+  CHECK_NETCDF(nc_create(fileName.c_str(), NC_CLOBBER, &nc));
+  CHECK_NETCDF(nc_def_dim(nc, "time", NC_UNLIMITED, &timeDim));
+  CHECK_NETCDF(nc_def_dim(nc, "lev", NumberOfLevels, &levDim));
+  CHECK_NETCDF(nc_def_dim(nc, "lat", NumberOfLatitudes, &latDim));
+  CHECK_NETCDF(nc_def_dim(nc, "lon", NumberOfLongitudes, &lonDim));
+
+  int timeVar, levVar, latVar, lonVar, tempVar, presVar;
+  CHECK_NETCDF(nc_def_var(nc, "time", NC_DOUBLE, 1, &timeDim, &timeVar));
+  CHECK_NETCDF(nc_put_att_text(nc, timeVar, "units", 19, "days since 2000-1-1"));
+  CHECK_NETCDF(nc_def_var(nc, "lev", NC_DOUBLE, 1, &levDim, &levVar));
+  CHECK_NETCDF(nc_put_att_text(nc, levVar, "units", 2, "km"));
+  CHECK_NETCDF(nc_put_att_text(nc, levVar, "positive", 2, "up"));
+  CHECK_NETCDF(nc_def_var(nc, "lat", NC_DOUBLE, 1, &latDim, &latVar));
+  CHECK_NETCDF(nc_put_att_text(nc, latVar, "units", 13, "degrees_north"));
+  CHECK_NETCDF(nc_def_var(nc, "lon", NC_DOUBLE, 1, &lonDim, &lonVar));
+  CHECK_NETCDF(nc_put_att_text(nc, lonVar, "units", 12, "degrees_east"));
+  int dims[4] = { timeDim, levDim, latDim, lonDim };
+  CHECK_NETCDF(nc_def_var(nc, "temp", NC_FLOAT, 4, dims, &tempVar));
+  CHECK_NETCDF(nc_put_att_float(nc, tempVar, "_FillValue", NC_FLOAT, 1, &FillValue));
+  CHECK_NETCDF(nc_def_var(nc, "pres", NC_SHORT, 4, dims, &presVar));
+  const double scale = 0.5;
+  const double offset = 10.0;
+  CHECK_NETCDF(nc_put_att_double(nc, presVar, "scale_factor", NC_DOUBLE, 1, &scale));
+  CHECK_NETCDF(nc_put_att_double(nc, presVar, "add_offset", NC_DOUBLE, 1, &offset));
+  CHECK_NETCDF(nc_enddef(nc));
+
+  std::vector<double> levels = { 1.0, 2.0, 4.0, 8.0 };
+  std::vector<double> latitudes(NumberOfLatitudes);
+  std::vector<double> longitudes(NumberOfLongitudes);
+  for (size_t i = 0; i < NumberOfLatitudes; i++)
+  {
+    latitudes[i] = -70.0 + 10.0 * i;
+  }
+  for (size_t i = 0; i < NumberOfLongitudes; i++)
+  {
+    longitudes[i] = 18.0 * i;
+  }
+  CHECK_NETCDF(nc_put_var_double(nc, levVar, levels.data()));
+  CHECK_NETCDF(nc_put_var_double(nc, latVar, latitudes.data()));
+  CHECK_NETCDF(nc_put_var_double(nc, lonVar, longitudes.data()));
+
+  const size_t numValues = NumberOfLevels * NumberOfLatitudes * NumberOfLongitudes;
+  for (size_t step = 0; step < 2; step++)
+  {
+    const double time = static_cast<double>(step);
+    CHECK_NETCDF(nc_put_var1_double(nc, timeVar, &step, &time));
+    std::vector<float> temp(numValues);
+    std::vector<short> pres(numValues);
+    for (size_t i = 0; i < numValues; i++)
+    {
+      temp[i] = i % 17 == 0 ? FillValue : static_cast<float>(1000 * step + i);
+      pres[i] = static_cast<short>(i + step);
+    }
+    size_t start[4] = { step, 0, 0, 0 };
+    size_t count[4] = { 1, NumberOfLevels, NumberOfLatitudes, NumberOfLongitudes };
+    CHECK_NETCDF(nc_put_vara_float(nc, tempVar, start, count, temp.data()));
+    CHECK_NETCDF(nc_put_vara_short(nc, presVar, start, count, pres.data()));
+  }
+  CHECK_NETCDF(nc_close(nc));
+  return true;
+}
+
+void Update(vtkNetCDFCFReader* reader, double time, int piece = 0, int numberOfPieces = 1)
+{
+  reader->UpdateInformation();
+  vtkInformation* outInfo = reader->GetOutputInformation(0);
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), time);
+  reader->UpdatePiece(piece, numberOfPieces, 0);
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); c++)
+    {
+      double va = a->GetComponent(i, c);
+      double vb = b->GetComponent(i, c);
+      if (va != vb && !(vtkMath::IsNan(va) && vtkMath::IsNan(vb)))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPointSet* a, vtkPointSet* b)
+{
+  if (!SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()) ||
+    !SameArrays(a->GetCellData()->GetArray("temp"), b->GetCellData()->GetArray("temp")) ||
+    !SameArrays(a->GetCellData()->GetArray("pres"), b->GetCellData()->GetArray("pres")))
+  {
+    return false;
+  }
+  vtkUnstructuredGrid* gridA = vtkUnstructuredGrid::SafeDownCast(a);
+  vtkUnstructuredGrid* gridB = vtkUnstructuredGrid::SafeDownCast(b);
+  return !gridA ||
+    (SameArrays(gridA->GetCellTypesArray(), gridB->GetCellTypesArray()) &&
+      SameArrays(
+        gridA->GetCells()->GetConnectivityArray(), gridB->GetCells()->GetConnectivityArray()));
+}
+
+bool TestOutputType(const std::string& fileName, int outputType)
+{
+  vtkNew<vtkNetCDFCFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetOutputType(outputType);
+  reader->SetReplaceFillValueWithNan(1);
+  reader->UpdateInformation();
+  reader->SetVariableArrayStatus("temp", 1);
+  reader->SetVariableArrayStatus("pres", 1);
+
+  Update(reader, 0.0);
+  vtkPointSet* output = vtkPointSet::SafeDownCast(reader->GetOutputDataObject(0));
+  vtkDataArray* temp = output ? output->GetCellData()->GetArray("temp") : nullptr;
+  vtkDataArray* pres = output ? output->GetCellData()->GetArray("pres") : nullptr;
+  if (!temp || !pres || temp->GetDataType() != VTK_FLOAT || pres->GetRange()[0] != 10.0)
+  {
+    std::cerr << "Unexpected output for type " << outputType << ".\n";
+    return false;
+  }
+  vtkSmartPointer<vtkPoints> points = output->GetPoints();
+
+  // The points do not depend on the time step.
+  Update(reader, 1.0);
+  output = vtkPointSet::SafeDownCast(reader->GetOutputDataObject(0));
+  if (output->GetPoints() != points)
+  {
+    std::cerr << "The points were built again for another time step.\n";
+    return false;
+  }
+  vtkNew<vtkNetCDFCFReader> newReader;
+  newReader->SetFileName(fileName.c_str());
+  newReader->SetOutputType(outputType);
+  newReader->SetReplaceFillValueWithNan(1);
+  newReader->UpdateInformation();
+  newReader->SetVariableArrayStatus("temp", 1);
+  newReader->SetVariableArrayStatus("pres", 1);
+  Update(newReader, 1.0);
+  if (!SameOutput(output, vtkPointSet::SafeDownCast(newReader->GetOutputDataObject(0))))
+  {
+    std::cerr << "The second time step differs from the one of a new reader.\n";
+    return false;
+  }
+
+  // They do depend on the vertical bias and on the piece.
+  reader->SetVerticalBias(5.0);
+  newReader->SetVerticalBias(5.0);
+  for (int piece = 0; piece < 2; piece++)
+  {
+    Update(reader, 1.0, piece, 2);
+    Update(newReader, 1.0, piece, 2);
+    output = vtkPointSet::SafeDownCast(reader->GetOutputDataObject(0));
+    if (!SameOutput(output, vtkPointSet::SafeDownCast(newReader->GetOutputDataObject(0))))
+    {
+      std::cerr << "Piece " << piece << " differs from the one of a new reader.\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestNetCDFCFReaderTimeSteps(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(tempDir) + "/TestNetCDFCFReaderTimeSteps.nc";
+  delete[] tempDir;
+
+  if (!WriteFile(fileName) || !TestOutputType(fileName, VTK_STRUCTURED_GRID) ||
+    !TestOutputType(fileName, VTK_UNSTRUCTURED_GRID))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -71,6 +71,8 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkDataArraySelection.h"
 #include "vtkDataObject.h"
 #include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleVectorKey.h"
 #include "vtkInformationVector.h"
@@ -79,15 +81,19 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkToolkits.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include "vtk_netcdf.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cfloat>
 #include <cmath>
 #include <cstdarg>
@@ -267,6 +273,10 @@ public:
   // Set of dimensions currently used by the selected arrays:
   vtkNew<vtkStringArray> extraDims;
   vtkTimeStamp extraDimTime;
+  // Points and cells of the last grid built, reused for the other time steps
+  // until the reader is modified:
+  vtkSmartPointer<vtkUnstructuredGrid> grid;
+  vtkTimeStamp gridTime;
 };
 
 bool vtkMPASReader::Internal::isExtraDim(const std::string& name)
@@ -1027,6 +1037,7 @@ vtkMPASReader::~vtkMPASReader()
 //----------------------------------------------------------------------------
 void vtkMPASReader::ReleaseNcData()
 {
+  this->Internals->grid = nullptr;
   this->Internals->pointVars.clear();
   this->Internals->pointArrays.clear();
   this->Internals->cellVars.clear();
@@ -1160,11 +1171,29 @@ int vtkMPASReader::RequestData(vtkInformation* vtkNotUsed(reqInfo),
   vtkUnstructuredGrid* output =
     vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  this->DestroyData();
-  if (!this->ReadAndOutputGrid())
+  // The grid does not depend on the time step, so it is only built again
+  // when the reader is modified.
+  this->Internals->cellArrays.clear();
+  this->Internals->pointArrays.clear();
+  vtkUnstructuredGrid* grid = this->Internals->grid;
+  if (grid && this->Internals->gridTime.GetMTime() > this->GetMTime())
+  {
+    output->SetPoints(grid->GetPoints());
+    output->SetCells(grid->GetCellTypesArray(), grid->GetCells());
+  }
+  else
   {
+    this->Internals->grid = nullptr;
     this->DestroyData();
-    return 0;
+    if (!this->ReadAndOutputGrid())
+    {
+      this->DestroyData();
+      return 0;
+    }
+    this->Internals->grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    this->Internals->grid->SetPoints(output->GetPoints());
+    this->Internals->grid->SetCells(output->GetCellTypesArray(), output->GetCells());
+    this->Internals->gridTime.Modified();
   }
 
   // Collect the time step requested
@@ -2237,39 +2266,48 @@ void vtkMPASReader::OutputPoints()
                                                      : static_cast<double>(this->LayerThickness);
 
   vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  points->Allocate(this->MaximumPoints);
   output->SetPoints(points);
 
-  for (size_t j = 0; j < this->CurrentExtraPoint; j++)
+  if (this->Geometry != vtkMPASReader::Planar && this->Geometry != vtkMPASReader::Spherical &&
+    this->Geometry != vtkMPASReader::Projected)
   {
-    double x, y, z;
+    vtkErrorMacro("Unrecognized geometry type (" << this->Geometry << ").");
+    return;
+  }
 
-    switch (this->Geometry)
-    {
-      case vtkMPASReader::Planar:
-      case vtkMPASReader::Spherical:
-        x = this->PointX[j];
-        y = this->PointY[j];
-        z = this->PointZ[j];
-        break;
+  // Each column of points is independent, so they are computed in parallel.
+  const size_t pointsPerColumn = this->ShowMultilayerView ? this->MaximumNVertLevels + 1 : 1;
+  points->SetNumberOfPoints(static_cast<vtkIdType>(this->CurrentExtraPoint * pointsPerColumn));
+  float* coords = vtkFloatArray::SafeDownCast(points->GetData())->GetPointer(0);
+  std::atomic<bool> layerFailed(false);
 
-      case vtkMPASReader::Projected:
+  const vtkIdType numColumns = static_cast<vtkIdType>(this->CurrentExtraPoint);
+  vtkSMPTools::For(0, numColumns, [&](vtkIdType first, vtkIdType last) {
+    for (size_t j = static_cast<size_t>(first); j < static_cast<size_t>(last); j++)
+    {
+      double x, y, z;
+      if (this->Geometry == vtkMPASReader::Projected)
+      {
         x = this->PointX[j] * 180.0 / vtkMath::Pi();
         y = this->PointY[j] * 180.0 / vtkMath::Pi();
         z = 0.0;
-        break;
+      }
+      else
+      {
+        x = this->PointX[j];
+        y = this->PointY[j];
+        z = this->PointZ[j];
+      }
 
-      default:
-        vtkErrorMacro("Unrecognized geometry type (" << this->Geometry << ").");
-        return;
-    }
+      float* point = coords + 3 * j * pointsPerColumn;
+      if (!this->ShowMultilayerView)
+      {
+        point[0] = static_cast<float>(x);
+        point[1] = static_cast<float>(y);
+        point[2] = static_cast<float>(z);
+        continue;
+      }
 
-    if (!this->ShowMultilayerView)
-    {
-      points->InsertNextPoint(x, y, z);
-    }
-    else
-    {
       double rho = 0.0, rholevel = 0.0, theta = 0.0, phi = 0.0;
       int retval = -1;
 
@@ -2280,7 +2318,7 @@ void vtkMPASReader::OutputPoints()
           retval = CartesianToSpherical(x, y, z, &rho, &phi, &theta);
           if (retval)
           {
-            vtkWarningMacro("Can't create point for layered view.");
+            layerFailed = true;
           }
         }
       }
@@ -2295,7 +2333,7 @@ void vtkMPASReader::OutputPoints()
             retval = SphericalToCartesian(rholevel, phi, theta, &x, &y, &z);
             if (retval)
             {
-              vtkWarningMacro("Can't create point for layered view.");
+              layerFailed = true;
             }
           }
         }
@@ -2303,9 +2341,16 @@ void vtkMPASReader::OutputPoints()
         {
           z = levelNum * -adjustedLayerThickness;
         }
-        points->InsertNextPoint(x, y, z);
+        point[3 * levelNum] = static_cast<float>(x);
+        point[3 * levelNum + 1] = static_cast<float>(y);
+        point[3 * levelNum + 2] = static_cast<float>(z);
       }
     }
+  });
+
+  if (layerFailed)
+  {
+    vtkWarningMacro("Can't create point for layered view.");
   }
 
   if (this->PointX)
@@ -2371,10 +2416,7 @@ void vtkMPASReader::OutputCells()
   vtkDebugMacro(<< "In OutputCells..." << endl);
   vtkUnstructuredGrid* output = GetOutput();
 
-  output->Allocate(this->MaximumCells, this->MaximumCells);
-
   int cellType = GetCellType();
-  size_t val;
 
   size_t pointsPerPolygon;
   if (this->ShowMultilayerView)
@@ -2391,105 +2433,107 @@ void vtkMPASReader::OutputCells()
                 << " LayerThickness: " << LayerThickness << " ProjectLatLon: " << ProjectLatLon
                 << " ShowMultilayerView: " << ShowMultilayerView);
 
-  std::vector<vtkIdType> polygon(pointsPerPolygon);
-
-  for (size_t j = 0; j < this->CurrentExtraCell; j++)
-  {
-
-    int* conns;
-    if (this->Geometry == Projected)
-    {
-      conns = this->ModConnections + (j * this->PointsPerCell);
-    }
-    else
-    {
-      conns = this->OrigConnections + (j * this->PointsPerCell);
-    }
-
-    int minLevel = 0;
-
-    if (this->IncludeTopography)
-    {
-      int* connections;
-
-      // check if it is a mirror cell, if so, get original
-      if (static_cast<size_t>(j) >= this->NumberOfCells + this->CellOffset)
+  // All cells have the same size, so the connectivity of each column of cells
+  // is written in parallel at a known offset.
+  const size_t cellsPerColumn = this->ShowMultilayerView ? this->MaximumNVertLevels : 1;
+  const vtkIdType numCells = static_cast<vtkIdType>(this->CurrentExtraCell * cellsPerColumn);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfTuples(numCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfTuples(numCells * static_cast<vtkIdType>(pointsPerPolygon));
+  vtkIdType* offsetPtr = offsets->GetPointer(0);
+  vtkIdType* connPtr = connectivity->GetPointer(0);
+  const int verticalLevel = this->GetVerticalLevel();
+
+  const vtkIdType numColumns = static_cast<vtkIdType>(this->CurrentExtraCell);
+  vtkSMPTools::For(0, numColumns, [&](vtkIdType first, vtkIdType last) {
+    for (size_t j = static_cast<size_t>(first); j < static_cast<size_t>(last); j++)
+    {
+      int* conns;
+      if (this->Geometry == Projected)
       {
-        size_t origCellNum = *(this->CellMap + (j - this->NumberOfCells - this->CellOffset));
-        connections = this->OrigConnections + (origCellNum * this->PointsPerCell);
+        conns = this->ModConnections + (j * this->PointsPerCell);
       }
       else
       {
-        connections = this->OrigConnections + (j * this->PointsPerCell);
+        conns = this->OrigConnections + (j * this->PointsPerCell);
       }
 
-      minLevel = this->MaximumLevelPoint[connections[0]];
+      int minLevel = 0;
 
-      // Take the min of the this->MaximumLevelPoint of each point
-      for (size_t k = 1; k < this->PointsPerCell; k++)
+      if (this->IncludeTopography)
       {
-        minLevel = std::min(minLevel, this->MaximumLevelPoint[connections[k]]);
-      }
-    }
+        int* connections;
 
-    // singlelayer
-    if (!this->ShowMultilayerView)
-    {
-      // If that min is greater than or equal to this output level,
-      // include the cell, otherwise set all points to zero.
+        // check if it is a mirror cell, if so, get original
+        if (static_cast<size_t>(j) >= this->NumberOfCells + this->CellOffset)
+        {
+          size_t origCellNum = *(this->CellMap + (j - this->NumberOfCells - this->CellOffset));
+          connections = this->OrigConnections + (origCellNum * this->PointsPerCell);
+        }
+        else
+        {
+          connections = this->OrigConnections + (j * this->PointsPerCell);
+        }
 
-      if (this->IncludeTopography && ((minLevel - 1) < this->GetVerticalLevel()))
-      {
-        // cerr << "Setting all points to zero" << endl;
-        val = 0;
-        for (size_t k = 0; k < this->PointsPerCell; k++)
+        minLevel = this->MaximumLevelPoint[connections[0]];
+
+        // Take the min of the this->MaximumLevelPoint of each point
+        for (size_t k = 1; k < this->PointsPerCell; k++)
         {
-          polygon[k] = static_cast<vtkIdType>(val);
+          minLevel = std::min(minLevel, this->MaximumLevelPoint[connections[k]]);
         }
       }
-      else
+
+      for (size_t c = j * cellsPerColumn; c < (j + 1) * cellsPerColumn; c++)
       {
-        for (size_t k = 0; k < this->PointsPerCell; k++)
-        {
-          polygon[k] = conns[k];
-        }
+        offsetPtr[c] = static_cast<vtkIdType>(c * pointsPerPolygon);
       }
-      output->InsertNextCell(cellType, static_cast<vtkIdType>(pointsPerPolygon), &polygon[0]);
-    }
-    else
-    { // multilayer
-      // for each level, write the cell
-      for (size_t levelNum = 0; levelNum < this->MaximumNVertLevels; levelNum++)
+      vtkIdType* polygon = connPtr + j * cellsPerColumn * pointsPerPolygon;
+
+      // singlelayer
+      if (!this->ShowMultilayerView)
       {
-        if (this->IncludeTopography && (static_cast<size_t>(minLevel - 1) < levelNum))
+        // If that min is greater than or equal to this output level,
+        // include the cell, otherwise set all points to zero.
+        if (this->IncludeTopography && ((minLevel - 1) < verticalLevel))
         {
-          // setting all points to zero
-          val = 0;
-          for (size_t k = 0; k < pointsPerPolygon; k++)
-          {
-            polygon[k] = static_cast<vtkIdType>(val);
-          }
+          std::fill(polygon, polygon + this->PointsPerCell, 0);
         }
         else
         {
-          for (size_t k = 0; k < this->PointsPerCell; k++)
+          std::copy(conns, conns + this->PointsPerCell, polygon);
+        }
+      }
+      else
+      { // multilayer
+        // for each level, write the cell
+        for (size_t levelNum = 0; levelNum < this->MaximumNVertLevels; levelNum++)
+        {
+          if (this->IncludeTopography && (static_cast<size_t>(minLevel - 1) < levelNum))
           {
-            val = (conns[k] * (this->MaximumNVertLevels + 1)) + levelNum;
-            polygon[k] = static_cast<vtkIdType>(val);
+            // setting all points to zero
+            std::fill(polygon, polygon + pointsPerPolygon, 0);
           }
-
-          for (size_t k = 0; k < this->PointsPerCell; k++)
+          else
           {
-            val = (conns[k] * (this->MaximumNVertLevels + 1)) + levelNum + 1;
-            polygon[k + this->PointsPerCell] = static_cast<vtkIdType>(val);
+            for (size_t k = 0; k < this->PointsPerCell; k++)
+            {
+              size_t val = (conns[k] * (this->MaximumNVertLevels + 1)) + levelNum;
+              polygon[k] = static_cast<vtkIdType>(val);
+              polygon[k + this->PointsPerCell] = static_cast<vtkIdType>(val + 1);
+            }
           }
+          polygon += pointsPerPolygon;
         }
-        // vtkDebugMacro
-        //("InsertingCell j: " << j << " level: " << levelNum << endl);
-        output->InsertNextCell(cellType, static_cast<vtkIdType>(pointsPerPolygon), &polygon[0]);
       }
     }
-  }
+  });
+  offsetPtr[numCells] = numCells * static_cast<vtkIdType>(pointsPerPolygon);
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  output->SetCells(cellType, cells);
 
   delete[] this->ModConnections;
   this->ModConnections = nullptr;
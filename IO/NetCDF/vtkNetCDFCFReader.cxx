@@ -36,10 +36,12 @@
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include "vtkSmartPointer.h"
@@ -704,6 +706,51 @@ public:
   std::vector<vtkNetCDFCFReader::vtkDependentDimensionInfo> v;
 };
 
+//-----------------------------------------------------------------------------
+class vtkNetCDFCFReader::vtkGeometryCache
+{
+public:
+  int DataType = -1;
+  int Extent[6];
+  std::vector<int> Dimensions;
+  vtkTypeBool SphericalCoordinates = 0;
+  double VerticalScale = 1.0;
+  double VerticalBias = 0.0;
+  vtkMTimeType MetaDataTime = 0;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkUnsignedCharArray> CellTypes;
+  vtkSmartPointer<vtkCellArray> Cells;
+
+  bool Matches(vtkNetCDFCFReader* reader, int dataType, const int extent[6]) const
+  {
+    vtkIntArray* dimensions = reader->LoadingDimensions;
+    return this->Points && this->DataType == dataType &&
+      std::equal(extent, extent + 6, this->Extent) &&
+      this->Dimensions.size() == static_cast<size_t>(dimensions->GetNumberOfTuples()) &&
+      std::equal(this->Dimensions.begin(), this->Dimensions.end(), dimensions->GetPointer(0)) &&
+      this->SphericalCoordinates == reader->SphericalCoordinates &&
+      this->VerticalScale == reader->VerticalScale && this->VerticalBias == reader->VerticalBias &&
+      this->MetaDataTime == reader->MetaDataMTime.GetMTime();
+  }
+
+  void Store(vtkNetCDFCFReader* reader, int dataType, const int extent[6], vtkPoints* points,
+    vtkUnsignedCharArray* cellTypes = nullptr, vtkCellArray* cells = nullptr)
+  {
+    vtkIntArray* dimensions = reader->LoadingDimensions;
+    this->DataType = dataType;
+    std::copy(extent, extent + 6, this->Extent);
+    this->Dimensions.assign(
+      dimensions->GetPointer(0), dimensions->GetPointer(0) + dimensions->GetNumberOfTuples());
+    this->SphericalCoordinates = reader->SphericalCoordinates;
+    this->VerticalScale = reader->VerticalScale;
+    this->VerticalBias = reader->VerticalBias;
+    this->MetaDataTime = reader->MetaDataMTime.GetMTime();
+    this->Points = points;
+    this->CellTypes = cellTypes;
+    this->Cells = cells;
+  }
+};
+
 //=============================================================================
 vtkStandardNewMacro(vtkNetCDFCFReader);
 
@@ -717,12 +764,14 @@ vtkNetCDFCFReader::vtkNetCDFCFReader()
 
   this->DimensionInfo = new vtkDimensionInfoVector;
   this->DependentDimensionInfo = new vtkDependentDimensionInfoVector;
+  this->GeometryCache = new vtkGeometryCache;
 }
 
 vtkNetCDFCFReader::~vtkNetCDFCFReader()
 {
   delete this->DimensionInfo;
   delete this->DependentDimensionInfo;
+  delete this->GeometryCache;
 }
 
 void vtkNetCDFCFReader::PrintSelf(ostream& os, vtkIndent indent)
@@ -1068,32 +1117,43 @@ int vtkNetCDFCFReader::RequestData(
   vtkStructuredGrid* structuredOutput = vtkStructuredGrid::GetData(outputVector);
   if (structuredOutput)
   {
-    switch (this->CoordinateType(this->LoadingDimensions))
+    int extent[6];
+    structuredOutput->GetExtent(extent);
+    if (this->GeometryCache->Matches(this, VTK_STRUCTURED_GRID, extent))
     {
-      case COORDS_UNIFORM_RECTILINEAR:
-      case COORDS_NONUNIFORM_RECTILINEAR:
-        this->Add1DRectilinearCoordinates(structuredOutput);
-        break;
-      case COORDS_REGULAR_SPHERICAL:
-        this->Add1DSphericalCoordinates(structuredOutput);
-        break;
-      case COORDS_2D_EUCLIDEAN:
-      case COORDS_EUCLIDEAN_4SIDED_CELLS:
-        this->Add2DRectilinearCoordinates(structuredOutput);
-        break;
-      case COORDS_2D_SPHERICAL:
-      case COORDS_SPHERICAL_4SIDED_CELLS:
-        this->Add2DSphericalCoordinates(structuredOutput);
-        break;
-      case COORDS_EUCLIDEAN_PSIDED_CELLS:
-      case COORDS_SPHERICAL_PSIDED_CELLS:
-        // There is no sensible way to store p-sided cells in a structured grid.
-        // Just fake some coordinates (ParaView bug #11543).
-        this->FakeStructuredCoordinates(structuredOutput);
-        break;
-      default:
-        vtkErrorMacro("Internal error: unknown coordinate type.");
-        return 0;
+      structuredOutput->SetPoints(this->GeometryCache->Points);
+    }
+    else
+    {
+      switch (this->CoordinateType(this->LoadingDimensions))
+      {
+        case COORDS_UNIFORM_RECTILINEAR:
+        case COORDS_NONUNIFORM_RECTILINEAR:
+          this->Add1DRectilinearCoordinates(structuredOutput);
+          break;
+        case COORDS_REGULAR_SPHERICAL:
+          this->Add1DSphericalCoordinates(structuredOutput);
+          break;
+        case COORDS_2D_EUCLIDEAN:
+        case COORDS_EUCLIDEAN_4SIDED_CELLS:
+          this->Add2DRectilinearCoordinates(structuredOutput);
+          break;
+        case COORDS_2D_SPHERICAL:
+        case COORDS_SPHERICAL_4SIDED_CELLS:
+          this->Add2DSphericalCoordinates(structuredOutput);
+          break;
+        case COORDS_EUCLIDEAN_PSIDED_CELLS:
+        case COORDS_SPHERICAL_PSIDED_CELLS:
+          // There is no sensible way to store p-sided cells in a structured grid.
+          // Just fake some coordinates (ParaView bug #11543).
+          this->FakeStructuredCoordinates(structuredOutput);
+          break;
+        default:
+          vtkErrorMacro("Internal error: unknown coordinate type.");
+          return 0;
+      }
+      this->GeometryCache->Store(
+        this, VTK_STRUCTURED_GRID, extent, structuredOutput->GetPoints());
     }
   }
 
@@ -1103,32 +1163,43 @@ int vtkNetCDFCFReader::RequestData(
     int extent[6];
     this->GetUpdateExtentForOutput(unstructuredOutput, extent);
 
-    switch (this->CoordinateType(this->LoadingDimensions))
+    if (this->GeometryCache->Matches(this, VTK_UNSTRUCTURED_GRID, extent))
     {
-      case COORDS_UNIFORM_RECTILINEAR:
-      case COORDS_NONUNIFORM_RECTILINEAR:
-        this->Add1DRectilinearCoordinates(unstructuredOutput, extent);
-        break;
-      case COORDS_REGULAR_SPHERICAL:
-        this->Add1DSphericalCoordinates(unstructuredOutput, extent);
-        break;
-      case COORDS_2D_EUCLIDEAN:
-      case COORDS_EUCLIDEAN_4SIDED_CELLS:
-        this->Add2DRectilinearCoordinates(unstructuredOutput, extent);
-        break;
-      case COORDS_2D_SPHERICAL:
-      case COORDS_SPHERICAL_4SIDED_CELLS:
-        this->Add2DSphericalCoordinates(unstructuredOutput, extent);
-        break;
-      case COORDS_EUCLIDEAN_PSIDED_CELLS:
-        this->AddUnstructuredRectilinearCoordinates(unstructuredOutput, extent);
-        break;
-      case COORDS_SPHERICAL_PSIDED_CELLS:
-        this->AddUnstructuredSphericalCoordinates(unstructuredOutput, extent);
-        break;
-      default:
-        vtkErrorMacro("Internal error: unknown coordinate type.");
-        return 0;
+      unstructuredOutput->SetPoints(this->GeometryCache->Points);
+      unstructuredOutput->SetCells(this->GeometryCache->CellTypes, this->GeometryCache->Cells);
+    }
+    else
+    {
+      switch (this->CoordinateType(this->LoadingDimensions))
+      {
+        case COORDS_UNIFORM_RECTILINEAR:
+        case COORDS_NONUNIFORM_RECTILINEAR:
+          this->Add1DRectilinearCoordinates(unstructuredOutput, extent);
+          break;
+        case COORDS_REGULAR_SPHERICAL:
+          this->Add1DSphericalCoordinates(unstructuredOutput, extent);
+          break;
+        case COORDS_2D_EUCLIDEAN:
+        case COORDS_EUCLIDEAN_4SIDED_CELLS:
+          this->Add2DRectilinearCoordinates(unstructuredOutput, extent);
+          break;
+        case COORDS_2D_SPHERICAL:
+        case COORDS_SPHERICAL_4SIDED_CELLS:
+          this->Add2DSphericalCoordinates(unstructuredOutput, extent);
+          break;
+        case COORDS_EUCLIDEAN_PSIDED_CELLS:
+          this->AddUnstructuredRectilinearCoordinates(unstructuredOutput, extent);
+          break;
+        case COORDS_SPHERICAL_PSIDED_CELLS:
+          this->AddUnstructuredSphericalCoordinates(unstructuredOutput, extent);
+          break;
+        default:
+          vtkErrorMacro("Internal error: unknown coordinate type.");
+          return 0;
+      }
+      this->GeometryCache->Store(this, VTK_UNSTRUCTURED_GRID, extent,
+        unstructuredOutput->GetPoints(), unstructuredOutput->GetCellTypesArray(),
+        unstructuredOutput->GetCells());
     }
   }
 
@@ -1449,8 +1520,6 @@ void vtkNetCDFCFReader::Add2DRectilinearCoordinates(
 void vtkNetCDFCFReader::Add1DSphericalCoordinates(vtkPoints* points, const int extent[6])
 {
   points->SetDataTypeToDouble();
-  points->Allocate(
-    (extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1));
 
   vtkDoubleArray* coordArrays[3];
   for (vtkIdType i = 0; i < this->LoadingDimensions->GetNumberOfTuples(); i++)
@@ -1491,12 +1560,21 @@ void vtkNetCDFCFReader::Add1DSphericalCoordinates(vtkPoints* points, const int e
     }
   }
 
-  int ijk[3];
-  for (ijk[0] = extent[4]; ijk[0] <= extent[5]; ijk[0]++)
-  {
-    for (ijk[1] = extent[2]; ijk[1] <= extent[3]; ijk[1]++)
+  points->SetNumberOfPoints(
+    (extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1));
+
+  // Each row of points is projected independently.
+  const vtkIdType rowLength = extent[1] - extent[0] + 1;
+  const vtkIdType numRows = extent[3] - extent[2] + 1;
+  double* pointData = vtkDoubleArray::SafeDownCast(points->GetData())->GetPointer(0);
+  vtkSMPTools::For(0, numRows * (extent[5] - extent[4] + 1), [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType row = first; row < last; row++)
     {
-      for (ijk[2] = extent[0]; ijk[2] <= extent[1]; ijk[2]++)
+      int ijk[3];
+      ijk[0] = extent[4] + static_cast<int>(row / numRows);
+      ijk[1] = extent[2] + static_cast<int>(row % numRows);
+      double* cartesianCoord = pointData + 3 * row * rowLength;
+      for (ijk[2] = extent[0]; ijk[2] <= extent[1]; ijk[2]++, cartesianCoord += 3)
       {
         double lon, lat, h;
         if (verticalDim >= 0)
@@ -1515,22 +1593,18 @@ void vtkNetCDFCFReader::Add1DSphericalCoordinates(vtkPoints* points, const int e
         lat = vtkMath::RadiansFromDegrees(lat);
         h = h * vertScale + vertBias;
 
-        double cartesianCoord[3];
         cartesianCoord[0] = h * cos(lon) * cos(lat);
         cartesianCoord[1] = h * sin(lon) * cos(lat);
         cartesianCoord[2] = h * sin(lat);
-        points->InsertNextPoint(cartesianCoord);
       }
     }
-  }
+  });
 }
 
 //-----------------------------------------------------------------------------
 void vtkNetCDFCFReader::Add2DSphericalCoordinates(vtkPoints* points, const int extent[6])
 {
   points->SetDataTypeToDouble();
-  points->Allocate(
-    (extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1));
 
   vtkDependentDimensionInfo* info = this->FindDependentDimensionInfo(this->LoadingDimensions);
 
@@ -1572,34 +1646,41 @@ void vtkNetCDFCFReader::Add2DSphericalCoordinates(vtkPoints* points, const int e
     }
   }
 
-  for (int k = extent[4]; k <= extent[5]; k++)
-  {
-    double h;
-    if (verticalCoordinates)
-    {
-      h = verticalCoordinates->GetValue(k) * vertScale + vertBias;
-    }
-    else
-    {
-      h = vertScale + vertBias;
-    }
-    for (int j = extent[2]; j <= extent[3]; j++)
-    {
-      for (int i = extent[0]; i <= extent[1]; i++)
+  points->SetNumberOfPoints(
+    (extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1));
+
+  // Each row of points is projected independently.
+  const vtkIdType rowLength = extent[1] - extent[0] + 1;
+  const vtkIdType numRows = extent[3] - extent[2] + 1;
+  double* pointData = vtkDoubleArray::SafeDownCast(points->GetData())->GetPointer(0);
+  vtkSMPTools::For(0, numRows * (extent[5] - extent[4] + 1), [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType row = first; row < last; row++)
+    {
+      const int k = extent[4] + static_cast<int>(row / numRows);
+      const int j = extent[2] + static_cast<int>(row % numRows);
+      double h;
+      if (verticalCoordinates)
+      {
+        h = verticalCoordinates->GetValue(k) * vertScale + vertBias;
+      }
+      else
+      {
+        h = vertScale + vertBias;
+      }
+      double* cartesianCoord = pointData + 3 * row * rowLength;
+      for (int i = extent[0]; i <= extent[1]; i++, cartesianCoord += 3)
       {
         double lon = longitudeCoordinates->GetComponent(j, i);
         double lat = latitudeCoordinates->GetComponent(j, i);
         lon = vtkMath::RadiansFromDegrees(lon);
         lat = vtkMath::RadiansFromDegrees(lat);
 
-        double cartesianCoord[3];
         cartesianCoord[0] = h * cos(lon) * cos(lat);
         cartesianCoord[1] = h * sin(lon) * cos(lat);
         cartesianCoord[2] = h * sin(lat);
-        points->InsertNextPoint(cartesianCoord);
       }
     }
-  }
+  });
 }
 
 //-----------------------------------------------------------------------------
@@ -1796,19 +1877,20 @@ void vtkNetCDFCFReader::AddUnstructuredSphericalCoordinates(
 
   vtkPoints* points = unstructuredOutput->GetPoints();
   vtkIdType numPoints = points->GetNumberOfPoints();
-  for (vtkIdType pointId = 0; pointId < numPoints; pointId++)
-  {
-    double lonLat[3];
-    points->GetPoint(pointId, lonLat);
-    double lon = vtkMath::RadiansFromDegrees(lonLat[0]);
-    double lat = vtkMath::RadiansFromDegrees(lonLat[1]);
+  double* pointData = vtkDoubleArray::SafeDownCast(points->GetData())->GetPointer(0);
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType pointId = first; pointId < last; pointId++)
+    {
+      double* coord = pointData + 3 * pointId;
+      double lon = vtkMath::RadiansFromDegrees(coord[0]);
+      double lat = vtkMath::RadiansFromDegrees(coord[1]);
 
-    double cartesianCoord[3];
-    cartesianCoord[0] = height * cos(lon) * cos(lat);
-    cartesianCoord[1] = height * sin(lon) * cos(lat);
-    cartesianCoord[2] = height * sin(lat);
-    points->SetPoint(pointId, cartesianCoord);
-  }
+      coord[0] = height * cos(lon) * cos(lat);
+      coord[1] = height * sin(lon) * cos(lat);
+      coord[2] = height * sin(lat);
+    }
+  });
+  points->Modified();
 }
 
 //-----------------------------------------------------------------------------
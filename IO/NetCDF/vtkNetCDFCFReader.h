@@ -302,6 +302,15 @@ protected:
     vtkUnstructuredGrid* unstructuredOutput, const int extent[6]);
   //@}
 
+  /**
+   * Points and cells built for the last structured or unstructured output.
+   * They do not depend on the time step, so they are reused while the
+   * dimensions, extent, and coordinate settings they were built for do not
+   * change.
+   */
+  class vtkGeometryCache;
+  vtkGeometryCache* GeometryCache;
+
 private:
   vtkNetCDFCFReader(const vtkNetCDFCFReader&) = delete;
   void operator=(const vtkNetCDFCFReader&) = delete;
@@ -34,6 +34,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStructuredGrid.h"
@@ -98,6 +99,17 @@ static int NetCDFTypeToVTKType(nc_type type)
   }
 }
 
+//-----------------------------------------------------------------------------
+// Replaces the fill value of a variable with NaN, in parallel since variables
+// can be large.
+template <typename T>
+static void ReplaceFillValue(T* values, vtkIdType numValues, T fillValue, T nan)
+{
+  vtkSMPTools::For(0, numValues, [&](vtkIdType first, vtkIdType last) {
+    std::replace(values + first, values + last, fillValue, nan);
+  });
+}
+
 //=============================================================================
 vtkStandardNewMacro(vtkNetCDFReader);
 
@@ -862,17 +874,15 @@ int vtkNetCDFReader::LoadVariable(int ncFD, const char* varName, double time, vt
       {
         float fillValue;
         nc_get_att_float(ncFD, varId, "_FillValue", &fillValue);
-        std::replace(reinterpret_cast<float*>(dataArray->GetVoidPointer(0)),
-          reinterpret_cast<float*>(dataArray->GetVoidPointer(dataArray->GetNumberOfTuples())),
-          fillValue, static_cast<float>(vtkMath::Nan()));
+        ReplaceFillValue(static_cast<float*>(dataArray->GetVoidPointer(0)), arraySize, fillValue,
+          static_cast<float>(vtkMath::Nan()));
       }
       else if (dataArray->GetDataType() == VTK_DOUBLE)
       {
         double fillValue;
         nc_get_att_double(ncFD, varId, "_FillValue", &fillValue);
-        std::replace(reinterpret_cast<double*>(dataArray->GetVoidPointer(0)),
-          reinterpret_cast<double*>(dataArray->GetVoidPointer(dataArray->GetNumberOfTuples())),
-          fillValue, vtkMath::Nan());
+        ReplaceFillValue(static_cast<double*>(dataArray->GetVoidPointer(0)), arraySize, fillValue,
+          vtkMath::Nan());
       }
       else
       {
@@ -899,10 +909,14 @@ int vtkNetCDFReader::LoadVariable(int ncFD, const char* varName, double time, vt
     VTK_CREATE(vtkDoubleArray, adjustedArray);
     adjustedArray->SetNumberOfComponents(1);
     adjustedArray->SetNumberOfTuples(arraySize);
-    for (vtkIdType i = 0; i < arraySize; i++)
-    {
-      adjustedArray->SetValue(i, dataArray->GetTuple1(i) * scale + offset);
-    }
+    double* adjusted = adjustedArray->GetPointer(0);
+    vtkDataArray* rawArray = dataArray;
+    vtkSMPTools::For(0, arraySize, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType i = first; i < last; i++)
+      {
+        adjusted[i] = rawArray->GetComponent(i, 0) * scale + offset;
+      }
+    });
     dataArray = adjustedArray;
   }
 
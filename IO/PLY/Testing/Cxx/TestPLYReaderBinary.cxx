@@ -0,0 +1,226 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPLYReaderBinary.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write the same mesh as ascii, binary little endian and binary big endian
+// PLY strings, with properties of various types and properties that are not
+// read, and check that the binary blocks decode to the same output as the
+// ascii elements.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkTestErrorObserver.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+const int NumberOfVertices = 700;
+const int NumberOfFaces = 1100;
+
+class PLYBuilder
+{
+public:
+  PLYBuilder(const char* format)
+    : Ascii(!strcmp(format, "ascii"))
+    , BigEndian(!strcmp(format, "binary_big_endian"))
+  {
+    this->Header << "ply\nformat " << format << " 1.0\n";
+  }
+
+  template <typename T>
+  void Add(T value, bool last = false)
+  {
+    if (this->Ascii)
+    {
+      this->Data << +value << (last ? "\n" : " ");
+      return;
+    }
+    char bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    const unsigned short one = 1;
+    const bool hostBigEndian = *reinterpret_cast<const unsigned char*>(&one) == 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+      this->Data.put(bytes[hostBigEndian == this->BigEndian ? i : sizeof(T) - 1 - i]);
+    }
+  }
+
+  bool Ascii;
+  bool BigEndian;
+  std::ostringstream Header;
+  std::ostringstream Data;
+};
+
+std::string MakePLY(const char* format)
+{
+  PLYBuilder ply(format);
+  ply.Header << "element vertex " << NumberOfVertices << "\n"
+             << "property float x\nproperty double y\nproperty short z\n"
+             << "property int unused\n"
+             << "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+             << "property float nx\nproperty float ny\nproperty float nz\n"
+             << "element face " << NumberOfFaces << "\n"
+             << "property uchar intensity\n"
+             << "property list uint int vertex_indices\n"
+             << "property list uchar float unused_list\n"
+             << "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+             << "element edge 2\nproperty int vertex1\nproperty int vertex2\n"
+             << "end_header\n";
+  for (int i = 0; i < NumberOfVertices; ++i)
+  {
+    ply.Add(0.25f * i);
+    ply.Add(-0.5 * i);
+    ply.Add(static_cast<short>(i % 300 - 150));
+    ply.Add(-i);
+    ply.Add(static_cast<unsigned char>(i % 256));
+    ply.Add(static_cast<unsigned char>((3 * i) % 256));
+    ply.Add(static_cast<unsigned char>(255 - i % 256));
+    ply.Add(0.0f);
+    ply.Add(i % 2 ? 1.0f : -1.0f);
+    ply.Add(0.125f * (i % 8), true);
+  }
+  for (int i = 0; i < NumberOfFaces; ++i)
+  {
+    ply.Add(static_cast<unsigned char>(i % 200));
+    const unsigned int n = 3 + i % 3;
+    ply.Add(n);
+    for (unsigned int k = 0; k < n; ++k)
+    {
+      ply.Add(static_cast<int>((i + 7 * k) % NumberOfVertices));
+    }
+    const unsigned char m = static_cast<unsigned char>(i % 4);
+    ply.Add(m);
+    for (unsigned char k = 0; k < m; ++k)
+    {
+      ply.Add(0.5f * k);
+    }
+    ply.Add(static_cast<unsigned char>(i % 256));
+    ply.Add(static_cast<unsigned char>(i % 128));
+    ply.Add(static_cast<unsigned char>(i % 64), true);
+  }
+  for (int i = 0; i < 2; ++i)
+  {
+    ply.Add(i);
+    ply.Add(i + 1, true);
+  }
+  return ply.Header.str() + ply.Data.str();
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b, const char* name)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    std::cerr << "Array " << name << " is missing or has a different size.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        std::cerr << "Array " << name << " differs at " << i << ".\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* a, vtkPolyData* b)
+{
+  if (!SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData(), "Points") ||
+    !SameArrays(a->GetPointData()->GetNormals(), b->GetPointData()->GetNormals(), "Normals") ||
+    !SameArrays(a->GetPointData()->GetScalars(), b->GetPointData()->GetScalars(), "RGB") ||
+    !SameArrays(a->GetCellData()->GetArray("intensity"), b->GetCellData()->GetArray("intensity"),
+      "intensity") ||
+    !SameArrays(a->GetCellData()->GetArray("RGB"), b->GetCellData()->GetArray("RGB"), "cell RGB"))
+  {
+    return false;
+  }
+  vtkCellArray* polysA = a->GetPolys();
+  vtkCellArray* polysB = b->GetPolys();
+  if (polysA->GetNumberOfCells() != NumberOfFaces || polysB->GetNumberOfCells() != NumberOfFaces)
+  {
+    std::cerr << "Wrong number of faces.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < NumberOfFaces; ++i)
+  {
+    vtkIdType nA, nB;
+    const vtkIdType* ptsA;
+    const vtkIdType* ptsB;
+    polysA->GetCellAtId(i, nA, ptsA);
+    polysB->GetCellAtId(i, nB, ptsB);
+    if (nA != nB || !std::equal(ptsA, ptsA + nA, ptsB))
+    {
+      std::cerr << "Face " << i << " differs.\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestPLYReaderBinary(int, char*[])
+{
+  vtkNew<vtkPLYReader> asciiReader;
+  asciiReader->ReadFromInputStringOn();
+  asciiReader->SetInputString(MakePLY("ascii"));
+  asciiReader->Update();
+
+  const char* formats[] = { "binary_little_endian", "binary_big_endian" };
+  for (const char* format : formats)
+  {
+    vtkNew<vtkPLYReader> reader;
+    reader->ReadFromInputStringOn();
+    reader->SetInputString(MakePLY(format));
+    reader->Update();
+    if (!SameOutput(asciiReader->GetOutput(), reader->GetOutput()))
+    {
+      std::cerr << "The " << format << " output differs from the ascii output.\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A truncated face block is an error.
+  std::string truncated = MakePLY("binary_little_endian");
+  truncated.resize(truncated.size() - 60);
+  vtkNew<vtkPLYReader> reader;
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  reader->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(truncated);
+  reader->Update();
+  if (errorObserver->CheckErrorMessage("Cannot read the face data") ||
+    reader->GetOutput()->GetNumberOfPolys() != 0)
+  {
+    std::cerr << "The truncated input was read.\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
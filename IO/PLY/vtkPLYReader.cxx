@@ -14,13 +14,16 @@
 =========================================================================*/
 #include "vtkPLYReader.h"
 
+#include "vtkByteSwap.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalOctreePointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkMathUtilities.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -29,6 +32,7 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkUnsignedCharArray.h"
@@ -38,6 +42,8 @@
 #include <algorithm>
 #include <cctype>
 #include <cstddef>
+#include <cstring>
+#include <numeric>
 #include <vector>
 
 vtkStandardNewMacro(vtkPLYReader);
@@ -132,6 +138,250 @@ typedef struct _plyFace
   unsigned char ntexcoord; // number of texcoord in list
   float* texcoord;         // texcoord list
 } plyFace;
+
+/**
+ * An item of a binary file, converted the way vtkPLY::get_binary_item does.
+ */
+struct plyItem
+{
+  int Int;
+  unsigned int UInt;
+  double Double;
+};
+
+int plyTypeSize(int type)
+{
+  switch (type)
+  {
+    case PLY_CHAR:
+    case PLY_INT8:
+    case PLY_UCHAR:
+    case PLY_UINT8:
+      return 1;
+    case PLY_SHORT:
+    case PLY_INT16:
+    case PLY_USHORT:
+    case PLY_UINT16:
+      return 2;
+    case PLY_INT:
+    case PLY_INT32:
+    case PLY_UINT:
+    case PLY_UINT32:
+    case PLY_FLOAT:
+    case PLY_FLOAT32:
+      return 4;
+    case PLY_DOUBLE:
+    case PLY_FLOAT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template <typename T>
+T plyLoad(const char* p, bool bigEndian)
+{
+  T value;
+  memcpy(&value, p, sizeof(T));
+  bigEndian ? vtkByteSwap::SwapBE(&value) : vtkByteSwap::SwapLE(&value);
+  return value;
+}
+
+template <typename T>
+plyItem plyIntegerItem(T value)
+{
+  plyItem item = { static_cast<int>(value), static_cast<unsigned int>(value),
+    static_cast<double>(value) };
+  return item;
+}
+
+plyItem plyDecodeItem(const char* p, int type, bool bigEndian)
+{
+  switch (type)
+  {
+    case PLY_CHAR:
+    case PLY_INT8:
+      return plyIntegerItem(plyLoad<vtkTypeInt8>(p, bigEndian));
+    case PLY_UCHAR:
+    case PLY_UINT8:
+      return plyIntegerItem(plyLoad<vtkTypeUInt8>(p, bigEndian));
+    case PLY_SHORT:
+    case PLY_INT16:
+      return plyIntegerItem(plyLoad<vtkTypeInt16>(p, bigEndian));
+    case PLY_USHORT:
+    case PLY_UINT16:
+      return plyIntegerItem(plyLoad<vtkTypeUInt16>(p, bigEndian));
+    case PLY_INT:
+    case PLY_INT32:
+      return plyIntegerItem(plyLoad<vtkTypeInt32>(p, bigEndian));
+    case PLY_UINT:
+    case PLY_UINT32:
+      return plyIntegerItem(plyLoad<vtkTypeUInt32>(p, bigEndian));
+    case PLY_FLOAT:
+    case PLY_FLOAT32:
+    {
+      vtkTypeFloat32 value = plyLoad<vtkTypeFloat32>(p, bigEndian);
+      plyItem item = {
+        static_cast<int>(vtkMath::ClampValue(value, (float)VTK_INT_MIN, 2147483520.0f)),
+        static_cast<unsigned int>(vtkMath::ClampValue(value, 0.0f, 4294967040.0f)),
+        static_cast<double>(value) };
+      return item;
+    }
+    case PLY_DOUBLE:
+    case PLY_FLOAT64:
+    {
+      vtkTypeFloat64 value = plyLoad<vtkTypeFloat64>(p, bigEndian);
+      plyItem item = {
+        static_cast<int>(vtkMath::ClampValue(value, (double)VTK_INT_MIN, (double)VTK_INT_MAX)),
+        static_cast<unsigned int>(
+          vtkMath::ClampValue(value, 0.0, (double)VTK_UNSIGNED_INT_MAX)),
+        value };
+      return item;
+    }
+    default:
+    {
+      plyItem item = { 0, 0, 0.0 };
+      return item;
+    }
+  }
+}
+
+/**
+ * A scalar property of an element whose records have a fixed layout: its
+ * byte offset in a record and its type.
+ */
+struct plyField
+{
+  int Offset;
+  int Type;
+};
+
+/**
+ * Return the size of the records of elem, or 0 if it has lists.
+ */
+int plyRecordSize(PlyElement* elem)
+{
+  int size = 0;
+  for (int i = 0; i < elem->nprops; ++i)
+  {
+    if (elem->props[i]->is_list)
+    {
+      return 0;
+    }
+    size += plyTypeSize(elem->props[i]->external_type);
+  }
+  return size;
+}
+
+plyField plyFindField(PlyElement* elem, const char* name)
+{
+  plyField field = { 0, PLY_START_TYPE };
+  for (int i = 0; i < elem->nprops; ++i)
+  {
+    if (!strcmp(elem->props[i]->name, name))
+    {
+      field.Type = elem->props[i]->external_type;
+      return field;
+    }
+    field.Offset += plyTypeSize(elem->props[i]->external_type);
+  }
+  return field;
+}
+
+/**
+ * Walk the properties of the face records of a binary file, which may have
+ * lists of any length, and call visit(property index, record position).
+ * Return the end of the record, or nullptr if it goes past end.
+ */
+template <typename Visitor>
+const char* plyVisitRecord(
+  PlyElement* elem, bool bigEndian, const char* p, const char* end, Visitor&& visit)
+{
+  for (int i = 0; i < elem->nprops; ++i)
+  {
+    PlyProperty* prop = elem->props[i];
+    const int countSize = prop->is_list ? plyTypeSize(prop->count_external) : 0;
+    if (p + countSize > end)
+    {
+      return nullptr;
+    }
+    visit(i, p);
+    if (prop->is_list)
+    {
+      const int count = plyDecodeItem(p, prop->count_external, bigEndian).Int;
+      if (count < 0)
+      {
+        return nullptr;
+      }
+      p += countSize;
+      if (end - p < static_cast<std::ptrdiff_t>(count) * plyTypeSize(prop->external_type))
+      {
+        return nullptr;
+      }
+      p += static_cast<std::ptrdiff_t>(count) * plyTypeSize(prop->external_type);
+    }
+    else
+    {
+      p += plyTypeSize(prop->external_type);
+      if (p > end)
+      {
+        return nullptr;
+      }
+    }
+  }
+  return p;
+}
+
+/**
+ * Read the records of the element of a binary file whose data starts at the
+ * current position of its stream, which may have lists. The record offsets
+ * are found by a sequential scan and the stream is left at the end of the
+ * element.
+ */
+bool plyReadVariableBlock(PlyFile* ply, PlyElement* elem, int num, std::vector<char>& block,
+  std::vector<size_t>& recordOffsets)
+{
+  std::istream* is = ply->is;
+  const std::streampos start = is->tellg();
+  if (start == std::streampos(-1))
+  {
+    return false;
+  }
+  is->seekg(0, std::ios::end);
+  const std::streampos last = is->tellg();
+  is->seekg(start);
+  if (last == std::streampos(-1) || last < start || !is->good())
+  {
+    return false;
+  }
+  block.resize(static_cast<size_t>(last - start));
+  is->read(block.data(), static_cast<std::streamsize>(block.size()));
+  if (static_cast<size_t>(is->gcount()) != block.size())
+  {
+    return false;
+  }
+
+  const bool bigEndian = ply->file_type == PLY_BINARY_BE;
+  const char* begin = block.data();
+  const char* end = begin + block.size();
+  const char* p = begin;
+  recordOffsets.resize(static_cast<size_t>(num) + 1);
+  for (int j = 0; j < num; ++j)
+  {
+    recordOffsets[j] = static_cast<size_t>(p - begin);
+    p = plyVisitRecord(elem, bigEndian, p, end, [](int, const char*) {});
+    if (!p)
+    {
+      return false;
+    }
+  }
+  recordOffsets[num] = static_cast<size_t>(p - begin);
+
+  // Leave the stream where the next element starts.
+  is->clear();
+  is->seekg(start + static_cast<std::streamoff>(p - begin));
+  return is->good();
+}
 }
 
 int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
@@ -346,6 +596,16 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
       output->GetPointData()->SetTCoords(texCoordsPoints);
     }
   }
+  // Release the file and the remaining element names when the data is bad.
+  auto abortRead = [&](int first) {
+    for (int k = first; k < nelems; ++k)
+    {
+      free(elist[k]);
+    }
+    free(elist);
+    vtkPLY::ply_close(ply);
+  };
+
   // Okay, now we can grab the data
   int numPts = 0, numPolys = 0;
   for (int i = 0; i < nelems; i++)
@@ -395,28 +655,87 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         rgbPoints->SetNumberOfTuples(numPts);
       }
 
-      plyVertex vertex;
-      for (int j = 0; j < numPts; j++)
+      PlyElement* vertexElem = vtkPLY::find_element(ply, elemName);
+      const int recordSize = ply->file_type != PLY_ASCII ? plyRecordSize(vertexElem) : 0;
+      if (recordSize > 0)
       {
-        vtkPLY::ply_get_element(ply, (void*)&vertex);
-        pts->SetPoint(j, vertex.x);
-        if (texCoordsPointsAvailable)
+        // Binary vertices without lists are read at once and decoded in
+        // parallel.
+        std::vector<char> block(static_cast<size_t>(recordSize) * numPts);
+        ply->is->read(block.data(), static_cast<std::streamsize>(block.size()));
+        if (static_cast<size_t>(ply->is->gcount()) != block.size())
         {
-          texCoordsPoints->SetTuple2(j, vertex.tex[0], vertex.tex[1]);
+          vtkErrorMacro(<< "Premature end of the vertex data");
+          pts->Delete();
+          abortRead(i);
+          return 0;
         }
-        if (normalPointsAvailable)
+        const bool bigEndian = ply->file_type == PLY_BINARY_BE;
+        plyField fields[12];
+        for (int k = 0; k < 12; ++k)
         {
-          normals->SetTuple3(j, vertex.normal[0], vertex.normal[1], vertex.normal[2]);
+          fields[k] = plyFindField(vertexElem, vertProps[k].name);
         }
-        if (rgbPointsAvailable)
+        float* xyz = vtkArrayDownCast<vtkFloatArray>(pts->GetData())->GetPointer(0);
+        float* tex = texCoordsPointsAvailable ? texCoordsPoints->GetPointer(0) : nullptr;
+        float* nrm = normalPointsAvailable ? normals->GetPointer(0) : nullptr;
+        unsigned char* rgb = rgbPointsAvailable ? rgbPoints->GetPointer(0) : nullptr;
+        const int rgbComponents = rgbPointsAvailable ? rgbPoints->GetNumberOfComponents() : 0;
+        vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType j = begin; j < end; ++j)
+          {
+            const char* record = block.data() + j * recordSize;
+            for (int k = 0; k < 3; ++k)
+            {
+              xyz[3 * j + k] = static_cast<float>(
+                plyDecodeItem(record + fields[k].Offset, fields[k].Type, bigEndian).Double);
+            }
+            for (int k = 0; tex && k < 2; ++k)
+            {
+              tex[2 * j + k] = static_cast<float>(
+                plyDecodeItem(record + fields[3 + k].Offset, fields[3 + k].Type, bigEndian)
+                  .Double);
+            }
+            for (int k = 0; nrm && k < 3; ++k)
+            {
+              nrm[3 * j + k] = static_cast<float>(
+                plyDecodeItem(record + fields[5 + k].Offset, fields[5 + k].Type, bigEndian)
+                  .Double);
+            }
+            for (int k = 0; k < rgbComponents; ++k)
+            {
+              rgb[rgbComponents * j + k] = static_cast<unsigned char>(
+                plyDecodeItem(record + fields[8 + k].Offset, fields[8 + k].Type, bigEndian)
+                  .UInt);
+            }
+          }
+        });
+      }
+      else
+      {
+        plyVertex vertex;
+        for (int j = 0; j < numPts; j++)
         {
-          if (rgbPointsHaveAlpha)
+          vtkPLY::ply_get_element(ply, (void*)&vertex);
+          pts->SetPoint(j, vertex.x);
+          if (texCoordsPointsAvailable)
+          {
+            texCoordsPoints->SetTuple2(j, vertex.tex[0], vertex.tex[1]);
+          }
+          if (normalPointsAvailable)
           {
-            rgbPoints->SetTuple4(j, vertex.red, vertex.green, vertex.blue, vertex.alpha);
+            normals->SetTuple3(j, vertex.normal[0], vertex.normal[1], vertex.normal[2]);
           }
-          else
+          if (rgbPointsAvailable)
           {
-            rgbPoints->SetTuple3(j, vertex.red, vertex.green, vertex.blue);
+            if (rgbPointsHaveAlpha)
+            {
+              rgbPoints->SetTuple4(j, vertex.red, vertex.green, vertex.blue, vertex.alpha);
+            }
+            else
+            {
+              rgbPoints->SetTuple3(j, vertex.red, vertex.green, vertex.blue);
+            }
           }
         }
       }
@@ -479,138 +798,231 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         }
       }
 
-      // grab all the face elements
-      vtkNew<vtkPolygon> cell;
-      for (int j = 0; j < numPolys; j++)
+      PlyElement* faceElem = vtkPLY::find_element(ply, elemName);
+      PlyProperty* vertsProp = vtkPLY::find_property(faceElem, "vertex_indices", &index);
+      if (ply->file_type != PLY_ASCII && !texCoordsFaceAvailable && vertsProp &&
+        vertsProp->is_list)
       {
-        // grab and element from the file
-        vtkPLY::ply_get_element(ply, (void*)&face);
-        for (int k = 0; k < face.nverts; k++)
+        // Binary faces are read at once, located by a sequential scan of the
+        // list counts and decoded in parallel.
+        std::vector<char> block;
+        std::vector<size_t> recordOffsets;
+        if (!plyReadVariableBlock(ply, faceElem, numPolys, block, recordOffsets))
         {
-          vtkVerts[k] = face.verts[k];
+          vtkErrorMacro(<< "Cannot read the face data");
+          abortRead(i);
+          return 0;
         }
-        free(face.verts); // allocated in vtkPLY::ascii/binary_get_element
-
-        cell->Initialize(face.nverts, vtkVerts, output->GetPoints());
+        const bool bigEndian = ply->file_type == PLY_BINARY_BE;
+        int vertsIndex = -1;
+        int intensityIndex = -1;
+        int rgbIndex[4] = { -1, -1, -1, -1 };
+        vtkPLY::find_property(faceElem, "vertex_indices", &vertsIndex);
         if (intensityAvailable)
         {
-          intensity->SetValue(j, face.intensity);
+          vtkPLY::find_property(faceElem, "intensity", &intensityIndex);
         }
-        if (rgbCellsAvailable)
+        const int rgbComponents = rgbCellsAvailable ? rgbCells->GetNumberOfComponents() : 0;
+        for (int k = 0; k < rgbComponents; ++k)
         {
-          if (rgbCellsHaveAlpha)
+          vtkPLY::find_property(faceElem, faceProps[2 + k].name, &rgbIndex[k]);
+        }
+
+        // The number of vertices is stored in an unsigned char as in
+        // plyFace, the list may be longer.
+        vtkNew<vtkIdTypeArray> offsets;
+        offsets->SetNumberOfValues(static_cast<vtkIdType>(numPolys) + 1);
+        vtkIdType* offsetData = offsets->GetPointer(0);
+        offsetData[0] = 0;
+        const char* blockEnd = block.data() + block.size();
+        vtkSMPTools::For(0, numPolys, [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType j = begin; j < end; ++j)
           {
-            rgbCells->SetValue(4 * j, face.red);
-            rgbCells->SetValue(4 * j + 1, face.green);
-            rgbCells->SetValue(4 * j + 2, face.blue);
-            rgbCells->SetValue(4 * j + 3, face.alpha);
+            plyVisitRecord(faceElem, bigEndian, block.data() + recordOffsets[j], blockEnd,
+              [&](int k, const char* p) {
+                if (k == vertsIndex)
+                {
+                  offsetData[j + 1] = static_cast<unsigned char>(
+                    plyDecodeItem(p, faceElem->props[k]->count_external, bigEndian).UInt);
+                }
+              });
           }
-          else
+        });
+        std::partial_sum(offsetData, offsetData + numPolys + 1, offsetData);
+
+        vtkNew<vtkIdTypeArray> connectivity;
+        connectivity->SetNumberOfValues(offsetData[numPolys]);
+        vtkIdType* connectivityData = connectivity->GetPointer(0);
+        unsigned char* intensityData = intensityAvailable ? intensity->GetPointer(0) : nullptr;
+        unsigned char* rgbData = rgbCellsAvailable ? rgbCells->GetPointer(0) : nullptr;
+        vtkSMPTools::For(0, numPolys, [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType j = begin; j < end; ++j)
           {
-            rgbCells->SetValue(3 * j, face.red);
-            rgbCells->SetValue(3 * j + 1, face.green);
-            rgbCells->SetValue(3 * j + 2, face.blue);
+            plyVisitRecord(faceElem, bigEndian, block.data() + recordOffsets[j], blockEnd,
+              [&](int k, const char* p) {
+                PlyProperty* prop = faceElem->props[k];
+                if (k == vertsIndex)
+                {
+                  p += plyTypeSize(prop->count_external);
+                  const int itemSize = plyTypeSize(prop->external_type);
+                  for (vtkIdType n = offsetData[j]; n < offsetData[j + 1]; ++n, p += itemSize)
+                  {
+                    connectivityData[n] = plyDecodeItem(p, prop->external_type, bigEndian).Int;
+                  }
+                }
+                else if (k == intensityIndex)
+                {
+                  intensityData[j] = static_cast<unsigned char>(
+                    plyDecodeItem(p, prop->external_type, bigEndian).UInt);
+                }
+                for (int c = 0; c < rgbComponents; ++c)
+                {
+                  if (k == rgbIndex[c])
+                  {
+                    rgbData[rgbComponents * j + c] = static_cast<unsigned char>(
+                      plyDecodeItem(p, prop->external_type, bigEndian).UInt);
+                  }
+                }
+              });
           }
-        }
-        if (texCoordsFaceAvailable)
+        });
+        polys->SetData(offsets, connectivity);
+      }
+      else
+      {
+        // grab all the face elements
+        vtkNew<vtkPolygon> cell;
+        for (int j = 0; j < numPolys; j++)
         {
-          // Test to know if there is a texcoord for every vertex
-          if (face.nverts == (face.ntexcoord / 2))
+          // grab and element from the file
+          vtkPLY::ply_get_element(ply, (void*)&face);
+          for (int k = 0; k < face.nverts; k++)
           {
-            if (this->DuplicatePointsForFaceTexture)
+            vtkVerts[k] = face.verts[k];
+          }
+          free(face.verts); // allocated in vtkPLY::ascii/binary_get_element
+
+          cell->Initialize(face.nverts, vtkVerts, output->GetPoints());
+          if (intensityAvailable)
+          {
+            intensity->SetValue(j, face.intensity);
+          }
+          if (rgbCellsAvailable)
+          {
+            if (rgbCellsHaveAlpha)
             {
-              for (int k = 0; k < face.nverts; k++)
+              rgbCells->SetValue(4 * j, face.red);
+              rgbCells->SetValue(4 * j + 1, face.green);
+              rgbCells->SetValue(4 * j + 2, face.blue);
+              rgbCells->SetValue(4 * j + 3, face.alpha);
+            }
+            else
+            {
+              rgbCells->SetValue(3 * j, face.red);
+              rgbCells->SetValue(3 * j + 1, face.green);
+              rgbCells->SetValue(3 * j + 2, face.blue);
+            }
+          }
+          if (texCoordsFaceAvailable)
+          {
+            // Test to know if there is a texcoord for every vertex
+            if (face.nverts == (face.ntexcoord / 2))
+            {
+              if (this->DuplicatePointsForFaceTexture)
               {
-                // new texture stored at the current face
-                float newTex[] = { face.texcoord[k * 2], face.texcoord[k * 2 + 1] };
-                // texture stored at vtkVerts[k] point
-                float currentTex[2];
-                texCoordsPoints->GetTypedTuple(vtkVerts[k], currentTex);
-                double newTex3[] = { newTex[0], newTex[1], 0 };
-                if (currentTex[0] == -1.0)
+                for (int k = 0; k < face.nverts; k++)
                 {
-                  // newly seen texture coordinates for vertex
-                  texCoordsPoints->SetTuple2(vtkVerts[k], newTex[0], newTex[1]);
-                  vtkIdType ti;
-                  texLocator->InsertUniquePoint(newTex3, ti);
-                  pointIds.resize(std::max(ti + 1, static_cast<vtkIdType>(pointIds.size())));
-                  pointIds[ti].push_back(vtkVerts[k]);
-                }
-                else
-                {
-                  if (!vtkMathUtilities::FuzzyCompare(
-                        currentTex[0], newTex[0], this->FaceTextureTolerance) ||
-                    !vtkMathUtilities::FuzzyCompare(
-                      currentTex[1], newTex[1], this->FaceTextureTolerance))
+                  // new texture stored at the current face
+                  float newTex[] = { face.texcoord[k * 2], face.texcoord[k * 2 + 1] };
+                  // texture stored at vtkVerts[k] point
+                  float currentTex[2];
+                  texCoordsPoints->GetTypedTuple(vtkVerts[k], currentTex);
+                  double newTex3[] = { newTex[0], newTex[1], 0 };
+                  if (currentTex[0] == -1.0)
                   {
-                    // different texture coordinate
-                    // than stored at point vtkVerts[k]
+                    // newly seen texture coordinates for vertex
+                    texCoordsPoints->SetTuple2(vtkVerts[k], newTex[0], newTex[1]);
                     vtkIdType ti;
-                    int inserted = texLocator->InsertUniquePoint(newTex3, ti);
-                    if (inserted)
-                    {
-                      // newly seen texture coordinate for vertex
-                      // which already has some texture coordinates.
-                      vtkIdType dp = duplicateCellPoint(output, cell, k);
-                      texCoordsPoints->SetTuple2(dp, newTex[0], newTex[1]);
-                      pointIds.resize(std::max(ti + 1, static_cast<vtkIdType>(pointIds.size())));
-                      pointIds[ti].push_back(dp);
-                    }
-                    else
+                    texLocator->InsertUniquePoint(newTex3, ti);
+                    pointIds.resize(std::max(ti + 1, static_cast<vtkIdType>(pointIds.size())));
+                    pointIds[ti].push_back(vtkVerts[k]);
+                  }
+                  else
+                  {
+                    if (!vtkMathUtilities::FuzzyCompare(
+                          currentTex[0], newTex[0], this->FaceTextureTolerance) ||
+                      !vtkMathUtilities::FuzzyCompare(
+                        currentTex[1], newTex[1], this->FaceTextureTolerance))
                     {
-                      size_t sameTexIndex = 0;
-                      if (pointIds[ti].size() > 1)
+                      // different texture coordinate
+                      // than stored at point vtkVerts[k]
+                      vtkIdType ti;
+                      int inserted = texLocator->InsertUniquePoint(newTex3, ti);
+                      if (inserted)
+                      {
+                        // newly seen texture coordinate for vertex
+                        // which already has some texture coordinates.
+                        vtkIdType dp = duplicateCellPoint(output, cell, k);
+                        texCoordsPoints->SetTuple2(dp, newTex[0], newTex[1]);
+                        pointIds.resize(std::max(ti + 1, static_cast<vtkIdType>(pointIds.size())));
+                        pointIds[ti].push_back(dp);
+                      }
+                      else
                       {
-                        double first[3];
-                        output->GetPoint(vtkVerts[k], first);
-                        for (; sameTexIndex < pointIds[ti].size(); ++sameTexIndex)
+                        size_t sameTexIndex = 0;
+                        if (pointIds[ti].size() > 1)
                         {
-                          double second[3];
-                          output->GetPoint(pointIds[ti][sameTexIndex], second);
-                          if (FuzzyEqual(first, second, this->FaceTextureTolerance))
+                          double first[3];
+                          output->GetPoint(vtkVerts[k], first);
+                          for (; sameTexIndex < pointIds[ti].size(); ++sameTexIndex)
                           {
-                            break;
+                            double second[3];
+                            output->GetPoint(pointIds[ti][sameTexIndex], second);
+                            if (FuzzyEqual(first, second, this->FaceTextureTolerance))
+                            {
+                              break;
+                            }
+                          }
+                          if (sameTexIndex == pointIds[ti].size())
+                          {
+                            // newly seen point for this texture coordinate
+                            vtkIdType dp = duplicateCellPoint(output, cell, k);
+                            texCoordsPoints->SetTuple2(dp, newTex[0], newTex[1]);
+                            pointIds[ti].push_back(dp);
                           }
                         }
-                        if (sameTexIndex == pointIds[ti].size())
-                        {
-                          // newly seen point for this texture coordinate
-                          vtkIdType dp = duplicateCellPoint(output, cell, k);
-                          texCoordsPoints->SetTuple2(dp, newTex[0], newTex[1]);
-                          pointIds[ti].push_back(dp);
-                        }
-                      }
 
-                      // texture coordinate already seen before, use the vertex
-                      // associated with these texture coordinates
-                      vtkIdType vi = pointIds[ti][sameTexIndex];
-                      setCellPoint(cell, k, vi);
+                        // texture coordinate already seen before, use the vertex
+                        // associated with these texture coordinates
+                        vtkIdType vi = pointIds[ti][sameTexIndex];
+                        setCellPoint(cell, k, vi);
+                      }
                     }
+                    // same texture coordinate, nothing to do.
                   }
-                  // same texture coordinate, nothing to do.
+                }
+              }
+              else
+              {
+                // if we don't want point duplication we only need to set
+                // the texture coordinates
+                for (int k = 0; k < face.nverts; k++)
+                {
+                  // new texture stored at the current face
+                  float newTex[] = { face.texcoord[k * 2], face.texcoord[k * 2 + 1] };
+                  texCoordsPoints->SetTuple2(vtkVerts[k], newTex[0], newTex[1]);
                 }
               }
             }
             else
             {
-              // if we don't want point duplication we only need to set
-              // the texture coordinates
-              for (int k = 0; k < face.nverts; k++)
-              {
-                // new texture stored at the current face
-                float newTex[] = { face.texcoord[k * 2], face.texcoord[k * 2 + 1] };
-                texCoordsPoints->SetTuple2(vtkVerts[k], newTex[0], newTex[1]);
-              }
+              vtkWarningMacro(<< "Number of texture coordinates " << face.ntexcoord
+                              << " different than number of points " << face.nverts);
             }
+            free(face.texcoord);
           }
-          else
-          {
-            vtkWarningMacro(<< "Number of texture coordinates " << face.ntexcoord
-                            << " different than number of points " << face.nverts);
-          }
-          free(face.texcoord);
+          polys->InsertNextCell(cell);
         }
-        polys->InsertNextCell(cell);
       }
       output->SetPolys(polys);
     }
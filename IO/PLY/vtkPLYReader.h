@@ -33,6 +33,8 @@
  * artifacts. If unique points are required use a vtkCleanPolyData
  * filter after this reader or use this reader with DuplicatePointsForFaceTexture
  * set to false.
+ * The vertices and faces of binary files are read as blocks and decoded in
+ * parallel, except for faces with texture coordinates.
  *
  * @sa
  * vtkPLYWriter, vtkCleanPolyData
@@ -0,0 +1,145 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLPConcurrentPieces.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write multi-piece .pvtp and .pvti files and check that reading the pieces
+// concurrently gives the same output as reading them one after another.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageGaussianSource.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTesting.h"
+#include "vtkXMLPImageDataReader.h"
+#include "vtkXMLPImageDataWriter.h"
+#include "vtkXMLPPolyDataReader.h"
+#include "vtkXMLPPolyDataWriter.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int TestPolyData(const std::string& fileName)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+
+  vtkNew<vtkXMLPPolyDataWriter> writer;
+  writer->SetInputConnection(sphere->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->SetNumberOfPieces(12);
+  writer->SetStartPiece(0);
+  writer->SetEndPiece(11);
+  writer->Write();
+
+  vtkNew<vtkXMLPPolyDataReader> serial;
+  serial->SetFileName(fileName.c_str());
+  serial->SetMaxNumberOfConcurrentPieces(1);
+  serial->Update();
+  vtkNew<vtkXMLPPolyDataReader> concurrent;
+  concurrent->SetFileName(fileName.c_str());
+  concurrent->SetMaxNumberOfConcurrentPieces(4);
+  concurrent->Update();
+
+  vtkPolyData* a = serial->GetOutput();
+  vtkPolyData* b = concurrent->GetOutput();
+  if (a->GetNumberOfPoints() == 0 || a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    std::cerr << "Poly data pieces differ in size.\n";
+    return EXIT_FAILURE;
+  }
+  if (!SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()) ||
+    !SameArrays(a->GetPointData()->GetArray("Normals"), b->GetPointData()->GetArray("Normals")))
+  {
+    std::cerr << "Poly data pieces differ in content.\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int TestImageData(const std::string& fileName)
+{
+  vtkNew<vtkImageGaussianSource> source;
+  source->SetWholeExtent(0, 39, 0, 29, 0, 19);
+  source->SetCenter(20, 15, 10);
+  source->SetStandardDeviation(8);
+
+  vtkNew<vtkXMLPImageDataWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->SetNumberOfPieces(6);
+  writer->SetStartPiece(0);
+  writer->SetEndPiece(5);
+  writer->Write();
+
+  vtkNew<vtkXMLPImageDataReader> serial;
+  serial->SetFileName(fileName.c_str());
+  serial->SetMaxNumberOfConcurrentPieces(1);
+  serial->Update();
+  vtkNew<vtkXMLPImageDataReader> concurrent;
+  concurrent->SetFileName(fileName.c_str());
+  concurrent->SetMaxNumberOfConcurrentPieces(0);
+  concurrent->Update();
+
+  vtkImageData* a = serial->GetOutput();
+  vtkImageData* b = concurrent->GetOutput();
+  if (a->GetNumberOfPoints() != 40 * 30 * 20 || b->GetNumberOfPoints() != a->GetNumberOfPoints() ||
+    !SameArrays(a->GetPointData()->GetScalars(), b->GetPointData()->GetScalars()))
+  {
+    std::cerr << "Image data pieces differ.\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+} // end anon namespace
+
+int TestXMLPConcurrentPieces(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDir = testing->GetTempDirectory();
+
+  if (TestPolyData(tempDir + "/TestXMLPConcurrentPieces.pvtp") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return TestImageData(tempDir + "/TestXMLPConcurrentPieces.pvti");
+}
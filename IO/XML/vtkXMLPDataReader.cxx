@@ -19,21 +19,27 @@
 #include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataSet.h"
+#include "vtkGarbageCollector.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataReader.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <sstream>
+#include <vector>
 
 //----------------------------------------------------------------------------
 vtkXMLPDataReader::vtkXMLPDataReader()
 {
   this->GhostLevel = 0;
   this->PieceReaders = nullptr;
+  this->MaxNumberOfConcurrentPieces = 8;
 }
 
 //----------------------------------------------------------------------------
@@ -50,6 +56,7 @@ void vtkXMLPDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "NumberOfPieces: " << this->NumberOfPieces << "\n";
+  os << indent << "MaxNumberOfConcurrentPieces: " << this->MaxNumberOfConcurrentPieces << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -310,21 +317,105 @@ int vtkXMLPDataReader::ReadPieceData(int index)
   this->Piece = index;
 
   // We need data, make sure the piece can be read.
-  if (!this->CanReadPiece(this->Piece))
+  if (!this->PreparePieceReader(this->Piece))
   {
     vtkErrorMacro("File for piece " << this->Piece << " cannot be read.");
     return 0;
   }
 
   // Actually read the data.
-  this->PieceReaders[this->Piece]->SetAbortExecute(0);
-  vtkDataArraySelection* pds = this->PieceReaders[this->Piece]->GetPointDataArraySelection();
-  vtkDataArraySelection* cds = this->PieceReaders[this->Piece]->GetCellDataArraySelection();
-  pds->CopySelections(this->PointDataArraySelection);
-  cds->CopySelections(this->CellDataArraySelection);
   return this->ReadPieceData();
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLPDataReader::PreparePieceReader(int index)
+{
+  if (!this->CanReadPiece(index))
+  {
+    return 0;
+  }
+
+  // These only modify the reader when the settings change, so a reader
+  // already executed by UpdatePieceReaders() is not executed again.
+  vtkXMLDataReader* reader = this->PieceReaders[index];
+  reader->SetAbortExecute(0);
+  reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
+  reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPDataReader::UpdatePieceReaders(int numReads, const int* pieces)
+{
+  int maxConcurrent = this->MaxNumberOfConcurrentPieces;
+  if (maxConcurrent == 0)
+  {
+    maxConcurrent = vtkSMPTools::GetEstimatedNumberOfThreads();
+  }
+  if (maxConcurrent < 2 || numReads < 2)
+  {
+    return;
+  }
+
+  // A piece read more than once (e.g. several sub-extents of one structured
+  // piece) needs a different request each time, so leave it to the serial
+  // ReadPieceData() calls.
+  std::vector<int> timesRead(this->NumberOfPieces, 0);
+  for (int read = 0; read < numReads; ++read)
+  {
+    ++timesRead[pieces[read]];
+  }
+  std::vector<int> reads;
+  for (int read = 0; read < numReads; ++read)
+  {
+    const int piece = pieces[read];
+    if (timesRead[piece] == 1 && this->PreparePieceReader(piece))
+    {
+      reads.push_back(read);
+    }
+  }
+  if (reads.size() < 2)
+  {
+    return;
+  }
+
+  // The progress callback reports on this->Piece, which the workers do not
+  // set. Progress is reported again while the output is assembled.
+  for (int read : reads)
+  {
+    this->PieceReaders[pieces[read]]->RemoveObserver(this->PieceProgressObserver);
+  }
+
+  // Each worker pulls the next read from a shared counter, which bounds the
+  // number of readers running at once and balances unevenly sized pieces.
+  const int numWorkers = std::min(maxConcurrent, static_cast<int>(reads.size()));
+  std::atomic<size_t> next(0);
+  const bool deferCollection = vtkGarbageCollector::IsMainThread();
+  if (deferCollection)
+  {
+    vtkGarbageCollector::DeferredCollectionPush();
+  }
+  vtkSMPTools::For(0, numWorkers, 1, [&](vtkIdType, vtkIdType) {
+    for (size_t i = next++; i < reads.size(); i = next++)
+    {
+      this->UpdatePieceReader(reads[i], pieces[reads[i]]);
+    }
+  });
+  if (deferCollection)
+  {
+    vtkGarbageCollector::DeferredCollectionPop();
+  }
+
+  for (int read : reads)
+  {
+    this->PieceReaders[pieces[read]]->AddObserver(
+      vtkCommand::ProgressEvent, this->PieceProgressObserver);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPDataReader::UpdatePieceReader(int, int) {}
+
 //----------------------------------------------------------------------------
 int vtkXMLPDataReader::ReadPieceData()
 {
@@ -46,6 +46,19 @@ public:
    */
   void CopyOutputInformation(vtkInformation* outInfo, int port) override;
 
+  ///@{
+  /**
+   * Set/Get the maximum number of piece files read at the same time. The
+   * readers of the pieces assigned to this process are executed
+   * concurrently through vtkSMPTools before their data are copied into the
+   * output, so this bounds the number of files open and decompressed at
+   * once. 0 uses as many as there are SMP threads, 1 reads the pieces one
+   * after another. Default is 8.
+   */
+  vtkSetClampMacro(MaxNumberOfConcurrentPieces, int, 0, VTK_INT_MAX);
+  vtkGetMacro(MaxNumberOfConcurrentPieces, int);
+  ///@}
+
 protected:
   vtkXMLPDataReader();
   ~vtkXMLPDataReader() override;
@@ -107,6 +120,27 @@ protected:
    */
   virtual int ReadPieceData();
 
+  /**
+   * Make sure the piece at the given index can be read and pass the current
+   * array selections to its reader. Returns 0 if the piece cannot be read.
+   */
+  int PreparePieceReader(int index);
+
+  /**
+   * Execute the readers of the given pieces concurrently, at most
+   * MaxNumberOfConcurrentPieces at a time, so that ReadPieceData() only has
+   * to copy data that were already read. pieces[read] is the piece used by
+   * each read; pieces listed more than once are left to ReadPieceData().
+   */
+  void UpdatePieceReaders(int numReads, const int* pieces);
+
+  /**
+   * Execute the reader of a piece for one read of UpdatePieceReaders().
+   * Called from worker threads, so it must only touch that piece's reader.
+   * Does nothing by default.
+   */
+  virtual void UpdatePieceReader(int read, int piece);
+
   /**
    * Read the information relative to the dataset and allocate the needed structures according to it
    */
@@ -125,6 +159,8 @@ protected:
    */
   int GhostLevel;
 
+  int MaxNumberOfConcurrentPieces;
+
   /**
    * Information per-piece.
    */
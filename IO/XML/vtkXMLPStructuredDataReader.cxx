@@ -24,6 +24,7 @@
 #include "vtkXMLStructuredDataReader.h"
 
 #include <sstream>
+#include <vector>
 
 //----------------------------------------------------------------------------
 vtkXMLPStructuredDataReader::vtkXMLPStructuredDataReader()
@@ -136,6 +137,15 @@ void vtkXMLPStructuredDataReader::ReadXMLData()
     fractions[i] = fractions[i] / fractions[n];
   }
 
+  // Execute the piece readers concurrently, then copy their sub-extents in
+  // order.
+  std::vector<int> pieces(n);
+  for (i = 0; i < n; ++i)
+  {
+    pieces[i] = this->ExtentSplitter->GetSubExtentSource(i);
+  }
+  this->UpdatePieceReaders(n, pieces.data());
+
   // Read the data needed from each sub-extent.
   for (i = 0; (i < n && !this->AbortExecute && !this->DataError); ++i)
   {
@@ -296,6 +306,14 @@ int vtkXMLPStructuredDataReader::ReadPieceData()
   return this->Superclass::ReadPieceData();
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLPStructuredDataReader::UpdatePieceReader(int read, int piece)
+{
+  int subExtent[6];
+  this->ExtentSplitter->GetSubExtent(read, subExtent);
+  this->PieceReaders[piece]->UpdateExtent(subExtent);
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLPStructuredDataReader::CopyArrayForPoints(vtkDataArray* inArray, vtkDataArray* outArray)
 {
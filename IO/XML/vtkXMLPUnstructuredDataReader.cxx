@@ -22,6 +22,9 @@
 #include "vtkXMLDataElement.h"
 #include "vtkXMLUnstructuredDataReader.h"
 
+#include <numeric>
+#include <vector>
+
 //----------------------------------------------------------------------------
 vtkXMLPUnstructuredDataReader::vtkXMLPUnstructuredDataReader()
 {
@@ -300,6 +303,11 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
     fractions[index + 1] = fractions[index + 1] / fractions[this->EndPiece - this->StartPiece];
   }
 
+  // Execute the piece readers concurrently, then copy their outputs in order.
+  std::vector<int> pieces(this->EndPiece - this->StartPiece);
+  std::iota(pieces.begin(), pieces.end(), this->StartPiece);
+  this->UpdatePieceReaders(static_cast<int>(pieces.size()), pieces.data());
+
   // Read the data needed from each piece.
   for (int i = this->StartPiece; (i < this->EndPiece && !this->AbortExecute && !this->DataError);
        ++i)
@@ -347,6 +355,12 @@ int vtkXMLPUnstructuredDataReader::ReadPieceData()
   return this->Superclass::ReadPieceData();
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLPUnstructuredDataReader::UpdatePieceReader(int, int piece)
+{
+  this->PieceReaders[piece]->UpdatePiece(0, 1, this->UpdateGhostLevel);
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLPUnstructuredDataReader::CopyArrayForPoints(
   vtkDataArray* inArray, vtkDataArray* outArray)
@@ -72,6 +72,7 @@ protected:
   void SetupUpdateExtent(int piece, int numberOfPieces, int ghostLevel);
 
   int ReadPieceData() override;
+  void UpdatePieceReader(int read, int piece) override;
   void CopyCellArray(vtkIdType totalNumberOfCells, vtkCellArray* inCells, vtkCellArray* outCells);
 
   // Get the number of points/cells in the given piece.  Valid after
@@ -745,6 +745,13 @@ int vtkXMLUnstructuredDataReader::ReadCellArray(vtkIdType numberOfCells,
            "type.");
       return 0;
     }
+
+    // Files written with 64-bit ids still load into compact storage when
+    // 32-bit cell arrays are the default.
+    if (!vtkCellArray::GetDefaultStorageIs64Bit())
+    {
+      outCells->ConvertToSmallestStorage();
+    }
   }
   else
   { // Construct a temporary vtkCellArray that holds the arrays, and then
@@ -0,0 +1,260 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ImageAccumulateJoint.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the joint histograms and statistics of vtkImageAccumulate, dense
+// and sparse, with and without a stencil, with a serial count of the bins.
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageAccumulate.h"
+#include "vtkImageData.h"
+#include "vtkImageStencilData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+#include <iostream>
+#include <map>
+
+namespace
+{
+
+const int Dims[3] = { 40, 33, 17 };
+
+struct Reference
+{
+  std::map<vtkIdType, vtkIdType> Bins;
+  double Min[3];
+  double Max[3];
+  double Mean[3];
+  vtkIdType VoxelCount;
+};
+
+void FillImage(vtkImageData* image, int scalarType, int numComps, double minval, double maxval)
+{
+  image->SetDimensions(Dims[0], Dims[1], Dims[2]);
+  image->AllocateScalars(scalarType, numComps);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  unsigned int state = 7;
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    state = state * 1103515245u + 12345u;
+    double v = minval + (maxval - minval) * ((state >> 8) % 65536) / 65535.0;
+    // correlate the components and leave some zeros
+    v = (i % numComps ? 0.5 * (v + scalars->GetComponent(i / numComps, 0)) : v);
+    scalars->SetComponent(i / numComps, i % numComps, (state >> 28) == 0 ? 0.0 : v);
+  }
+}
+
+// A serial count of the bins, with the pixels in the same order as the filter.
+void Accumulate(vtkImageData* image, vtkImageAccumulate* accumulate, vtkImageStencilData* stencil,
+  Reference* reference)
+{
+  int numC = image->GetNumberOfScalarComponents();
+  const int* extent = accumulate->GetComponentExtent();
+  vtkIdType incs[3] = { 1, extent[1] - extent[0] + 1,
+    static_cast<vtkIdType>(extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) };
+  double sum[3] = { 0.0, 0.0, 0.0 };
+  reference->Bins.clear();
+  reference->VoxelCount = 0;
+  for (int c = 0; c < 3; ++c)
+  {
+    reference->Min[c] = VTK_DOUBLE_MAX;
+    reference->Max[c] = VTK_DOUBLE_MIN;
+  }
+  for (int k = 0; k < Dims[2]; ++k)
+  {
+    for (int j = 0; j < Dims[1]; ++j)
+    {
+      for (int i = 0; i < Dims[0]; ++i)
+      {
+        if (stencil && (stencil->IsInside(i, j, k) != 0) == (accumulate->GetReverseStencil() != 0))
+        {
+          continue;
+        }
+        vtkIdType bin = 0;
+        bool inside = true;
+        for (int c = 0; c < numC; ++c)
+        {
+          double v = image->GetScalarComponentAsDouble(i, j, k, c);
+          if (!accumulate->GetIgnoreZero() || v != 0)
+          {
+            sum[c] += v;
+            reference->Min[c] = std::min(reference->Min[c], v);
+            reference->Max[c] = std::max(reference->Max[c], v);
+            reference->VoxelCount++;
+          }
+          int idx = vtkMath::Floor(
+            (v - accumulate->GetComponentOrigin()[c]) / accumulate->GetComponentSpacing()[c]);
+          inside &= (idx >= extent[2 * c] && idx <= extent[2 * c + 1]);
+          bin += (idx - extent[2 * c]) * incs[c];
+        }
+        if (inside)
+        {
+          reference->Bins[bin]++;
+        }
+      }
+    }
+  }
+  for (int c = 0; c < 3; ++c)
+  {
+    reference->Mean[c] = (reference->VoxelCount ? sum[c] / reference->VoxelCount : 0.0);
+  }
+}
+
+bool Check(vtkImageData* image, vtkImageAccumulate* accumulate, vtkImageStencilData* stencil,
+  const char* name)
+{
+  Reference reference;
+  Accumulate(image, accumulate, stencil, &reference);
+  accumulate->Update();
+
+  bool success = (accumulate->GetVoxelCount() == reference.VoxelCount);
+  for (int c = 0; c < 3; ++c)
+  {
+    success &= (accumulate->GetMin()[c] == reference.Min[c]);
+    success &= (accumulate->GetMax()[c] == reference.Max[c]);
+    success &= (std::abs(accumulate->GetMean()[c] - reference.Mean[c]) <=
+      1e-12 * (1.0 + std::abs(reference.Mean[c])));
+  }
+  if (!success)
+  {
+    std::cerr << name << ": the statistics differ.\n";
+    return false;
+  }
+
+  if (accumulate->GetSparseOutput())
+  {
+    vtkIdTypeArray* indices = accumulate->GetSparseBinIndices();
+    vtkIdTypeArray* counts = accumulate->GetSparseBinCounts();
+    if (counts->GetNumberOfValues() != static_cast<vtkIdType>(reference.Bins.size()) ||
+      indices->GetNumberOfTuples() != counts->GetNumberOfValues() ||
+      accumulate->GetOutput()->GetPointData()->GetScalars() != nullptr)
+    {
+      std::cerr << name << ": " << counts->GetNumberOfValues() << " sparse bins instead of "
+                << reference.Bins.size() << ".\n";
+      return false;
+    }
+    const int* extent = accumulate->GetComponentExtent();
+    vtkIdType nx = extent[1] - extent[0] + 1;
+    vtkIdType ny = extent[3] - extent[2] + 1;
+    vtkIdType i = 0;
+    for (const auto& bin : reference.Bins)
+    {
+      vtkIdType idx[3];
+      indices->GetTypedTuple(i, idx);
+      vtkIdType binId =
+        (idx[0] - extent[0]) + nx * ((idx[1] - extent[2]) + ny * (idx[2] - extent[4]));
+      if (binId != bin.first || counts->GetValue(i) != bin.second)
+      {
+        std::cerr << name << ": sparse bin " << i << " differs.\n";
+        return false;
+      }
+      ++i;
+    }
+  }
+  else
+  {
+    vtkDataArray* bins = accumulate->GetOutput()->GetPointData()->GetScalars();
+    for (vtkIdType i = 0; i < bins->GetNumberOfTuples(); ++i)
+    {
+      auto it = reference.Bins.find(i);
+      vtkIdType expected = (it == reference.Bins.end() ? 0 : it->second);
+      if (static_cast<vtkIdType>(bins->GetComponent(i, 0)) != expected)
+      {
+        std::cerr << name << ": bin " << i << " has " << bins->GetComponent(i, 0) << " instead of "
+                  << expected << ".\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int ImageAccumulateJoint(int, char*[])
+{
+  vtkNew<vtkImageAccumulate> accumulate;
+  bool success = true;
+
+  // joint histogram of two short components, through the tables of bins
+  vtkNew<vtkImageData> shortImage;
+  FillImage(shortImage, VTK_SHORT, 2, -2000.0, 2000.0);
+  accumulate->SetInputData(shortImage);
+  accumulate->SetComponentOrigin(-1000.0, -1500.0, 0.0);
+  accumulate->SetComponentSpacing(25.0, 40.0, 1.0);
+  accumulate->SetComponentExtent(0, 79, 0, 69, 0, 0);
+  success &= Check(shortImage, accumulate, nullptr, "Short");
+  accumulate->IgnoreZeroOn();
+  success &= Check(shortImage, accumulate, nullptr, "Short ignoring zero");
+  accumulate->IgnoreZeroOff();
+
+  // a stencil of a sphere, and its reverse
+  vtkNew<vtkImageStencilData> stencil;
+  stencil->SetExtent(0, Dims[0] - 1, 0, Dims[1] - 1, 0, Dims[2] - 1);
+  stencil->AllocateExtents();
+  for (int k = 0; k < Dims[2]; ++k)
+  {
+    for (int j = 0; j < Dims[1]; ++j)
+    {
+      double r2 = 225.0 - (j - 16.0) * (j - 16.0) - (k - 8.0) * (k - 8.0) * 3.0;
+      if (r2 > 0)
+      {
+        int r = static_cast<int>(sqrt(r2));
+        stencil->InsertNextExtent(20 - r, 20 + r, j, k);
+      }
+    }
+  }
+  accumulate->SetStencilData(stencil);
+  success &= Check(shortImage, accumulate, stencil, "Short with stencil");
+  accumulate->ReverseStencilOn();
+  success &= Check(shortImage, accumulate, stencil, "Short with reverse stencil");
+  accumulate->ReverseStencilOff();
+  accumulate->SetStencilData(nullptr);
+
+  // the same joint histogram as a sparse histogram
+  accumulate->SparseOutputOn();
+  success &= Check(shortImage, accumulate, nullptr, "Short sparse");
+
+  // a sparse joint histogram with too many bins for an image
+  accumulate->SetComponentOrigin(-2000.0, -2000.0, 0.0);
+  accumulate->SetComponentSpacing(1.0, 1.0, 1.0);
+  accumulate->SetComponentExtent(0, 3999, 0, 3999, 0, 0);
+  success &= Check(shortImage, accumulate, nullptr, "Short sparse fine bins");
+  accumulate->SparseOutputOff();
+
+  // three unsigned char components, through the tables of bins
+  vtkNew<vtkImageData> charImage;
+  FillImage(charImage, VTK_UNSIGNED_CHAR, 3, 0.0, 255.0);
+  accumulate->SetInputData(charImage);
+  accumulate->SetComponentOrigin(0.0, 0.0, 0.0);
+  accumulate->SetComponentSpacing(8.0, 16.0, 32.0);
+  accumulate->SetComponentExtent(0, 31, 0, 15, 1, 6);
+  success &= Check(charImage, accumulate, nullptr, "Unsigned char");
+
+  // two float components, without tables
+  vtkNew<vtkImageData> floatImage;
+  FillImage(floatImage, VTK_FLOAT, 2, -1.0, 1.0);
+  accumulate->SetInputData(floatImage);
+  accumulate->SetComponentOrigin(-1.0, -0.5, 0.0);
+  accumulate->SetComponentSpacing(0.05, 0.025, 1.0);
+  accumulate->SetComponentExtent(0, 39, 0, 39, 0, 0);
+  success &= Check(floatImage, accumulate, nullptr, "Float");
+  accumulate->SparseOutputOn();
+  success &= Check(floatImage, accumulate, nullptr, "Float sparse");
+
+  return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ImageInterpolateRows.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the rows that the image interpolators compute from precomputed
+// weights with the interpolation of each point, for permutation matrices
+// with various scales and border modes.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageInterpolator.h"
+#include "vtkImageSincInterpolator.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+vtkSmartPointer<vtkImageData> MakeImage(int scalarType, int numComps, int nx, int ny, int nz)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(nx, ny, nz);
+  image->AllocateScalars(scalarType, numComps);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  unsigned int state = 1;
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    state = state * 1103515245u + 12345u;
+    scalars->SetVariantValue(i, static_cast<double>((state >> 16) % 200));
+  }
+  return image;
+}
+
+bool TestRows(vtkAbstractImageInterpolator* interpolator, vtkImageData* image, int borderMode)
+{
+  // each matrix maps output indices to input indices
+  const double matrices[][16] = {
+    { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },
+    { 1, 0, 0, 0, 0, 1, 0, 0.5, 0, 0, 0.5, 0.25, 0, 0, 0, 1 },
+    { 0.7, 0, 0, 0.3, 0, 1.3, 0, -0.5, 0, 0, 1, 0.6, 0, 0, 0, 1 },
+    { -1, 0, 0, 9, 0, 0, 1, 0.2, 0, 1, 0, 0, 0, 0, 0, 1 },
+    { 0, 2.5, 0, 1.1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },
+    { 0.25, 0, 0, -2, 0, 0.5, 0, 0, 0, 0, 1, 1.5, 0, 0, 0, 1 },
+  };
+  const int extent[6] = { 0, 40, 0, 8, 0, 4 };
+
+  interpolator->SetBorderMode(borderMode);
+  interpolator->Initialize(image);
+  interpolator->Update();
+  const int numComps = interpolator->GetNumberOfComponents();
+  std::vector<double> row((extent[1] - extent[0] + 1) * numComps);
+  std::vector<double> value(numComps);
+  for (const double* matrix : matrices)
+  {
+    int clipExt[6];
+    vtkInterpolationWeights* weights;
+    // only the clipped extent lies within the bounds of the input
+    interpolator->PrecomputeWeightsForExtent(matrix, extent, clipExt, weights);
+    for (int k = clipExt[4]; k <= clipExt[5]; ++k)
+    {
+      for (int j = clipExt[2]; j <= clipExt[3]; ++j)
+      {
+        interpolator->InterpolateRow(
+          weights, clipExt[0], j, k, row.data(), clipExt[1] - clipExt[0] + 1);
+        for (int i = clipExt[0]; i <= clipExt[1]; ++i)
+        {
+          double point[3];
+          for (int r = 0; r < 3; ++r)
+          {
+            point[r] = matrix[4 * r] * i + matrix[4 * r + 1] * j + matrix[4 * r + 2] * k +
+              matrix[4 * r + 3];
+          }
+          interpolator->InterpolateIJK(point, value.data());
+          for (int c = 0; c < numComps; ++c)
+          {
+            if (std::abs(row[(i - clipExt[0]) * numComps + c] - value[c]) > 1e-6)
+            {
+              std::cerr << interpolator->GetClassName() << " with border mode " << borderMode
+                        << ": row value " << row[(i - clipExt[0]) * numComps + c]
+                        << " differs from " << value[c] << " at (" << i << ", " << j << ", " << k
+                        << ").\n";
+              interpolator->FreePrecomputedWeights(weights);
+              return false;
+            }
+          }
+        }
+      }
+    }
+    interpolator->FreePrecomputedWeights(weights);
+  }
+  interpolator->ReleaseData();
+  return true;
+}
+
+} // end anon namespace
+
+int ImageInterpolateRows(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> images[] = { MakeImage(VTK_UNSIGNED_CHAR, 1, 23, 17, 9),
+    MakeImage(VTK_FLOAT, 3, 23, 17, 9), MakeImage(VTK_SHORT, 1, 1100, 4, 3) };
+  for (vtkImageData* image : images)
+  {
+    for (int borderMode = VTK_IMAGE_BORDER_CLAMP; borderMode <= VTK_IMAGE_BORDER_MIRROR;
+         ++borderMode)
+    {
+      for (int mode = VTK_NEAREST_INTERPOLATION; mode <= VTK_CUBIC_INTERPOLATION; ++mode)
+      {
+        vtkNew<vtkImageInterpolator> interpolator;
+        interpolator->SetInterpolationMode(mode);
+        if (!TestRows(interpolator, image, borderMode))
+        {
+          return EXIT_FAILURE;
+        }
+      }
+      vtkNew<vtkImageSincInterpolator> sinc;
+      if (!TestRows(sinc, image, borderMode))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ImagePointwiseFuse.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare vtkImagePointwiseFuse with the chains of filters that it replaces,
+// for short input with and without the table of results for each value,
+// and for float input with two components.
+
+#include "vtkDataArray.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageMapToColors.h"
+#include "vtkImageMathematics.h"
+#include "vtkImagePointwiseFuse.h"
+#include "vtkImageShiftScale.h"
+#include "vtkImageThreshold.h"
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <iostream>
+
+namespace
+{
+
+void FillImage(vtkImageData* image, int dims, int scalarType, int numComps, double minval,
+  double maxval)
+{
+  image->SetDimensions(dims, dims, 20);
+  image->AllocateScalars(scalarType, numComps);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  unsigned int state = 1;
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    state = state * 1103515245u + 12345u;
+    scalars->SetVariantValue(i, minval + (maxval - minval) * ((state >> 8) % 65536) / 65535.0);
+  }
+}
+
+bool Compare(vtkImageData* image, vtkImageData* expected, const char* name)
+{
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  vtkDataArray* expectedScalars = expected->GetPointData()->GetScalars();
+  if (scalars->GetDataType() != expectedScalars->GetDataType() ||
+    scalars->GetNumberOfComponents() != expectedScalars->GetNumberOfComponents() ||
+    scalars->GetNumberOfTuples() != expectedScalars->GetNumberOfTuples())
+  {
+    std::cerr << name << ": the output has the wrong type or size.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    if (scalars->GetVariantValue(i) != expectedScalars->GetVariantValue(i))
+    {
+      std::cerr << name << ": value " << scalars->GetVariantValue(i).ToDouble()
+                << " differs from " << expectedScalars->GetVariantValue(i).ToDouble() << " at "
+                << i << ".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+// ShiftScale -> Cast -> Mathematics -> Threshold -> MapToColors
+bool TestShortChain(int dims)
+{
+  vtkNew<vtkImageData> image;
+  FillImage(image, dims, VTK_SHORT, 1, -3000.0, 3000.0);
+
+  vtkNew<vtkImageShiftScale> shiftScale;
+  shiftScale->SetInputData(image);
+  shiftScale->SetShift(100.0);
+  shiftScale->SetScale(0.75);
+  shiftScale->SetOutputScalarTypeToFloat();
+  shiftScale->ClampOverflowOn();
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputConnection(shiftScale->GetOutputPort());
+  cast->SetOutputScalarTypeToShort();
+  cast->ClampOverflowOn();
+  vtkNew<vtkImageMathematics> mathematics;
+  mathematics->SetInputConnection(cast->GetOutputPort());
+  mathematics->SetOperationToAbsoluteValue();
+  vtkNew<vtkImageThreshold> threshold;
+  threshold->SetInputConnection(mathematics->GetOutputPort());
+  threshold->ThresholdByUpper(500.0);
+  threshold->SetOutValue(0.0);
+  vtkNew<vtkLookupTable> table;
+  table->SetRange(0.0, 2500.0);
+  vtkNew<vtkImageMapToColors> colors;
+  colors->SetInputConnection(threshold->GetOutputPort());
+  colors->SetLookupTable(table);
+  colors->Update();
+  threshold->Update();
+
+  vtkNew<vtkImagePointwiseFuse> fuse;
+  fuse->SetInputData(image);
+  fuse->AddShiftScale(100.0, 0.75);
+  fuse->AddCast(VTK_FLOAT);
+  fuse->AddCast(VTK_SHORT);
+  fuse->AddMathematics(vtkImagePointwiseFuse::AbsoluteValue);
+  fuse->AddThreshold(500.0, VTK_DOUBLE_MAX, 0, 0.0, 1, 0.0);
+  if (fuse->GetNumberOfOperations() != 5 || fuse->GetOperation(3) != 9)
+  {
+    std::cerr << "The operations were not added.\n";
+    return false;
+  }
+  fuse->Update();
+  bool success = Compare(fuse->GetOutput(), threshold->GetOutput(), "Short");
+  fuse->SetLookupTable(table);
+  fuse->Update();
+  success &= Compare(fuse->GetOutput(), colors->GetOutput(), "Short colors");
+  return success;
+}
+
+// Mathematics -> Mathematics -> Mathematics -> Mathematics -> Threshold
+bool TestFloatChain()
+{
+  vtkNew<vtkImageData> image;
+  FillImage(image, 24, VTK_FLOAT, 2, 1.0, 1000.0);
+
+  vtkNew<vtkImageMathematics> multiply;
+  multiply->SetInputData(image);
+  multiply->SetOperationToMultiplyByK();
+  multiply->SetConstantK(0.01);
+  vtkNew<vtkImageMathematics> add;
+  add->SetInputConnection(multiply->GetOutputPort());
+  add->SetOperationToAddConstant();
+  add->SetConstantC(2.0);
+  vtkNew<vtkImageMathematics> log;
+  log->SetInputConnection(add->GetOutputPort());
+  log->SetOperationToLog();
+  vtkNew<vtkImageMathematics> square;
+  square->SetInputConnection(log->GetOutputPort());
+  square->SetOperationToSquare();
+  vtkNew<vtkImageThreshold> threshold;
+  threshold->SetInputConnection(square->GetOutputPort());
+  threshold->ThresholdBetween(1.0, 4.0);
+  threshold->SetInValue(1.0);
+  threshold->Update();
+
+  // the filters store each result as float
+  vtkNew<vtkImagePointwiseFuse> fuse;
+  fuse->SetInputData(image);
+  fuse->AddMathematics(vtkImagePointwiseFuse::MultiplyByK, 0.0, 0.01);
+  fuse->AddCast(VTK_FLOAT);
+  fuse->AddMathematics(vtkImagePointwiseFuse::AddConstant, 2.0);
+  fuse->AddCast(VTK_FLOAT);
+  fuse->AddMathematics(vtkImagePointwiseFuse::Log);
+  fuse->AddCast(VTK_FLOAT);
+  fuse->AddMathematics(vtkImagePointwiseFuse::Square);
+  fuse->AddCast(VTK_FLOAT);
+  fuse->AddThreshold(1.0, 4.0, 1, 1.0, 0, 0.0);
+  fuse->Update();
+  bool success = Compare(fuse->GetOutput(), threshold->GetOutput(), "Float");
+
+  // no operations and another output type
+  fuse->RemoveAllOperations();
+  fuse->SetOutputScalarTypeToUnsignedChar();
+  fuse->Update();
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputData(image);
+  cast->SetOutputScalarTypeToUnsignedChar();
+  cast->ClampOverflowOn();
+  cast->Update();
+  success &= Compare(fuse->GetOutput(), cast->GetOutput(), "Float to unsigned char");
+  return success;
+}
+
+} // end anon namespace
+
+int ImagePointwiseFuse(int, char*[])
+{
+  // the larger image has enough values to use a table for the short type
+  bool success = TestShortChain(64);
+  success &= TestShortChain(16);
+  success &= TestFloatChain();
+  return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
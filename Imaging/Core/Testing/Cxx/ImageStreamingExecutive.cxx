@@ -0,0 +1,251 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    ImageStreamingExecutive.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Stream a pipeline of filters with borders through vtkImageStreamingExecutive
+// and compare its output with the output of the same pipeline in one piece.
+
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkImageGradientMagnitude.h"
+#include "vtkImageStreamingExecutive.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+
+#include <iostream>
+
+namespace
+{
+
+class ExecuteCounter : public vtkCommand
+{
+public:
+  static ExecuteCounter* New() { return new ExecuteCounter; }
+  void Execute(vtkObject*, unsigned long, void*) override { ++this->Count; }
+  int Count = 0;
+};
+
+// A source that fails once it has executed FailAfter times, if that is not
+// negative.
+class FailingSource : public vtkRTAnalyticSource
+{
+public:
+  static FailingSource* New();
+  vtkTypeMacro(FailingSource, vtkRTAnalyticSource);
+  int FailAfter = -1;
+
+protected:
+  FailingSource() = default;
+
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    if (this->FailAfter == 0)
+    {
+      return 0;
+    }
+    if (this->FailAfter > 0)
+    {
+      --this->FailAfter;
+    }
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+};
+
+vtkStandardNewMacro(FailingSource);
+
+// Build source -> smooth -> gradient magnitude -> cast, where the cast has
+// the given executive (it must be set before the input is connected).
+vtkImageCast* MakePipeline(vtkRTAnalyticSource* source, vtkExecutive* executive)
+{
+  source->SetWholeExtent(0, 47, 0, 39, 0, 31);
+  vtkImageGaussianSmooth* smooth = vtkImageGaussianSmooth::New();
+  smooth->SetInputConnection(source->GetOutputPort());
+  smooth->SetStandardDeviations(1.5, 1.5, 1.5);
+  vtkImageGradientMagnitude* gradient = vtkImageGradientMagnitude::New();
+  gradient->SetInputConnection(smooth->GetOutputPort());
+  gradient->SetDimensionality(3);
+  gradient->HandleBoundariesOn();
+  vtkImageCast* cast = vtkImageCast::New();
+  if (executive)
+  {
+    cast->SetExecutive(executive);
+  }
+  cast->SetInputConnection(gradient->GetOutputPort());
+  cast->SetOutputScalarTypeToFloat();
+  smooth->Delete();
+  gradient->Delete();
+  return cast;
+}
+
+bool Compare(vtkImageData* image, vtkImageData* expected, const char* name)
+{
+  int extent[6], expectedExt[6];
+  image->GetExtent(extent);
+  expected->GetExtent(expectedExt);
+  for (int i = 0; i < 6; ++i)
+  {
+    if (extent[i] != expectedExt[i])
+    {
+      std::cerr << name << ": the extent of the output is wrong.\n";
+      return false;
+    }
+  }
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  vtkDataArray* expectedScalars = expected->GetPointData()->GetScalars();
+  if (!scalars || scalars->GetDataType() != VTK_FLOAT ||
+    scalars->GetNumberOfTuples() != expectedScalars->GetNumberOfTuples())
+  {
+    std::cerr << name << ": the output has the wrong scalars.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+  {
+    if (scalars->GetComponent(i, 0) != expectedScalars->GetComponent(i, 0))
+    {
+      std::cerr << name << ": value " << scalars->GetComponent(i, 0) << " differs from "
+                << expectedScalars->GetComponent(i, 0) << " at " << i << ".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int ImageStreamingExecutive(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> referenceSource;
+  vtkImageCast* reference = MakePipeline(referenceSource, nullptr);
+  reference->Update();
+
+  vtkNew<FailingSource> source;
+  vtkNew<ExecuteCounter> counter;
+  source->AddObserver(vtkCommand::StartEvent, counter);
+  vtkNew<vtkImageStreamingExecutive> executive;
+  vtkImageCast* cast = MakePipeline(source, executive);
+
+  // without a limit, the pipeline executes once
+  cast->Update();
+  bool success = Compare(cast->GetOutput(), reference->GetOutput(), "No limit");
+  if (executive->GetNumberOfPieces() != 1 || counter->Count != 1)
+  {
+    std::cerr << "The pipeline without a limit was streamed.\n";
+    success = false;
+  }
+
+  // the whole pipeline needs about 1 MiB, so 256 KiB needs several slabs
+  const int modes[2] = { 2, 1 };
+  for (int mode : modes)
+  {
+    executive->SetSplitMode(mode);
+    executive->SetMemoryLimit(256);
+    source->Modified();
+    counter->Count = 0;
+    cast->Update();
+    success &= Compare(cast->GetOutput(), reference->GetOutput(), "Slabs");
+    if (executive->GetNumberOfPieces() < 2 || counter->Count != executive->GetNumberOfPieces() ||
+      executive->GetEstimatedMemorySize() > executive->GetMemoryLimit())
+    {
+      std::cerr << "Split mode " << mode << ": " << executive->GetNumberOfPieces()
+                << " pieces for " << counter->Count << " executions, estimated "
+                << executive->GetEstimatedMemorySize() << " KiB.\n";
+      success = false;
+    }
+
+    // an update of an up-to-date pipeline does not execute it again
+    counter->Count = 0;
+    cast->Update();
+    if (counter->Count != 0)
+    {
+      std::cerr << "The up-to-date pipeline executed again.\n";
+      success = false;
+    }
+  }
+
+  // a limit that slabs of one slice cannot meet needs blocks
+  executive->SetSplitMode(2);
+  executive->SetMemoryLimit(16);
+  source->Modified();
+  cast->Update();
+  success &= Compare(cast->GetOutput(), reference->GetOutput(), "Blocks");
+  if (executive->GetNumberOfPieces() <= 32)
+  {
+    std::cerr << "Only " << executive->GetNumberOfPieces() << " pieces for blocks.\n";
+    success = false;
+  }
+
+  // a smaller update extent is streamed within itself
+  const int updateExt[6] = { 4, 40, 2, 30, 3, 20 };
+  executive->SetMemoryLimit(128);
+  source->Modified();
+  cast->UpdateExtent(updateExt);
+  vtkImageData* output = cast->GetOutput();
+  int* extent = output->GetExtent();
+  if (extent[0] != 4 || extent[1] != 40 || extent[4] != 3 || extent[5] != 20)
+  {
+    std::cerr << "The smaller update extent has output " << extent[0] << ", " << extent[1]
+              << ", " << extent[4] << ", " << extent[5] << ".\n";
+    success = false;
+  }
+  else
+  {
+    for (int k = 3; k <= 20 && success; ++k)
+    {
+      for (int j = 2; j <= 30 && success; ++j)
+      {
+        for (int i = 4; i <= 40 && success; ++i)
+        {
+          float value = output->GetScalarComponentAsFloat(i, j, k, 0);
+          float expected = reference->GetOutput()->GetScalarComponentAsFloat(i, j, k, 0);
+          if (value != expected)
+          {
+            std::cerr << "The smaller update extent differs at " << i << ", " << j << ", " << k
+                      << ".\n";
+            success = false;
+          }
+        }
+      }
+    }
+  }
+
+  // a failed piece fails the update, and the pipeline streams again once the
+  // source recovers
+  const int wholeExt[6] = { 0, 47, 0, 39, 0, 31 };
+  vtkObject::GlobalWarningDisplayOff();
+  for (int failAfter = 0; failAfter < 2; ++failAfter)
+  {
+    source->FailAfter = failAfter;
+    source->Modified();
+    if (cast->UpdateExtent(wholeExt))
+    {
+      std::cerr << "The update did not fail after " << failAfter << " pieces.\n";
+      success = false;
+    }
+  }
+  vtkObject::GlobalWarningDisplayOn();
+  source->FailAfter = -1;
+  source->Modified();
+  cast->UpdateExtent(wholeExt);
+  success &= Compare(cast->GetOutput(), reference->GetOutput(), "After a failure");
+
+  reference->Delete();
+  cast->Delete();
+  return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -517,6 +517,18 @@ void vtkImageNLCRowInterpolate<F, T>::Nearest(
   // get the number of components per pixel
   int numscalars = weights->NumberOfComponents;
 
+  // consecutive pixels are converted in one loop that can be vectorized
+  if (vtkInterpolationIsContiguous(iX, numscalars, n))
+  {
+    const T* tmpPtr = &inPtr0[iX[0]];
+    vtkIdType m = static_cast<vtkIdType>(n) * numscalars;
+    for (vtkIdType i = 0; i < m; i++)
+    {
+      outPtr[i] = tmpPtr[i];
+    }
+    return;
+  }
+
   // This is a hot loop.
   for (int i = n; i > 0; --i)
   {
@@ -590,6 +602,28 @@ void vtkImageNLCRowInterpolate<F, T>::Trilinear(
   F fyrz = fy * rz;
   F fyfz = fy * fz;
 
+  // consecutive pixels are blended in y and z in one vectorizable loop
+  // (when x is interpolated, blending first does not pay for two taps)
+  if (stepX == 1 && vtkInterpolationIsContiguous(iX, numscalars, n))
+  {
+    const vtkIdType allOffsets[4] = { i00, i01, i10, i11 };
+    const F allWeights[4] = { ryrz, ryfz, fyrz, fyfz };
+    vtkIdType offsets[4] = { i00, 0, 0, 0 };
+    F w[4] = { ryrz, 0, 0, 0 };
+    int ntaps = 1;
+    for (int t = 1; t < 4; t++)
+    {
+      if (allWeights[t] != 0)
+      {
+        offsets[ntaps] = allOffsets[t];
+        w[ntaps++] = allWeights[t];
+      }
+    }
+    vtkInterpolationRow<F, T>::Blend(
+      inPtr + iX[0], offsets, w, ntaps, outPtr, static_cast<vtkIdType>(n) * numscalars);
+    return;
+  }
+
   if (stepX == 1)
   {
     if (fy == 0 && fz == 0)
@@ -707,6 +741,25 @@ void vtkImageNLCRowInterpolate<F, T>::Tricubic(
   // get the number of components per pixel
   int numscalars = weights->NumberOfComponents;
 
+  // blend the rows in y and z, then interpolate the blended row in x
+  vtkIdType offsets[16];
+  F w[16];
+  int ntaps = 0;
+  for (int k = 0; k < stepZ; k++)
+  {
+    for (int j = 0; j < stepY && fZ[k] != 0; j++)
+    {
+      offsets[ntaps] = iZ[k] + iY[j];
+      w[ntaps++] = fZ[k] * fY[j];
+    }
+  }
+  if (ntaps > 0 &&
+    vtkInterpolationRow<F, T>::Interpolate(inPtr, offsets, w, ntaps, iX,
+      (stepX == 1 ? nullptr : fX), stepX, numscalars, outPtr, n))
+  {
+    return;
+  }
+
   for (int i = n; i > 0; --i)
   {
     vtkIdType iX0 = iX[0];
@@ -961,7 +1014,7 @@ void vtkImageInterpolatorPrecomputeWeights(const F newmat[16], const int outExt[
             }
             for (int jj = 0; jj < step; jj++)
             {
-              positions[step * i + jj] = minExt + jj;
+              positions[step * i + jj] = (minExt + jj) * inInc;
               constants[step * i + jj] = gg[jj];
             }
           }
@@ -202,5 +202,253 @@ inline int vtkInterpolationMath::Mirror(int a, int b, int c)
 #endif
 }
 
+//--------------------------------------------------------------------------
+// Separable evaluation of the row kernels for precomputed weights.  The
+// input rows that the kernel reaches in y and z are blended into one
+// contiguous row with the y and z weights, and then the x weights are
+// applied to the blended row.  The blend runs over contiguous memory, so
+// the compiler can vectorize it for the target architecture, and each
+// blended value is shared by all the output samples whose x kernels reach
+// it, instead of being computed again for each of them.
+
+#define VTK_INTERPOLATE_ROW_BUFFER_SIZE 1024
+
+template <class F, class T>
+struct vtkInterpolationRow
+{
+  // Set outPtr[i] to the sum of w[t]*inPtr[offsets[t] + i] for all taps t.
+  static void Blend(
+    const T* inPtr, const vtkIdType* offsets, const F* w, int ntaps, F* outPtr, vtkIdType count);
+
+  // Sum M taps into outPtr, or add them to it if first is false.
+  template <int M>
+  static void BlendPass(const T* const p[], const F w[], F* outPtr, vtkIdType count, bool first);
+
+  // Apply the x weights (or a weight of one if fX is null) to the row that
+  // was blended into buffer from position lo, for count samples.  The kernel
+  // size is K, or stepX if K is zero.
+  template <int K>
+  static void Apply(const F* buffer, vtkIdType lo, const vtkIdType* iX, const F* fX,
+    int numscalars, F* outPtr, int count, int stepX = K);
+
+  // Interpolate n samples, given the offsets and weights of the y and z
+  // taps, and the x positions iX and weights fX of each sample (the x
+  // weights are taken to be one if fX is null).  Returns false without
+  // doing anything if the x positions are too sparse for the blend to pay.
+  static bool Interpolate(const T* inPtr, const vtkIdType* offsets, const F* w, int ntaps,
+    const vtkIdType* iX, const F* fX, int stepX, int numscalars, F* outPtr, int n);
+};
+
+//--------------------------------------------------------------------------
+// Whether the n pixels at positions iX are consecutive in memory.
+inline bool vtkInterpolationIsContiguous(const vtkIdType* iX, int numscalars, int n)
+{
+  if (n <= 0)
+  {
+    return false;
+  }
+  vtkIdType position = iX[0];
+  for (int i = 1; i < n; i++)
+  {
+    position += numscalars;
+    if (iX[i] != position)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//--------------------------------------------------------------------------
+template <class F, class T>
+void vtkInterpolationRow<F, T>::Blend(
+  const T* inPtr, const vtkIdType* offsets, const F* w, int ntaps, F* outPtr, vtkIdType count)
+{
+  // the taps are summed in order, up to four of them in each pass
+  for (int t = 0; t < ntaps; t += 4)
+  {
+    const T* p[4] = { inPtr, inPtr, inPtr, inPtr };
+    for (int l = 0; l < 4 && t + l < ntaps; l++)
+    {
+      p[l] = inPtr + offsets[t + l];
+    }
+    switch (ntaps - t)
+    {
+      case 1:
+        BlendPass<1>(p, w + t, outPtr, count, t == 0);
+        break;
+      case 2:
+        BlendPass<2>(p, w + t, outPtr, count, t == 0);
+        break;
+      case 3:
+        BlendPass<3>(p, w + t, outPtr, count, t == 0);
+        break;
+      default:
+        BlendPass<4>(p, w + t, outPtr, count, t == 0);
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+template <class F, class T>
+template <int M>
+void vtkInterpolationRow<F, T>::BlendPass(
+  const T* const p[], const F w[], F* outPtr, vtkIdType count, bool first)
+{
+  const T* p0 = p[0];
+  const T* p1 = p[M > 1 ? 1 : 0];
+  const T* p2 = p[M > 2 ? 2 : 0];
+  const T* p3 = p[M > 3 ? 3 : 0];
+  F w0 = w[0];
+  F w1 = w[M > 1 ? 1 : 0];
+  F w2 = w[M > 2 ? 2 : 0];
+  F w3 = w[M > 3 ? 3 : 0];
+  for (vtkIdType i = 0; i < count; i++)
+  {
+    F v = (first ? w0 * p0[i] : outPtr[i] + w0 * p0[i]);
+    v = (M > 1 ? v + w1 * p1[i] : v);
+    v = (M > 2 ? v + w2 * p2[i] : v);
+    v = (M > 3 ? v + w3 * p3[i] : v);
+    outPtr[i] = v;
+  }
+}
+
+//--------------------------------------------------------------------------
+template <class F, class T>
+template <int K>
+void vtkInterpolationRow<F, T>::Apply(const F* buffer, vtkIdType lo, const vtkIdType* iX,
+  const F* fX, int numscalars, F* outPtr, int count, int stepX)
+{
+  const int step = (K ? K : stepX);
+  for (int i = 0; i < count; i++)
+  {
+    const F* tmpPtr = &buffer[iX[0] - lo];
+    int c = numscalars;
+    do
+    {
+      F result;
+      if (!fX)
+      {
+        result = tmpPtr[0];
+      }
+      else if (K == 2)
+      {
+        result = fX[0] * tmpPtr[0] + fX[1] * tmpPtr[iX[1] - iX[0]];
+      }
+      else
+      {
+        result = 0;
+        for (int l = 0; l < step; l++)
+        {
+          result += fX[l] * tmpPtr[iX[l] - iX[0]];
+        }
+      }
+      *outPtr++ = result;
+      tmpPtr++;
+    } while (--c);
+    iX += step;
+    fX = (fX ? fX + step : fX);
+  }
+}
+
+//--------------------------------------------------------------------------
+template <class F, class T>
+bool vtkInterpolationRow<F, T>::Interpolate(const T* inPtr, const vtkIdType* offsets, const F* w,
+  int ntaps, const vtkIdType* iX, const F* fX, int stepX, int numscalars, F* outPtr, int n)
+{
+  if (n <= 0)
+  {
+    return true;
+  }
+
+  // consecutive pixels without x weights are blended into the output
+  if (stepX == 1 && !fX && vtkInterpolationIsContiguous(iX, numscalars, n))
+  {
+    Blend(inPtr + iX[0], offsets, w, ntaps, outPtr, static_cast<vtkIdType>(n) * numscalars);
+    return true;
+  }
+
+  // the blend must not cover more values than the x kernels read
+  vtkIdType m = static_cast<vtkIdType>(n) * stepX;
+  vtkIdType lo = iX[0];
+  vtkIdType hi = iX[0];
+  for (vtkIdType j = 1; j < m; j++)
+  {
+    lo = (iX[j] < lo ? iX[j] : lo);
+    hi = (iX[j] > hi ? iX[j] : hi);
+  }
+  if (hi - lo > m * numscalars)
+  {
+    return false;
+  }
+
+  F buffer[VTK_INTERPOLATE_ROW_BUFFER_SIZE];
+  int i = 0;
+  while (i < n)
+  {
+    // take as many samples as the buffer can blend for
+    int count = n - i;
+    for (;;)
+    {
+      lo = iX[0];
+      hi = iX[0];
+      for (int j = 1; j < count * stepX; j++)
+      {
+        lo = (iX[j] < lo ? iX[j] : lo);
+        hi = (iX[j] > hi ? iX[j] : hi);
+      }
+      if (hi - lo + numscalars <= VTK_INTERPOLATE_ROW_BUFFER_SIZE || count == 1)
+      {
+        break;
+      }
+      count = (count + 1) / 2;
+    }
+
+    if (hi - lo + numscalars <= VTK_INTERPOLATE_ROW_BUFFER_SIZE)
+    {
+      Blend(inPtr + lo, offsets, w, ntaps, buffer, hi - lo + numscalars);
+      switch (fX ? stepX : 0)
+      {
+        case 0:
+          Apply<1>(buffer, lo, iX, nullptr, numscalars, outPtr, count);
+          break;
+        case 2:
+          Apply<2>(buffer, lo, iX, fX, numscalars, outPtr, count);
+          break;
+        case 4:
+          Apply<4>(buffer, lo, iX, fX, numscalars, outPtr, count);
+          break;
+        default:
+          Apply<0>(buffer, lo, iX, fX, numscalars, outPtr, count, stepX);
+      }
+      outPtr += static_cast<vtkIdType>(count) * numscalars;
+      iX += count * stepX;
+      fX = (fX ? fX + count * stepX : fX);
+    }
+    else
+    {
+      // a kernel that wraps around the input is summed directly
+      for (int c = 0; c < numscalars; c++)
+      {
+        F result = 0;
+        for (int l = 0; l < stepX; l++)
+        {
+          F value = 0;
+          for (int t = 0; t < ntaps; t++)
+          {
+            value += w[t] * inPtr[iX[l] + offsets[t] + c];
+          }
+          result += (fX ? fX[l] : static_cast<F>(1)) * value;
+        }
+        *outPtr++ = result;
+      }
+      iX += stepX;
+      fX = (fX ? fX + stepX : fX);
+    }
+    i += count;
+  }
+  return true;
+}
+
 #endif
 // VTK-HeaderTest-Exclude: vtkImageInterpolatorInternals.h
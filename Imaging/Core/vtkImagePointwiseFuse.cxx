@@ -0,0 +1,574 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImagePointwiseFuse.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImagePointwiseFuse.h"
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageProgressIterator.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkScalarsToColors.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTypeTraits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+vtkStandardNewMacro(vtkImagePointwiseFuse);
+vtkCxxSetObjectMacro(vtkImagePointwiseFuse, LookupTable, vtkScalarsToColors);
+
+//----------------------------------------------------------------------------
+// An operation with its parameters, which for a cast are the range of the
+// type and whether it is an integer type or float.
+struct vtkImagePointwiseFuseOperation
+{
+  int Operation;
+  double Parameters[6];
+};
+
+typedef std::vector<vtkImagePointwiseFuseOperation> vtkImagePointwiseFuseOperations;
+
+class vtkImagePointwiseFuse::vtkInternals
+{
+public:
+  vtkImagePointwiseFuseOperations Operations;
+
+  // The results for each value of an 8 or 16 bit input type, starting at
+  // the minimum of the type, as output values or as colors.
+  std::vector<double> ValueTable;
+  std::vector<unsigned char> ColorTable;
+  int TableMinimum = 0;
+};
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Clamp a value to a range.  NaN is kept for floating-point types, and
+// goes to the minimum for integer types, for which it has no value.
+template <class T>
+inline double vtkImagePointwiseFuseClamp(double v, double minval, double maxval)
+{
+  if (std::numeric_limits<T>::is_integer)
+  {
+    return (v >= minval ? (v <= maxval ? v : maxval) : minval);
+  }
+  return (v < minval ? minval : (v > maxval ? maxval : v));
+}
+
+//----------------------------------------------------------------------------
+// Apply the operations, one after the other, to a row of values.
+void vtkImagePointwiseFuseApply(
+  const vtkImagePointwiseFuseOperations& operations, double* values, size_t n)
+{
+  double* end = values + n;
+  for (const vtkImagePointwiseFuseOperation& operation : operations)
+  {
+    const double* p = operation.Parameters;
+    double* v = values;
+    switch (operation.Operation)
+    {
+      case vtkImagePointwiseFuse::ShiftScale:
+        for (; v != end; ++v)
+        {
+          *v = (*v + p[0]) * p[1];
+        }
+        break;
+      case vtkImagePointwiseFuse::Cast:
+        if (p[2] != 0.0)
+        {
+          for (; v != end; ++v)
+          {
+            *v = std::trunc(vtkImagePointwiseFuseClamp<int>(*v, p[0], p[1]));
+          }
+        }
+        else if (p[3] != 0.0)
+        {
+          for (; v != end; ++v)
+          {
+            *v = static_cast<float>(vtkImagePointwiseFuseClamp<float>(*v, p[0], p[1]));
+          }
+        }
+        break;
+      case vtkImagePointwiseFuse::AddConstant:
+        for (; v != end; ++v)
+        {
+          *v += p[0];
+        }
+        break;
+      case vtkImagePointwiseFuse::MultiplyByK:
+        for (; v != end; ++v)
+        {
+          *v *= p[1];
+        }
+        break;
+      case vtkImagePointwiseFuse::Invert:
+        for (; v != end; ++v)
+        {
+          *v = (*v != 0.0 ? 1.0 / *v : p[0]);
+        }
+        break;
+      case vtkImagePointwiseFuse::Sin:
+        for (; v != end; ++v)
+        {
+          *v = sin(*v);
+        }
+        break;
+      case vtkImagePointwiseFuse::Cos:
+        for (; v != end; ++v)
+        {
+          *v = cos(*v);
+        }
+        break;
+      case vtkImagePointwiseFuse::Exp:
+        for (; v != end; ++v)
+        {
+          *v = exp(*v);
+        }
+        break;
+      case vtkImagePointwiseFuse::Log:
+        for (; v != end; ++v)
+        {
+          *v = log(*v);
+        }
+        break;
+      case vtkImagePointwiseFuse::AbsoluteValue:
+        for (; v != end; ++v)
+        {
+          *v = fabs(*v);
+        }
+        break;
+      case vtkImagePointwiseFuse::Square:
+        for (; v != end; ++v)
+        {
+          *v *= *v;
+        }
+        break;
+      case vtkImagePointwiseFuse::SquareRoot:
+        for (; v != end; ++v)
+        {
+          *v = sqrt(*v);
+        }
+        break;
+      case vtkImagePointwiseFuse::Minimum:
+        for (; v != end; ++v)
+        {
+          *v = (*v < p[0] ? *v : p[0]);
+        }
+        break;
+      case vtkImagePointwiseFuse::Maximum:
+        for (; v != end; ++v)
+        {
+          *v = (*v > p[0] ? *v : p[0]);
+        }
+        break;
+      case vtkImagePointwiseFuse::ReplaceCByK:
+        for (; v != end; ++v)
+        {
+          *v = (*v == p[0] ? p[1] : *v);
+        }
+        break;
+      case vtkImagePointwiseFuse::Threshold:
+        for (; v != end; ++v)
+        {
+          if (p[0] <= *v && *v <= p[1])
+          {
+            *v = (p[2] != 0.0 ? p[3] : *v);
+          }
+          else
+          {
+            *v = (p[4] != 0.0 ? p[5] : *v);
+          }
+        }
+        break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Compute the output values of an image that is not mapped to colors.
+template <class IT, class OT>
+void vtkImagePointwiseFuseExecute(vtkImagePointwiseFuse* self, vtkImageData* inData,
+  vtkImageData* outData, int outExt[6], int id, const vtkImagePointwiseFuseOperations& operations,
+  const double* table, int tableMin, IT*, OT*)
+{
+  vtkImageIterator<IT> inIt(inData, outExt);
+  vtkImageProgressIterator<OT> outIt(outData, outExt, self, id);
+  const double typeMin = vtkTypeTraits<OT>::Min();
+  const double typeMax = vtkTypeTraits<OT>::Max();
+  std::vector<double> row;
+
+  while (!outIt.IsAtEnd())
+  {
+    IT* inSI = inIt.BeginSpan();
+    OT* outSI = outIt.BeginSpan();
+    size_t n = outIt.EndSpan() - outSI;
+    if (table)
+    {
+      // the table has the clamped results for each input value
+      for (size_t i = 0; i < n; ++i)
+      {
+        outSI[i] = static_cast<OT>(table[static_cast<int>(inSI[i]) - tableMin]);
+      }
+    }
+    else
+    {
+      row.resize(n);
+      std::copy(inSI, inSI + n, row.begin());
+      vtkImagePointwiseFuseApply(operations, row.data(), n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        outSI[i] = static_cast<OT>(vtkImagePointwiseFuseClamp<OT>(row[i], typeMin, typeMax));
+      }
+    }
+    inIt.NextSpan();
+    outIt.NextSpan();
+  }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImagePointwiseFuseExecute1(vtkImagePointwiseFuse* self, vtkImageData* inData,
+  vtkImageData* outData, int outExt[6], int id, const vtkImagePointwiseFuseOperations& operations,
+  const double* table, int tableMin, T*)
+{
+  switch (outData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkImagePointwiseFuseExecute(self, inData, outData, outExt, id, operations,
+      table, tableMin, static_cast<T*>(nullptr), static_cast<VTK_TT*>(nullptr)));
+    default:
+      vtkErrorWithObjectMacro(self, "ThreadedRequestData: Unknown output ScalarType");
+      return;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Compute the colors of the active component through the lookup table.
+template <class IT>
+void vtkImagePointwiseFuseMapExecute(vtkImagePointwiseFuse* self, vtkImageData* inData,
+  vtkImageData* outData, int outExt[6], int id, const vtkImagePointwiseFuseOperations& operations,
+  const unsigned char* table, int tableMin, IT*)
+{
+  vtkImageIterator<IT> inIt(inData, outExt);
+  vtkImageProgressIterator<unsigned char> outIt(outData, outExt, self, id);
+  vtkScalarsToColors* lookupTable = self->GetLookupTable();
+  int numComps = inData->GetNumberOfScalarComponents();
+  int numOutComps = outData->GetNumberOfScalarComponents();
+  int outputFormat = self->GetOutputFormat();
+  int component = std::min(std::max(self->GetActiveComponent(), 0), numComps - 1);
+  std::vector<double> row;
+
+  while (!outIt.IsAtEnd())
+  {
+    IT* inSI = inIt.BeginSpan() + component;
+    unsigned char* outSI = outIt.BeginSpan();
+    size_t n = (outIt.EndSpan() - outSI) / numOutComps;
+    if (table)
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        const unsigned char* color =
+          table + (static_cast<int>(inSI[i * numComps]) - tableMin) * numOutComps;
+        std::copy(color, color + numOutComps, outSI + i * numOutComps);
+      }
+    }
+    else
+    {
+      row.resize(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        row[i] = inSI[i * numComps];
+      }
+      vtkImagePointwiseFuseApply(operations, row.data(), n);
+      lookupTable->MapScalarsThroughTable2(
+        row.data(), outSI, VTK_DOUBLE, static_cast<int>(n), 1, outputFormat);
+    }
+    inIt.NextSpan();
+    outIt.NextSpan();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkImagePointwiseFuseNumberOfColors(int outputFormat)
+{
+  switch (outputFormat)
+  {
+    case VTK_RGBA:
+      return 4;
+    case VTK_RGB:
+      return 3;
+    case VTK_LUMINANCE_ALPHA:
+      return 2;
+    case VTK_LUMINANCE:
+      return 1;
+  }
+  return 0;
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkImagePointwiseFuse::vtkImagePointwiseFuse()
+{
+  this->OutputScalarType = -1;
+  this->LookupTable = nullptr;
+  this->OutputFormat = VTK_RGBA;
+  this->ActiveComponent = 0;
+  this->Internals = new vtkInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkImagePointwiseFuse::~vtkImagePointwiseFuse()
+{
+  this->SetLookupTable(nullptr);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePointwiseFuse::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfOperations: " << this->GetNumberOfOperations() << "\n";
+  os << indent << "OutputScalarType: " << this->OutputScalarType << "\n";
+  os << indent << "LookupTable: " << this->LookupTable << "\n";
+  if (this->LookupTable)
+  {
+    this->LookupTable->PrintSelf(os, indent.GetNextIndent());
+  }
+  os << indent << "OutputFormat: " << this->OutputFormat << "\n";
+  os << indent << "ActiveComponent: " << this->ActiveComponent << "\n";
+}
+
+//----------------------------------------------------------------------------
+vtkMTimeType vtkImagePointwiseFuse::GetMTime()
+{
+  vtkMTimeType t1 = this->Superclass::GetMTime();
+  if (this->LookupTable)
+  {
+    t1 = std::max(t1, this->LookupTable->GetMTime());
+  }
+  return t1;
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePointwiseFuse::AddShiftScale(double shift, double scale)
+{
+  vtkImagePointwiseFuseOperation operation = { ShiftScale, { shift, scale } };
+  this->Internals->Operations.push_back(operation);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePointwiseFuse::AddCast(int scalarType)
+{
+  double typeMin = vtkDataArray::GetDataTypeMin(scalarType);
+  double typeMax = vtkDataArray::GetDataTypeMax(scalarType);
+  if (typeMin >= typeMax)
+  {
+    vtkErrorMacro("AddCast: Unknown scalar type " << scalarType);
+    return;
+  }
+  // a cast to double does nothing
+  bool isFloat = (scalarType == VTK_FLOAT);
+  bool isInteger = (!isFloat && scalarType != VTK_DOUBLE);
+  vtkImagePointwiseFuseOperation operation = { Cast,
+    { typeMin, typeMax, (isInteger ? 1.0 : 0.0), (isFloat ? 1.0 : 0.0) } };
+  this->Internals->Operations.push_back(operation);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePointwiseFuse::AddMathematics(int operation, double c, double k)
+{
+  if (operation < AddConstant || operation > ReplaceCByK)
+  {
+    vtkErrorMacro("AddMathematics: Unknown operation " << operation);
+    return;
+  }
+  vtkImagePointwiseFuseOperation mathematics = { operation, { c, k } };
+  this->Internals->Operations.push_back(mathematics);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePointwiseFuse::AddThreshold(
+  double lower, double upper, int replaceIn, double inValue, int replaceOut, double outValue)
+{
+  vtkImagePointwiseFuseOperation operation = { Threshold,
+    { lower, upper, static_cast<double>(replaceIn != 0), inValue,
+      static_cast<double>(replaceOut != 0), outValue } };
+  this->Internals->Operations.push_back(operation);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkImagePointwiseFuse::GetNumberOfOperations()
+{
+  return static_cast<int>(this->Internals->Operations.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkImagePointwiseFuse::GetOperation(int idx)
+{
+  if (idx < 0 || idx >= this->GetNumberOfOperations())
+  {
+    return -1;
+  }
+  return this->Internals->Operations[idx].Operation;
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePointwiseFuse::RemoveAllOperations()
+{
+  if (!this->Internals->Operations.empty())
+  {
+    this->Internals->Operations.clear();
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkImagePointwiseFuse::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  if (this->LookupTable)
+  {
+    int numComponents = vtkImagePointwiseFuseNumberOfColors(this->OutputFormat);
+    if (numComponents == 0)
+    {
+      vtkErrorMacro("RequestInformation: Unrecognized color format.");
+      return 0;
+    }
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_UNSIGNED_CHAR, numComponents);
+  }
+  else if (this->OutputScalarType != -1)
+  {
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, this->OutputScalarType, -1);
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Evaluate the operations once for each value of 8 or 16 bit integer
+// inputs, if the update extent has at least as many values, so that the
+// threads only have to read the results from a table.
+int vtkImagePointwiseFuse::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* inData = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkInternals* internals = this->Internals;
+  internals->ValueTable.clear();
+  internals->ColorTable.clear();
+
+  if (this->LookupTable)
+  {
+    this->LookupTable->Build(); // make sure table is built
+  }
+
+  int scalarType = (inData ? inData->GetScalarType() : VTK_VOID);
+  if (scalarType == VTK_CHAR || scalarType == VTK_SIGNED_CHAR ||
+    scalarType == VTK_UNSIGNED_CHAR || scalarType == VTK_SHORT ||
+    scalarType == VTK_UNSIGNED_SHORT)
+  {
+    int typeMin = static_cast<int>(vtkDataArray::GetDataTypeMin(scalarType));
+    int typeMax = static_cast<int>(vtkDataArray::GetDataTypeMax(scalarType));
+    size_t tableSize = typeMax - typeMin + 1;
+    int* updateExt = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+    double numValues = inData->GetNumberOfScalarComponents();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      numValues *= std::max(updateExt[2 * axis + 1] - updateExt[2 * axis] + 1, 0);
+    }
+    if (numValues >= tableSize)
+    {
+      std::vector<double> values(tableSize);
+      for (size_t i = 0; i < tableSize; ++i)
+      {
+        values[i] = typeMin + static_cast<double>(i);
+      }
+      vtkImagePointwiseFuseApply(internals->Operations, values.data(), tableSize);
+      internals->TableMinimum = typeMin;
+      if (this->LookupTable)
+      {
+        int numComponents = vtkImagePointwiseFuseNumberOfColors(this->OutputFormat);
+        internals->ColorTable.resize(tableSize * numComponents);
+        this->LookupTable->MapScalarsThroughTable2(values.data(), internals->ColorTable.data(),
+          VTK_DOUBLE, static_cast<int>(tableSize), 1, this->OutputFormat);
+      }
+      else
+      {
+        int outType = (this->OutputScalarType != -1 ? this->OutputScalarType : scalarType);
+        double outMin = vtkDataArray::GetDataTypeMin(outType);
+        double outMax = vtkDataArray::GetDataTypeMax(outType);
+        bool isInteger = (outType != VTK_FLOAT && outType != VTK_DOUBLE);
+        for (double& v : values)
+        {
+          v = (isInteger ? vtkImagePointwiseFuseClamp<int>(v, outMin, outMax)
+                         : vtkImagePointwiseFuseClamp<double>(v, outMin, outMax));
+        }
+        internals->ValueTable.swap(values);
+      }
+    }
+  }
+
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+// This method is passed a input and output data, and executes the filter
+// algorithm to fill the output from the input.
+void vtkImagePointwiseFuse::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* vtkNotUsed(outputVector),
+  vtkImageData*** inData, vtkImageData** outData, int outExt[6], int id)
+{
+  vtkImageData* input = inData[0][0];
+  vtkImageData* output = outData[0];
+  const vtkInternals* internals = this->Internals;
+  int tableMin = internals->TableMinimum;
+
+  if (this->LookupTable)
+  {
+    const unsigned char* table =
+      (internals->ColorTable.empty() ? nullptr : internals->ColorTable.data());
+    switch (input->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImagePointwiseFuseMapExecute(this, input, output, outExt, id,
+        internals->Operations, table, tableMin, static_cast<VTK_TT*>(nullptr)));
+      default:
+        vtkErrorMacro("ThreadedRequestData: Unknown input ScalarType");
+        return;
+    }
+  }
+  else
+  {
+    const double* table = (internals->ValueTable.empty() ? nullptr : internals->ValueTable.data());
+    switch (input->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImagePointwiseFuseExecute1(this, input, output, outExt, id,
+        internals->Operations, table, tableMin, static_cast<VTK_TT*>(nullptr)));
+      default:
+        vtkErrorMacro("ThreadedRequestData: Unknown input ScalarType");
+        return;
+    }
+  }
+}
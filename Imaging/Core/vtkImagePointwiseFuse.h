@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImagePointwiseFuse.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImagePointwiseFuse
+ * @brief   apply a chain of point-wise operations in one pass
+ *
+ * vtkImagePointwiseFuse applies a list of point-wise operations to each
+ * component of its input, in the order in which they were added, and
+ * writes only the final result.  It replaces a chain of filters such as
+ * vtkImageShiftScale, vtkImageCast, vtkImageMathematics (with a single
+ * input), vtkImageThreshold and vtkImageMapToColors, which would each
+ * allocate an image for their output, with one threaded pass over the
+ * input that keeps the values of one row at a time:
+ *
+ * \code
+ * vtkNew<vtkImagePointwiseFuse> fuse;
+ * fuse->AddShiftScale(-1000.0, 0.5);
+ * fuse->AddCast(VTK_SHORT);
+ * fuse->AddMathematics(vtkImagePointwiseFuse::AbsoluteValue);
+ * fuse->AddThreshold(100.0, VTK_DOUBLE_MAX, 0, 0.0, 1, 0.0);
+ * fuse->SetLookupTable(table);
+ * \endcode
+ *
+ * The operations compute in double precision, so a conversion between
+ * types that a filter of the chain would do must be added with AddCast.
+ * The result is clamped to the range of the output scalar type, and if a
+ * lookup table is set, the ActiveComponent of the result is mapped
+ * through it to unsigned char colors.  For inputs of 8 or 16 bit integer
+ * types, the operations and the lookup table are evaluated once for each
+ * value of the type, and the pass reads the results from a table.
+ *
+ * @sa
+ * vtkImageShiftScale vtkImageCast vtkImageMathematics vtkImageThreshold
+ * vtkImageMapToColors
+ */
+
+#ifndef vtkImagePointwiseFuse_h
+#define vtkImagePointwiseFuse_h
+
+#include "vtkImagingCoreModule.h" // For export macro
+#include "vtkThreadedImageAlgorithm.h"
+
+class vtkScalarsToColors;
+
+class VTKIMAGINGCORE_EXPORT vtkImagePointwiseFuse : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkImagePointwiseFuse* New();
+  vtkTypeMacro(vtkImagePointwiseFuse, vtkThreadedImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * The operations, where C and K are the constants of AddMathematics.
+   */
+  enum OperationEnum
+  {
+    ShiftScale = 0,     // (x + shift) * scale
+    Cast = 1,           // clamp to a scalar type and convert to it
+    AddConstant = 2,    // x + C
+    MultiplyByK = 3,    // x * K
+    Invert = 4,         // 1 / x, or C if x is zero
+    Sin = 5,            // sin(x)
+    Cos = 6,            // cos(x)
+    Exp = 7,            // exp(x)
+    Log = 8,            // log(x)
+    AbsoluteValue = 9,  // fabs(x)
+    Square = 10,        // x * x
+    SquareRoot = 11,    // sqrt(x)
+    Minimum = 12,       // min(x, C)
+    Maximum = 13,       // max(x, C)
+    ReplaceCByK = 14,   // K if x == C, else x
+    Threshold = 15      // see AddThreshold
+  };
+
+  /**
+   * Add (x + shift) * scale, as computed by vtkImageShiftScale.
+   */
+  void AddShiftScale(double shift, double scale);
+
+  /**
+   * Add a conversion to the given scalar type, as done by vtkImageCast
+   * with ClampOverflow on: values are clamped to the range of the type,
+   * and truncated if the type is an integer type.
+   */
+  void AddCast(int scalarType);
+
+  /**
+   * Add one of the single-input operations of vtkImageMathematics, from
+   * AddConstant to ReplaceCByK, with its constants.  The division by zero
+   * of Invert gives C, as with DivideByZeroToC.
+   */
+  void AddMathematics(int operation, double c = 0.0, double k = 1.0);
+
+  /**
+   * Add a threshold, as computed by vtkImageThreshold: the values within
+   * [lower, upper] are replaced by inValue if replaceIn is set, and the
+   * other values are replaced by outValue if replaceOut is set.
+   */
+  void AddThreshold(
+    double lower, double upper, int replaceIn, double inValue, int replaceOut, double outValue);
+
+  /**
+   * Get the number of operations.
+   */
+  int GetNumberOfOperations();
+
+  /**
+   * Get the type of an operation, or -1 if the index is out of range.
+   */
+  int GetOperation(int idx);
+
+  /**
+   * Remove all operations, after which the input is only converted to
+   * the output scalar type or mapped through the lookup table.
+   */
+  void RemoveAllOperations();
+
+  //@{
+  /**
+   * Set/Get the output scalar type.  The default, -1, gives the scalar
+   * type of the input.  It is ignored if a lookup table is set.
+   */
+  vtkSetMacro(OutputScalarType, int);
+  vtkGetMacro(OutputScalarType, int);
+  void SetOutputScalarTypeToFloat() { this->SetOutputScalarType(VTK_FLOAT); }
+  void SetOutputScalarTypeToDouble() { this->SetOutputScalarType(VTK_DOUBLE); }
+  void SetOutputScalarTypeToInt() { this->SetOutputScalarType(VTK_INT); }
+  void SetOutputScalarTypeToShort() { this->SetOutputScalarType(VTK_SHORT); }
+  void SetOutputScalarTypeToUnsignedShort() { this->SetOutputScalarType(VTK_UNSIGNED_SHORT); }
+  void SetOutputScalarTypeToUnsignedChar() { this->SetOutputScalarType(VTK_UNSIGNED_CHAR); }
+  //@}
+
+  //@{
+  /**
+   * Set the lookup table that maps the result to colors, as the last
+   * stage.  The default is none.
+   */
+  virtual void SetLookupTable(vtkScalarsToColors*);
+  vtkGetObjectMacro(LookupTable, vtkScalarsToColors);
+  //@}
+
+  //@{
+  /**
+   * Set the output format of the colors, the default is RGBA.
+   */
+  vtkSetMacro(OutputFormat, int);
+  vtkGetMacro(OutputFormat, int);
+  void SetOutputFormatToRGBA() { this->SetOutputFormat(VTK_RGBA); }
+  void SetOutputFormatToRGB() { this->SetOutputFormat(VTK_RGB); }
+  void SetOutputFormatToLuminanceAlpha() { this->SetOutputFormat(VTK_LUMINANCE_ALPHA); }
+  void SetOutputFormatToLuminance() { this->SetOutputFormat(VTK_LUMINANCE); }
+  //@}
+
+  //@{
+  /**
+   * Set the component that is mapped to colors (default: 0).
+   */
+  vtkSetMacro(ActiveComponent, int);
+  vtkGetMacro(ActiveComponent, int);
+  //@}
+
+  /**
+   * We need to check the modified time of the lookup table too.
+   */
+  vtkMTimeType GetMTime() override;
+
+protected:
+  vtkImagePointwiseFuse();
+  ~vtkImagePointwiseFuse() override;
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
+    int extent[6], int id) override;
+
+  int OutputScalarType;
+  vtkScalarsToColors* LookupTable;
+  int OutputFormat;
+  int ActiveComponent;
+
+private:
+  vtkImagePointwiseFuse(const vtkImagePointwiseFuse&) = delete;
+  void operator=(const vtkImagePointwiseFuse&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
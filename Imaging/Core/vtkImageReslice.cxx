@@ -2225,6 +2225,14 @@ void vtkImageResliceRowInterpolate<T, N>::Nearest(void*& outPtr0, int idX, int i
   const T* inPtr0 = static_cast<const T*>(weights->Pointer) + iY[0] + iZ[0];
   T* outPtr = static_cast<T*>(outPtr0);
 
+  // consecutive pixels are copied at once
+  if (vtkInterpolationIsContiguous(iX, numscalars, n))
+  {
+    memcpy(outPtr, &inPtr0[iX[0]], static_cast<size_t>(n) * numscalars * sizeof(T));
+    outPtr0 = outPtr + static_cast<size_t>(n) * numscalars;
+    return;
+  }
+
   // This is a hot loop.
   // Be very careful changing it, as it affects performance greatly.
   for (int i = n; i > 0; --i)
@@ -2252,6 +2260,14 @@ void vtkImageResliceRowInterpolate<T, N>::Nearest1(
   const T* inPtr0 = static_cast<const T*>(weights->Pointer) + iY[0] + iZ[0];
   T* outPtr = static_cast<T*>(outPtr0);
 
+  // consecutive pixels are copied at once
+  if (vtkInterpolationIsContiguous(iX, 1, n))
+  {
+    memcpy(outPtr, &inPtr0[iX[0]], static_cast<size_t>(n) * sizeof(T));
+    outPtr0 = outPtr + n;
+    return;
+  }
+
   // This is a hot loop.
   // Be very careful changing it, as it affects performance greatly.
   for (int i = n; i > 0; --i)
@@ -2275,6 +2291,14 @@ void vtkImageResliceRowInterpolate<T, N>::NearestN(
   const T* inPtr0 = static_cast<const T*>(weights->Pointer) + iY[0] + iZ[0];
   T* outPtr = static_cast<T*>(outPtr0);
 
+  // consecutive pixels are copied at once
+  if (vtkInterpolationIsContiguous(iX, N, n))
+  {
+    memcpy(outPtr, &inPtr0[iX[0]], static_cast<size_t>(n) * N * sizeof(T));
+    outPtr0 = outPtr + static_cast<size_t>(n) * N;
+    return;
+  }
+
   // This is a hot loop.
   // Be very careful changing it, as it affects performance greatly.
   for (int i = n; i > 0; --i)
@@ -952,6 +952,25 @@ void vtkImageSincRowInterpolate<F, T>::General(
   const T* inPtr = static_cast<const T*>(weights->Pointer);
 
   int numscalars = weights->NumberOfComponents;
+
+  // blend the rows in y and z, then interpolate the blended row in x
+  vtkIdType offsets[VTK_SINC_KERNEL_SIZE_MAX * VTK_SINC_KERNEL_SIZE_MAX];
+  F w[VTK_SINC_KERNEL_SIZE_MAX * VTK_SINC_KERNEL_SIZE_MAX];
+  int ntaps = 0;
+  for (int k = 0; k < stepZ; k++)
+  {
+    for (int j = 0; j < stepY; j++)
+    {
+      offsets[ntaps] = factZ[k] + factY[j];
+      w[ntaps++] = fZ[k] * fY[j];
+    }
+  }
+  if (vtkInterpolationRow<F, T>::Interpolate(
+        inPtr, offsets, w, ntaps, factX, fX, stepX, numscalars, outPtr, n))
+  {
+    return;
+  }
+
   for (int i = n; i > 0; --i)
   {
     const T* inPtr0 = inPtr;
@@ -0,0 +1,343 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageStreamingExecutive.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageStreamingExecutive.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataArray.h"
+#include "vtkExtentTranslator.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+vtkStandardNewMacro(vtkImageStreamingExecutive);
+
+namespace
+{
+
+// The bytes per point of an output, from the information about its
+// scalars or from the point data that it currently holds.
+double vtkImageStreamingBytesPerPoint(vtkInformation* info)
+{
+  double bytes = 0.0;
+  vtkInformation* scalarInfo = vtkDataObject::GetActiveFieldInformation(
+    info, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
+  if (scalarInfo && scalarInfo->Has(vtkDataObject::FIELD_ARRAY_TYPE()))
+  {
+    int numComps = 1;
+    if (scalarInfo->Has(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS()))
+    {
+      numComps = scalarInfo->Get(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS());
+    }
+    bytes = static_cast<double>(vtkDataArray::GetDataTypeSize(
+              scalarInfo->Get(vtkDataObject::FIELD_ARRAY_TYPE()))) *
+      numComps;
+  }
+  vtkDataSet* data = vtkDataSet::SafeDownCast(info->Get(vtkDataObject::DATA_OBJECT()));
+  if (data)
+  {
+    double current = 0.0;
+    vtkPointData* pd = data->GetPointData();
+    for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
+    {
+      vtkAbstractArray* array = pd->GetAbstractArray(i);
+      current += static_cast<double>(array->GetDataTypeSize()) * array->GetNumberOfComponents();
+    }
+    bytes = std::max(bytes, current);
+  }
+  return bytes;
+}
+
+// The bytes that an output needs for its update extent.
+double vtkImageStreamingOutputSize(vtkInformation* info)
+{
+  int extent[6];
+  if (info->Length(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()) == 6)
+  {
+    info->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent);
+    double points = 1.0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      points *= std::max(extent[2 * axis + 1] - extent[2 * axis] + 1, 0);
+    }
+    return points * vtkImageStreamingBytesPerPoint(info);
+  }
+  // other data is counted with the size that it currently has
+  vtkDataObject* data = info->Get(vtkDataObject::DATA_OBJECT());
+  return (data ? 1024.0 * data->GetActualMemorySize() : 0.0);
+}
+
+// Collect the outputs that feed an executive, directly or through other
+// executives, with each output once.
+void vtkImageStreamingCollectInputs(
+  vtkExecutive* executive, std::set<vtkInformation*>& visited, std::vector<vtkInformation*>& infos)
+{
+  for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+  {
+    for (int j = 0; j < executive->GetNumberOfInputConnections(i); ++j)
+    {
+      vtkInformation* inInfo = executive->GetInputInformation(i, j);
+      if (!inInfo || !visited.insert(inInfo).second)
+      {
+        continue;
+      }
+      infos.push_back(inInfo);
+      vtkExecutive* producer;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(inInfo, producer, producerPort);
+      if (producer)
+      {
+        vtkImageStreamingCollectInputs(producer, visited, infos);
+      }
+    }
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkImageStreamingExecutive::vtkImageStreamingExecutive()
+{
+  this->MemoryLimit = 0;
+  this->SplitMode = vtkExtentTranslator::Z_SLAB_MODE;
+  this->NumberOfPieces = 1;
+  this->EstimatedMemorySize = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkImageStreamingExecutive::~vtkImageStreamingExecutive() = default;
+
+//----------------------------------------------------------------------------
+void vtkImageStreamingExecutive::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "MemoryLimit (in kibibytes): " << this->MemoryLimit << "\n";
+  os << indent << "SplitMode: " << this->SplitMode << "\n";
+  os << indent << "NumberOfPieces: " << this->NumberOfPieces << "\n";
+  os << indent << "EstimatedMemorySize (in kibibytes): " << this->EstimatedMemorySize << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkImageStreamingExecutive::CollectPipelineOutputs(
+  int port, std::vector<vtkInformation*>& infos)
+{
+  std::set<vtkInformation*> visited;
+  infos.assign(1, this->GetOutputInformation(port));
+  vtkImageStreamingCollectInputs(this, visited, infos);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageStreamingExecutive::SetPieceExtent(int port, const int extent[6])
+{
+  // the pipeline combines the extents that are requested until it executes,
+  // so the extents of the earlier requests must be forgotten
+  static const int emptyExt[6] = { 0, -1, 0, -1, 0, -1 };
+  std::vector<vtkInformation*> infos;
+  this->CollectPipelineOutputs(port, infos);
+  for (vtkInformation* info : infos)
+  {
+    if (info->Has(COMBINED_UPDATE_EXTENT()))
+    {
+      info->Set(COMBINED_UPDATE_EXTENT(), emptyExt, 6);
+    }
+  }
+  this->GetOutputInformation(port)->Set(UPDATE_EXTENT(), extent, 6);
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkImageStreamingExecutive::ComputePipelineMemorySize(int port)
+{
+  std::vector<vtkInformation*> infos;
+  this->CollectPipelineOutputs(port, infos);
+  double bytes = 0.0;
+  for (vtkInformation* info : infos)
+  {
+    bytes += vtkImageStreamingOutputSize(info);
+  }
+  bytes = std::min(bytes / 1024.0, static_cast<double>(VTK_UNSIGNED_LONG_MAX));
+  return static_cast<unsigned long>(bytes);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageStreamingExecutive::PlanPieces(
+  int port, const int extent[6], int& numPieces, int& splitMode)
+{
+  vtkNew<vtkExtentTranslator> translator;
+  int wholeExt[6];
+  std::copy(extent, extent + 6, wholeExt);
+
+  numPieces = 1;
+  splitMode = this->SplitMode;
+  unsigned long size = this->EstimatedMemorySize;
+  while (size > this->MemoryLimit)
+  {
+    // a slab is at least one slice thick, after that blocks are needed
+    int next = 2 * numPieces;
+    int mode = splitMode;
+    if (mode != vtkExtentTranslator::BLOCK_MODE &&
+      next > extent[2 * mode + 1] - extent[2 * mode] + 1)
+    {
+      mode = vtkExtentTranslator::BLOCK_MODE;
+    }
+    double points = 1.0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      points *= extent[2 * axis + 1] - extent[2 * axis] + 1;
+    }
+    if (next > points)
+    {
+      break;
+    }
+
+    // the first piece has a border on one side, a middle piece on both
+    unsigned long pieceSize = 0;
+    const int pieces[2] = { 0, next / 2 };
+    for (int piece : pieces)
+    {
+      int pieceExt[6];
+      translator->PieceToExtentThreadSafe(piece, next, 0, wholeExt, pieceExt, mode, 1);
+      this->SetPieceExtent(port, pieceExt);
+      this->PropagateUpdateExtent(port);
+      pieceSize = std::max(pieceSize, this->ComputePipelineMemorySize(port));
+    }
+    // stop if the pipeline needs the whole extent for each piece
+    if (pieceSize >= size)
+    {
+      break;
+    }
+    numPieces = next;
+    splitMode = mode;
+    size = pieceSize;
+  }
+  this->EstimatedMemorySize = size;
+  if (size > this->MemoryLimit)
+  {
+    vtkWarningMacro("The pipeline needs " << size << " KiB for each of " << numPieces
+                                          << " pieces, more than the limit of "
+                                          << this->MemoryLimit << " KiB.");
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeBool vtkImageStreamingExecutive::Update(int port, vtkInformationVector* requests)
+{
+  this->NumberOfPieces = 1;
+  if (this->MemoryLimit == 0 || port < 0 || port >= this->Algorithm->GetNumberOfOutputPorts())
+  {
+    return this->Superclass::Update(port, requests);
+  }
+  if (!this->UpdateInformation())
+  {
+    return 0;
+  }
+  vtkInformation* outInfo = this->GetOutputInformation(port);
+  vtkImageData* output = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+  if (!output)
+  {
+    return this->Superclass::Update(port, requests);
+  }
+  if (requests)
+  {
+    for (int i = 0; i < this->Algorithm->GetNumberOfOutputPorts(); ++i)
+    {
+      vtkInformation* req = requests->GetInformationObject(i);
+      if (req)
+      {
+        this->GetOutputInformation(i)->Append(req);
+      }
+    }
+  }
+
+  // propagate the whole request to find the extent that it needs and to
+  // estimate its memory, unless the output is already up to date
+  this->PropagateTime(port);
+  this->UpdateTimeDependentInformation(port);
+  if (!this->PropagateUpdateExtent(port))
+  {
+    return 0;
+  }
+  if (this->LastPropogateUpdateExtentShortCircuited)
+  {
+    return 1;
+  }
+  int extent[6];
+  outInfo->Get(UPDATE_EXTENT(), extent);
+  this->EstimatedMemorySize = this->ComputePipelineMemorySize(port);
+  if (this->EstimatedMemorySize <= this->MemoryLimit || extent[0] > extent[1] ||
+    extent[2] > extent[3] || extent[4] > extent[5])
+  {
+    return this->Superclass::Update(port, nullptr);
+  }
+
+  int numPieces, splitMode;
+  this->PlanPieces(port, extent, numPieces, splitMode);
+  this->NumberOfPieces = numPieces;
+
+  // update each piece and copy its point data into the whole extent
+  vtkNew<vtkExtentTranslator> translator;
+  vtkNew<vtkImageData> result;
+  result->SetExtent(extent);
+  bool allocated = false;
+  vtkTypeBool retval = 1;
+  for (int piece = 0; piece < numPieces && !this->Algorithm->GetAbortExecute(); ++piece)
+  {
+    int pieceExt[6];
+    if (!translator->PieceToExtentThreadSafe(piece, numPieces, 0, extent, pieceExt, splitMode, 1))
+    {
+      continue;
+    }
+    this->SetPieceExtent(port, pieceExt);
+    if (!this->Superclass::Update(port, nullptr))
+    {
+      retval = 0;
+      break;
+    }
+    output = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+    if (!allocated)
+    {
+      result->SetOrigin(output->GetOrigin());
+      result->SetSpacing(output->GetSpacing());
+      result->SetDirectionMatrix(output->GetDirectionMatrix());
+      result->GetPointData()->CopyAllocate(output->GetPointData(), result->GetNumberOfPoints());
+      allocated = true;
+    }
+    vtkIdType rowSize = pieceExt[1] - pieceExt[0] + 1;
+    for (int k = pieceExt[4]; k <= pieceExt[5]; ++k)
+    {
+      for (int j = pieceExt[2]; j <= pieceExt[3]; ++j)
+      {
+        int ijk[3] = { pieceExt[0], j, k };
+        result->GetPointData()->CopyData(output->GetPointData(), result->ComputePointId(ijk),
+          rowSize, output->ComputePointId(ijk));
+      }
+    }
+  }
+
+  // a failed or aborted update leaves the output as the pieces left it
+  this->SetPieceExtent(port, extent);
+  if (retval && allocated)
+  {
+    output->ShallowCopy(result);
+  }
+  return retval;
+}
@@ -0,0 +1,142 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageStreamingExecutive.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageStreamingExecutive
+ * @brief   Streams an image pipeline within a memory limit.
+ *
+ * vtkImageStreamingExecutive is an executive for the last algorithm of an
+ * image pipeline.  When the algorithm is updated, the executive estimates
+ * the memory that the pipeline needs for the requested extent, from the
+ * update extents that the upstream filters request (which include the
+ * borders that their kernels need) and from the scalar types of their
+ * outputs.  If the estimate is larger than MemoryLimit, the executive
+ * splits the extent into slabs, or into blocks if slabs of one slice are
+ * still too large, and doubles the number of pieces until the estimate
+ * for each piece fits within the limit.  It then updates the pipeline once
+ * for each piece and assembles the point data of the pieces into the
+ * output, so no streamer has to be placed in the pipeline.  The executive
+ * must be set before the input of the algorithm is connected:
+ *
+ * \code
+ * vtkNew<vtkImageStreamingExecutive> executive;
+ * executive->SetMemoryLimit(4 * 1024 * 1024); // 4 GiB
+ * threshold->SetExecutive(executive);
+ * threshold->SetInputConnection(smooth->GetOutputPort());
+ * threshold->Update();
+ * \endcode
+ *
+ * The limit covers the data that the pipeline generates for each piece,
+ * and the output of the whole extent is allocated in addition to it.  The
+ * borders that neighboring pieces share are computed for each piece.
+ * Outputs that are not image data are updated without streaming.
+ *
+ * @sa
+ * vtkMemoryLimitImageDataStreamer vtkImageDataStreamer vtkExtentTranslator
+ */
+
+#ifndef vtkImageStreamingExecutive_h
+#define vtkImageStreamingExecutive_h
+
+#include "vtkImagingCoreModule.h" // For export macro
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vector> // For std::vector
+
+class vtkImageData;
+
+class VTKIMAGINGCORE_EXPORT vtkImageStreamingExecutive : public vtkStreamingDemandDrivenPipeline
+{
+public:
+  static vtkImageStreamingExecutive* New();
+  vtkTypeMacro(vtkImageStreamingExecutive, vtkStreamingDemandDrivenPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the memory limit in kibibytes (1024 bytes).  The default, 0,
+   * means that there is no limit and that the pipeline is not streamed.
+   */
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+  //@}
+
+  //@{
+  /**
+   * Set/Get how the extent is split into slabs, with the modes of
+   * vtkExtentTranslator.  The default is vtkExtentTranslator::Z_SLAB_MODE.
+   * If the slabs of one slice are too large for the limit, the extent is
+   * split into blocks instead.
+   */
+  vtkSetClampMacro(SplitMode, int, 0, 3);
+  vtkGetMacro(SplitMode, int);
+  //@}
+
+  //@{
+  /**
+   * Get the number of pieces of the last update, and the memory in
+   * kibibytes that the pipeline was estimated to need for the largest
+   * piece.
+   */
+  vtkGetMacro(NumberOfPieces, int);
+  vtkGetMacro(EstimatedMemorySize, unsigned long);
+  //@}
+
+  //@{
+  /**
+   * Bring the outputs up-to-date, in pieces if the pipeline would need
+   * more memory than the limit.
+   */
+  using vtkStreamingDemandDrivenPipeline::Update;
+  vtkTypeBool Update(int port, vtkInformationVector* requests) override;
+  //@}
+
+protected:
+  vtkImageStreamingExecutive();
+  ~vtkImageStreamingExecutive() override;
+
+  /**
+   * Estimate the memory in kibibytes that the pipeline needs for the
+   * update extent of the given output port, after it has been propagated.
+   */
+  unsigned long ComputePipelineMemorySize(int port);
+
+  /**
+   * Collect the information of the given output port and of the outputs
+   * that feed it, each output once.
+   */
+  void CollectPipelineOutputs(int port, std::vector<vtkInformation*>& infos);
+
+  /**
+   * Set the update extent of the given output port, and clear the extents
+   * that the pipeline has combined from the earlier requests.
+   */
+  void SetPieceExtent(int port, const int extent[6]);
+
+  /**
+   * Choose the number of pieces and the split mode for the extent.
+   */
+  void PlanPieces(int port, const int extent[6], int& numPieces, int& splitMode);
+
+  unsigned long MemoryLimit;
+  int SplitMode;
+  int NumberOfPieces;
+  unsigned long EstimatedMemorySize;
+
+private:
+  vtkImageStreamingExecutive(const vtkImageStreamingExecutive&) = delete;
+  void operator=(const vtkImageStreamingExecutive&) = delete;
+};
+
+#endif
@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageFFT.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare vtkImageFFT with a direct evaluation of the discrete Fourier
+// transform along each axis, for real and complex input and for lengths
+// with various factors, and check that vtkImageRFFT inverts it.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageFFT.h"
+#include "vtkImageRFFT.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+typedef std::complex<double> Complex;
+
+// Values of the image in x-fastest order.
+std::vector<Complex> MakeValues(const int dims[3], bool complexValues)
+{
+  std::vector<Complex> values(static_cast<size_t>(dims[0]) * dims[1] * dims[2]);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    double re = static_cast<double>((i * 37) % 101) - 50.0;
+    double im = complexValues ? static_cast<double>((i * 53) % 67) - 30.0 : 0.0;
+    values[i] = Complex(re, im);
+  }
+  return values;
+}
+
+// Direct DFT of the values along each axis in turn.
+void DirectDFT(std::vector<Complex>& values, const int dims[3], int dimensionality)
+{
+  const int strides[3] = { 1, dims[0], dims[0] * dims[1] };
+  for (int axis = 0; axis < dimensionality; ++axis)
+  {
+    const int n = dims[axis];
+    std::vector<Complex> row(n);
+    for (size_t start = 0; start < values.size(); ++start)
+    {
+      if ((start / strides[axis]) % n != 0)
+      {
+        continue;
+      }
+      for (int k = 0; k < n; ++k)
+      {
+        Complex sum = 0.0;
+        for (int j = 0; j < n; ++j)
+        {
+          double angle = -2.0 * vtkMath::Pi() * ((static_cast<long>(j) * k) % n) / n;
+          sum += values[start + static_cast<size_t>(j) * strides[axis]] *
+            Complex(cos(angle), sin(angle));
+        }
+        row[k] = sum;
+      }
+      for (int k = 0; k < n; ++k)
+      {
+        values[start + static_cast<size_t>(k) * strides[axis]] = row[k];
+      }
+    }
+  }
+}
+
+bool TestSize(const int dims[3], int dimensionality, bool complexValues)
+{
+  std::vector<Complex> values = MakeValues(dims, complexValues);
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(dims[0], dims[1], dims[2]);
+  image->AllocateScalars(VTK_DOUBLE, complexValues ? 2 : 1);
+  double* scalars = static_cast<double*>(image->GetScalarPointer());
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    if (complexValues)
+    {
+      scalars[2 * i] = values[i].real();
+      scalars[2 * i + 1] = values[i].imag();
+    }
+    else
+    {
+      scalars[i] = values[i].real();
+    }
+  }
+
+  vtkNew<vtkImageFFT> fft;
+  fft->SetDimensionality(dimensionality);
+  fft->SetInputData(image);
+  fft->Update();
+  vtkNew<vtkImageRFFT> rfft;
+  rfft->SetDimensionality(dimensionality);
+  rfft->SetInputConnection(fft->GetOutputPort());
+  rfft->Update();
+
+  DirectDFT(values, dims, dimensionality);
+  vtkDataArray* spectrum = fft->GetOutput()->GetPointData()->GetScalars();
+  vtkDataArray* inverse = rfft->GetOutput()->GetPointData()->GetScalars();
+  const double tolerance = 1e-7 * values.size();
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    const vtkIdType id = static_cast<vtkIdType>(i);
+    if (std::abs(Complex(spectrum->GetComponent(id, 0), spectrum->GetComponent(id, 1)) -
+          values[i]) > tolerance)
+    {
+      std::cerr << "FFT of " << dims[0] << "x" << dims[1] << "x" << dims[2] << " image differs at "
+                << i << ".\n";
+      return false;
+    }
+    const double original = complexValues ? scalars[2 * i] : scalars[i];
+    const double originalImag = complexValues ? scalars[2 * i + 1] : 0.0;
+    if (std::abs(Complex(inverse->GetComponent(id, 0), inverse->GetComponent(id, 1)) -
+          Complex(original, originalImag)) > 1e-9)
+    {
+      std::cerr << "RFFT of " << dims[0] << "x" << dims[1] << "x" << dims[2]
+                << " image differs at " << i << ".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestImageFFT(int, char*[])
+{
+  const int sizes[][3] = { { 1, 1, 1 }, { 64, 3, 1 }, { 12, 9, 5 }, { 7, 30, 1 }, { 97, 2, 1 },
+    { 100, 1, 1 }, { 45, 16, 3 } };
+  for (const int* dims : sizes)
+  {
+    for (int dimensionality = 1; dimensionality <= 3; ++dimensionality)
+    {
+      if (!TestSize(dims, dimensionality, false) || !TestSize(dims, dimensionality, true))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // A batch of interleaved arrays gives the same results as ExecuteFft on
+  // each array.
+  vtkNew<vtkImageFFT> fft;
+  const int n = 360;
+  const int count = 3;
+  std::vector<double> real(n * count), imag(n * count), work(2 * n * count);
+  for (int i = 0; i < n * count; ++i)
+  {
+    real[i] = sin(0.1 * i);
+    imag[i] = cos(0.7 * i);
+  }
+  fft->ExecuteFftBatch(real.data(), imag.data(), work.data(), n, count, 1);
+  std::vector<vtkImageComplex> in(n), expected(n);
+  for (int b = 0; b < count; ++b)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      in[i].Real = sin(0.1 * (i * count + b));
+      in[i].Imag = cos(0.7 * (i * count + b));
+    }
+    fft->ExecuteFft(in.data(), expected.data(), n);
+    for (int i = 0; i < n; ++i)
+    {
+      if (std::abs(Complex(real[i * count + b], imag[i * count + b]) -
+            Complex(expected[i].Real, expected[i].Imag)) > 1e-9)
+      {
+        std::cerr << "ExecuteFftBatch differs from ExecuteFft at " << i << ".\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
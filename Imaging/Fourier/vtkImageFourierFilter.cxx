@@ -14,8 +14,243 @@
 =========================================================================*/
 #include "vtkImageFourierFilter.h"
 
+#include "vtkImageData.h"
 #include "vtkMath.h"
+
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*=========================================================================
+        Plans for batched transforms.
+=========================================================================*/
+
+namespace
+{
+// One pass of a self-sorting (Stockham) FFT.  For a span p (the product of
+// the radices of the previous passes), twiddle holds w^(r*k) for k < p and
+// 0 < r < radix, with w = exp(-2*pi*i / (p * radix)), and root holds the
+// radix roots of unity for the generic butterfly.
+struct vtkImageFourierStage
+{
+  int Radix;
+  int Span;
+  std::vector<double> TwiddleReal;
+  std::vector<double> TwiddleImag;
+  std::vector<double> RootReal;
+  std::vector<double> RootImag;
+};
+
+struct vtkImageFourierPlan
+{
+  int Length;
+  std::vector<vtkImageFourierStage> Stages;
+
+  explicit vtkImageFourierPlan(int n)
+    : Length(n)
+  {
+    // Factors of 4 first, then 2, then the odd factors.
+    std::vector<int> radices;
+    int rest = n;
+    while (rest % 4 == 0)
+    {
+      radices.push_back(4);
+      rest /= 4;
+    }
+    if (rest % 2 == 0)
+    {
+      radices.push_back(2);
+      rest /= 2;
+    }
+    for (int f = 3; rest > 1; f += 2)
+    {
+      if (f * f > rest)
+      {
+        f = rest;
+      }
+      while (rest % f == 0)
+      {
+        radices.push_back(f);
+        rest /= f;
+      }
+    }
+
+    int span = 1;
+    for (int radix : radices)
+    {
+      vtkImageFourierStage stage;
+      stage.Radix = radix;
+      stage.Span = span;
+      stage.TwiddleReal.resize(static_cast<size_t>(span) * (radix - 1));
+      stage.TwiddleImag.resize(stage.TwiddleReal.size());
+      for (int k = 0; k < span; ++k)
+      {
+        for (int r = 1; r < radix; ++r)
+        {
+          double angle = -2.0 * vtkMath::Pi() * r * k / (static_cast<double>(span) * radix);
+          stage.TwiddleReal[k * (radix - 1) + r - 1] = cos(angle);
+          stage.TwiddleImag[k * (radix - 1) + r - 1] = sin(angle);
+        }
+      }
+      if (radix != 2 && radix != 4)
+      {
+        stage.RootReal.resize(radix);
+        stage.RootImag.resize(radix);
+        for (int r = 0; r < radix; ++r)
+        {
+          double angle = -2.0 * vtkMath::Pi() * r / radix;
+          stage.RootReal[r] = cos(angle);
+          stage.RootImag[r] = sin(angle);
+        }
+      }
+      this->Stages.push_back(std::move(stage));
+      span *= radix;
+    }
+  }
+};
+
+// Apply one pass to count interleaved arrays.  Element i + r * N / radix of
+// the input goes, after the butterfly, to element (i - k) * radix + k + r * p
+// of the output, where k = i % p.  The inner loops run over the arrays.
+void vtkImageFourierPass(const vtkImageFourierStage& stage, int n, int count, double fb,
+  const double* inReal, const double* inImag, double* outReal, double* outImag,
+  std::vector<double>& scratch)
+{
+  const int radix = stage.Radix;
+  const int span = stage.Span;
+  const int m = n / radix;
+  const size_t stride = static_cast<size_t>(m) * count;
+  for (int i = 0; i < m; ++i)
+  {
+    const int k = i % span;
+    const double* twr = stage.TwiddleReal.data() + k * (radix - 1);
+    const double* twi = stage.TwiddleImag.data() + k * (radix - 1);
+    const double* ir = inReal + static_cast<size_t>(i) * count;
+    const double* ii = inImag + static_cast<size_t>(i) * count;
+    const size_t first = (static_cast<size_t>(i - k) * radix + k) * count;
+    const size_t ostride = static_cast<size_t>(span) * count;
+    double* orl = outReal + first;
+    double* oim = outImag + first;
+
+    if (radix == 2)
+    {
+      const double wr = twr[0];
+      const double wi = fb * twi[0];
+      for (int b = 0; b < count; ++b)
+      {
+        double x1r = ir[stride + b] * wr - ii[stride + b] * wi;
+        double x1i = ir[stride + b] * wi + ii[stride + b] * wr;
+        orl[b] = ir[b] + x1r;
+        oim[b] = ii[b] + x1i;
+        orl[ostride + b] = ir[b] - x1r;
+        oim[ostride + b] = ii[b] - x1i;
+      }
+    }
+    else if (radix == 4)
+    {
+      const double w1r = twr[0], w1i = fb * twi[0];
+      const double w2r = twr[1], w2i = fb * twi[1];
+      const double w3r = twr[2], w3i = fb * twi[2];
+      for (int b = 0; b < count; ++b)
+      {
+        double x0r = ir[b];
+        double x0i = ii[b];
+        double x1r = ir[stride + b] * w1r - ii[stride + b] * w1i;
+        double x1i = ir[stride + b] * w1i + ii[stride + b] * w1r;
+        double x2r = ir[2 * stride + b] * w2r - ii[2 * stride + b] * w2i;
+        double x2i = ir[2 * stride + b] * w2i + ii[2 * stride + b] * w2r;
+        double x3r = ir[3 * stride + b] * w3r - ii[3 * stride + b] * w3i;
+        double x3i = ir[3 * stride + b] * w3i + ii[3 * stride + b] * w3r;
+        double t0r = x0r + x2r, t0i = x0i + x2i;
+        double t1r = x0r - x2r, t1i = x0i - x2i;
+        double t2r = x1r + x3r, t2i = x1i + x3i;
+        // (x1 - x3) times -i (forward) or i (backward).
+        double t3r = fb * (x1i - x3i), t3i = fb * (x3r - x1r);
+        orl[b] = t0r + t2r;
+        oim[b] = t0i + t2i;
+        orl[ostride + b] = t1r + t3r;
+        oim[ostride + b] = t1i + t3i;
+        orl[2 * ostride + b] = t0r - t2r;
+        oim[2 * ostride + b] = t0i - t2i;
+        orl[3 * ostride + b] = t1r - t3r;
+        oim[3 * ostride + b] = t1i - t3i;
+      }
+    }
+    else
+    {
+      // Generic butterfly: a direct DFT of length radix.
+      double* xr = scratch.data();
+      double* xi = xr + radix;
+      for (int b = 0; b < count; ++b)
+      {
+        xr[0] = ir[b];
+        xi[0] = ii[b];
+        for (int r = 1; r < radix; ++r)
+        {
+          double vr = ir[r * stride + b];
+          double vi = ii[r * stride + b];
+          double wi = fb * twi[r - 1];
+          xr[r] = vr * twr[r - 1] - vi * wi;
+          xi[r] = vr * wi + vi * twr[r - 1];
+        }
+        for (int r = 0; r < radix; ++r)
+        {
+          double sr = 0.0;
+          double si = 0.0;
+          int q = 0;
+          for (int j = 0; j < radix; ++j)
+          {
+            double wr = stage.RootReal[q];
+            double wi = fb * stage.RootImag[q];
+            sr += xr[j] * wr - xi[j] * wi;
+            si += xr[j] * wi + xi[j] * wr;
+            q += r;
+            if (q >= radix)
+            {
+              q -= radix;
+            }
+          }
+          orl[r * ostride + b] = sr;
+          oim[r * ostride + b] = si;
+        }
+      }
+    }
+  }
+}
+}
+
+class vtkImageFourierFilter::vtkInternals
+{
+public:
+  std::mutex Mutex;
+  std::map<int, std::shared_ptr<const vtkImageFourierPlan> > Plans;
+
+  std::shared_ptr<const vtkImageFourierPlan> GetPlan(int n)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    std::shared_ptr<const vtkImageFourierPlan>& plan = this->Plans[n];
+    if (!plan)
+    {
+      plan = std::make_shared<const vtkImageFourierPlan>(n);
+    }
+    return plan;
+  }
+};
+
+//----------------------------------------------------------------------------
+vtkImageFourierFilter::vtkImageFourierFilter()
+{
+  this->Internals = new vtkInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkImageFourierFilter::~vtkImageFourierFilter()
+{
+  delete this->Internals;
+}
 
 /*=========================================================================
         Vectors of complex numbers.
@@ -146,58 +381,19 @@ void vtkImageFourierFilter::ExecuteFftStepN(
 void vtkImageFourierFilter::ExecuteFftForwardBackward(
   vtkImageComplex* in, vtkImageComplex* out, int N, int fb)
 {
-  vtkImageComplex *p1, *p2, *p3;
-  int block_size = 1;
-  int rest_size = N;
-  int n = 2;
-  int idx;
-
-  // If this is a reverse transform (scale accordingly).
-  if (fb == -1)
+  std::vector<double> buffer(4 * static_cast<size_t>(N));
+  double* real = buffer.data();
+  double* imag = real + N;
+  for (int idx = 0; idx < N; ++idx)
   {
-    p1 = in;
-    for (idx = 0; idx < N; ++idx)
-    {
-      p1->Real = p1->Real / N;
-      p1->Imag = p1->Imag / N;
-      ++p1;
-    }
-  }
-  p1 = in;
-  p2 = out;
-  while (block_size < N && n <= N)
-  {
-    if ((rest_size % n) == 0)
-    {
-      // n is a prime factor, perform one "butterfly" stage of the fft.
-      if (n == 2)
-      {
-        this->ExecuteFftStep2(p1, p2, N, block_size, fb);
-      }
-      else
-      {
-        this->ExecuteFftStepN(p1, p2, N, block_size, n, fb);
-      }
-      block_size = block_size * n;
-      rest_size = rest_size / n;
-      // switch input and output.
-      p3 = p1;
-      p1 = p2;
-      p2 = p3;
-    }
-    else
-    {
-      // n is not a prime factor. increment n to see if n+1 is.
-      ++n;
-    }
+    real[idx] = in[idx].Real;
+    imag[idx] = in[idx].Imag;
   }
-  // If the results ended up in the input, copy to output.
-  if (p1 != out)
+  this->ExecuteFftBatch(real, imag, imag + N, N, 1, fb);
+  for (int idx = 0; idx < N; ++idx)
   {
-    for (n = 0; n < N; ++n)
-    {
-      *out++ = *p1++;
-    }
+    out[idx].Real = real[idx];
+    out[idx].Imag = imag[idx];
   }
 }
 
@@ -219,9 +415,202 @@ void vtkImageFourierFilter::ExecuteRfft(vtkImageComplex* in, vtkImageComplex* ou
   this->ExecuteFftForwardBackward(in, out, N, -1);
 }
 
+
+//----------------------------------------------------------------------------
+// This function calculates the ffts of count interleaved arrays at once.
+void vtkImageFourierFilter::ExecuteFftBatch(
+  double* real, double* imag, double* work, int N, int count, int fb)
+{
+  if (N <= 0 || count <= 0)
+  {
+    return;
+  }
+  std::shared_ptr<const vtkImageFourierPlan> plan = this->Internals->GetPlan(N);
+  const size_t size = static_cast<size_t>(N) * count;
+
+  // If this is a reverse transform (scale accordingly).
+  if (fb == -1)
+  {
+    const double scale = 1.0 / N;
+    for (size_t idx = 0; idx < size; ++idx)
+    {
+      real[idx] *= scale;
+      imag[idx] *= scale;
+    }
+  }
+
+  std::vector<double> scratch;
+  double* inReal = real;
+  double* inImag = imag;
+  double* outReal = work;
+  double* outImag = work + size;
+  for (const vtkImageFourierStage& stage : plan->Stages)
+  {
+    scratch.resize(2 * static_cast<size_t>(stage.Radix));
+    vtkImageFourierPass(stage, N, count, fb, inReal, inImag, outReal, outImag, scratch);
+    std::swap(inReal, outReal);
+    std::swap(inImag, outImag);
+  }
+  // If the results ended up in the work array, copy them back.
+  if (inReal != real)
+  {
+    std::copy(inReal, inReal + size, real);
+    std::copy(inImag, inImag + size, imag);
+  }
+}
+
+//----------------------------------------------------------------------------
+// This templated function gathers the rows of the input into batches,
+// transforms them and scatters the results to the output.  The output is
+// always doubles.
+template <class T>
+void vtkImageFourierFilterExecuteRows(vtkImageFourierFilter* self, vtkImageData* inData,
+  int inExt[6], T* inPtr, vtkImageData* outData, int outExt[6], double* outPtr, int fb, int id)
+{
+  int inMin0, inMax0, outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
+  vtkIdType inInc0, inInc1, inInc2;
+  vtkIdType outInc0, outInc1, outInc2;
+
+  // Reorder axes (The outs here are just placeholders)
+  self->PermuteExtent(inExt, inMin0, inMax0, outMin1, outMax1, outMin2, outMax2);
+  self->PermuteExtent(outExt, outMin0, outMax0, outMin1, outMax1, outMin2, outMax2);
+  self->PermuteIncrements(inData->GetIncrements(), inInc0, inInc1, inInc2);
+  self->PermuteIncrements(outData->GetIncrements(), outInc0, outInc1, outInc2);
+
+  // Input has to have real components at least.
+  const int numberOfComponents = inData->GetNumberOfScalarComponents();
+  if (numberOfComponents < 1)
+  {
+    vtkGenericWarningMacro("No real components");
+    return;
+  }
+
+  const int N = inMax0 - inMin0 + 1;
+  const vtkIdType size1 = outMax1 - outMin1 + 1;
+  const vtkIdType numberOfRows = size1 * (outMax2 - outMin2 + 1);
+  if (N <= 0 || numberOfRows <= 0)
+  {
+    return;
+  }
+
+  // Transform a few rows at a time so that the batch stays in cache.  Real
+  // rows are paired as the real and imaginary parts of one complex row.
+  const bool realInput = (numberOfComponents == 1);
+  const int lanes = std::max(4, std::min(16, 8192 / N));
+  const int rowsPerBatch = realInput ? 2 * lanes : lanes;
+  std::vector<double> buffer(4 * static_cast<size_t>(N) * lanes);
+  std::vector<T*> inRows(rowsPerBatch);
+  std::vector<double*> outRows(rowsPerBatch);
+
+  const double startProgress =
+    self->GetIteration() / static_cast<double>(self->GetNumberOfIterations());
+  const vtkIdType numberOfBatches = (numberOfRows + rowsPerBatch - 1) / rowsPerBatch;
+  const vtkIdType target = numberOfBatches / 50 + 1;
+  const double progressScale = 1.0 / (numberOfBatches * self->GetNumberOfIterations());
+
+  for (vtkIdType batch = 0; batch < numberOfBatches && !self->AbortExecute; ++batch)
+  {
+    if (!id && batch % target == 0)
+    {
+      self->UpdateProgress(startProgress + batch * progressScale);
+    }
+    const vtkIdType firstRow = batch * rowsPerBatch;
+    const int rows = static_cast<int>(std::min<vtkIdType>(rowsPerBatch, numberOfRows - firstRow));
+    const int count = realInput ? (rows + 1) / 2 : rows;
+    for (int r = 0; r < rows; ++r)
+    {
+      const vtkIdType idx1 = (firstRow + r) % size1;
+      const vtkIdType idx2 = (firstRow + r) / size1;
+      inRows[r] = inPtr + idx1 * inInc1 + idx2 * inInc2;
+      outRows[r] = outPtr + idx1 * outInc1 + idx2 * outInc2;
+    }
+
+    // copy into complex numbers
+    const size_t size = static_cast<size_t>(N) * count;
+    double* real = buffer.data();
+    double* imag = real + size;
+    for (int idx0 = 0; idx0 < N; ++idx0)
+    {
+      double* pReal = real + static_cast<size_t>(idx0) * count;
+      double* pImag = imag + static_cast<size_t>(idx0) * count;
+      const vtkIdType offset = idx0 * inInc0;
+      if (realInput)
+      {
+        for (int b = 0; b < count; ++b)
+        {
+          pReal[b] = static_cast<double>(inRows[2 * b][offset]);
+          pImag[b] = (2 * b + 1 < rows) ? static_cast<double>(inRows[2 * b + 1][offset]) : 0.0;
+        }
+      }
+      else
+      {
+        for (int b = 0; b < count; ++b)
+        {
+          pReal[b] = static_cast<double>(inRows[b][offset]);
+          pImag[b] = static_cast<double>(inRows[b][offset + 1]);
+        }
+      }
+    }
+
+    self->ExecuteFftBatch(real, imag, imag + size, N, count, fb);
+
+    // copy into output
+    for (int idx0 = outMin0; idx0 <= outMax0; ++idx0)
+    {
+      const int k = idx0 - inMin0;
+      const double* pReal = real + static_cast<size_t>(k) * count;
+      const double* pImag = imag + static_cast<size_t>(k) * count;
+      const vtkIdType offset = (idx0 - outMin0) * outInc0;
+      if (realInput)
+      {
+        // Z = A + i*B for real rows A and B, so A[k] = (Z[k] + conj(Z[N-k])) / 2
+        // and B[k] = (Z[k] - conj(Z[N-k])) / 2i.
+        const int m = (k == 0 ? 0 : N - k);
+        const double* mReal = real + static_cast<size_t>(m) * count;
+        const double* mImag = imag + static_cast<size_t>(m) * count;
+        for (int b = 0; b < count; ++b)
+        {
+          double* pA = outRows[2 * b] + offset;
+          pA[0] = 0.5 * (pReal[b] + mReal[b]);
+          pA[1] = 0.5 * (pImag[b] - mImag[b]);
+          if (2 * b + 1 < rows)
+          {
+            double* pB = outRows[2 * b + 1] + offset;
+            pB[0] = 0.5 * (pImag[b] + mImag[b]);
+            pB[1] = 0.5 * (mReal[b] - pReal[b]);
+          }
+        }
+      }
+      else
+      {
+        for (int b = 0; b < count; ++b)
+        {
+          double* pOut = outRows[b] + offset;
+          pOut[0] = pReal[b];
+          pOut[1] = pImag[b];
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageFourierFilter::ExecuteFftRows(vtkImageData* inData, int inExt[6], void* inPtr,
+  vtkImageData* outData, int outExt[6], double* outPtr, int fb, int threadId)
+{
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkImageFourierFilterExecuteRows(this, inData, inExt,
+      static_cast<VTK_TT*>(inPtr), outData, outExt, outPtr, fb, threadId));
+    default:
+      vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      return;
+  }
+}
+
 //----------------------------------------------------------------------------
-// Called each axis over which the filter is executed.
-int vtkImageFourierFilter::RequestData(
+// Called for each axis over which the filter is executed.
+int vtkImageFourierFilter::IterativeRequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
   // ensure that iteration axis is not split during threaded execution
@@ -234,5 +623,5 @@ int vtkImageFourierFilter::RequestData(
     }
   }
 
-  return this->Superclass::RequestData(request, inputVector, outputVector);
+  return this->Superclass::IterativeRequestData(request, inputVector, outputVector);
 }
@@ -20,6 +20,13 @@
  * this superclass is a container for methods that manipulate these structure
  * including fast Fourier transforms.  Complex numbers may become a class.
  * This should really be a helper class.
+ *
+ * The transforms are computed by a mixed-radix, self-sorting FFT that works
+ * on many rows at once, with the real and imaginary parts of the rows in
+ * separate arrays so that each butterfly is a loop over the rows.  The
+ * factorization and twiddle factors of each length are computed once and
+ * cached.  Real input is transformed two rows at a time, as the real and
+ * imaginary parts of a single complex row.
  */
 
 #ifndef vtkImageFourierFilter_h
@@ -103,9 +110,18 @@ public:
    */
   void ExecuteRfft(vtkImageComplex* in, vtkImageComplex* out, int N);
 
+  /**
+   * This function calculates the fft (fb = 1) or the scaled inverse fft
+   * (fb = -1) of count arrays of length N at once.  The arrays are stored
+   * in split layout: element n of array b is real[n * count + b] +
+   * i * imag[n * count + b].  The results replace the input, and work must
+   * hold 2 * N * count values.
+   */
+  void ExecuteFftBatch(double* real, double* imag, double* work, int N, int count, int fb);
+
 protected:
-  vtkImageFourierFilter() {}
-  ~vtkImageFourierFilter() override {}
+  vtkImageFourierFilter();
+  ~vtkImageFourierFilter() override;
 
   void ExecuteFftStep2(vtkImageComplex* p_in, vtkImageComplex* p_out, int N, int bsize, int fb);
   void ExecuteFftStepN(
@@ -113,14 +129,25 @@ protected:
   void ExecuteFftForwardBackward(vtkImageComplex* in, vtkImageComplex* out, int N, int fb);
 
   /**
-   * Override to change extent splitting rules.
+   * Transform the rows of inExt along the current axis, where inPtr points
+   * to the first input value, and write the part of them that lies in outExt
+   * to outPtr.  This is called by the ThreadedRequestData of subclasses.
    */
-  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+  void ExecuteFftRows(vtkImageData* inData, int inExt[6], void* inPtr, vtkImageData* outData,
+    int outExt[6], double* outPtr, int fb, int threadId);
+
+  /**
+   * Override to change extent splitting rules for each axis.
+   */
+  int IterativeRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
 private:
   vtkImageFourierFilter(const vtkImageFourierFilter&) = delete;
   void operator=(const vtkImageFourierFilter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif
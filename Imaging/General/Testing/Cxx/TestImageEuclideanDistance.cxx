@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageEuclideanDistance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the Felzenszwalb algorithm of vtkImageEuclideanDistance with the
+// Saito algorithm for isotropic distances, and with a brute force search of
+// the nearest voxels for signed anisotropic distances and their features.
+// (The Saito algorithm is not exact with anisotropic spacing.)
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkImageEuclideanDistance.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+const int Dims[3] = { 23, 17, 11 };
+const double Spacing[3] = { 1.0, 1.5, 0.75 };
+
+double SquaredDistance(vtkIdType a, vtkIdType b, int dimensionality)
+{
+  double d2 = 0.0;
+  for (int axis = 0; axis < dimensionality; ++axis)
+  {
+    double d = (a % Dims[axis] - b % Dims[axis]) * Spacing[axis];
+    d2 += d * d;
+    a /= Dims[axis];
+    b /= Dims[axis];
+  }
+  // the voxels on other slices are not considered
+  return (a == b ? d2 : VTK_DOUBLE_MAX);
+}
+
+bool TestDimensionality(vtkImageData* image, int dimensionality)
+{
+  vtkNew<vtkImageEuclideanDistance> saito;
+  saito->SetInputData(image);
+  saito->SetDimensionality(dimensionality);
+  saito->SetAlgorithmToSaito();
+  saito->ConsiderAnisotropyOff();
+  saito->Update();
+  vtkDataArray* expected = saito->GetOutput()->GetPointData()->GetScalars();
+
+  vtkNew<vtkImageEuclideanDistance> linear;
+  linear->SetInputData(image);
+  linear->SetDimensionality(dimensionality);
+  linear->SetAlgorithmToFelzenszwalb();
+  linear->ConsiderAnisotropyOff();
+  linear->Update();
+  vtkDataArray* scalars = linear->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+  {
+    if (scalars->GetComponent(i, 0) != expected->GetComponent(i, 0))
+    {
+      std::cerr << "Dimensionality " << dimensionality << ": distance "
+                << scalars->GetComponent(i, 0) << " differs from " << expected->GetComponent(i, 0)
+                << " at " << i << ".\n";
+      return false;
+    }
+  }
+
+  // signed distances and the voxels that they come from
+  linear->ConsiderAnisotropyOn();
+  linear->SignedDistanceOn();
+  linear->GenerateFeatureIndicesOn();
+  linear->SetOutputScalarType(VTK_INT); // clamped to float
+  linear->Update();
+  vtkImageData* output = linear->GetOutput();
+  scalars = output->GetPointData()->GetScalars();
+  vtkIdTypeArray* features =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("FeatureIndices"));
+  if (scalars->GetDataType() != VTK_FLOAT || !features)
+  {
+    std::cerr << "The output has no float distances or no feature indices.\n";
+    return false;
+  }
+  const unsigned char* mask = static_cast<unsigned char*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+  {
+    double nearest = VTK_DOUBLE_MAX;
+    for (vtkIdType j = 0; j < scalars->GetNumberOfTuples(); ++j)
+    {
+      if ((mask[i] == 0) != (mask[j] == 0))
+      {
+        nearest = std::min(nearest, SquaredDistance(i, j, dimensionality));
+      }
+    }
+    // the rows without any zero voxel are at the maximum distance
+    bool found = (nearest < linear->GetMaximumDistance());
+    nearest = std::min(nearest, linear->GetMaximumDistance());
+    nearest = (mask[i] == 0 ? -nearest : nearest);
+    vtkIdType feature = features->GetValue(i);
+    if (std::abs(scalars->GetComponent(i, 0) - nearest) > 1e-6 * std::abs(nearest) ||
+      (found ? (feature < 0 || (mask[feature] == 0) == (mask[i] == 0) ||
+                 std::abs(SquaredDistance(i, feature, dimensionality) - std::abs(nearest)) > 1e-4)
+             : feature != -1))
+    {
+      std::cerr << "Dimensionality " << dimensionality << ": signed distance "
+                << scalars->GetComponent(i, 0) << " with feature " << feature << " differs from "
+                << nearest << " at " << i << ".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestImageEuclideanDistance(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dims[0], Dims[1], Dims[2]);
+  image->SetSpacing(Spacing[0], Spacing[1], Spacing[2]);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  unsigned char* scalars = static_cast<unsigned char*>(image->GetScalarPointer());
+  unsigned int state = 1;
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    state = state * 1103515245u + 12345u;
+    scalars[i] = (((state >> 16) % 100) < 97 ? 1 : 0);
+  }
+  for (int dimensionality = 1; dimensionality <= 3; ++dimensionality)
+  {
+    if (!TestDimensionality(image, dimensionality))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,200 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageGaussianSmoothRecursive.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the recursive method of vtkImageGaussianSmooth with a convolution
+// by the sampled gaussian and its derivatives, with the image extended past
+// its borders by its edge pixels, and check that a part of the output is
+// the same as the corresponding part of the whole output.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+const int Dims[3] = { 41, 30, 23 };
+
+// The gaussian or one of its derivatives at x.
+double Kernel(double x, double sigma, int order)
+{
+  double g = exp(-0.5 * x * x / (sigma * sigma)) / (sqrt(2 * vtkMath::Pi()) * sigma);
+  if (order == 1)
+  {
+    return -x / (sigma * sigma) * g;
+  }
+  else if (order == 2)
+  {
+    return (x * x / (sigma * sigma) - 1.0) / (sigma * sigma) * g;
+  }
+  return g;
+}
+
+// Convolve the values along each axis.
+void Convolve(std::vector<double>& values, const double sigma[3], const int orders[3],
+  const double spacing[3])
+{
+  const int strides[3] = { 1, Dims[0], Dims[0] * Dims[1] };
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (sigma[axis] == 0)
+    {
+      continue;
+    }
+    int radius = static_cast<int>(8 * sigma[axis]);
+    std::vector<double> kernel(2 * radius + 1);
+    for (int k = -radius; k <= radius; ++k)
+    {
+      kernel[k + radius] =
+        Kernel(k, sigma[axis], orders[axis]) / pow(spacing[axis], orders[axis]);
+    }
+    std::vector<double> result(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      int idx = static_cast<int>((i / strides[axis]) % Dims[axis]);
+      size_t start = i - static_cast<size_t>(idx) * strides[axis];
+      double sum = 0.0;
+      for (int k = -radius; k <= radius; ++k)
+      {
+        int j = std::min(std::max(idx - k, 0), Dims[axis] - 1);
+        sum += kernel[k + radius] * values[start + static_cast<size_t>(j) * strides[axis]];
+      }
+      result[i] = sum;
+    }
+    values.swap(result);
+  }
+}
+
+bool TestDerivatives(vtkImageData* image, const double sigma[3], const int orders[3])
+{
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  smooth->SetMethodToRecursive();
+  smooth->SetStandardDeviations(sigma[0], sigma[1], sigma[2]);
+  smooth->SetDerivativeOrders(orders[0], orders[1], orders[2]);
+  smooth->SetInputData(image);
+  smooth->Update();
+  vtkImageData* output = smooth->GetOutput();
+  bool derivatives = (orders[0] || orders[1] || orders[2]);
+  if (output->GetScalarType() != (derivatives ? VTK_DOUBLE : image->GetScalarType()))
+  {
+    std::cerr << "Wrong output scalar type " << output->GetScalarType() << ".\n";
+    return false;
+  }
+
+  vtkDataArray* inScalars = image->GetPointData()->GetScalars();
+  std::vector<double> expected(inScalars->GetNumberOfTuples());
+  for (vtkIdType i = 0; i < inScalars->GetNumberOfTuples(); ++i)
+  {
+    expected[i] = inScalars->GetComponent(i, 0);
+  }
+  Convolve(expected, sigma, orders, image->GetSpacing());
+
+  // the error of the recursive approximation is below one percent of the
+  // largest value for the gaussian and its first derivative, and below two
+  // percent for the second derivative
+  double largest = 0.0;
+  for (double value : expected)
+  {
+    largest = std::max(largest, std::abs(value));
+  }
+  bool second = (orders[0] == 2 || orders[1] == 2 || orders[2] == 2);
+  double tolerance = (second ? 0.02 : 0.01) * largest;
+  vtkDataArray* outScalars = output->GetPointData()->GetScalars();
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    double value = outScalars->GetComponent(static_cast<vtkIdType>(i), 0);
+    if (std::abs(value - expected[i]) > tolerance)
+    {
+      std::cerr << "Orders (" << orders[0] << ", " << orders[1] << ", " << orders[2]
+                << ") with deviations (" << sigma[0] << ", " << sigma[1] << ", " << sigma[2]
+                << "): value " << value << " differs from " << expected[i] << " at " << i
+                << ".\n";
+      return false;
+    }
+  }
+
+  // a part of the output is the same as the part of the whole output
+  int updateExtent[6] = { 4, 30, 7, 18, 2, 20 };
+  smooth->UpdateExtent(updateExtent);
+  output = smooth->GetOutput();
+  for (int k = updateExtent[4]; k <= updateExtent[5]; ++k)
+  {
+    for (int j = updateExtent[2]; j <= updateExtent[3]; ++j)
+    {
+      for (int i = updateExtent[0]; i <= updateExtent[1]; ++i)
+      {
+        double value = output->GetScalarComponentAsDouble(i, j, k, 0);
+        double whole =
+          outScalars->GetComponent((static_cast<vtkIdType>(k) * Dims[1] + j) * Dims[0] + i, 0);
+        if (std::abs(value - whole) > 1e-9 * largest)
+        {
+          std::cerr << "The partial output differs at (" << i << ", " << j << ", " << k << ").\n";
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestImageGaussianSmoothRecursive(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dims[0], Dims[1], Dims[2]);
+  image->SetSpacing(1.0, 0.5, 2.0);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  float* scalars = static_cast<float*>(image->GetScalarPointer());
+  unsigned int state = 1;
+  for (int k = 0; k < Dims[2]; ++k)
+  {
+    for (int j = 0; j < Dims[1]; ++j)
+    {
+      for (int i = 0; i < Dims[0]; ++i)
+      {
+        state = state * 1103515245u + 12345u;
+        *scalars++ = static_cast<float>(
+          100 * sin(0.2 * i + 0.1 * j) + 50 * cos(0.3 * k) + ((state >> 16) % 40));
+      }
+    }
+  }
+
+  const double deviations[][3] = { { 2.0, 2.0, 2.0 }, { 1.0, 3.5, 0.0 }, { 6.0, 4.0, 5.0 } };
+  const int orders[][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 2 }, { 2, 1, 0 } };
+  for (const double* sigma : deviations)
+  {
+    for (const int* order : orders)
+    {
+      bool valid = true;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        valid &= (order[axis] == 0 || sigma[axis] > 0);
+      }
+      if (valid && !TestDerivatives(image, sigma, order))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
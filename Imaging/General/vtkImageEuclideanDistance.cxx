@@ -14,13 +14,18 @@
 =========================================================================*/
 #include "vtkImageEuclideanDistance.h"
 
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageEuclideanDistance);
 
@@ -32,6 +37,9 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
   this->Initialize = 1;
   this->ConsiderAnisotropy = 1;
   this->Algorithm = VTK_EDT_SAITO;
+  this->SignedDistance = 0;
+  this->GenerateFeatureIndices = 0;
+  this->OutputScalarType = VTK_DOUBLE;
 }
 
 //----------------------------------------------------------------------------
@@ -39,7 +47,12 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
 int vtkImageEuclideanDistance::IterativeRequestInformation(
   vtkInformation* vtkNotUsed(input), vtkInformation* output)
 {
-  vtkDataObject::SetPointDataActiveScalarInfo(output, VTK_DOUBLE, 1);
+  int scalarType = VTK_DOUBLE;
+  if (this->Algorithm == VTK_EDT_FELZENSZWALB && this->OutputScalarType == VTK_FLOAT)
+  {
+    scalarType = VTK_FLOAT;
+  }
+  vtkDataObject::SetPointDataActiveScalarInfo(output, scalarType, 1);
   return 1;
 }
 
@@ -611,6 +624,292 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
   free(temp);
   free(sq);
 }
+//----------------------------------------------------------------------------
+// Execute the algorithm of Felzenszwalb and Huttenlocher.
+//
+// P.F. Felzenszwalb and D.P. Huttenlocher. Distance transforms of sampled
+// functions. Theory of Computing, 8(19). pp. 415--428, 2012.
+//
+// Along each axis, the squared distance of each voxel is the lower envelope
+// of the parabolas w*(q - p)^2 + f(p), where f is the result of the previous
+// axes and w is the squared spacing. The envelope is built in one scan of
+// the line and then evaluated in another one.
+namespace
+{
+
+struct vtkImageEuclideanDistanceEnvelope
+{
+  std::vector<double> F;
+  std::vector<vtkIdType> Features;
+  std::vector<int> V;
+  std::vector<double> Z;
+
+  void Resize(int n)
+  {
+    this->F.resize(n);
+    this->Features.resize(n);
+    this->V.resize(n);
+    this->Z.resize(n + 1);
+  }
+
+  // Compute the line, whose n values go in steps of inc, in place. The
+  // sites are the values below maxDist.
+  template <class T>
+  void Execute(T* line, vtkIdType* features, int n, vtkIdType inc, double w, double maxDist)
+  {
+    double* f = this->F.data();
+    int* v = this->V.data();
+    double* z = this->Z.data();
+    int k = -1;
+    for (int q = 0; q < n; ++q)
+    {
+      f[q] = static_cast<double>(line[q * inc]);
+      if (features)
+      {
+        this->Features[q] = features[q * inc];
+      }
+      if (f[q] >= maxDist)
+      {
+        continue;
+      }
+      double s = -VTK_DOUBLE_MAX;
+      while (k >= 0)
+      {
+        int p = v[k];
+        s = ((f[q] + w * q * q) - (f[p] + w * p * p)) / (2 * w * (q - p));
+        if (s > z[k])
+        {
+          break;
+        }
+        --k;
+      }
+      ++k;
+      v[k] = q;
+      z[k] = (k == 0 ? -VTK_DOUBLE_MAX : s);
+      z[k + 1] = VTK_DOUBLE_MAX;
+    }
+
+    if (k < 0)
+    {
+      // no sites, nothing is within the maximum distance
+      for (int q = 0; q < n; ++q)
+      {
+        line[q * inc] = static_cast<T>(maxDist);
+        if (features)
+        {
+          features[q * inc] = -1;
+        }
+      }
+      return;
+    }
+
+    k = 0;
+    for (int q = 0; q < n; ++q)
+    {
+      while (z[k + 1] < q)
+      {
+        ++k;
+      }
+      int p = v[k];
+      double d = w * (q - p) * (q - p) + f[p];
+      line[q * inc] = static_cast<T>(d < maxDist ? d : maxDist);
+      if (features)
+      {
+        features[q * inc] = (d < maxDist ? this->Features[p] : -1);
+      }
+    }
+  }
+};
+
+// Set the voxels that are zero in the input (or, for the outside of a
+// signed distance map, those that are not) to zero and the others to
+// maxDist, or copy the input if it is not initialized.
+template <class TIn, class TOut>
+void vtkImageEuclideanDistanceLinearInitialize(vtkImageData* inData, TIn* inPtr, const int ext[6],
+  TOut* outPtr, vtkIdType* features, bool initialize, bool outside, double maxDist)
+{
+  vtkIdType inIncX, inIncY, inIncZ;
+  inData->GetContinuousIncrements(const_cast<int*>(ext), inIncX, inIncY, inIncZ);
+  vtkIdType id = 0;
+  for (int idxZ = ext[4]; idxZ <= ext[5]; ++idxZ)
+  {
+    for (int idxY = ext[2]; idxY <= ext[3]; ++idxY)
+    {
+      for (int idxX = ext[0]; idxX <= ext[1]; ++idxX)
+      {
+        if (!initialize)
+        {
+          *outPtr = static_cast<TOut>(*inPtr);
+        }
+        else
+        {
+          *outPtr = static_cast<TOut>(((*inPtr == 0) != outside) ? 0.0 : maxDist);
+        }
+        if (features)
+        {
+          features[id] = id;
+        }
+        ++id;
+        ++inPtr;
+        ++outPtr;
+      }
+      inPtr += inIncY;
+    }
+    inPtr += inIncZ;
+  }
+}
+
+// Compute the distance map in place, one axis after the other.
+template <class T>
+void vtkImageEuclideanDistanceLinearExecute(vtkImageEuclideanDistance* self, T* data,
+  vtkIdType* features, const int size[3], const double w[3], double maxDist, int numAxes)
+{
+  const vtkIdType incs[3] = { 1, size[0], static_cast<vtkIdType>(size[0]) * size[1] };
+  for (int axis = 0; axis < numAxes && !self->AbortExecute; ++axis)
+  {
+    int axis1 = (axis == 0 ? 1 : 0);
+    int axis2 = (axis == 2 ? 1 : 2);
+    int n = size[axis];
+    vtkIdType inc = incs[axis];
+    vtkIdType numLines = static_cast<vtkIdType>(size[axis1]) * size[axis2];
+    vtkSMPTools::For(0, numLines, [&](vtkIdType first, vtkIdType last) {
+      vtkImageEuclideanDistanceEnvelope envelope;
+      envelope.Resize(n);
+      for (vtkIdType line = first; line < last; ++line)
+      {
+        vtkIdType offset =
+          (line % size[axis1]) * incs[axis1] + (line / size[axis1]) * incs[axis2];
+        envelope.Execute(
+          data + offset, (features ? features + offset : nullptr), n, inc, w[axis], maxDist);
+      }
+    });
+    self->UpdateProgress((axis + 1.0) / numAxes);
+  }
+}
+
+template <class T>
+void vtkImageEuclideanDistanceLinear(vtkImageEuclideanDistance* self, vtkImageData* inData,
+  const int ext[6], T* outPtr, vtkIdType* features, const double w[3], int numAxes)
+{
+  const int size[3] = { ext[1] - ext[0] + 1, ext[3] - ext[2] + 1, ext[5] - ext[4] + 1 };
+  vtkIdType numPoints = static_cast<vtkIdType>(size[0]) * size[1] * size[2];
+  double maxDist = self->GetMaximumDistance();
+  bool initialize = (self->GetInitialize() != 0);
+  void* inPtr = inData->GetScalarPointerForExtent(const_cast<int*>(ext));
+
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkImageEuclideanDistanceLinearInitialize(inData,
+      static_cast<VTK_TT*>(inPtr), ext, outPtr, features, initialize, false, maxDist));
+  }
+  vtkImageEuclideanDistanceLinearExecute(self, outPtr, features, size, w, maxDist, numAxes);
+  if (!initialize || !self->GetSignedDistance())
+  {
+    return;
+  }
+
+  // the zero voxels get minus their distance to the non-zero voxels
+  std::vector<T> outside(numPoints);
+  std::vector<vtkIdType> outsideFeatures(features ? numPoints : 0);
+  vtkIdType* outsideFeaturesPtr = (features ? outsideFeatures.data() : nullptr);
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkImageEuclideanDistanceLinearInitialize(inData,
+      static_cast<VTK_TT*>(inPtr), ext, outside.data(), outsideFeaturesPtr, true, true, maxDist));
+  }
+  vtkImageEuclideanDistanceLinearExecute(
+    self, outside.data(), outsideFeaturesPtr, size, w, maxDist, numAxes);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    // the voxels that are zero in the input are at zero from themselves
+    if (outPtr[i] == 0 && outside[i] != 0)
+    {
+      outPtr[i] = -outside[i];
+      if (features)
+      {
+        features[i] = outsideFeatures[i];
+      }
+    }
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkImageEuclideanDistance::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->Algorithm != VTK_EDT_FELZENSZWALB)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // all the axes are done at once, in place in the output
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkImageData* inData = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* outData = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), outExt);
+  this->AllocateOutputScalars(outData, outExt, outInfo);
+
+  vtkDebugMacro(<< "Executing image euclidean distance");
+
+  if (!inData->GetScalarPointerForExtent(outExt))
+  {
+    vtkErrorMacro(<< "Execute: No scalars for update extent.");
+    return 1;
+  }
+  if (inData->GetNumberOfScalarComponents() != 1)
+  {
+    vtkErrorMacro(<< "Execute: Cannot handle more than 1 components");
+    return 1;
+  }
+  if (outExt[0] > outExt[1] || outExt[2] > outExt[3] || outExt[4] > outExt[5])
+  {
+    return 1;
+  }
+
+  vtkIdType* features = nullptr;
+  if (this->GenerateFeatureIndices)
+  {
+    vtkIdTypeArray* featureArray = vtkIdTypeArray::New();
+    featureArray->SetName("FeatureIndices");
+    featureArray->SetNumberOfTuples(outData->GetNumberOfPoints());
+    outData->GetPointData()->AddArray(featureArray);
+    featureArray->Delete();
+    features = featureArray->GetPointer(0);
+  }
+
+  double w[3] = { 1.0, 1.0, 1.0 };
+  if (this->ConsiderAnisotropy)
+  {
+    double* spacing = outData->GetSpacing();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      w[axis] = spacing[axis] * spacing[axis];
+    }
+  }
+
+  void* outPtr = outData->GetScalarPointer();
+  switch (outData->GetScalarType())
+  {
+    case VTK_FLOAT:
+      vtkImageEuclideanDistanceLinear(
+        this, inData, outExt, static_cast<float*>(outPtr), features, w, this->Dimensionality);
+      break;
+    case VTK_DOUBLE:
+      vtkImageEuclideanDistanceLinear(
+        this, inData, outExt, static_cast<double*>(outPtr), features, w, this->Dimensionality);
+      break;
+    default:
+      vtkErrorMacro(<< "Execute: Output must be type float or double.");
+  }
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkImageEuclideanDistance::AllocateOutputScalars(
   vtkImageData* outData, int outExt[6], vtkInformation* outInfo)
@@ -731,8 +1030,16 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << "Saito\n";
   }
+  else if (this->Algorithm == VTK_EDT_FELZENSZWALB)
+  {
+    os << "Felzenszwalb\n";
+  }
   else
   {
     os << "Saito Cached\n";
   }
+
+  os << indent << "Signed Distance: " << (this->SignedDistance ? "On\n" : "Off\n");
+  os << indent << "Generate Feature Indices: " << (this->GenerateFeatureIndices ? "On\n" : "Off\n");
+  os << indent << "Output Scalar Type: " << this->OutputScalarType << "\n";
 }
@@ -31,6 +31,13 @@
  * slow it very significantly. In that case, one should use
  * ::SetAlgorithmToSaitoCached() instead for better performance.
  *
+ * ::SetAlgorithmToFelzenszwalb() selects the algorithm of Felzenszwalb and
+ * Huttenlocher, which computes the exact distance map in linear time with
+ * the lower envelope of parabolas along each axis. It works in place in the
+ * output instead of copying the image for each axis, it processes the lines
+ * of each axis in parallel, and it also provides signed distances, the
+ * indices of the nearest features and a float output.
+ *
  * References:
  *
  * T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance
@@ -40,6 +47,9 @@
  * O. Cuisenaire. Distance Transformation: fast algorithms and applications
  * to medical image processing. PhD Thesis, Universite catholique de Louvain,
  * October 1999. http://ltswww.epfl.ch/~cuisenai/papers/oc_thesis.pdf
+ *
+ * P.F. Felzenszwalb and D.P. Huttenlocher. Distance transforms of sampled
+ * functions. Theory of Computing, 8(19). pp. 415--428, 2012.
  */
 
 #ifndef vtkImageEuclideanDistance_h
@@ -50,6 +60,7 @@
 
 #define VTK_EDT_SAITO_CACHED 0
 #define VTK_EDT_SAITO 1
+#define VTK_EDT_FELZENSZWALB 2
 
 class VTKIMAGINGGENERAL_EXPORT vtkImageEuclideanDistance : public vtkImageDecomposeFilter
 {
@@ -94,12 +105,49 @@ public:
    * Selects a Euclidean DT algorithm.
    * 1. Saito
    * 2. Saito-cached
-   * More algorithms will be added later on.
+   * 3. Felzenszwalb
    */
   vtkSetMacro(Algorithm, int);
   vtkGetMacro(Algorithm, int);
   void SetAlgorithmToSaito() { this->SetAlgorithm(VTK_EDT_SAITO); }
   void SetAlgorithmToSaitoCached() { this->SetAlgorithm(VTK_EDT_SAITO_CACHED); }
+  void SetAlgorithmToFelzenszwalb() { this->SetAlgorithm(VTK_EDT_FELZENSZWALB); }
+  //@}
+
+  //@{
+  /**
+   * Compute signed distances: the voxels that are zero in the input get
+   * minus the square of the distance to the nearest non-zero voxel.
+   * This needs Initialize and the Felzenszwalb algorithm.
+   */
+  vtkSetMacro(SignedDistance, vtkTypeBool);
+  vtkGetMacro(SignedDistance, vtkTypeBool);
+  vtkBooleanMacro(SignedDistance, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Add a "FeatureIndices" array to the output with, for each voxel, the
+   * point id of the voxel whose distance it got, i.e. of the nearest zero
+   * voxel (or non-zero voxel, for the zero voxels of a signed distance map).
+   * The id is -1 when no such voxel is within MaximumDistance. This needs
+   * the Felzenszwalb algorithm.
+   */
+  vtkSetMacro(GenerateFeatureIndices, vtkTypeBool);
+  vtkGetMacro(GenerateFeatureIndices, vtkTypeBool);
+  vtkBooleanMacro(GenerateFeatureIndices, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Set the scalar type of the output of the Felzenszwalb algorithm to
+   * float or double (the default), other types are clamped to one of them.
+   * The Saito algorithms always produce doubles.
+   */
+  vtkSetClampMacro(OutputScalarType, int, VTK_FLOAT, VTK_DOUBLE);
+  vtkGetMacro(OutputScalarType, int);
+  void SetOutputScalarTypeToFloat() { this->SetOutputScalarType(VTK_FLOAT); }
+  void SetOutputScalarTypeToDouble() { this->SetOutputScalarType(VTK_DOUBLE); }
   //@}
 
   int IterativeRequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -112,12 +160,16 @@ protected:
   vtkTypeBool Initialize;
   vtkTypeBool ConsiderAnisotropy;
   int Algorithm;
+  vtkTypeBool SignedDistance;
+  vtkTypeBool GenerateFeatureIndices;
+  int OutputScalarType;
 
   // Replaces "EnlargeOutputUpdateExtent"
   virtual void AllocateOutputScalars(vtkImageData* outData, int outExt[6], vtkInformation* outInfo);
 
   int IterativeRequestInformation(vtkInformation* in, vtkInformation* out) override;
   int IterativeRequestUpdateExtent(vtkInformation* in, vtkInformation* out) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
 private:
   vtkImageEuclideanDistance(const vtkImageEuclideanDistance&) = delete;
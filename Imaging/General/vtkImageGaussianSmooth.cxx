@@ -18,9 +18,13 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageGaussianSmooth);
 
@@ -34,6 +38,10 @@ vtkImageGaussianSmooth::vtkImageGaussianSmooth()
   this->RadiusFactors[0] = 1.5;
   this->RadiusFactors[1] = 1.5;
   this->RadiusFactors[2] = 1.5;
+  this->Method = Convolution;
+  this->DerivativeOrders[0] = 0;
+  this->DerivativeOrders[1] = 0;
+  this->DerivativeOrders[2] = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -55,6 +63,34 @@ void vtkImageGaussianSmooth::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "StandardDeviations: ( " << this->StandardDeviations[0] << ", "
      << this->StandardDeviations[1] << ", " << this->StandardDeviations[2] << " )\n";
+
+  os << indent << "Method: " << this->GetMethodAsString() << "\n";
+
+  os << indent << "DerivativeOrders: ( " << this->DerivativeOrders[0] << ", "
+     << this->DerivativeOrders[1] << ", " << this->DerivativeOrders[2] << " )\n";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkImageGaussianSmooth::GetMethodAsString()
+{
+  return (this->Method == Recursive ? "Recursive" : "Convolution");
+}
+
+//----------------------------------------------------------------------------
+bool vtkImageGaussianSmooth::HasDerivatives()
+{
+  if (this->Method != Recursive)
+  {
+    return false;
+  }
+  for (int idx = 0; idx < this->Dimensionality; ++idx)
+  {
+    if (this->DerivativeOrders[idx] != 0)
+    {
+      return true;
+    }
+  }
+  return false;
 }
 
 //----------------------------------------------------------------------------
@@ -84,6 +120,22 @@ void vtkImageGaussianSmooth::ComputeKernel(double* kernel, int min, int max, dou
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkImageGaussianSmooth::RequestInformation(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  this->Superclass::RequestInformation(request, inputVector, outputVector);
+
+  // derivatives are signed and fractional, like those of vtkImageGradient
+  if (this->HasDerivatives())
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_DOUBLE, -1);
+  }
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkImageGaussianSmooth::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -114,6 +166,13 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(int* inExt, int* wholeE
   // Expand filtered axes
   for (idx = 0; idx < this->Dimensionality; ++idx)
   {
+    if (this->Method == Recursive)
+    {
+      // the recursive filter needs whole lines
+      inExt[idx * 2] = wholeExtent[idx * 2];
+      inExt[idx * 2 + 1] = wholeExtent[idx * 2 + 1];
+      continue;
+    }
     radius = static_cast<int>(this->StandardDeviations[idx] * this->RadiusFactors[idx]);
     inExt[idx * 2] -= radius;
     if (inExt[idx * 2] < wholeExtent[idx * 2])
@@ -448,3 +507,398 @@ void vtkImageGaussianSmooth::ThreadedRequestData(vtkInformation* vtkNotUsed(requ
       break;
   }
 }
+
+//----------------------------------------------------------------------------
+// The recursive method smooths with the fourth-order approximation of the
+// gaussian and its derivatives by Deriche ("Recursively implementing the
+// gaussian and its derivatives", 1993), as the sum of a causal filter
+//   y+[i] = N0 x[i] + ... + N3 x[i-3] - D1 y+[i-1] - ... - D4 y+[i-4]
+// and an anticausal filter
+//   y-[i] = M1 x[i+1] + ... + M4 x[i+4] - D1 y-[i+1] - ... - D4 y-[i+4]
+namespace
+{
+
+struct vtkGaussianRecursiveFilter
+{
+  double N[4];
+  double M[5];
+  double D[5];
+  // the steady state of the causal and anticausal filters for a constant
+  double CausalGain;
+  double AntiCausalGain;
+
+  void Initialize(double sigma, int order);
+};
+
+// The numerator of the causal filter for one set of Deriche's parameters.
+void vtkGaussianRecursiveNumerator(
+  double sigma, double a1, double b1, double a2, double b2, double n[4], double moments[3])
+{
+  const double w1 = 0.6681;
+  const double l1 = -1.3932;
+  const double w2 = 2.0787;
+  const double l2 = -1.3732;
+  double sin1 = sin(w1 / sigma);
+  double sin2 = sin(w2 / sigma);
+  double cos1 = cos(w1 / sigma);
+  double cos2 = cos(w2 / sigma);
+  double exp1 = exp(l1 / sigma);
+  double exp2 = exp(l2 / sigma);
+
+  n[0] = a1 + a2;
+  n[1] = exp2 * (b2 * sin2 - (a2 + 2 * a1) * cos2) + exp1 * (b1 * sin1 - (a1 + 2 * a2) * cos1);
+  n[2] = 2 * exp1 * exp2 * ((a1 + a2) * cos2 * cos1 - b1 * cos2 * sin1 - b2 * cos1 * sin2) +
+    a2 * exp1 * exp1 + a1 * exp2 * exp2;
+  n[3] =
+    exp2 * exp1 * exp1 * (b2 * sin2 - a2 * cos2) + exp1 * exp2 * exp2 * (b1 * sin1 - a1 * cos1);
+
+  // the sum of the coefficients and of the coefficients times i and i*i
+  moments[0] = n[0] + n[1] + n[2] + n[3];
+  moments[1] = n[1] + 2 * n[2] + 3 * n[3];
+  moments[2] = n[1] + 4 * n[2] + 9 * n[3];
+}
+
+void vtkGaussianRecursiveFilter::Initialize(double sigma, int order)
+{
+  // Deriche's parameters for the gaussian and its two derivatives
+  const double a1[3] = { 1.3530, -0.6724, -1.3563 };
+  const double b1[3] = { 1.8151, -3.4327, 5.2438 };
+  const double a2[3] = { -0.3531, 0.6724, 0.3446 };
+  const double b2[3] = { 0.0902, 0.6100, -2.2355 };
+
+  // the denominator is the same for all orders
+  double cos1 = cos(0.6681 / sigma);
+  double cos2 = cos(2.0787 / sigma);
+  double exp1 = exp(-1.3932 / sigma);
+  double exp2 = exp(-1.3732 / sigma);
+  this->D[0] = 1.0;
+  this->D[1] = -2 * (exp2 * cos2 + exp1 * cos1);
+  this->D[2] = 4 * cos2 * cos1 * exp1 * exp2 + exp1 * exp1 + exp2 * exp2;
+  this->D[3] = -2 * cos1 * exp1 * exp2 * exp2 - 2 * cos2 * exp2 * exp1 * exp1;
+  this->D[4] = exp1 * exp1 * exp2 * exp2;
+  double sd = 0.0, dd = 0.0, ed = 0.0;
+  for (int k = 0; k <= 4; ++k)
+  {
+    sd += this->D[k];
+    dd += k * this->D[k];
+    ed += k * k * this->D[k];
+  }
+
+  // normalize the response to a constant, a ramp or a parabola
+  double moments[3];
+  double scale = 1.0;
+  if (order == 0)
+  {
+    vtkGaussianRecursiveNumerator(sigma, a1[0], b1[0], a2[0], b2[0], this->N, moments);
+    scale = 2 * moments[0] / sd - this->N[0];
+  }
+  else if (order == 1)
+  {
+    vtkGaussianRecursiveNumerator(sigma, a1[1], b1[1], a2[1], b2[1], this->N, moments);
+    scale = 2 * (moments[0] * dd - moments[1] * sd) / (sd * sd);
+  }
+  else
+  {
+    // remove the response to a constant from the second derivative
+    double n0[4], moments0[3];
+    vtkGaussianRecursiveNumerator(sigma, a1[0], b1[0], a2[0], b2[0], n0, moments0);
+    vtkGaussianRecursiveNumerator(sigma, a1[2], b1[2], a2[2], b2[2], this->N, moments);
+    double beta = -(2 * moments[0] - sd * this->N[0]) / (2 * moments0[0] - sd * n0[0]);
+    for (int k = 0; k < 3; ++k)
+    {
+      this->N[k] += beta * n0[k];
+      moments[k] += beta * moments0[k];
+    }
+    this->N[3] += beta * n0[3];
+    scale = (moments[2] * sd * sd - ed * moments[0] * sd - 2 * moments[1] * dd * sd +
+              2 * dd * dd * moments[0]) /
+      (sd * sd * sd);
+  }
+  for (int k = 0; k < 4; ++k)
+  {
+    this->N[k] /= scale;
+  }
+
+  // the anticausal filter mirrors the causal one, with a change of sign
+  // for the odd derivative
+  double sign = (order == 1 ? -1.0 : 1.0);
+  this->M[0] = 0.0;
+  for (int k = 1; k < 4; ++k)
+  {
+    this->M[k] = sign * (this->N[k] - this->D[k] * this->N[0]);
+  }
+  this->M[4] = -sign * this->D[4] * this->N[0];
+
+  double sn = this->N[0] + this->N[1] + this->N[2] + this->N[3];
+  double sm = this->M[1] + this->M[2] + this->M[3] + this->M[4];
+  this->CausalGain = sn / sd;
+  this->AntiCausalGain = sm / sd;
+}
+
+// Filter "lanes" adjacent lines of length n in place, where the lines start
+// at data and go in steps of "stride". The image is extended past the ends
+// of the lines with copies of the end pixels. The x and y buffers hold
+// n + 8 rows of "lanes" values, so that the lanes are the inner loop.
+void vtkGaussianRecursiveLines(const vtkGaussianRecursiveFilter& f, double* data, int n,
+  vtkIdType stride, int lanes, double* x, double* y)
+{
+  const double* N = f.N;
+  const double* M = f.M;
+  const double* D = f.D;
+
+  // copy the lines, and pad them with four copies of the end pixels
+  for (int i = 0; i < n; ++i)
+  {
+    std::copy(data + i * stride, data + i * stride + lanes, x + (i + 4) * lanes);
+  }
+  for (int i = 0; i < 4; ++i)
+  {
+    std::copy(x + 4 * lanes, x + 5 * lanes, x + i * lanes);
+    std::copy(x + (n + 3) * lanes, x + (n + 4) * lanes, x + (n + 4 + i) * lanes);
+  }
+
+  // causal filter, from the steady state for the first pixel
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int l = 0; l < lanes; ++l)
+    {
+      y[i * lanes + l] = f.CausalGain * x[4 * lanes + l];
+    }
+  }
+  for (int i = 4; i < n + 4; ++i)
+  {
+    const double* xi = x + i * lanes;
+    double* yi = y + i * lanes;
+    for (int l = 0; l < lanes; ++l)
+    {
+      yi[l] = N[0] * xi[l] + N[1] * xi[l - lanes] + N[2] * xi[l - 2 * lanes] +
+        N[3] * xi[l - 3 * lanes] - D[1] * yi[l - lanes] - D[2] * yi[l - 2 * lanes] -
+        D[3] * yi[l - 3 * lanes] - D[4] * yi[l - 4 * lanes];
+    }
+    std::copy(yi, yi + lanes, data + (i - 4) * stride);
+  }
+
+  // anticausal filter, from the steady state for the last pixel
+  for (int i = n + 4; i < n + 8; ++i)
+  {
+    for (int l = 0; l < lanes; ++l)
+    {
+      y[i * lanes + l] = f.AntiCausalGain * x[(n + 3) * lanes + l];
+    }
+  }
+  for (int i = n + 3; i >= 4; --i)
+  {
+    const double* xi = x + i * lanes;
+    double* yi = y + i * lanes;
+    double* outPtr = data + (i - 4) * stride;
+    for (int l = 0; l < lanes; ++l)
+    {
+      yi[l] = M[1] * xi[l + lanes] + M[2] * xi[l + 2 * lanes] + M[3] * xi[l + 3 * lanes] +
+        M[4] * xi[l + 4 * lanes] - D[1] * yi[l + lanes] - D[2] * yi[l + 2 * lanes] -
+        D[3] * yi[l + 3 * lanes] - D[4] * yi[l + 4 * lanes];
+      outPtr[l] += yi[l];
+    }
+  }
+}
+
+// Copy the input extent into a buffer of doubles.
+template <class T>
+void vtkGaussianRecursiveGather(vtkImageData* inData, T* inPtr, const int ext[6], double* buffer)
+{
+  vtkIdType inIncX, inIncY, inIncZ;
+  inData->GetContinuousIncrements(const_cast<int*>(ext), inIncX, inIncY, inIncZ);
+  vtkIdType rowLength =
+    static_cast<vtkIdType>(ext[1] - ext[0] + 1) * inData->GetNumberOfScalarComponents();
+  for (int idxZ = ext[4]; idxZ <= ext[5]; ++idxZ)
+  {
+    for (int idxY = ext[2]; idxY <= ext[3]; ++idxY)
+    {
+      for (vtkIdType i = 0; i < rowLength; ++i)
+      {
+        *buffer++ = static_cast<double>(*inPtr++);
+      }
+      inPtr += inIncY;
+    }
+    inPtr += inIncZ;
+  }
+}
+
+// Copy the output extent out of the buffer, which holds the input extent.
+template <class T>
+void vtkGaussianRecursiveScatter(const double* buffer, const int inExt[6], vtkImageData* outData,
+  T* outPtr, const int outExt[6])
+{
+  int numComps = outData->GetNumberOfScalarComponents();
+  vtkIdType outIncX, outIncY, outIncZ;
+  outData->GetContinuousIncrements(const_cast<int*>(outExt), outIncX, outIncY, outIncZ);
+  vtkIdType bufIncY = static_cast<vtkIdType>(inExt[1] - inExt[0] + 1) * numComps;
+  vtkIdType bufIncZ = bufIncY * (inExt[3] - inExt[2] + 1);
+  vtkIdType rowLength = static_cast<vtkIdType>(outExt[1] - outExt[0] + 1) * numComps;
+  for (int idxZ = outExt[4]; idxZ <= outExt[5]; ++idxZ)
+  {
+    for (int idxY = outExt[2]; idxY <= outExt[3]; ++idxY)
+    {
+      const double* bufPtr = buffer + (idxZ - inExt[4]) * bufIncZ + (idxY - inExt[2]) * bufIncY +
+        (outExt[0] - inExt[0]) * numComps;
+      for (vtkIdType i = 0; i < rowLength; ++i)
+      {
+        *outPtr++ = static_cast<T>(bufPtr[i]);
+      }
+      outPtr += outIncY;
+    }
+    outPtr += outIncZ;
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkImageGaussianSmooth::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->Method != Recursive)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // the recursive method filters whole lines, so instead of splitting the
+  // extent into pieces, it splits each pass into groups of lines
+  vtkImageData* inData = nullptr;
+  vtkImageData** inDataPtr = &inData;
+  vtkImageData* outData = nullptr;
+  this->PrepareImageData(inputVector, outputVector, &inDataPtr, &outData);
+
+  int inExt[6], outExt[6], wholeExt[6];
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  if (outExt[0] > outExt[1] || outExt[2] > outExt[3] || outExt[4] > outExt[5] ||
+    !inData->GetPointData()->GetScalars())
+  {
+    return 1;
+  }
+  std::copy(outExt, outExt + 6, inExt);
+  this->InternalRequestUpdateExtent(inExt, wholeExt);
+
+  this->ExecuteRecursive(inData, inExt, outData, outExt);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageGaussianSmooth::ExecuteRecursive(
+  vtkImageData* inData, int inExt[6], vtkImageData* outData, int outExt[6])
+{
+  if (!this->HasDerivatives() && inData->GetScalarType() != outData->GetScalarType())
+  {
+    vtkErrorMacro("Execute: input ScalarType, " << inData->GetScalarType()
+                                                << ", must match out ScalarType "
+                                                << outData->GetScalarType());
+    return;
+  }
+  int numAxes = std::min(this->Dimensionality, 3);
+  for (int axis = 0; axis < numAxes; ++axis)
+  {
+    int order = this->DerivativeOrders[axis];
+    if (order < 0 || order > 2)
+    {
+      vtkErrorMacro("Execute: the derivative order must be 0, 1 or 2, not " << order);
+      return;
+    }
+    if (order > 0 && this->StandardDeviations[axis] <= 0.0)
+    {
+      vtkErrorMacro("Execute: a derivative needs a positive standard deviation");
+      return;
+    }
+  }
+
+  // filter a copy of the input extent as doubles
+  int numComps = inData->GetNumberOfScalarComponents();
+  int size[3] = { inExt[1] - inExt[0] + 1, inExt[3] - inExt[2] + 1, inExt[5] - inExt[4] + 1 };
+  vtkIdType incs[3];
+  incs[0] = numComps;
+  incs[1] = incs[0] * size[0];
+  incs[2] = incs[1] * size[1];
+  std::vector<double> buffer(static_cast<size_t>(incs[2] * size[2]));
+  void* inPtr = inData->GetScalarPointerForExtent(inExt);
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkGaussianRecursiveGather(
+      inData, static_cast<VTK_TT*>(inPtr), inExt, buffer.data()));
+    default:
+      vtkErrorMacro("Unknown scalar type");
+      return;
+  }
+
+  double* spacing = inData->GetSpacing();
+  for (int axis = 0; axis < numAxes && !this->AbortExecute; ++axis)
+  {
+    int order = this->DerivativeOrders[axis];
+    if (this->StandardDeviations[axis] <= 0.0 || size[axis] < 2)
+    {
+      continue;
+    }
+    vtkGaussianRecursiveFilter filter;
+    filter.Initialize(this->StandardDeviations[axis], order);
+    if (order > 0)
+    {
+      // derivatives in data coordinates, rather than per pixel
+      double scale = pow(spacing[axis], -order);
+      for (int k = 0; k < 4; ++k)
+      {
+        filter.N[k] *= scale;
+        filter.M[k + 1] *= scale;
+      }
+      filter.CausalGain *= scale;
+      filter.AntiCausalGain *= scale;
+    }
+
+    // along x the lanes are the components, otherwise they are runs of
+    // adjacent values along x that are split into blocks
+    const int blockSize = 64;
+    int n = size[axis];
+    vtkIdType stride = incs[axis];
+    vtkIdType lanesPerLine = (axis == 0 ? numComps : incs[1]);
+    vtkIdType blocksPerLine = (lanesPerLine + blockSize - 1) / blockSize;
+    vtkIdType numLines = static_cast<vtkIdType>(size[0]) * size[1] * size[2] / size[axis];
+    if (axis != 0)
+    {
+      numLines /= size[0];
+    }
+    int otherAxis = (axis == 2 ? 1 : 2);
+    double* data = buffer.data();
+
+    vtkSMPTools::For(0, numLines * blocksPerLine, [&](vtkIdType first, vtkIdType last) {
+      std::vector<double> work(2 * static_cast<size_t>(n + 8) * blockSize);
+      for (vtkIdType task = first; task < last; ++task)
+      {
+        vtkIdType line = task / blocksPerLine;
+        vtkIdType lane = (task % blocksPerLine) * blockSize;
+        int lanes = static_cast<int>(std::min<vtkIdType>(blockSize, lanesPerLine - lane));
+        vtkIdType offset = lane;
+        if (axis == 0)
+        {
+          offset += (line % size[1]) * incs[1] + (line / size[1]) * incs[2];
+        }
+        else
+        {
+          offset += line * incs[otherAxis];
+        }
+        vtkGaussianRecursiveLines(filter, data + offset, n, stride, lanes, work.data(),
+          work.data() + static_cast<size_t>(n + 8) * blockSize);
+      }
+    });
+    this->UpdateProgress(static_cast<double>(axis + 1) / numAxes);
+  }
+
+  void* outPtr = outData->GetScalarPointerForExtent(outExt);
+  switch (outData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkGaussianRecursiveScatter(
+      buffer.data(), inExt, outData, static_cast<VTK_TT*>(outPtr), outExt));
+    default:
+      vtkErrorMacro("Unknown scalar type");
+      return;
+  }
+}
@@ -18,6 +18,12 @@
  *
  * vtkImageGaussianSmooth implements a convolution of the input image
  * with a gaussian. Supports from one to three dimensional convolutions.
+ * By default the gaussian is a kernel that is truncated at RadiusFactors
+ * times the StandardDeviations, so the cost per pixel grows with the
+ * standard deviation. The recursive method approximates the gaussian with
+ * a recursive filter whose cost per pixel does not depend on the standard
+ * deviation, and it can also compute the first and second derivatives of
+ * the gaussian along each axis.
  */
 
 #ifndef vtkImageGaussianSmooth_h
@@ -39,6 +45,12 @@ public:
    */
   static vtkImageGaussianSmooth* New();
 
+  enum MethodEnum
+  {
+    Convolution = 0,
+    Recursive = 1
+  };
+
   //@{
   /**
    * Sets/Gets the Standard deviation of the gaussian in pixel units.
@@ -77,6 +89,35 @@ public:
   vtkGetMacro(Dimensionality, int);
   //@}
 
+  //@{
+  /**
+   * Set/Get the method used to smooth the image. Convolution, the default,
+   * convolves with a truncated kernel. Recursive uses the fourth-order
+   * recursive approximation of the gaussian by Deriche, which is accurate
+   * for standard deviations of one pixel or more and is much faster for
+   * large ones. It processes whole lines of the input, so it requests the
+   * whole extent along the smoothed axes, it ignores the RadiusFactors, and
+   * it extends the image past its borders by repeating the edge pixels.
+   */
+  vtkSetClampMacro(Method, int, Convolution, Recursive);
+  void SetMethodToConvolution() { this->SetMethod(Convolution); }
+  void SetMethodToRecursive() { this->SetMethod(Recursive); }
+  vtkGetMacro(Method, int);
+  const char* GetMethodAsString();
+  //@}
+
+  //@{
+  /**
+   * Set/Get the order of the derivative of the gaussian that the recursive
+   * method computes along each axis: 0 to smooth (the default), 1 or 2 for
+   * the first or second derivative. Like the ones of vtkImageGradient, the
+   * derivatives are in data coordinates and the output is double when any
+   * of them is computed. The convolution method ignores this setting.
+   */
+  vtkSetVector3Macro(DerivativeOrders, int);
+  vtkGetVector3Macro(DerivativeOrders, int);
+  //@}
+
 protected:
   vtkImageGaussianSmooth();
   ~vtkImageGaussianSmooth() override;
@@ -84,9 +125,16 @@ protected:
   int Dimensionality;
   double StandardDeviations[3];
   double RadiusFactors[3];
+  int Method;
+  int DerivativeOrders[3];
+
+  bool HasDerivatives();
 
   void ComputeKernel(double* kernel, int min, int max, double std);
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  void ExecuteRecursive(vtkImageData* inData, int inExt[6], vtkImageData* outData, int outExt[6]);
   void InternalRequestUpdateExtent(int*, int*);
   void ExecuteAxis(int axis, vtkImageData* inData, int inExt[6], vtkImageData* outData,
     int outExt[6], int* pcycle, int target, int* pcount, int total, vtkInformation* inInfo);
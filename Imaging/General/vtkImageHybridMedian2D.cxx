@@ -20,8 +20,6 @@
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include <algorithm>
-#include <numeric>
-#include <vector>
 
 vtkStandardNewMacro(vtkImageHybridMedian2D);
 
@@ -37,6 +35,18 @@ vtkImageHybridMedian2D::vtkImageHybridMedian2D()
   this->HandleBoundaries = 1;
 }
 
+namespace
+{
+// Select the upper median of a few values without sorting them all
+template <class T>
+T vtkHybridMedianOfArray(T* array, int size)
+{
+  T* mid = array + size / 2;
+  std::nth_element(array, mid, array + size);
+  return *mid;
+}
+}
+
 template <class T>
 void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D* self, vtkImageData* inData, T* inPtr2,
   vtkImageData* outData, T* outPtr2, int outExt[6], int id, vtkInformation* inInfo)
@@ -50,7 +60,9 @@ void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D* self, vtkImageData* i
   T *inPtr0, *inPtr1, *inPtrC;
   T *outPtr0, *outPtr1, *outPtrC, *ptr;
   T median1, median2, temp;
-  std::vector<T> array;
+  // each neighborhood has the center and up to 8 neighbors
+  T array[9];
+  int size;
   unsigned long count = 0;
   unsigned long target;
 
@@ -98,119 +110,117 @@ void vtkImageHybridMedian2DExecute(vtkImageHybridMedian2D* self, vtkImageData* i
           // compute median of + neighborhood
           // note that y axis direction is up in vtk images, not down
           // as in screen coordinates
-          array.clear();
+          size = 0;
           // Center
           ptr = inPtrC;
-          array.push_back(*ptr);
+          array[size++] = *ptr;
           // left
           ptr = inPtrC;
           if (idx0 > wholeMin0)
           {
             ptr -= inInc0;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           if (idx0 - 1 > wholeMin0)
           {
             ptr -= inInc0;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           // right
           ptr = inPtrC;
           if (idx0 < wholeMax0)
           {
             ptr += inInc0;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           if (idx0 + 1 < wholeMax0)
           {
             ptr += inInc0;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           // down
           ptr = inPtrC;
           if (idx1 > wholeMin1)
           {
             ptr -= inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           if (idx1 - 1 > wholeMin1)
           {
             ptr -= inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           // up
           ptr = inPtrC;
           if (idx1 < wholeMax1)
           {
             ptr += inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           if (idx1 + 1 < wholeMax1)
           {
             ptr += inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
 
-          std::sort(array.begin(), array.end());
-          median1 = array[static_cast<unsigned int>(0.5 * array.size())];
+          median1 = vtkHybridMedianOfArray(array, size);
 
           // compute median of x neighborhood
           // note that y axis direction is up in vtk images, not down
           // as in screen coordinates
-          array.clear();
+          size = 0;
           // Center
           ptr = inPtrC;
-          array.push_back(*ptr);
+          array[size++] = *ptr;
           // lower left
           if (idx0 > wholeMin0 && idx1 > wholeMin1)
           {
             ptr -= inInc0 + inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           if (idx0 - 1 > wholeMin0 && idx1 - 1 > wholeMin1)
           {
             ptr -= inInc0 + inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           // upper right
           ptr = inPtrC;
           if (idx0 < wholeMax0 && idx1 < wholeMax1)
           {
             ptr += inInc0 + inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           if (idx0 + 1 < wholeMax0 && idx1 + 1 < wholeMax1)
           {
             ptr += inInc0 + inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           // upper left
           ptr = inPtrC;
           if (idx0 > wholeMin0 && idx1 < wholeMax1)
           {
             ptr += -inInc0 + inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           if (idx0 - 1 > wholeMin0 && idx1 + 1 < wholeMax1)
           {
             ptr += -inInc0 + inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           // lower right
           ptr = inPtrC;
           if (idx0 < wholeMax0 && idx1 > wholeMin1)
           {
             ptr += inInc0 - inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
           if (idx0 + 1 < wholeMax0 && idx1 - 1 > wholeMin1)
           {
             ptr += inInc0 - inInc1;
-            array.push_back(*ptr);
+            array[size++] = *ptr;
           }
 
-          std::sort(array.begin(), array.end());
-          median2 = array[static_cast<unsigned int>(0.5 * array.size())];
+          median2 = vtkHybridMedianOfArray(array, size);
 
           // Compute the median of the three. (med1, med2 and center)
           if (median1 > median2)
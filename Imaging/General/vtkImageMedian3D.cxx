@@ -24,6 +24,9 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm> // for std::nth_element
+#include <limits>
+#include <memory>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageMedian3D);
 
@@ -32,6 +35,7 @@ vtkStandardNewMacro(vtkImageMedian3D);
 vtkImageMedian3D::vtkImageMedian3D()
 {
   this->NumberOfElements = 0;
+  this->Percentile = 50.0;
   this->SetKernelSize(1, 1, 1);
   this->HandleBoundaries = 1;
 }
@@ -45,6 +49,7 @@ void vtkImageMedian3D::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "NumberOfElements: " << this->NumberOfElements << endl;
+  os << indent << "Percentile: " << this->Percentile << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -83,24 +88,269 @@ namespace
 {
 
 //-----------------------------------------------------------------------------
-// Compute the median with std::nth_element
+// Rank (from 0) of the value to output from a neighborhood of n values.  For
+// the median of an even number of values, this is the lower of the two
+// middle ranks and average is set to true.
+int vtkMedian3DRank(double percentile, int n, bool& average)
+{
+  if (percentile == 50.0)
+  {
+    average = (n % 2 == 0);
+    return (n - 1) / 2;
+  }
+  average = false;
+  return static_cast<int>(percentile * 0.01 * (n - 1) + 0.5);
+}
+
+//-----------------------------------------------------------------------------
+// The mean of the two middle values, computed in the scalar type.
+template <class T>
+T vtkMedian3DAverage(T low, T high)
+{
+  return low + (high - low) / 2;
+}
+
+//-----------------------------------------------------------------------------
+// Compute the value of the given rank with std::nth_element
 template <class T>
-T vtkComputeMedianOfArray(T* aBegin, T* aEnd)
+T vtkComputeRankOfArray(T* aBegin, T* aEnd, int rank, bool average)
 {
-  T* aMid = aBegin + (aEnd - aBegin) / 2;
-  std::nth_element(aBegin, aMid, aEnd);
-  T m = *aMid;
+  T* aRank = aBegin + rank;
+  std::nth_element(aBegin, aRank, aEnd);
+  T m = *aRank;
 
-  // if even size, get max of lower part of array and compute the average
-  if (aMid - aBegin == aEnd - aMid)
+  // for the median of an even size, average with the smallest value above
+  if (average)
   {
-    T* lowMid = std::max_element(aBegin, aMid);
-    m = *lowMid + (m - *lowMid) / 2;
+    m = vtkMedian3DAverage(m, *std::min_element(aRank + 1, aEnd));
   }
 
   return m;
 }
 
+//-----------------------------------------------------------------------------
+// A histogram of 8-bit or 16-bit values with a coarse level that counts the
+// values in blocks of bins.  It remembers the bin found by the last search
+// and the number of values below it, so that searching for the rank of a
+// neighborhood that slid by one pixel usually takes a few steps.
+class vtkMedian3DHistogram
+{
+public:
+  explicit vtkMedian3DHistogram(int bits)
+    : Shift(bits / 2)
+    , Fine(static_cast<size_t>(1) << bits, 0)
+    , Coarse(static_cast<size_t>(1) << (bits - bits / 2), 0)
+  {
+  }
+
+  void Add(int bin)
+  {
+    ++this->Fine[bin];
+    ++this->Coarse[bin >> this->Shift];
+    this->Below += (bin < this->Position);
+  }
+
+  void Remove(int bin)
+  {
+    --this->Fine[bin];
+    --this->Coarse[bin >> this->Shift];
+    this->Below -= (bin < this->Position);
+  }
+
+  // Return the bin that holds the value of the given rank.
+  int Find(int rank)
+  {
+    const int width = 1 << this->Shift;
+    const int mask = width - 1;
+    while (this->Below > rank)
+    {
+      if ((this->Position & mask) == 0 &&
+        this->Below - this->Coarse[(this->Position >> this->Shift) - 1] > rank)
+      {
+        this->Position -= width;
+        this->Below -= this->Coarse[this->Position >> this->Shift];
+      }
+      else
+      {
+        --this->Position;
+        this->Below -= this->Fine[this->Position];
+      }
+    }
+    while (this->Below + this->Fine[this->Position] <= rank)
+    {
+      if ((this->Position & mask) == 0 &&
+        this->Below + this->Coarse[this->Position >> this->Shift] <= rank)
+      {
+        this->Below += this->Coarse[this->Position >> this->Shift];
+        this->Position += width;
+      }
+      else
+      {
+        this->Below += this->Fine[this->Position];
+        ++this->Position;
+      }
+    }
+    return this->Position;
+  }
+
+private:
+  int Shift;
+  std::vector<int> Fine;
+  std::vector<int> Coarse;
+  int Position = 0;
+  int Below = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Computes the output of one row.  The neighborhood of the first pixel of
+// the row is given by HoodMin and HoodMax, and it shifts along the row like
+// in the rest of the filter: it grows until the kernel fits in the input and
+// shrinks when it reaches the end of the input.
+template <class T>
+class vtkImageMedian3DRow
+{
+public:
+  int OutMin0, OutMax0;
+  int HoodMin[3], HoodMax[3];
+  int MiddleMin0, MiddleMax0;
+  vtkIdType InInc[3];
+  int NumComp;
+  double Percentile;
+
+  // Gather the neighborhood of each pixel and select the rank from it.
+  void Select(const T* inPtr, T* outPtr, T* workArray)
+  {
+    int hoodMin0 = this->HoodMin[0];
+    int hoodMax0 = this->HoodMax[0];
+    for (int outIdx0 = this->OutMin0; outIdx0 <= this->OutMax0; ++outIdx0)
+    {
+      for (int outIdxC = 0; outIdxC < this->NumComp; outIdxC++)
+      {
+        T* workEnd = workArray;
+
+        // loop through neighborhood pixels
+        const T* tmpPtr2 = inPtr + outIdxC;
+        for (int hoodIdx2 = this->HoodMin[2]; hoodIdx2 <= this->HoodMax[2]; ++hoodIdx2)
+        {
+          const T* tmpPtr1 = tmpPtr2;
+          for (int hoodIdx1 = this->HoodMin[1]; hoodIdx1 <= this->HoodMax[1]; ++hoodIdx1)
+          {
+            const T* tmpPtr0 = tmpPtr1;
+            for (int hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
+            {
+              *workEnd++ = *tmpPtr0;
+              tmpPtr0 += this->InInc[0];
+            }
+            tmpPtr1 += this->InInc[1];
+          }
+          tmpPtr2 += this->InInc[2];
+        }
+
+        // Replace this pixel with the value of the requested rank
+        bool average;
+        int n = static_cast<int>(workEnd - workArray);
+        int rank = vtkMedian3DRank(this->Percentile, n, average);
+        *outPtr++ = vtkComputeRankOfArray(workArray, workEnd, rank, average);
+      }
+
+      // shift neighborhood considering boundaries
+      if (outIdx0 >= this->MiddleMin0)
+      {
+        inPtr += this->InInc[0];
+        ++hoodMin0;
+      }
+      if (outIdx0 < this->MiddleMax0)
+      {
+        ++hoodMax0;
+      }
+    }
+  }
+
+  // Slide a histogram of the neighborhood along the row: only the columns
+  // (across y and z) that enter and leave the neighborhood are counted.
+  void Slide(const T* inPtr, T* outPtr, vtkMedian3DHistogram& histogram)
+  {
+    const int offset = -static_cast<int>(std::numeric_limits<T>::min());
+    const int columnSize =
+      (this->HoodMax[1] - this->HoodMin[1] + 1) * (this->HoodMax[2] - this->HoodMin[2] + 1);
+    for (int outIdxC = 0; outIdxC < this->NumComp; outIdxC++)
+    {
+      const T* hoodPtr = inPtr + outIdxC;
+      int hoodMin0 = this->HoodMin[0];
+      int hoodMax0 = this->HoodMax[0];
+      for (int hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
+      {
+        this->Column(hoodPtr + (hoodIdx0 - hoodMin0) * this->InInc[0], histogram, 1);
+      }
+
+      T* tmpOutPtr = outPtr + outIdxC;
+      for (int outIdx0 = this->OutMin0; outIdx0 <= this->OutMax0; ++outIdx0)
+      {
+        bool average;
+        int n = (hoodMax0 - hoodMin0 + 1) * columnSize;
+        int rank = vtkMedian3DRank(this->Percentile, n, average);
+        T m = static_cast<T>(histogram.Find(rank) - offset);
+        if (average)
+        {
+          m = vtkMedian3DAverage(m, static_cast<T>(histogram.Find(rank + 1) - offset));
+        }
+        *tmpOutPtr = m;
+        tmpOutPtr += this->NumComp;
+
+        // shift neighborhood considering boundaries
+        if (outIdx0 >= this->MiddleMin0)
+        {
+          this->Column(hoodPtr, histogram, -1);
+          hoodPtr += this->InInc[0];
+          ++hoodMin0;
+        }
+        if (outIdx0 < this->MiddleMax0)
+        {
+          ++hoodMax0;
+          this->Column(hoodPtr + (hoodMax0 - hoodMin0) * this->InInc[0], histogram, 1);
+        }
+      }
+
+      // empty the histogram for the next row
+      for (int hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
+      {
+        this->Column(hoodPtr + (hoodIdx0 - hoodMin0) * this->InInc[0], histogram, -1);
+      }
+    }
+  }
+
+private:
+  // Add (sign > 0) or remove the column of the neighborhood at ptr.
+  void Column(const T* ptr, vtkMedian3DHistogram& histogram, int sign)
+  {
+    const int offset = -static_cast<int>(std::numeric_limits<T>::min());
+    for (int hoodIdx2 = this->HoodMin[2]; hoodIdx2 <= this->HoodMax[2]; ++hoodIdx2)
+    {
+      const T* tmpPtr = ptr;
+      for (int hoodIdx1 = this->HoodMin[1]; hoodIdx1 <= this->HoodMax[1]; ++hoodIdx1)
+      {
+        if (sign > 0)
+        {
+          histogram.Add(static_cast<int>(*tmpPtr) + offset);
+        }
+        else
+        {
+          histogram.Remove(static_cast<int>(*tmpPtr) + offset);
+        }
+        tmpPtr += this->InInc[1];
+      }
+      ptr += this->InInc[2];
+    }
+  }
+};
+
+// Whether the histogram can be used for a scalar type.
+template <class T>
+struct vtkMedian3DUseHistogram
+{
+  static const bool value = std::numeric_limits<T>::is_integer && sizeof(T) <= 2;
+};
+
 } // end anonymous namespace
 
 //-----------------------------------------------------------------------------
@@ -112,18 +362,15 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
 {
   int *kernelMiddle, *kernelSize;
   // For looping though output (and input) pixels.
-  int outIdx0, outIdx1, outIdx2;
+  int outIdx1, outIdx2;
   vtkIdType inInc0, inInc1, inInc2;
-  int outIdxC;
   vtkIdType outIncX, outIncY, outIncZ;
-  T *inPtr0, *inPtr1, *inPtr2;
+  T *inPtr1, *inPtr2;
   // For looping through hood pixels
   int hoodMin0, hoodMax0, hoodMin1, hoodMax1, hoodMin2, hoodMax2;
-  int hoodStartMin0, hoodStartMax0, hoodStartMin1, hoodStartMax1;
-  int hoodIdx0, hoodIdx1, hoodIdx2;
-  T *tmpPtr0, *tmpPtr1, *tmpPtr2;
+  int hoodStartMin1, hoodStartMax1;
   // The portion of the out image that needs no boundary processing.
-  int middleMin0, middleMax0, middleMin1, middleMax1, middleMin2, middleMax2;
+  int middleMin1, middleMax1, middleMin2, middleMax2;
   int numComp;
   int* inExt;
   unsigned long count = 0;
@@ -134,9 +381,6 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
     return;
   }
 
-  // Array used to compute the median
-  T* workArray = new T[self->GetNumberOfElements()];
-
   // Get information to march through data
   inData->GetIncrements(inInc0, inInc1, inInc2);
   outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
@@ -162,19 +406,42 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
   hoodMax2 = (hoodMax2 < inExt[5]) ? hoodMax2 : inExt[5];
 
   // Save the starting neighborhood dimensions (2 loops only once)
-  hoodStartMin0 = hoodMin0;
-  hoodStartMax0 = hoodMax0;
   hoodStartMin1 = hoodMin1;
   hoodStartMax1 = hoodMax1;
 
   // The portion of the output that needs no boundary computation.
-  middleMin0 = inExt[0] + kernelMiddle[0];
-  middleMax0 = inExt[1] - (kernelSize[0] - 1) + kernelMiddle[0];
   middleMin1 = inExt[2] + kernelMiddle[1];
   middleMax1 = inExt[3] - (kernelSize[1] - 1) + kernelMiddle[1];
   middleMin2 = inExt[4] + kernelMiddle[2];
   middleMax2 = inExt[5] - (kernelSize[2] - 1) + kernelMiddle[2];
 
+  vtkImageMedian3DRow<T> row;
+  row.OutMin0 = outExt[0];
+  row.OutMax0 = outExt[1];
+  row.HoodMin[0] = hoodMin0;
+  row.HoodMax[0] = hoodMax0;
+  row.MiddleMin0 = inExt[0] + kernelMiddle[0];
+  row.MiddleMax0 = inExt[1] - (kernelSize[0] - 1) + kernelMiddle[0];
+  row.InInc[0] = inInc0;
+  row.InInc[1] = inInc1;
+  row.InInc[2] = inInc2;
+  row.NumComp = numComp;
+  row.Percentile = self->GetPercentile();
+
+  // The histogram is worthwhile once the columns of the kernel are shorter
+  // than its volume, and an array is used to select from small kernels.
+  const bool useHistogram = vtkMedian3DUseHistogram<T>::value && kernelSize[0] > 1;
+  std::unique_ptr<vtkMedian3DHistogram> histogram;
+  std::vector<T> workArray;
+  if (useHistogram)
+  {
+    histogram.reset(new vtkMedian3DHistogram(8 * static_cast<int>(sizeof(T))));
+  }
+  else
+  {
+    workArray.resize(self->GetNumberOfElements());
+  }
+
   target =
     static_cast<unsigned long>((outExt[5] - outExt[4] + 1) * (outExt[3] - outExt[2] + 1) / 50.0);
   target++;
@@ -183,6 +450,7 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
   inPtr = static_cast<T*>(inArray->GetVoidPointer((hoodMin0 - inExt[0]) * inInc0 +
     (hoodMin1 - inExt[2]) * inInc1 + (hoodMin2 - inExt[4]) * inInc2));
   inPtr2 = inPtr;
+  const vtkIdType outRowSize = static_cast<vtkIdType>(outExt[1] - outExt[0] + 1) * numComp;
   for (outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
   {
     inPtr1 = inPtr2;
@@ -198,50 +466,20 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
         }
         count++;
       }
-      inPtr0 = inPtr1;
-      hoodMin0 = hoodStartMin0;
-      hoodMax0 = hoodStartMax0;
-      for (outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+      row.HoodMin[1] = hoodMin1;
+      row.HoodMax[1] = hoodMax1;
+      row.HoodMin[2] = hoodMin2;
+      row.HoodMax[2] = hoodMax2;
+      if (useHistogram)
       {
-        for (outIdxC = 0; outIdxC < numComp; outIdxC++)
-        {
-          // Compute median of neighborhood
-          T* workEnd = workArray;
-
-          // loop through neighborhood pixels
-          tmpPtr2 = inPtr0 + outIdxC;
-          for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
-          {
-            tmpPtr1 = tmpPtr2;
-            for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
-            {
-              tmpPtr0 = tmpPtr1;
-              for (hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
-              {
-                // Add this pixel to the median
-                *workEnd++ = *tmpPtr0;
-                tmpPtr0 += inInc0;
-              }
-              tmpPtr1 += inInc1;
-            }
-            tmpPtr2 += inInc2;
-          }
-
-          // Replace this pixel with the hood median
-          *outPtr++ = vtkComputeMedianOfArray(workArray, workEnd);
-        }
-
-        // shift neighborhood considering boundaries
-        if (outIdx0 >= middleMin0)
-        {
-          inPtr0 += inInc0;
-          ++hoodMin0;
-        }
-        if (outIdx0 < middleMax0)
-        {
-          ++hoodMax0;
-        }
+        row.Slide(inPtr1, outPtr, *histogram);
       }
+      else
+      {
+        row.Select(inPtr1, outPtr, workArray.data());
+      }
+      outPtr += outRowSize;
+
       // shift neighborhood considering boundaries
       if (outIdx1 >= middleMin1)
       {
@@ -266,8 +504,6 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
     }
     outPtr += outIncZ;
   }
-
-  delete[] workArray;
 }
 
 //-----------------------------------------------------------------------------
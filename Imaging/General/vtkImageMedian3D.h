@@ -21,6 +21,12 @@
  * Neighborhoods can be no more than 3 dimensional.  Setting one
  * axis of the neighborhood kernelSize to 1 changes the filter
  * into a 2D median.
+ *
+ * The filter can also output another percentile of the neighborhood than
+ * the median, e.g. 0 for its minimum and 100 for its maximum.  For 8-bit
+ * and 16-bit integer scalars it keeps a histogram of the neighborhood that
+ * it updates as the neighborhood slides along each row, so that the cost per
+ * pixel grows with the area of the kernel rather than with its volume.
  */
 
 #ifndef vtkImageMedian3D_h
@@ -49,11 +55,24 @@ public:
   vtkGetMacro(NumberOfElements, int);
   //@}
 
+  //@{
+  /**
+   * Set the percentile of the neighborhood values to output, between 0
+   * (the minimum) and 100 (the maximum).  The default is 50, the median,
+   * which is the mean of the two middle values when the neighborhood has
+   * an even number of elements.  Other percentiles select the value whose
+   * rank is nearest to Percentile/100 * (NumberOfElements - 1).
+   */
+  vtkSetClampMacro(Percentile, double, 0.0, 100.0);
+  vtkGetMacro(Percentile, double);
+  //@}
+
 protected:
   vtkImageMedian3D();
   ~vtkImageMedian3D() override;
 
   int NumberOfElements;
+  double Percentile;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -0,0 +1,161 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageConnectivityFilterLabels.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Label a random mask with vtkImageConnectivityFilter and compare the
+// labels, sizes and extents of the regions with a flood fill that numbers
+// the regions in the order in which a raster scan finds them.
+
+#include "vtkIdTypeArray.h"
+#include "vtkImageConnectivityFilter.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+const int Dims[3] = { 37, 23, 11 };
+
+// Label the voxels that are set with 6-connectivity, return the sizes.
+std::vector<vtkIdType> FloodFill(const std::vector<unsigned char>& mask, std::vector<int>& labels,
+  std::vector<int>& extents)
+{
+  const vtkIdType strides[3] = { 1, Dims[0], Dims[0] * Dims[1] };
+  std::vector<vtkIdType> sizes;
+  labels.assign(mask.size(), 0);
+  for (vtkIdType seed = 0; seed < static_cast<vtkIdType>(mask.size()); ++seed)
+  {
+    if (!mask[seed] || labels[seed])
+    {
+      continue;
+    }
+    const int label = static_cast<int>(sizes.size()) + 1;
+    int extent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX,
+      VTK_INT_MIN };
+    vtkIdType size = 0;
+    std::vector<vtkIdType> stack(1, seed);
+    labels[seed] = label;
+    while (!stack.empty())
+    {
+      vtkIdType id = stack.back();
+      stack.pop_back();
+      ++size;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        int idx = static_cast<int>((id / strides[axis]) % Dims[axis]);
+        extent[2 * axis] = std::min(extent[2 * axis], idx);
+        extent[2 * axis + 1] = std::max(extent[2 * axis + 1], idx);
+        for (int step = -1; step <= 1; step += 2)
+        {
+          vtkIdType neighbor = id + step * strides[axis];
+          if (idx + step >= 0 && idx + step < Dims[axis] && mask[neighbor] && !labels[neighbor])
+          {
+            labels[neighbor] = label;
+            stack.push_back(neighbor);
+          }
+        }
+      }
+    }
+    sizes.push_back(size);
+    extents.insert(extents.end(), extent, extent + 6);
+  }
+  return sizes;
+}
+
+} // end anon namespace
+
+int TestImageConnectivityFilterLabels(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dims[0], Dims[1], Dims[2]);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  unsigned char* scalars = static_cast<unsigned char*>(image->GetScalarPointer());
+  std::vector<unsigned char> mask(static_cast<size_t>(Dims[0]) * Dims[1] * Dims[2]);
+  unsigned int state = 1;
+  for (size_t i = 0; i < mask.size(); ++i)
+  {
+    state = state * 1103515245u + 12345u;
+    mask[i] = ((state >> 16) % 100) < 45;
+    scalars[i] = mask[i] ? 200 : 10;
+  }
+
+  std::vector<int> expectedLabels;
+  std::vector<int> expectedExtents;
+  std::vector<vtkIdType> expectedSizes = FloodFill(mask, expectedLabels, expectedExtents);
+
+  vtkNew<vtkImageConnectivityFilter> connectivity;
+  connectivity->SetInputData(image);
+  connectivity->SetScalarRange(100, 255);
+  connectivity->SetExtractionModeToAllRegions();
+  connectivity->SetLabelScalarTypeToInt();
+  connectivity->GenerateRegionExtentsOn();
+  connectivity->Update();
+
+  int* labels = static_cast<int*>(connectivity->GetOutput()->GetScalarPointer());
+  vtkIdType numberOfRegions = connectivity->GetNumberOfExtractedRegions();
+  if (numberOfRegions != static_cast<vtkIdType>(expectedSizes.size()))
+  {
+    std::cerr << "Found " << numberOfRegions << " regions instead of " << expectedSizes.size()
+              << ".\n";
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < mask.size(); ++i)
+  {
+    if (labels[i] != expectedLabels[i])
+    {
+      std::cerr << "Voxel " << i << " has label " << labels[i] << " instead of "
+                << expectedLabels[i] << ".\n";
+      return EXIT_FAILURE;
+    }
+  }
+  for (vtkIdType r = 0; r < numberOfRegions; ++r)
+  {
+    int extent[6];
+    connectivity->GetExtractedRegionExtents()->GetTypedTuple(r, extent);
+    if (connectivity->GetExtractedRegionSizes()->GetValue(r) != expectedSizes[r] ||
+      !std::equal(extent, extent + 6, &expectedExtents[6 * r]))
+    {
+      std::cerr << "Region " << r << " has the wrong size or extent.\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Request a part of the output: the regions are found in the whole input
+  // and keep their labels.
+  int updateExtent[6] = { 5, 30, 2, 20, 3, 9 };
+  connectivity->UpdateExtent(updateExtent);
+  vtkImageData* output = connectivity->GetOutput();
+  for (int k = updateExtent[4]; k <= updateExtent[5]; ++k)
+  {
+    for (int j = updateExtent[2]; j <= updateExtent[3]; ++j)
+    {
+      for (int i = updateExtent[0]; i <= updateExtent[1]; ++i)
+      {
+        int label = *static_cast<int*>(output->GetScalarPointer(i, j, k));
+        if (label != expectedLabels[(static_cast<size_t>(k) * Dims[1] + j) * Dims[0] + i])
+        {
+          std::cerr << "Voxel (" << i << ", " << j << ", " << k
+                    << ") of the partial output has the wrong label.\n";
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,363 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMorphologyKernelShapes.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the box kernels of the morphology filters with a brute force
+// maximum or minimum over the box, check that the segmented ellipsoid
+// gives the maximum over its footprint and is close to the ellipsoid, and
+// report the time of each kernel shape for a large kernel.
+
+#include "vtkImageContinuousDilate3D.h"
+#include "vtkImageContinuousErode3D.h"
+#include "vtkImageData.h"
+#include "vtkImageDilateErode3D.h"
+#include "vtkImageOpenClose3D.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+const int Dims[3] = { 29, 18, 13 };
+
+vtkSmartPointer<vtkImageData> MakeImage(int numComps, int levels)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(Dims[0], Dims[1], Dims[2]);
+  image->AllocateScalars(VTK_SHORT, numComps);
+  short* scalars = static_cast<short*>(image->GetScalarPointer());
+  unsigned int state = 1;
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints() * numComps; ++i)
+  {
+    state = state * 1103515245u + 12345u;
+    scalars[i] = static_cast<short>((state >> 16) % levels - levels / 2);
+  }
+  return image;
+}
+
+// The maximum (or minimum) of each component over the offsets that lie
+// within the image, from the voxel at (i, j, k).
+short Extremum(vtkImageData* image, int i, int j, int k, int c,
+  const std::vector<int>& offsets, bool maximum)
+{
+  short value = static_cast<short*>(image->GetScalarPointer(i, j, k))[c];
+  for (size_t o = 0; o < offsets.size(); o += 3)
+  {
+    int x = i + offsets[o], y = j + offsets[o + 1], z = k + offsets[o + 2];
+    if (x >= 0 && x < Dims[0] && y >= 0 && y < Dims[1] && z >= 0 && z < Dims[2])
+    {
+      short v = static_cast<short*>(image->GetScalarPointer(x, y, z))[c];
+      value = (maximum ? std::max(value, v) : std::min(value, v));
+    }
+  }
+  return value;
+}
+
+// Compare the output with the extremum over the offsets, either at every
+// voxel or only at the voxels whose neighborhood lies within the image.
+bool Compare(vtkImageData* input, vtkImageData* output, const std::vector<int>& offsets,
+  bool maximum, const int margin[3], const char* name)
+{
+  for (int k = margin[2]; k < Dims[2] - margin[2]; ++k)
+  {
+    for (int j = margin[1]; j < Dims[1] - margin[1]; ++j)
+    {
+      for (int i = margin[0]; i < Dims[0] - margin[0]; ++i)
+      {
+        for (int c = 0; c < input->GetNumberOfScalarComponents(); ++c)
+        {
+          short expected = Extremum(input, i, j, k, c, offsets, maximum);
+          short value = static_cast<short*>(output->GetScalarPointer(i, j, k))[c];
+          if (value != expected)
+          {
+            std::cerr << name << ": value " << value << " differs from " << expected << " at ("
+                      << i << ", " << j << ", " << k << ").\n";
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// The offsets of the voxels that are set in the output of a dilation of an
+// image with one voxel set in its middle.
+template <class Filter>
+std::vector<int> Footprint(const int size[3], int shape)
+{
+  vtkNew<vtkImageData> impulse;
+  impulse->SetExtent(-size[0], size[0], -size[1], size[1], -size[2], size[2]);
+  impulse->AllocateScalars(VTK_SHORT, 1);
+  std::fill_n(static_cast<short*>(impulse->GetScalarPointer()), impulse->GetNumberOfPoints(), 0);
+  *static_cast<short*>(impulse->GetScalarPointer(0, 0, 0)) = 1;
+  vtkNew<Filter> filter;
+  filter->SetInputData(impulse);
+  filter->SetKernelSize(size[0], size[1], size[2]);
+  filter->SetKernelShape(shape);
+  filter->Update();
+  // the footprint of the kernel is the reflection of the dilated voxels
+  std::vector<int> offsets;
+  vtkImageData* output = filter->GetOutput();
+  for (int k = -size[2]; k <= size[2]; ++k)
+  {
+    for (int j = -size[1]; j <= size[1]; ++j)
+    {
+      for (int i = -size[0]; i <= size[0]; ++i)
+      {
+        if (*static_cast<short*>(output->GetScalarPointer(i, j, k)))
+        {
+          offsets.push_back(-i);
+          offsets.push_back(-j);
+          offsets.push_back(-k);
+        }
+      }
+    }
+  }
+  return offsets;
+}
+
+template <class Filter>
+bool TestShapes(vtkImageData* image, const int size[3], bool maximum)
+{
+  vtkNew<Filter> filter;
+  filter->SetInputData(image);
+  filter->SetKernelSize(size[0], size[1], size[2]);
+  filter->SetKernelShapeToBox();
+  filter->Update();
+  std::vector<int> offsets;
+  for (int k = 0; k < size[2]; ++k)
+  {
+    for (int j = 0; j < size[1]; ++j)
+    {
+      for (int i = 0; i < size[0]; ++i)
+      {
+        offsets.push_back(i - size[0] / 2);
+        offsets.push_back(j - size[1] / 2);
+        offsets.push_back(k - size[2] / 2);
+      }
+    }
+  }
+  const int noMargin[3] = { 0, 0, 0 };
+  if (!Compare(image, filter->GetOutput(), offsets, maximum, noMargin, "Box"))
+  {
+    return false;
+  }
+
+  // the segments give the extremum over their footprint, except near the
+  // borders where the composition of the segments can leave the image
+  filter->SetKernelShapeToSegmentedEllipsoid();
+  filter->Update();
+  offsets = Footprint<vtkImageContinuousDilate3D>(size, Filter::SegmentedEllipsoid);
+  int margin[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    margin[axis] = size[axis] / 2;
+    int low = VTK_INT_MAX, high = VTK_INT_MIN;
+    for (size_t o = axis; o < offsets.size(); o += 3)
+    {
+      low = std::min(low, offsets[o]);
+      high = std::max(high, offsets[o]);
+    }
+    // the footprint spans the kernel
+    if (low != -(size[axis] / 2) || high != size[axis] - 1 - size[axis] / 2)
+    {
+      std::cerr << "The segmented ellipsoid spans " << low << " to " << high << " along axis "
+                << axis << ".\n";
+      return false;
+    }
+  }
+  vtkNew<vtkImageData> whole;
+  whole->DeepCopy(filter->GetOutput());
+  if (!Compare(image, whole, offsets, maximum, margin, "SegmentedEllipsoid"))
+  {
+    return false;
+  }
+
+  // a part of the output is the same as the part of the whole output
+  int updateExtent[6] = { 3, 20, 4, 15, 1, 9 };
+  filter->UpdateExtent(updateExtent);
+  for (int k = updateExtent[4]; k <= updateExtent[5]; ++k)
+  {
+    for (int j = updateExtent[2]; j <= updateExtent[3]; ++j)
+    {
+      for (int i = updateExtent[0]; i <= updateExtent[1]; ++i)
+      {
+        for (int c = 0; c < image->GetNumberOfScalarComponents(); ++c)
+        {
+          if (static_cast<short*>(filter->GetOutput()->GetScalarPointer(i, j, k))[c] !=
+            static_cast<short*>(whole->GetScalarPointer(i, j, k))[c])
+          {
+            std::cerr << "The partial output differs at (" << i << ", " << j << ", " << k
+                      << ").\n";
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Dilate the close value over the open value within a box, by brute force.
+bool TestDilateErode(vtkImageData* image, const int size[3])
+{
+  vtkNew<vtkImageDilateErode3D> filter;
+  filter->SetInputData(image);
+  filter->SetKernelSize(size[0], size[1], size[2]);
+  filter->SetKernelShapeToBox();
+  filter->SetDilateValue(1);
+  filter->SetErodeValue(-1);
+  filter->Update();
+  vtkImageData* output = filter->GetOutput();
+  for (int k = 0; k < Dims[2]; ++k)
+  {
+    for (int j = 0; j < Dims[1]; ++j)
+    {
+      for (int i = 0; i < Dims[0]; ++i)
+      {
+        short value = *static_cast<short*>(image->GetScalarPointer(i, j, k));
+        short expected = value;
+        for (int z = k - size[2] / 2; value == -1 && z < k - size[2] / 2 + size[2]; ++z)
+        {
+          for (int y = j - size[1] / 2; y < j - size[1] / 2 + size[1]; ++y)
+          {
+            for (int x = i - size[0] / 2; x < i - size[0] / 2 + size[0]; ++x)
+            {
+              if (x >= 0 && x < Dims[0] && y >= 0 && y < Dims[1] && z >= 0 && z < Dims[2] &&
+                *static_cast<short*>(image->GetScalarPointer(x, y, z)) == 1)
+              {
+                expected = 1;
+              }
+            }
+          }
+        }
+        if (*static_cast<short*>(output->GetScalarPointer(i, j, k)) != expected)
+        {
+          std::cerr << "vtkImageDilateErode3D differs at (" << i << ", " << j << ", " << k
+                    << ").\n";
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestImageMorphologyKernelShapes(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> image = MakeImage(2, 1000);
+  const int sizes[][3] = { { 5, 5, 5 }, { 4, 7, 1 }, { 1, 1, 6 }, { 11, 9, 7 }, { 9, 9, 9 } };
+  for (const int* size : sizes)
+  {
+    if (!TestShapes<vtkImageContinuousDilate3D>(image, size, true) ||
+      !TestShapes<vtkImageContinuousErode3D>(image, size, false))
+    {
+      std::cerr << "Kernel size (" << size[0] << ", " << size[1] << ", " << size[2] << ").\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkSmartPointer<vtkImageData> labels = MakeImage(1, 3);
+  for (const int* size : sizes)
+  {
+    if (!TestDilateErode(labels, size))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // closing is a dilation followed by an erosion
+  vtkNew<vtkImageOpenClose3D> close;
+  close->SetInputData(labels);
+  close->SetKernelSize(5, 5, 3);
+  close->SetKernelShapeToBox();
+  close->SetOpenValue(-1);
+  close->SetCloseValue(1);
+  close->Update();
+  vtkNew<vtkImageDilateErode3D> dilate;
+  dilate->SetInputData(labels);
+  dilate->SetKernelSize(5, 5, 3);
+  dilate->SetDilateValue(1);
+  dilate->SetErodeValue(-1);
+  vtkNew<vtkImageDilateErode3D> erode;
+  erode->SetInputConnection(dilate->GetOutputPort());
+  erode->SetKernelSize(5, 5, 3);
+  erode->SetDilateValue(-1);
+  erode->SetErodeValue(1);
+  dilate->SetKernelShapeToBox();
+  erode->SetKernelShapeToBox();
+  erode->Update();
+  if (!std::equal(static_cast<short*>(close->GetOutput()->GetScalarPointer()),
+        static_cast<short*>(close->GetOutput()->GetScalarPointer()) + labels->GetNumberOfPoints(),
+        static_cast<short*>(erode->GetOutput()->GetScalarPointer())))
+  {
+    std::cerr << "vtkImageOpenClose3D differs from a dilation followed by an erosion.\n";
+    return EXIT_FAILURE;
+  }
+
+  // the segmented ellipsoid of a large kernel is close to the ellipsoid
+  const int large[3] = { 21, 21, 21 };
+  std::vector<int> ellipsoid =
+    Footprint<vtkImageContinuousDilate3D>(large, vtkImageContinuousDilate3D::Ellipsoid);
+  std::vector<int> segmented =
+    Footprint<vtkImageContinuousDilate3D>(large, vtkImageContinuousDilate3D::SegmentedEllipsoid);
+  size_t common = 0;
+  for (size_t o = 0; o < ellipsoid.size(); o += 3)
+  {
+    for (size_t p = 0; p < segmented.size(); p += 3)
+    {
+      common += std::equal(&ellipsoid[o], &ellipsoid[o] + 3, &segmented[p]);
+    }
+  }
+  size_t differences = ellipsoid.size() / 3 + segmented.size() / 3 - 2 * common;
+  std::cout << "The segmented ellipsoid has " << segmented.size() / 3 << " voxels, the ellipsoid "
+            << ellipsoid.size() / 3 << ", and they differ at " << differences << " voxels.\n";
+  if (differences > ellipsoid.size() / 3 / 8)
+  {
+    std::cerr << "The segmented ellipsoid differs too much from the ellipsoid.\n";
+    return EXIT_FAILURE;
+  }
+
+  // report the time of each shape for a large kernel
+  const char* names[] = { "Ellipsoid", "Box", "SegmentedEllipsoid" };
+  vtkNew<vtkImageData> volume;
+  volume->SetDimensions(64, 64, 64);
+  volume->AllocateScalars(VTK_SHORT, 1);
+  short* values = static_cast<short*>(volume->GetScalarPointer());
+  for (vtkIdType i = 0; i < volume->GetNumberOfPoints(); ++i)
+  {
+    values[i] = static_cast<short>((i * 37) % 1001);
+  }
+  for (int shape = 0; shape < 3; ++shape)
+  {
+    vtkNew<vtkImageContinuousDilate3D> filter;
+    filter->SetInputData(volume);
+    filter->SetKernelSize(9, 9, 7);
+    filter->SetKernelShape(shape);
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    filter->Update();
+    timer->StopTimer();
+    std::cout << names[shape] << ": " << timer->GetElapsedTime() << " seconds\n";
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -59,6 +59,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTemplateAliasMacro.h"
@@ -66,6 +67,7 @@
 #include "vtkVersion.h"
 
 #include <algorithm>
+#include <numeric>
 #include <stack>
 #include <vector>
 
@@ -265,6 +267,9 @@ protected:
   // A functor to assist in comparing region sizes.
   struct CompareSize;
 
+  // Runs of voxels along x, merged into connected components.
+  class ComponentTable;
+
   // Remove all but the largest region from the output image.
   template <class OT>
   static void PruneAllButLargest(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
@@ -287,6 +292,17 @@ protected:
   static vtkIdType Fill(OT* outPtr, vtkIdType outInc[3], int outLimits[6], unsigned char* maskPtr,
     int maxIdx[3], int fillExtent[6], std::stack<vtkICF::Seed>& seedStack);
 
+  // Call func(start, end) for each run of voxels along x that are not
+  // colored in the bitmask, for the row of n voxels at bit offset.
+  template <class F>
+  static void ScanRow(const unsigned char* maskPtr, vtkIdType offset, int n, F&& func);
+
+  // Find the connected components of the voxels that are not colored
+  // in the bitmask, numbered in the order of their first voxel.  The
+  // extent of each component is its first voxel unless fullExtents is set.
+  static void FindComponents(const unsigned char* maskPtr, int maxIdx[3], bool fullExtents,
+    vtkICF::ComponentTable& table);
+
   // Add a region to the list of regions.
   template <class OT>
   static void AddRegion(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
@@ -322,11 +338,11 @@ protected:
     vtkDataSet* seedData, vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr,
     int extent[6], vtkICF::RegionVector& regionInfo);
 
-  // Execute method for when no seeds are provided.
+  // Execute method for when no seeds are provided.  The voxels outside of
+  // the stencil are already marked in the mask.
   template <class OT>
   static void SeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
-    vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr, int extent[6],
-    vtkICF::RegionVector& regionInfo);
+    OT* outPtr, unsigned char* maskPtr, int extent[6], vtkICF::RegionVector& regionInfo);
 
 public:
   // Create a bit mask from the input
@@ -820,6 +836,227 @@ vtkIdType vtkICF::Fill(OT* outPtr, vtkIdType outInc[3], int outLimits[6], unsign
   return counter;
 }
 
+//----------------------------------------------------------------------------
+// The runs of uncolored voxels, stored row by row (x-fastest), and a
+// union-find forest over the runs.
+class vtkICF::ComponentTable
+{
+public:
+  // The index of the first run of each row, followed by the number of runs.
+  std::vector<vtkIdType> RowOffsets;
+  // The first and last x index of each run.
+  std::vector<int> RunStart;
+  std::vector<int> RunEnd;
+  // The parent of each run, which becomes the component of each run.
+  std::vector<vtkIdType> Parent;
+  // The size and the extent of each component.
+  std::vector<vtkIdType> Sizes;
+  std::vector<int> Extents;
+
+  vtkIdType Find(vtkIdType i)
+  {
+    while (this->Parent[i] != i)
+    {
+      this->Parent[i] = this->Parent[this->Parent[i]];
+      i = this->Parent[i];
+    }
+    return i;
+  }
+
+  // The root is always the run with the lowest index, i.e. the first run
+  // of the component, so that the parent of a run never follows it.
+  void Union(vtkIdType i, vtkIdType j)
+  {
+    i = this->Find(i);
+    j = this->Find(j);
+    if (i < j)
+    {
+      this->Parent[j] = i;
+    }
+    else if (j < i)
+    {
+      this->Parent[i] = j;
+    }
+  }
+
+  // Merge the runs of two rows that share a face.
+  void LinkRows(vtkIdType row1, vtkIdType row2)
+  {
+    vtkIdType i = this->RowOffsets[row1];
+    vtkIdType iEnd = this->RowOffsets[row1 + 1];
+    vtkIdType j = this->RowOffsets[row2];
+    vtkIdType jEnd = this->RowOffsets[row2 + 1];
+    while (i < iEnd && j < jEnd)
+    {
+      if (this->RunStart[i] <= this->RunEnd[j] && this->RunStart[j] <= this->RunEnd[i])
+      {
+        this->Union(i, j);
+      }
+      if (this->RunEnd[i] < this->RunEnd[j])
+      {
+        ++i;
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <class F>
+void vtkICF::ScanRow(const unsigned char* maskPtr, vtkIdType offset, int n, F&& func)
+{
+  int start = -1;
+  int x = 0;
+  while (x < n)
+  {
+    vtkIdType bitOffset = offset + x;
+    unsigned char bits = maskPtr[bitOffset >> 3];
+    int shift = static_cast<int>(bitOffset & 0x7);
+    if (shift == 0 && x + 8 <= n && bits == (start < 0 ? 0xFF : 0x00))
+    {
+      // skip a whole byte that does not start or end a run
+      x += 8;
+      continue;
+    }
+    bool colored = ((bits >> shift) & 1) != 0;
+    if (!colored && start < 0)
+    {
+      start = x;
+    }
+    else if (colored && start >= 0)
+    {
+      func(start, x - 1);
+      start = -1;
+    }
+    x++;
+  }
+  if (start >= 0)
+  {
+    func(start, n - 1);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Label the runs in parallel blocks of rows, merge the blocks, and then
+// number the components in the order of their first run.
+void vtkICF::FindComponents(const unsigned char* maskPtr, int maxIdx[3], bool fullExtents,
+  vtkICF::ComponentTable& table)
+{
+  const int nx = maxIdx[0] + 1;
+  const int ny = maxIdx[1] + 1;
+  const vtkIdType numberOfRows = static_cast<vtkIdType>(ny) * (maxIdx[2] + 1);
+
+  // count the runs in each row, then store them
+  table.RowOffsets.assign(numberOfRows + 1, 0);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType row = first; row < last; row++)
+    {
+      vtkIdType count = 0;
+      vtkICF::ScanRow(maskPtr, row * nx, nx, [&count](int, int) { count++; });
+      table.RowOffsets[row + 1] = count;
+    }
+  });
+  std::partial_sum(table.RowOffsets.begin(), table.RowOffsets.end(), table.RowOffsets.begin());
+  const vtkIdType numberOfRuns = table.RowOffsets[numberOfRows];
+  table.RunStart.resize(numberOfRuns);
+  table.RunEnd.resize(numberOfRuns);
+  table.Parent.resize(numberOfRuns);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType row = first; row < last; row++)
+    {
+      vtkIdType run = table.RowOffsets[row];
+      vtkICF::ScanRow(maskPtr, row * nx, nx, [&](int start, int end) {
+        table.RunStart[run] = start;
+        table.RunEnd[run] = end;
+        table.Parent[run] = run;
+        run++;
+      });
+    }
+  });
+
+  // merge the runs within blocks of rows, each block only touches its own
+  // runs so the blocks can be done in parallel
+  const vtkIdType numberOfBlocks = std::min<vtkIdType>(numberOfRows, 256);
+  const vtkIdType blockSize = (numberOfRows + numberOfBlocks - 1) / numberOfBlocks;
+  vtkSMPTools::For(0, numberOfBlocks, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType block = first; block < last; block++)
+    {
+      vtkIdType firstRow = block * blockSize;
+      vtkIdType lastRow = std::min(firstRow + blockSize, numberOfRows);
+      for (vtkIdType row = firstRow; row < lastRow; row++)
+      {
+        if (row % ny != 0 && row - 1 >= firstRow)
+        {
+          table.LinkRows(row, row - 1);
+        }
+        if (row >= ny && row - ny >= firstRow)
+        {
+          table.LinkRows(row, row - ny);
+        }
+      }
+    }
+  });
+
+  // merge the rows across the block boundaries
+  for (vtkIdType firstRow = blockSize; firstRow < numberOfRows; firstRow += blockSize)
+  {
+    vtkIdType lastRow = std::min(firstRow + std::min<vtkIdType>(blockSize, ny), numberOfRows);
+    for (vtkIdType row = firstRow; row < lastRow; row++)
+    {
+      if (row == firstRow && row % ny != 0)
+      {
+        table.LinkRows(row, row - 1);
+      }
+      if (row >= ny)
+      {
+        table.LinkRows(row, row - ny);
+      }
+    }
+  }
+
+  // replace the parents by component numbers, since the parent of a run
+  // never follows it this can be done in one pass
+  vtkIdType numberOfComponents = 0;
+  for (vtkIdType run = 0; run < numberOfRuns; run++)
+  {
+    vtkIdType parent = table.Parent[run];
+    table.Parent[run] = (parent == run ? numberOfComponents++ : table.Parent[parent]);
+  }
+
+  // compute the size and extent of the components
+  table.Sizes.assign(numberOfComponents, 0);
+  table.Extents.resize(6 * numberOfComponents);
+  for (vtkIdType row = 0; row < numberOfRows; row++)
+  {
+    int y = static_cast<int>(row % ny);
+    int z = static_cast<int>(row / ny);
+    for (vtkIdType run = table.RowOffsets[row]; run < table.RowOffsets[row + 1]; run++)
+    {
+      vtkIdType c = table.Parent[run];
+      int* extent = &table.Extents[6 * c];
+      if (table.Sizes[c] == 0)
+      {
+        extent[0] = table.RunStart[run];
+        extent[1] = (fullExtents ? table.RunEnd[run] : extent[0]);
+        extent[2] = extent[3] = y;
+        extent[4] = extent[5] = z;
+      }
+      else if (fullExtents)
+      {
+        extent[0] = std::min(extent[0], table.RunStart[run]);
+        extent[1] = std::max(extent[1], table.RunEnd[run]);
+        extent[2] = std::min(extent[2], y);
+        extent[3] = std::max(extent[3], y);
+        extent[5] = std::max(extent[5], z);
+      }
+      table.Sizes[c] += table.RunEnd[run] - table.RunStart[run] + 1;
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 template <class OT>
 void vtkICF::AddRegion(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
@@ -1235,8 +1472,7 @@ void vtkICF::SeededExecute(vtkImageConnectivityFilter* self, vtkImageData* outDa
 //----------------------------------------------------------------------------
 template <class OT>
 void vtkICF::SeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
-  vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr, int extent[6],
-  vtkICF::RegionVector& regionInfo)
+  OT* outPtr, unsigned char* maskPtr, int extent[6], vtkICF::RegionVector& regionInfo)
 {
   // Get execution parameters
   int extractionMode = self->GetExtractionMode();
@@ -1255,67 +1491,134 @@ void vtkICF::SeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* out
   int maxIdx[3];
   int* outLimits = vtkICF::ZeroBaseExtent(extent, outExt, maxIdx);
 
-  // for measuring extent of fill
-  int seedExtent[6];
-  // only set to non-null if extent generation was requested
-  int* fillExtent = (self->GetGenerateRegionExtents() ? seedExtent : nullptr);
-
-  // keep track of position in bitmask
-  unsigned char* maskPtr1 = maskPtr;
-  unsigned char bit = 1;
-
-  std::stack<vtkICF::Seed> seedStack;
+  // find all the regions at once, rather than with a flood fill from each
+  // voxel in turn, but number them as a raster scan would find them
+  vtkICF::ComponentTable table;
+  vtkICF::FindComponents(maskPtr, maxIdx, self->GetGenerateRegionExtents() != 0, table);
+  const vtkIdType numberOfComponents = static_cast<vtkIdType>(table.Sizes.size());
+
+  // the origin of each region: the component it came from, or if negative,
+  // the label that a seeded region has in the output
+  const size_t numberOfSeeded = regionInfo.size();
+  std::vector<vtkIdType> origins(numberOfSeeded);
+  for (size_t i = 0; i < origins.size(); i++)
+  {
+    origins[i] = -static_cast<vtkIdType>(i);
+  }
 
-  for (int zIdx = 0; zIdx <= maxIdx[2]; zIdx++)
+  // add the regions in order, and prune them as AddRegion() prunes the
+  // output when the labels run out
+  const size_t maxLabel = static_cast<size_t>(vtkTypeTraits<OT>::Max());
+  for (vtkIdType c = 0; c < numberOfComponents; c++)
   {
-    for (int yIdx = 0; yIdx <= maxIdx[1]; yIdx++)
+    vtkIdType voxelCount = table.Sizes[c];
+    if (voxelCount == 1 && regionInfo.size() == maxLabel)
     {
-      for (int xIdx = 0; xIdx <= maxIdx[0]; xIdx++)
+      // smallest region is definitely the one we just added
+      continue;
+    }
+    regionInfo.push_back(vtkICF::Region(voxelCount, -1, &table.Extents[6 * c]));
+    origins.push_back(c);
+    if (regionInfo.size() > maxLabel)
+    {
+      size_t m = 1;
+      for (size_t i = 1; i < regionInfo.size(); i++)
       {
-        // check the bitmask to see if voxel is already colored
-        unsigned char bitSet = *maskPtr1 & bit;
-        bit <<= 1;
-        if (bit == 0)
+        vtkIdType s = regionInfo[i].size;
+        if (s >= sizeRange[0] && s <= sizeRange[1])
         {
-          maskPtr1++;
-          bit = 1;
+          regionInfo[m] = regionInfo[i];
+          origins[m++] = origins[i];
         }
+      }
+      regionInfo.resize(m);
+      origins.resize(m);
+    }
+    if (regionInfo.size() > maxLabel)
+    {
+      if (extractionMode == vtkImageConnectivityFilter::LargestRegion)
+      {
+        vtkICF::RegionVector::iterator largest = regionInfo.largest();
+        origins[1] = origins[std::distance(regionInfo.begin(), largest)];
+        regionInfo[1] = *largest;
+        regionInfo.resize(2);
+        origins.resize(2);
+      }
+      else
+      {
+        vtkICF::RegionVector::iterator smallest = regionInfo.smallest();
+        origins.erase(origins.begin() + std::distance(regionInfo.begin(), smallest));
+        regionInfo.erase(smallest);
+      }
+    }
+  }
+
+  // get the output label of each component, and of each seeded region
+  std::vector<OT> componentLabels(numberOfComponents, 0);
+  std::vector<OT> seededLabels(numberOfSeeded, 0);
+  size_t keptSeeded = 1;
+  bool relabelSeeded = false;
+  for (size_t i = 1; i < regionInfo.size(); i++)
+  {
+    if (origins[i] >= 0)
+    {
+      componentLabels[origins[i]] = static_cast<OT>(i);
+    }
+    else
+    {
+      seededLabels[-origins[i]] = static_cast<OT>(i);
+      relabelSeeded |= (static_cast<vtkIdType>(i) != -origins[i]);
+      keptSeeded++;
+    }
+  }
+
+  // if pruning removed or moved seeded regions, relabel them first
+  if (relabelSeeded || keptSeeded != numberOfSeeded)
+  {
+    vtkIdType outSize = static_cast<vtkIdType>(outExt[1] - outExt[0] + 1) *
+      (outExt[3] - outExt[2] + 1) * (outExt[5] - outExt[4] + 1);
+    vtkSMPTools::For(0, outSize, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType i = first; i < last; i++)
+      {
+        outPtr[i] = seededLabels[outPtr[i]];
+      }
+    });
+  }
 
-        // if already colored, skip
-        if (bitSet != 0)
+  // write the labels of the runs that lie within the output extent
+  const vtkIdType numberOfRows = static_cast<vtkIdType>(maxIdx[1] + 1) * (maxIdx[2] + 1);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType row = first; row < last; row++)
+    {
+      int idx[3] = { 0, static_cast<int>(row % (maxIdx[1] + 1)),
+        static_cast<int>(row / (maxIdx[1] + 1)) };
+      int xMin = 0;
+      int xMax = maxIdx[0];
+      if (outLimits)
+      {
+        if (idx[1] < outLimits[2] || idx[1] > outLimits[3] || idx[2] < outLimits[4] ||
+          idx[2] > outLimits[5])
         {
           continue;
         }
-
-        // initialize the region extent from the seed position
-        seedExtent[0] = seedExtent[1] = xIdx;
-        seedExtent[2] = seedExtent[3] = yIdx;
-        seedExtent[4] = seedExtent[5] = zIdx;
-
-        OT label = static_cast<OT>(regionInfo.size());
-        seedStack.push(vtkICF::Seed(xIdx, yIdx, zIdx, label));
-
-        // find all voxels that are connected to the seed
-        vtkIdType voxelCount =
-          vtkICF::Fill(outPtr, outInc, outLimits, maskPtr, maxIdx, fillExtent, seedStack);
-
-        if (voxelCount != 0)
+        idx[1] -= outLimits[2];
+        idx[2] -= outLimits[4];
+        xMin = outLimits[0];
+        xMax = outLimits[1];
+      }
+      OT* rowPtr = outPtr + idx[1] * outInc[1] + idx[2] * outInc[2];
+      for (vtkIdType run = table.RowOffsets[row]; run < table.RowOffsets[row + 1]; run++)
+      {
+        OT label = componentLabels[table.Parent[run]];
+        int start = std::max(table.RunStart[run], xMin);
+        int end = std::min(table.RunEnd[run], xMax);
+        for (int x = start; label != 0 && x <= end; x++)
         {
-          if (voxelCount == 1 && static_cast<OT>(regionInfo.size()) == vtkTypeTraits<OT>::Max())
-          {
-            // smallest region is definitely the one we just added
-            vtkIdType outOffset = (xIdx * outInc[0] + yIdx * outInc[1] + zIdx * outInc[2]);
-            outPtr[outOffset] = 0;
-          }
-          else
-          {
-            vtkICF::AddRegion(outData, outPtr, stencil, extent, sizeRange, regionInfo, voxelCount,
-              -1, seedExtent, extractionMode);
-          }
+          rowPtr[(x - xMin) * outInc[0]] = label;
         }
       }
     }
-  }
+  });
 }
 
 //----------------------------------------------------------------------------
@@ -1341,7 +1644,7 @@ void vtkICF::ExecuteOutput(vtkImageConnectivityFilter* self, vtkImageData* outDa
   int extractionMode = self->GetExtractionMode();
   if (!seedData || extractionMode == vtkImageConnectivityFilter::AllRegions)
   {
-    vtkICF::SeedlessExecute(self, outData, stencil, outPtr, maskPtr, extent, regionInfo);
+    vtkICF::SeedlessExecute(self, outData, outPtr, maskPtr, extent, regionInfo);
   }
 
   // do final relabelling and other bookkeeping
@@ -17,12 +17,15 @@
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkImageContinuousDilate3D);
 
 //----------------------------------------------------------------------------
@@ -31,6 +34,7 @@ vtkStandardNewMacro(vtkImageContinuousDilate3D);
 vtkImageContinuousDilate3D::vtkImageContinuousDilate3D()
 {
   this->HandleBoundaries = 1;
+  this->KernelShape = Ellipsoid;
   this->KernelSize[0] = 0;
   this->KernelSize[1] = 0;
   this->KernelSize[2] = 0;
@@ -54,6 +58,21 @@ vtkImageContinuousDilate3D::~vtkImageContinuousDilate3D()
 void vtkImageContinuousDilate3D::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "KernelShape: " << this->GetKernelShapeAsString() << "\n";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkImageContinuousDilate3D::GetKernelShapeAsString()
+{
+  switch (this->KernelShape)
+  {
+    case Box:
+      return "Box";
+    case SegmentedEllipsoid:
+      return "SegmentedEllipsoid";
+    default:
+      return "Ellipsoid";
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -319,6 +338,61 @@ void vtkImageContinuousDilate3D::ThreadedRequestData(vtkInformation* vtkNotUsed(
 int vtkImageContinuousDilate3D::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  this->Ellipse->Update();
-  return this->Superclass::RequestData(request, inputVector, outputVector);
+  if (this->KernelShape == Ellipsoid)
+  {
+    this->Ellipse->Update();
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // the segments are filtered along whole lines, so instead of splitting
+  // the extent into pieces, each segment splits its lines into groups
+  vtkImageData* inData = nullptr;
+  vtkImageData** inDataPtr = &inData;
+  vtkImageData* outData = nullptr;
+  this->PrepareImageData(inputVector, outputVector, &inDataPtr, &outData);
+
+  int inExt[6], outExt[6], wholeExt[6];
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  vtkDataArray* inArray = this->GetInputArrayToProcess(0, inputVector);
+  if (outExt[0] > outExt[1] || outExt[2] > outExt[3] || outExt[4] > outExt[5] || !inArray)
+  {
+    return 1;
+  }
+  this->InternalRequestUpdateExtent(inExt, outExt, wholeExt);
+
+  // this filter expects the output type to be same as input
+  if (outData->GetScalarType() != inArray->GetDataType())
+  {
+    vtkErrorMacro(<< "Execute: output ScalarType, "
+                  << vtkImageScalarTypeNameMacro(outData->GetScalarType())
+                  << " must match input array data type");
+    return 1;
+  }
+
+  std::vector<vtkImageMorphologySegment> segments;
+  if (this->KernelShape == Box)
+  {
+    vtkImageMorphologyBoxSegments(this->KernelSize, this->KernelMiddle, segments);
+  }
+  else
+  {
+    vtkImageMorphologyEllipsoidSegments(this->KernelSize, this->KernelMiddle, segments);
+  }
+
+  void* inPtr = inArray->GetVoidPointer(0);
+  void* outPtr = outData->GetScalarPointer();
+  switch (inArray->GetDataType())
+  {
+    vtkTemplateMacro(vtkImageMorphologyExecute<vtkImageMorphologyMax<VTK_TT> >(this,
+      static_cast<VTK_TT*>(inPtr), inData->GetExtent(), inExt, static_cast<VTK_TT*>(outPtr),
+      outData->GetExtent(), outExt, inArray->GetNumberOfComponents(), segments));
+    default:
+      vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      return 1;
+  }
+
+  return 1;
 }
@@ -42,17 +42,43 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent) override;
   //@}
 
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1,
+    SegmentedEllipsoid = 2
+  };
+
   /**
    * This method sets the size of the neighborhood.  It also sets the
    * default middle of the neighborhood and computes the elliptical foot print.
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  //@{
+  /**
+   * Set/Get the shape of the neighborhood.  The default, Ellipsoid, checks
+   * every voxel of the ellipsoid for each output voxel, so its cost grows
+   * with the volume of the kernel.  Box and SegmentedEllipsoid are
+   * compositions of line segments, and the minimum over each segment is
+   * computed with the van Herk/Gil-Werman algorithm, whose cost does not
+   * depend on the length of the segment.  SegmentedEllipsoid approximates
+   * the ellipsoid with segments along the axes and the diagonals.
+   */
+  vtkSetClampMacro(KernelShape, int, Ellipsoid, SegmentedEllipsoid);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  void SetKernelShapeToSegmentedEllipsoid() { this->SetKernelShape(SegmentedEllipsoid); }
+  vtkGetMacro(KernelShape, int);
+  const char* GetKernelShapeAsString();
+  //@}
+
 protected:
   vtkImageContinuousErode3D();
   ~vtkImageContinuousErode3D() override;
 
   vtkImageEllipsoidSource* Ellipse;
+  int KernelShape;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -15,11 +15,15 @@
 #include "vtkImageDilateErode3D.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkImageDilateErode3D);
 
 //----------------------------------------------------------------------------
@@ -34,6 +38,7 @@ vtkImageDilateErode3D::vtkImageDilateErode3D()
 
   this->DilateValue = 0.0;
   this->ErodeValue = 255.0;
+  this->KernelShape = Ellipsoid;
 
   this->Ellipse = vtkImageEllipsoidSource::New();
   // Setup the Ellipse to default size
@@ -57,6 +62,21 @@ void vtkImageDilateErode3D::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "DilateValue: " << this->DilateValue << "\n";
   os << indent << "ErodeValue: " << this->ErodeValue << "\n";
+  os << indent << "KernelShape: " << this->GetKernelShapeAsString() << "\n";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkImageDilateErode3D::GetKernelShapeAsString()
+{
+  switch (this->KernelShape)
+  {
+    case Box:
+      return "Box";
+    case SegmentedEllipsoid:
+      return "SegmentedEllipsoid";
+    default:
+      return "Ellipsoid";
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -305,10 +325,109 @@ void vtkImageDilateErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(reque
   }
 }
 
+//----------------------------------------------------------------------------
+// Spread the voxels with the dilate value along the segments, and replace
+// the voxels with the erode value that they reach.
+template <class T>
+void vtkImageDilateErode3DExecuteSegments(vtkImageDilateErode3D* self, vtkImageData* inData,
+  const int inExt[6], vtkImageData* outData, const int outExt[6],
+  const std::vector<vtkImageMorphologySegment>& segments)
+{
+  const T erodeValue = static_cast<T>(self->GetErodeValue());
+  const T dilateValue = static_cast<T>(self->GetDilateValue());
+  const int numComps = inData->GetNumberOfScalarComponents();
+  int size[3] = { inExt[1] - inExt[0] + 1, inExt[3] - inExt[2] + 1, inExt[5] - inExt[4] + 1 };
+  const vtkIdType rowSize = static_cast<vtkIdType>(size[0]) * numComps;
+  std::vector<unsigned char> reached(static_cast<size_t>(rowSize) * size[1] * size[2]);
+  unsigned char* reachedPtr = reached.data();
+  for (int z = inExt[4]; z <= inExt[5]; ++z)
+  {
+    for (int y = inExt[2]; y <= inExt[3]; ++y)
+    {
+      const T* inPtr = static_cast<T*>(inData->GetScalarPointer(inExt[0], y, z));
+      for (vtkIdType i = 0; i < rowSize; ++i)
+      {
+        *reachedPtr++ = (inPtr[i] == dilateValue);
+      }
+    }
+  }
+
+  vtkImageMorphologyApplySegments<vtkImageMorphologyMax<unsigned char> >(
+    self, reached.data(), size, numComps, segments);
+
+  const vtkIdType outRowSize = static_cast<vtkIdType>(outExt[1] - outExt[0] + 1) * numComps;
+  for (int z = outExt[4]; z <= outExt[5]; ++z)
+  {
+    for (int y = outExt[2]; y <= outExt[3]; ++y)
+    {
+      const T* inPtr = static_cast<T*>(inData->GetScalarPointer(outExt[0], y, z));
+      T* outPtr = static_cast<T*>(outData->GetScalarPointer(outExt[0], y, z));
+      reachedPtr = reached.data() + (outExt[0] - inExt[0]) * numComps + (y - inExt[2]) * rowSize +
+        (z - inExt[4]) * rowSize * size[1];
+      for (vtkIdType i = 0; i < outRowSize; ++i)
+      {
+        outPtr[i] = (inPtr[i] == erodeValue && reachedPtr[i] ? dilateValue : inPtr[i]);
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkImageDilateErode3D::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  this->Ellipse->Update();
-  return this->Superclass::RequestData(request, inputVector, outputVector);
+  if (this->KernelShape == Ellipsoid)
+  {
+    this->Ellipse->Update();
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // the segments are filtered along whole lines, so instead of splitting
+  // the extent into pieces, each segment splits its lines into groups
+  vtkImageData* inData = nullptr;
+  vtkImageData** inDataPtr = &inData;
+  vtkImageData* outData = nullptr;
+  this->PrepareImageData(inputVector, outputVector, &inDataPtr, &outData);
+
+  int inExt[6], outExt[6], wholeExt[6];
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  if (outExt[0] > outExt[1] || outExt[2] > outExt[3] || outExt[4] > outExt[5] ||
+    !inData->GetPointData()->GetScalars())
+  {
+    return 1;
+  }
+  this->InternalRequestUpdateExtent(inExt, outExt, wholeExt);
+
+  // this filter expects the output type to be same as input
+  if (outData->GetScalarType() != inData->GetScalarType())
+  {
+    vtkErrorMacro(<< "Execute: output ScalarType, "
+                  << vtkImageScalarTypeNameMacro(outData->GetScalarType())
+                  << " must match input scalar type");
+    return 1;
+  }
+
+  std::vector<vtkImageMorphologySegment> segments;
+  if (this->KernelShape == Box)
+  {
+    vtkImageMorphologyBoxSegments(this->KernelSize, this->KernelMiddle, segments);
+  }
+  else
+  {
+    vtkImageMorphologyEllipsoidSegments(this->KernelSize, this->KernelMiddle, segments);
+  }
+
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(
+      vtkImageDilateErode3DExecuteSegments<VTK_TT>(this, inData, inExt, outData, outExt, segments));
+    default:
+      vtkErrorMacro(<< "Execute: Unknown ScalarType");
+      return 1;
+  }
+
+  return 1;
 }
@@ -44,6 +44,13 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent) override;
   //@}
 
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1,
+    SegmentedEllipsoid = 2
+  };
+
   /**
    * This method sets the size of the neighborhood.  It also sets the
    * default middle of the neighborhood and computes the elliptical foot print.
@@ -60,6 +67,25 @@ public:
   vtkGetMacro(ErodeValue, double);
   //@}
 
+  //@{
+  /**
+   * Set/Get the shape of the neighborhood.  The default, Ellipsoid, checks
+   * every voxel of the ellipsoid for each voxel with the erode value, so
+   * its cost grows with the volume of the kernel.  Box and
+   * SegmentedEllipsoid are compositions of line segments, and the voxels
+   * with the dilate value are spread along each segment with the van
+   * Herk/Gil-Werman algorithm, whose cost does not depend on the length of
+   * the segment.  SegmentedEllipsoid approximates the ellipsoid with
+   * segments along the axes and the diagonals.
+   */
+  vtkSetClampMacro(KernelShape, int, Ellipsoid, SegmentedEllipsoid);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  void SetKernelShapeToSegmentedEllipsoid() { this->SetKernelShape(SegmentedEllipsoid); }
+  vtkGetMacro(KernelShape, int);
+  const char* GetKernelShapeAsString();
+  //@}
+
 protected:
   vtkImageDilateErode3D();
   ~vtkImageDilateErode3D() override;
@@ -67,6 +93,7 @@ protected:
   vtkImageEllipsoidSource* Ellipse;
   double DilateValue;
   double ErodeValue;
+  int KernelShape;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
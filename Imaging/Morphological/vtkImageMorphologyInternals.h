@@ -0,0 +1,440 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageMorphologyInternals.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageMorphologyInternals
+ * @brief   internals for the morphology filters
+ *
+ * A kernel is decomposed into line segments, and the maximum or minimum
+ * over each segment is computed with the van Herk/Gil-Werman algorithm,
+ * which uses three comparisons per voxel regardless of the length of the
+ * segment.  The maximum over a composition (Minkowski sum) of segments is
+ * the result of filtering with each segment in turn.
+ */
+
+#ifndef vtkImageMorphologyInternals_h
+#define vtkImageMorphologyInternals_h
+
+#include "vtkAlgorithm.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+// A line segment that covers the voxels from Min to Max steps along
+// Direction away from each voxel.
+struct vtkImageMorphologySegment
+{
+  int Direction[3];
+  int Min;
+  int Max;
+};
+
+// The operators that combine the values within a segment.  The identity
+// is used for the voxels that lie outside of the image.
+template <class T>
+struct vtkImageMorphologyMax
+{
+  typedef T ValueType;
+  static T Identity() { return std::numeric_limits<T>::lowest(); }
+  static T Apply(T a, T b) { return (b > a ? b : a); }
+};
+
+template <class T>
+struct vtkImageMorphologyMin
+{
+  typedef T ValueType;
+  static T Identity() { return std::numeric_limits<T>::max(); }
+  static T Apply(T a, T b) { return (b < a ? b : a); }
+};
+
+//----------------------------------------------------------------------------
+// Decompose a box kernel into one segment along each axis.
+inline void vtkImageMorphologyBoxSegments(
+  const int size[3], const int middle[3], std::vector<vtkImageMorphologySegment>& segments)
+{
+  segments.clear();
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (size[axis] > 1)
+    {
+      vtkImageMorphologySegment segment = { { 0, 0, 0 }, -middle[axis],
+        size[axis] - 1 - middle[axis] };
+      segment.Direction[axis] = 1;
+      segments.push_back(segment);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Approximate the ellipsoidal kernel of the given size by segments along
+// the axes, the face diagonals and the body diagonals.  The composition of
+// these segments is a zonotope, which is symmetric under a reflection of
+// any axis if the two diagonals of each face, and the four body diagonals,
+// have the same lengths.  The lengths are chosen so that the zonotope
+// spans the kernel along each axis and so that its support function is
+// closest to that of the ellipsoid in a set of directions.  For an even
+// size, a segment of two voxels along the axis gives the extra voxel.
+inline void vtkImageMorphologyEllipsoidSegments(
+  const int size[3], const int middle[3], std::vector<vtkImageMorphologySegment>& segments)
+{
+  int reach[3];
+  double radius[3];
+  bool active[3];
+  int numActive = 0;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    reach[axis] = std::max(std::min(middle[axis], size[axis] - 1 - middle[axis]), 0);
+    radius[axis] = 0.5 * size[axis];
+    active[axis] = (reach[axis] > 0);
+    numActive += active[axis];
+  }
+
+  // the coefficients of the lengths (three axes, three pairs of face
+  // diagonals and the body diagonals) in the support function for each
+  // sample direction, and the support function of the ellipsoid
+  const int pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+  std::vector<double> coefficients;
+  std::vector<double> support;
+  const int steps = 4;
+  for (int i = 0; i <= steps; ++i)
+  {
+    for (int j = 0; j <= steps; ++j)
+    {
+      for (int k = 0; k <= steps; ++k)
+      {
+        // skip the inactive axes and the directions with a common factor
+        if ((i && !active[0]) || (j && !active[1]) || (k && !active[2]) || i + j + k == 0 ||
+          ((i % 2 + j % 2 + k % 2) == 0) || (i % 3 + j % 3 + k % 3) == 0)
+        {
+          continue;
+        }
+        double u[3] = { static_cast<double>(i), static_cast<double>(j), static_cast<double>(k) };
+        double norm = sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+        double h = 0.0;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          u[axis] /= norm;
+          h += radius[axis] * radius[axis] * u[axis] * u[axis];
+          coefficients.push_back(u[axis]);
+        }
+        for (const int* pair : pairs)
+        {
+          coefficients.push_back(
+            std::abs(u[pair[0]] + u[pair[1]]) + std::abs(u[pair[0]] - u[pair[1]]));
+        }
+        coefficients.push_back(std::abs(u[0] + u[1] + u[2]) + std::abs(u[0] + u[1] - u[2]) +
+          std::abs(u[0] - u[1] + u[2]) + std::abs(u[0] - u[1] - u[2]));
+        support.push_back(sqrt(h));
+      }
+    }
+  }
+
+  // search the lengths of the diagonals, the lengths of the axes follow
+  // from the reach of the kernel along each axis
+  int best[7] = { reach[0], reach[1], reach[2], 0, 0, 0, 0 };
+  double bestError = VTK_DOUBLE_MAX;
+  int maxBody = (numActive == 3 ? std::min(std::min(reach[0], reach[1]), reach[2]) / 4 : 0);
+  for (int c = 0; c <= maxBody; ++c)
+  {
+    int rest[3] = { reach[0] - 4 * c, reach[1] - 4 * c, reach[2] - 4 * c };
+    int maxXY = (active[0] && active[1] ? std::min(rest[0], rest[1]) / 2 : 0);
+    for (int bXY = 0; bXY <= maxXY; ++bXY)
+    {
+      int maxXZ = (active[0] && active[2] ? std::min(rest[0] - 2 * bXY, rest[2]) / 2 : 0);
+      for (int bXZ = 0; bXZ <= maxXZ; ++bXZ)
+      {
+        int maxYZ =
+          (active[1] && active[2] ? std::min(rest[1] - 2 * bXY, rest[2] - 2 * bXZ) / 2 : 0);
+        for (int bYZ = 0; bYZ <= maxYZ; ++bYZ)
+        {
+          int lengths[7] = { rest[0] - 2 * (bXY + bXZ), rest[1] - 2 * (bXY + bYZ),
+            rest[2] - 2 * (bXZ + bYZ), bXY, bXZ, bYZ, c };
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            lengths[axis] = (active[axis] ? lengths[axis] : 0);
+          }
+          double error = 0.0;
+          const double* coefficient = coefficients.data();
+          for (double h : support)
+          {
+            double hz = 0.0;
+            for (int l = 0; l < 7; ++l)
+            {
+              hz += lengths[l] * coefficient[l];
+            }
+            coefficient += 7;
+            error += std::abs(hz - h);
+          }
+          if (error < bestError)
+          {
+            bestError = error;
+            std::copy(lengths, lengths + 7, best);
+          }
+        }
+      }
+    }
+  }
+
+  segments.clear();
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    // the extra voxel of an even size lies on the side of the middle that
+    // has more voxels
+    vtkImageMorphologySegment segment = { { 0, 0, 0 }, -best[axis] - (middle[axis] - reach[axis]),
+      best[axis] + (size[axis] - 1 - middle[axis] - reach[axis]) };
+    segment.Direction[axis] = 1;
+    if (size[axis] > 1 && (segment.Min != 0 || segment.Max != 0))
+    {
+      segments.push_back(segment);
+    }
+  }
+  for (int p = 0; p < 3; ++p)
+  {
+    for (int sign = 1; sign >= -1 && best[3 + p] > 0; sign -= 2)
+    {
+      vtkImageMorphologySegment segment = { { 0, 0, 0 }, -best[3 + p], best[3 + p] };
+      segment.Direction[pairs[p][0]] = 1;
+      segment.Direction[pairs[p][1]] = sign;
+      segments.push_back(segment);
+    }
+  }
+  for (int d = 0; d < 4 && best[6] > 0; ++d)
+  {
+    vtkImageMorphologySegment segment = { { 1, (d & 1 ? -1 : 1), (d & 2 ? -1 : 1) },
+      -best[6], best[6] };
+    segments.push_back(segment);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Replace each of the n values along a group of lines with the result of
+// the operator over the values from lo to hi steps away.  The lines start
+// at data, the values of each step are lanes consecutive values, and the
+// steps are stride values apart.  The forward and backward buffers must
+// hold (n + hi - lo) * lanes values.
+template <class Op>
+void vtkImageMorphologyLines(typename Op::ValueType* data, int n, vtkIdType stride, int lanes,
+  int lo, int hi, typename Op::ValueType* forward, typename Op::ValueType* backward)
+{
+  typedef typename Op::ValueType T;
+  const T identity = Op::Identity();
+  const int k = hi - lo + 1;
+  const int m = n + k - 1;
+
+  // combine the values from the start of each block of k values, where
+  // the values are shifted by lo and padded with the identity
+  for (int j = 0, b = 0; j < m; ++j, b = (b + 1 == k ? 0 : b + 1))
+  {
+    int i = j + lo;
+    T* f = forward + static_cast<vtkIdType>(j) * lanes;
+    bool inside = (i >= 0 && i < n);
+    const T* v = (inside ? data + i * stride : data);
+    if (b == 0)
+    {
+      for (int l = 0; l < lanes; ++l)
+      {
+        f[l] = (inside ? v[l] : identity);
+      }
+    }
+    else if (inside)
+    {
+      for (int l = 0; l < lanes; ++l)
+      {
+        f[l] = Op::Apply(f[l - lanes], v[l]);
+      }
+    }
+    else
+    {
+      std::copy(f - lanes, f, f);
+    }
+  }
+
+  // combine the values up to the end of each block of k values
+  for (int j = m - 1; j >= 0; --j)
+  {
+    int i = j + lo;
+    T* g = backward + static_cast<vtkIdType>(j) * lanes;
+    bool inside = (i >= 0 && i < n);
+    const T* v = (inside ? data + i * stride : data);
+    if (j == m - 1 || (j + 1) % k == 0)
+    {
+      for (int l = 0; l < lanes; ++l)
+      {
+        g[l] = (inside ? v[l] : identity);
+      }
+    }
+    else if (inside)
+    {
+      for (int l = 0; l < lanes; ++l)
+      {
+        g[l] = Op::Apply(g[l + lanes], v[l]);
+      }
+    }
+    else
+    {
+      std::copy(g + lanes, g + 2 * lanes, g);
+    }
+  }
+
+  // each window of k values spans the end of one block and the start of
+  // the next one
+  for (int i = 0; i < n; ++i)
+  {
+    T* v = data + i * stride;
+    const T* g = backward + static_cast<vtkIdType>(i) * lanes;
+    const T* f = forward + static_cast<vtkIdType>(i + k - 1) * lanes;
+    for (int l = 0; l < lanes; ++l)
+    {
+      v[l] = Op::Apply(g[l], f[l]);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Filter a buffer with dimensions size and numComps components with each
+// segment in turn, in parallel over the lines of each segment.  Lines with
+// no step along x are processed in groups of adjacent lines.
+template <class Op>
+void vtkImageMorphologyApplySegments(vtkAlgorithm* self, typename Op::ValueType* buffer,
+  const int size[3], int numComps, const std::vector<vtkImageMorphologySegment>& segments)
+{
+  typedef typename Op::ValueType T;
+  const int blockSize = 64;
+  const vtkIdType incs[3] = { numComps, static_cast<vtkIdType>(numComps) * size[0],
+    static_cast<vtkIdType>(numComps) * size[0] * size[1] };
+
+  for (size_t s = 0; s < segments.size() && !self->GetAbortExecute(); ++s)
+  {
+    const vtkImageMorphologySegment& segment = segments[s];
+    const int* d = segment.Direction;
+    if (segment.Min == 0 && segment.Max == 0)
+    {
+      continue;
+    }
+
+    // the lines start where the previous step lies outside of the buffer
+    const int rowSize = (d[0] == 0 ? 1 : size[0]);
+    std::vector<int> starts;
+    for (int z = 0; z < size[2]; ++z)
+    {
+      for (int y = 0; y < size[1]; ++y)
+      {
+        bool outside = (y - d[1] < 0 || y - d[1] >= size[1] || z - d[2] < 0 ||
+          z - d[2] >= size[2]);
+        for (int x = 0; x < rowSize; ++x)
+        {
+          if (outside || (d[0] != 0 && (x - d[0] < 0 || x - d[0] >= size[0])))
+          {
+            starts.push_back(x);
+            starts.push_back(y);
+            starts.push_back(z);
+          }
+        }
+      }
+    }
+
+    const vtkIdType stride = d[0] * incs[0] + d[1] * incs[1] + d[2] * incs[2];
+    const int lanesPerLine = (d[0] == 0 ? static_cast<int>(incs[1]) : numComps);
+    const vtkIdType blocksPerLine = (lanesPerLine + blockSize - 1) / blockSize;
+    const vtkIdType numLines = static_cast<vtkIdType>(starts.size() / 3);
+    const int length = segment.Max - segment.Min;
+    const int maxSize = std::max(std::max(size[0], size[1]), size[2]);
+
+    vtkSMPTools::For(0, numLines * blocksPerLine, [&](vtkIdType first, vtkIdType last) {
+      std::vector<T> work(2 * static_cast<size_t>(maxSize + length) * blockSize);
+      T* forward = work.data();
+      T* backward = forward + static_cast<size_t>(maxSize + length) * blockSize;
+      for (vtkIdType task = first; task < last; ++task)
+      {
+        const int* start = &starts[3 * (task / blocksPerLine)];
+        int lane = static_cast<int>(task % blocksPerLine) * blockSize;
+        int lanes = std::min(blockSize, lanesPerLine - lane);
+        int n = VTK_INT_MAX;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          if (d[axis] != 0)
+          {
+            n = std::min(n, (d[axis] > 0 ? size[axis] - start[axis] : start[axis] + 1));
+          }
+        }
+        T* data = buffer + start[0] * incs[0] + start[1] * incs[1] + start[2] * incs[2] + lane;
+        vtkImageMorphologyLines<Op>(
+          data, n, stride, lanes, segment.Min, segment.Max, forward, backward);
+      }
+    });
+    self->UpdateProgress(static_cast<double>(s + 1) / segments.size());
+  }
+}
+
+//----------------------------------------------------------------------------
+// Filter the extent outExt of an image with the segments, where the values
+// outside of inExt are ignored.  The pointers are the first values of the
+// images with extents inDataExt and outDataExt, and the images have the
+// same number of components.
+template <class Op>
+void vtkImageMorphologyExecute(vtkAlgorithm* self, const typename Op::ValueType* inPtr,
+  const int inDataExt[6], const int inExt[6], typename Op::ValueType* outPtr,
+  const int outDataExt[6], const int outExt[6], int numComps,
+  const std::vector<vtkImageMorphologySegment>& segments)
+{
+  typedef typename Op::ValueType T;
+  int size[3];
+  vtkIdType inIncs[3], outIncs[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    size[axis] = inExt[2 * axis + 1] - inExt[2 * axis] + 1;
+    inIncs[axis] = (axis == 0 ? numComps
+                              : inIncs[axis - 1] *
+                                (inDataExt[2 * axis - 1] - inDataExt[2 * axis - 2] + 1));
+    outIncs[axis] = (axis == 0 ? numComps
+                               : outIncs[axis - 1] *
+                                 (outDataExt[2 * axis - 1] - outDataExt[2 * axis - 2] + 1));
+  }
+
+  // filter a copy of the input extent
+  const vtkIdType rowSize = static_cast<vtkIdType>(size[0]) * numComps;
+  std::vector<T> buffer(static_cast<size_t>(rowSize) * size[1] * size[2]);
+  T* bufPtr = buffer.data();
+  for (int z = inExt[4]; z <= inExt[5]; ++z)
+  {
+    for (int y = inExt[2]; y <= inExt[3]; ++y)
+    {
+      const T* row = inPtr + (inExt[0] - inDataExt[0]) * inIncs[0] +
+        (y - inDataExt[2]) * inIncs[1] + (z - inDataExt[4]) * inIncs[2];
+      bufPtr = std::copy(row, row + rowSize, bufPtr);
+    }
+  }
+
+  vtkImageMorphologyApplySegments<Op>(self, buffer.data(), size, numComps, segments);
+
+  const vtkIdType outRowSize = static_cast<vtkIdType>(outExt[1] - outExt[0] + 1) * numComps;
+  for (int z = outExt[4]; z <= outExt[5]; ++z)
+  {
+    for (int y = outExt[2]; y <= outExt[3]; ++y)
+    {
+      const T* row = buffer.data() + (outExt[0] - inExt[0]) * numComps +
+        (y - inExt[2]) * rowSize + (z - inExt[4]) * rowSize * size[1];
+      std::copy(row, row + outRowSize,
+        outPtr + (outExt[0] - outDataExt[0]) * outIncs[0] + (y - outDataExt[2]) * outIncs[1] +
+          (z - outDataExt[4]) * outIncs[2]);
+    }
+  }
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImageMorphologyInternals.h
@@ -232,6 +232,51 @@ void vtkImageOpenClose3D::SetKernelSize(int size0, int size1, int size2)
   // Sub filters take care of modified.
 }
 
+//----------------------------------------------------------------------------
+// Selects the shape of the kernel of the sub filters.
+void vtkImageOpenClose3D::SetKernelShape(int shape)
+{
+  if (!this->Filter0 || !this->Filter1)
+  {
+    vtkErrorMacro(<< "SetKernelShape: Sub filter not created yet.");
+    return;
+  }
+
+  this->Filter0->SetKernelShape(shape);
+  this->Filter1->SetKernelShape(shape);
+  // Sub filters take care of modified.
+}
+
+//----------------------------------------------------------------------------
+void vtkImageOpenClose3D::SetKernelShapeToEllipsoid()
+{
+  this->SetKernelShape(vtkImageDilateErode3D::Ellipsoid);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageOpenClose3D::SetKernelShapeToBox()
+{
+  this->SetKernelShape(vtkImageDilateErode3D::Box);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageOpenClose3D::SetKernelShapeToSegmentedEllipsoid()
+{
+  this->SetKernelShape(vtkImageDilateErode3D::SegmentedEllipsoid);
+}
+
+//----------------------------------------------------------------------------
+int vtkImageOpenClose3D::GetKernelShape()
+{
+  if (!this->Filter0)
+  {
+    vtkErrorMacro(<< "GetKernelShape: Sub filter not created yet.");
+    return 0;
+  }
+
+  return this->Filter0->GetKernelShape();
+}
+
 //----------------------------------------------------------------------------
 // Determines the value that will closed.
 // Close value is first dilated, and then eroded
@@ -76,6 +76,19 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  //@{
+  /**
+   * Selects the shape of the kernel of the sub filters, see
+   * vtkImageDilateErode3D::SetKernelShape().  The Box and
+   * SegmentedEllipsoid shapes are much faster for large kernels.
+   */
+  void SetKernelShape(int shape);
+  void SetKernelShapeToEllipsoid();
+  void SetKernelShapeToBox();
+  void SetKernelShapeToSegmentedEllipsoid();
+  int GetKernelShape();
+  //@}
+
   //@{
   /**
    * Determines the value that will opened.
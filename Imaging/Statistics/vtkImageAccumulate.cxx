@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkImageAccumulate.h"
 
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkImageStencilData.h"
 #include "vtkImageStencilIterator.h"
@@ -21,9 +22,17 @@
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTypeTraits.h"
 
+#include <algorithm>
 #include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageAccumulate);
 
@@ -48,13 +57,21 @@ vtkImageAccumulate::vtkImageAccumulate()
   this->StandardDeviation[0] = this->StandardDeviation[1] = this->StandardDeviation[2] = 0.0;
   this->VoxelCount = 0;
   this->IgnoreZero = 0;
+  this->SparseOutput = 0;
+  this->SparseBinIndices = vtkIdTypeArray::New();
+  this->SparseBinIndices->SetNumberOfComponents(3);
+  this->SparseBinCounts = vtkIdTypeArray::New();
 
   // we have the image input and the optional stencil input
   this->SetNumberOfInputPorts(2);
 }
 
 //----------------------------------------------------------------------------
-vtkImageAccumulate::~vtkImageAccumulate() = default;
+vtkImageAccumulate::~vtkImageAccumulate()
+{
+  this->SparseBinIndices->Delete();
+  this->SparseBinCounts->Delete();
+}
 
 //----------------------------------------------------------------------------
 void vtkImageAccumulate::SetComponentExtent(int extent[6])
@@ -116,58 +133,74 @@ vtkImageStencilData* vtkImageAccumulate::GetStencil()
 }
 
 //----------------------------------------------------------------------------
-// This templated function executes the filter for any type of data.
-template <class T>
-int vtkImageAccumulateExecute(vtkImageAccumulate* self, vtkImageData* inData, T*,
-  vtkImageData* outData, vtkIdType* outPtr, double min[3], double max[3], double mean[3],
-  double standardDeviation[3], vtkIdType* voxelCount, int* updateExtent)
+namespace
 {
-  // variables used to compute statistics (filter handles max 3 components)
-  double sum[3];
-  sum[0] = sum[1] = sum[2] = 0.0;
-  double sumSqr[3];
-  sumSqr[0] = sumSqr[1] = sumSqr[2] = 0.0;
-  min[0] = min[1] = min[2] = VTK_DOUBLE_MAX;
-  max[0] = max[1] = max[2] = VTK_DOUBLE_MIN;
-  standardDeviation[0] = standardDeviation[1] = standardDeviation[2] = 0.0;
-  *voxelCount = 0;
-
-  // input's number of components is used as output dimensionality
-  int numC = inData->GetNumberOfScalarComponents();
-  if (numC > 3)
-  {
-    return 0;
-  }
 
-  // get information for output data
-  int outExtent[6];
-  outData->GetExtent(outExtent);
-  vtkIdType outIncs[3];
-  outData->GetIncrements(outIncs);
-  double origin[3];
-  outData->GetOrigin(origin);
-  double spacing[3];
-  outData->GetSpacing(spacing);
-
-  // zero count in every bin
-  vtkIdType size = 1;
-  size *= (outExtent[1] - outExtent[0] + 1);
-  size *= (outExtent[3] - outExtent[2] + 1);
-  size *= (outExtent[5] - outExtent[4] + 1);
-  for (vtkIdType j = 0; j < size; j++)
+struct vtkImageAccumulateThreadData;
+
+// The parameters that all threads share.
+struct vtkImageAccumulateParameters
+{
+  // the accumulation for the scalar type of the input
+  void (*Execute)(const vtkImageAccumulateParameters&, int[6], vtkImageAccumulateThreadData*);
+  vtkImageData* Input;
+  vtkImageStencilData* Stencil;
+  int UpdateExtent[6];
+  int NumberOfComponents;
+  double Origin[3];
+  double Spacing[3];
+  int BinExtent[6];
+  vtkIdType BinIncrements[3];
+  vtkIdType NumberOfBins;
+  bool ReverseStencil;
+  bool IgnoreZero;
+  bool Sparse;
+  // for 8 and 16 bit integer types, the offset of the bin of each value
+  // of each component (or -1 if outside the bins), from the type minimum
+  std::vector<vtkIdType> BinTables[3];
+  int TableMinimum;
+};
+
+// The histogram and statistics of each thread.
+struct vtkImageAccumulateThreadData
+{
+  std::vector<vtkIdType> Bins;
+  std::unordered_map<vtkIdType, vtkIdType> SparseBins;
+  double Sum[3];
+  double SumSqr[3];
+  double Min[3];
+  double Max[3];
+  vtkIdType VoxelCount;
+  bool Initialized = false;
+};
+
+// Find the offset of the bin of a value along one component.
+inline vtkIdType vtkImageAccumulateBinOffset(
+  const vtkImageAccumulateParameters& params, int idxC, double v)
+{
+  int outIdx = vtkMath::Floor((v - params.Origin[idxC]) / params.Spacing[idxC]);
+  if (outIdx >= params.BinExtent[idxC * 2] && outIdx <= params.BinExtent[idxC * 2 + 1])
   {
-    outPtr[j] = 0;
+    return (outIdx - params.BinExtent[idxC * 2]) * params.BinIncrements[idxC];
   }
+  return -1;
+}
 
-  vtkImageStencilData* stencil = self->GetStencil();
-  bool reverseStencil = (self->GetReverseStencil() != 0);
-  bool ignoreZero = (self->GetIgnoreZero() != 0);
-
-  vtkImageStencilIterator<T> inIter(inData, stencil, updateExtent, self);
+// This templated function accumulates the voxels of an extent.
+template <class T>
+void vtkImageAccumulateExecute(
+  const vtkImageAccumulateParameters& params, int extent[6], vtkImageAccumulateThreadData* data)
+{
+  const int numC = params.NumberOfComponents;
+  const bool useTables = !params.BinTables[0].empty();
+  const vtkIdType* tables[3] = { params.BinTables[0].data(), params.BinTables[1].data(),
+    params.BinTables[2].data() };
+  vtkIdType* bins = (params.Sparse ? nullptr : data->Bins.data());
 
+  vtkImageStencilIterator<T> inIter(params.Input, params.Stencil, extent);
   while (!inIter.IsAtEnd())
   {
-    if (inIter.IsInStencil() ^ reverseStencil)
+    if (inIter.IsInStencil() ^ params.ReverseStencil)
     {
       T* inPtr = inIter.BeginSpan();
       T* spanEndPtr = inIter.EndSpan();
@@ -176,90 +209,142 @@ int vtkImageAccumulateExecute(vtkImageAccumulate* self, vtkImageData* inData, T*
       {
         // find the bin for this pixel.
         bool outOfBounds = false;
-        vtkIdType* outPtrC = outPtr;
+        vtkIdType binId = 0;
         for (int idxC = 0; idxC < numC; ++idxC)
         {
-          double v = static_cast<double>(*inPtr++);
-          if (!ignoreZero || v != 0)
+          T value = *inPtr++;
+          double v = static_cast<double>(value);
+          if (!params.IgnoreZero || v != 0)
           {
             // gather statistics
-            sum[idxC] += v;
-            sumSqr[idxC] += v * v;
-            if (v > max[idxC])
+            data->Sum[idxC] += v;
+            data->SumSqr[idxC] += v * v;
+            if (v > data->Max[idxC])
             {
-              max[idxC] = v;
+              data->Max[idxC] = v;
             }
-            if (v < min[idxC])
+            if (v < data->Min[idxC])
             {
-              min[idxC] = v;
+              data->Min[idxC] = v;
             }
-            (*voxelCount)++;
+            data->VoxelCount++;
           }
 
-          // compute the index
-          int outIdx = vtkMath::Floor((v - origin[idxC]) / spacing[idxC]);
+          vtkIdType offset = (useTables
+              ? tables[idxC][static_cast<int>(value) - params.TableMinimum]
+              : vtkImageAccumulateBinOffset(params, idxC, v));
+          outOfBounds |= (offset < 0);
+          binId += offset;
+        }
 
-          // verify that it is in range
-          if (outIdx >= outExtent[idxC * 2] && outIdx <= outExtent[idxC * 2 + 1])
+        // increment the bin
+        if (!outOfBounds)
+        {
+          if (bins)
           {
-            outPtrC += (outIdx - outExtent[idxC * 2]) * outIncs[idxC];
+            ++bins[binId];
           }
           else
           {
-            outOfBounds = true;
+            ++data->SparseBins[binId];
           }
         }
-
-        // increment the bin
-        if (!outOfBounds)
-        {
-          ++(*outPtrC);
-        }
       }
     }
 
     inIter.NextSpan();
   }
+}
 
-  // initialize the statistics
-  mean[0] = 0;
-  mean[1] = 0;
-  mean[2] = 0;
+// Functor for vtkSMPTools execution over the rows of the update extent.
+class vtkImageAccumulateFunctor
+{
+public:
+  vtkImageAccumulateFunctor(const vtkImageAccumulateParameters& params)
+    : Parameters(params)
+  {
+  }
 
-  standardDeviation[0] = 0;
-  standardDeviation[1] = 0;
-  standardDeviation[2] = 0;
+  // The functor runs once for each pass over the rows, so each thread keeps
+  // accumulating into the histogram it started with.
+  void Initialize()
+  {
+    vtkImageAccumulateThreadData& data = this->ThreadData.Local();
+    if (data.Initialized)
+    {
+      return;
+    }
+    data.Initialized = true;
+    if (!this->Parameters.Sparse)
+    {
+      data.Bins.assign(this->Parameters.NumberOfBins, 0);
+    }
+    for (int idxC = 0; idxC < 3; ++idxC)
+    {
+      data.Sum[idxC] = 0.0;
+      data.SumSqr[idxC] = 0.0;
+      data.Min[idxC] = VTK_DOUBLE_MAX;
+      data.Max[idxC] = VTK_DOUBLE_MIN;
+    }
+    data.VoxelCount = 0;
+  }
 
-  if (*voxelCount != 0) // avoid the div0
+  void operator()(vtkIdType begin, vtkIdType end)
   {
-    double n = static_cast<double>(*voxelCount);
-    mean[0] = sum[0] / n;
-    mean[1] = sum[1] / n;
-    mean[2] = sum[2] / n;
+    const int* uExt = this->Parameters.UpdateExtent;
+    vtkIdType rows = uExt[3] - uExt[2] + 1;
+    vtkImageAccumulateThreadData* data = &this->ThreadData.Local();
 
-    if (*voxelCount - 1 != 0) // avoid the div0
+    // process the rows in pieces that do not cross slices
+    while (begin < end)
     {
-      double m = static_cast<double>(*voxelCount - 1);
-      standardDeviation[0] = sqrt((sumSqr[0] - mean[0] * mean[0] * n) / m);
-      standardDeviation[1] = sqrt((sumSqr[1] - mean[1] * mean[1] * n) / m);
-      standardDeviation[2] = sqrt((sumSqr[2] - mean[2] * mean[2] * n) / m);
+      int extent[6] = { uExt[0], uExt[1], 0, 0, 0, 0 };
+      extent[4] = extent[5] = uExt[4] + static_cast<int>(begin / rows);
+      extent[2] = uExt[2] + static_cast<int>(begin % rows);
+      vtkIdType count = std::min(end - begin, rows - (begin % rows));
+      extent[3] = extent[2] + static_cast<int>(count) - 1;
+      this->Parameters.Execute(this->Parameters, extent, data);
+      begin += count;
     }
   }
 
-  return 1;
+  void Reduce() {}
+
+  vtkSMPThreadLocal<vtkImageAccumulateThreadData> ThreadData;
+
+private:
+  const vtkImageAccumulateParameters& Parameters;
+};
+
+// Fill the tables of bin offsets for the values of small integer types.
+template <class T>
+void vtkImageAccumulateFillTables(vtkImageAccumulateParameters* params, T*)
+{
+  params->TableMinimum = static_cast<int>(vtkTypeTraits<T>::Min());
+  int tableSize = static_cast<int>(vtkTypeTraits<T>::Max()) - params->TableMinimum + 1;
+  for (int idxC = 0; idxC < params->NumberOfComponents; ++idxC)
+  {
+    params->BinTables[idxC].resize(tableSize);
+    for (int i = 0; i < tableSize; ++i)
+    {
+      params->BinTables[idxC][i] =
+        vtkImageAccumulateBinOffset(*params, idxC, static_cast<double>(params->TableMinimum + i));
+    }
+  }
 }
 
+} // end anonymous namespace
+
 //----------------------------------------------------------------------------
 // This method is passed a input and output Data, and executes the filter
-// algorithm to fill the output from the input.
-// It just executes a switch statement to call the correct function for
-// the Datas data types.
+// algorithm to fill the output from the input.  The rows of the input are
+// accumulated by several threads, each into its own histogram, and the
+// histograms are summed at the end.  The rows are split into a few passes so
+// that this thread can report the progress and check for an abort between
+// them.
 int vtkImageAccumulate::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  void* inPtr;
-  void* outPtr;
-
   // get the input
   vtkInformation* in1Info = inputVector[0]->GetInformationObject(0);
   vtkImageData* inData = vtkImageData::SafeDownCast(in1Info->Get(vtkDataObject::DATA_OBJECT()));
@@ -272,41 +357,193 @@ int vtkImageAccumulate::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDebugMacro(<< "Executing image accumulate");
 
   // We need to allocate our own scalars since we are overriding
-  // the superclasses "Execute()" method.
+  // the superclasses "Execute()" method.  The sparse histogram has
+  // no image.
   outData->SetExtent(outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()));
-  outData->AllocateScalars(outInfo);
-
-  vtkDataArray* inArray = this->GetInputArrayToProcess(0, inputVector);
-  inPtr = inData->GetArrayPointerForExtent(inArray, uExt);
-  outPtr = outData->GetScalarPointer();
+  if (!this->SparseOutput)
+  {
+    outData->AllocateScalars(outInfo);
+  }
+  else
+  {
+    outData->GetPointData()->Initialize();
+  }
+  this->SparseBinIndices->Initialize();
+  this->SparseBinIndices->SetNumberOfComponents(3);
+  this->SparseBinCounts->Initialize();
 
   // Components turned into x, y and z
-  if (inData->GetNumberOfScalarComponents() > 3)
+  int numC = inData->GetNumberOfScalarComponents();
+  if (numC > 3)
   {
     vtkErrorMacro("This filter can handle up to 3 components");
     return 0;
   }
 
   // this filter expects that output is type int.
-  if (outData->GetScalarType() != VTK_ID_TYPE)
+  if (!this->SparseOutput && outData->GetScalarType() != VTK_ID_TYPE)
   {
     vtkErrorMacro(<< "Execute: out ScalarType " << outData->GetScalarType()
                   << " must be vtkIdType\n");
     return 0;
   }
 
-  int retVal = 0;
+  vtkImageAccumulateParameters params;
+  params.Input = inData;
+  params.Stencil = this->GetStencil();
+  std::copy(uExt, uExt + 6, params.UpdateExtent);
+  params.NumberOfComponents = numC;
+  params.NumberOfBins = 1;
+  for (int idx = 0; idx < 3; ++idx)
+  {
+    params.Origin[idx] = this->ComponentOrigin[idx];
+    params.Spacing[idx] = this->ComponentSpacing[idx];
+    params.BinExtent[2 * idx] = this->ComponentExtent[2 * idx];
+    params.BinExtent[2 * idx + 1] = this->ComponentExtent[2 * idx + 1];
+    params.BinIncrements[idx] = params.NumberOfBins;
+    params.NumberOfBins *=
+      std::max(this->ComponentExtent[2 * idx + 1] - this->ComponentExtent[2 * idx] + 1, 0);
+  }
+  params.ReverseStencil = (this->ReverseStencil != 0);
+  params.IgnoreZero = (this->IgnoreZero != 0);
+  params.Sparse = (this->SparseOutput != 0);
+  params.TableMinimum = 0;
+
+  // check the type here, since the threads cannot report an error
   switch (inData->GetScalarType())
   {
-    vtkTemplateMacro(retVal = vtkImageAccumulateExecute(this, inData, static_cast<VTK_TT*>(inPtr),
-                       outData, static_cast<vtkIdType*>(outPtr), this->Min, this->Max, this->Mean,
-                       this->StandardDeviation, &this->VoxelCount, uExt));
+    vtkTemplateMacro(params.Execute = &vtkImageAccumulateExecute<VTK_TT>);
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
       return 0;
   }
 
-  return retVal;
+  // the bins of 8 and 16 bit integer values are looked up in tables
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacroCase(VTK_CHAR, char,
+      vtkImageAccumulateFillTables(&params, static_cast<VTK_TT*>(nullptr)));
+    vtkTemplateMacroCase(VTK_SIGNED_CHAR, signed char,
+      vtkImageAccumulateFillTables(&params, static_cast<VTK_TT*>(nullptr)));
+    vtkTemplateMacroCase(VTK_UNSIGNED_CHAR, unsigned char,
+      vtkImageAccumulateFillTables(&params, static_cast<VTK_TT*>(nullptr)));
+    vtkTemplateMacroCase(VTK_SHORT, short,
+      vtkImageAccumulateFillTables(&params, static_cast<VTK_TT*>(nullptr)));
+    vtkTemplateMacroCase(VTK_UNSIGNED_SHORT, unsigned short,
+      vtkImageAccumulateFillTables(&params, static_cast<VTK_TT*>(nullptr)));
+    default:
+      break;
+  }
+
+  vtkImageAccumulateFunctor functor(params);
+  vtkIdType numRows = 0;
+  if (uExt[0] <= uExt[1] && uExt[2] <= uExt[3] && uExt[4] <= uExt[5])
+  {
+    numRows = static_cast<vtkIdType>(uExt[3] - uExt[2] + 1) * (uExt[5] - uExt[4] + 1);
+  }
+  const vtkIdType numPasses = std::min(numRows, static_cast<vtkIdType>(10));
+  vtkIdType begin = 0;
+  for (vtkIdType pass = 1; pass <= numPasses && !this->AbortExecute; ++pass)
+  {
+    vtkIdType end = numRows * pass / numPasses;
+    vtkSMPTools::For(begin, end, functor);
+    begin = end;
+    this->UpdateProgress(static_cast<double>(pass) / numPasses);
+  }
+
+  // sum the histograms and the statistics of the threads
+  double sum[3] = { 0.0, 0.0, 0.0 };
+  double sumSqr[3] = { 0.0, 0.0, 0.0 };
+  for (int idxC = 0; idxC < 3; ++idxC)
+  {
+    this->Min[idxC] = VTK_DOUBLE_MAX;
+    this->Max[idxC] = VTK_DOUBLE_MIN;
+  }
+  this->VoxelCount = 0;
+  vtkIdType* outPtr = nullptr;
+  if (!this->SparseOutput)
+  {
+    outPtr = static_cast<vtkIdType*>(outData->GetScalarPointer());
+    std::fill(outPtr, outPtr + params.NumberOfBins, 0);
+  }
+  std::unordered_map<vtkIdType, vtkIdType> sparseBins;
+  for (vtkImageAccumulateThreadData& data : functor.ThreadData)
+  {
+    if (outPtr)
+    {
+      for (vtkIdType j = 0; j < params.NumberOfBins; ++j)
+      {
+        outPtr[j] += data.Bins[j];
+      }
+    }
+    else if (sparseBins.empty())
+    {
+      sparseBins.swap(data.SparseBins);
+    }
+    else
+    {
+      for (const auto& bin : data.SparseBins)
+      {
+        sparseBins[bin.first] += bin.second;
+      }
+    }
+    for (int idxC = 0; idxC < 3; ++idxC)
+    {
+      sum[idxC] += data.Sum[idxC];
+      sumSqr[idxC] += data.SumSqr[idxC];
+      this->Min[idxC] = std::min(this->Min[idxC], data.Min[idxC]);
+      this->Max[idxC] = std::max(this->Max[idxC], data.Max[idxC]);
+    }
+    this->VoxelCount += data.VoxelCount;
+  }
+
+  // list the bins of the sparse histogram in the order of the image
+  if (this->SparseOutput)
+  {
+    std::vector<std::pair<vtkIdType, vtkIdType> > bins(sparseBins.begin(), sparseBins.end());
+    std::sort(bins.begin(), bins.end());
+    this->SparseBinIndices->SetNumberOfTuples(static_cast<vtkIdType>(bins.size()));
+    this->SparseBinCounts->SetNumberOfValues(static_cast<vtkIdType>(bins.size()));
+    vtkIdType nx = params.BinIncrements[1];
+    vtkIdType nxy = params.BinIncrements[2];
+    for (size_t i = 0; i < bins.size(); ++i)
+    {
+      vtkIdType binId = bins[i].first;
+      vtkIdType idx[3] = { this->ComponentExtent[0] + binId % nx,
+        this->ComponentExtent[2] + (binId / nx) % (nxy / nx),
+        this->ComponentExtent[4] + binId / nxy };
+      this->SparseBinIndices->SetTypedTuple(static_cast<vtkIdType>(i), idx);
+      this->SparseBinCounts->SetValue(static_cast<vtkIdType>(i), bins[i].second);
+    }
+  }
+
+  // initialize the statistics
+  for (int idxC = 0; idxC < 3; ++idxC)
+  {
+    this->Mean[idxC] = 0;
+    this->StandardDeviation[idxC] = 0;
+  }
+
+  if (this->VoxelCount != 0) // avoid the div0
+  {
+    double n = static_cast<double>(this->VoxelCount);
+    for (int idxC = 0; idxC < 3; ++idxC)
+    {
+      this->Mean[idxC] = sum[idxC] / n;
+    }
+
+    if (this->VoxelCount - 1 != 0) // avoid the div0
+    {
+      double m = static_cast<double>(this->VoxelCount - 1);
+      for (int idxC = 0; idxC < 3; ++idxC)
+      {
+        this->StandardDeviation[idxC] =
+          sqrt((sumSqr[idxC] - this->Mean[idxC] * this->Mean[idxC] * n) / m);
+      }
+    }
+  }
+
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -381,6 +618,9 @@ void vtkImageAccumulate::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Stencil: " << this->GetStencil() << "\n";
   os << indent << "ReverseStencil: " << (this->ReverseStencil ? "On\n" : "Off\n");
   os << indent << "IgnoreZero: " << (this->IgnoreZero ? "On" : "Off") << "\n";
+  os << indent << "SparseOutput: " << (this->SparseOutput ? "On" : "Off") << "\n";
+  os << indent << "SparseBinIndices: " << this->SparseBinIndices << "\n";
+  os << indent << "SparseBinCounts: " << this->SparseBinCounts << "\n";
 
   os << indent << "ComponentOrigin: ( " << this->ComponentOrigin[0] << ", "
      << this->ComponentOrigin[1] << ", " << this->ComponentOrigin[2] << " )\n";
@@ -32,6 +32,13 @@
  * option with vtkImageMask may result in results being slightly off since 0
  * could be a valid value from your input.
  *
+ * The rows of the input are accumulated by several threads, each into its
+ * own histogram, and the bins of 8 and 16 bit integer values are looked up
+ * in tables.  For joint histograms with many bins, SparseOutput keeps only
+ * the bins that are not empty, in a hash table for each thread.  The rows
+ * are accumulated in a few passes, between which the progress is reported
+ * and AbortExecute is checked.
+ *
  */
 
 #ifndef vtkImageAccumulate_h
@@ -40,6 +47,7 @@
 #include "vtkImageAlgorithm.h"
 #include "vtkImagingStatisticsModule.h" // For export macro
 
+class vtkIdTypeArray;
 class vtkImageStencilData;
 
 class VTKIMAGINGSTATISTICS_EXPORT vtkImageAccumulate : public vtkImageAlgorithm
@@ -134,6 +142,32 @@ public:
   vtkBooleanMacro(IgnoreZero, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Produce a sparse histogram instead of an image of bins.  The output
+   * image then has the extent of the bins but no scalars, and the bins
+   * that are not empty are given by GetSparseBinIndices() and
+   * GetSparseBinCounts().  This is useful for joint histograms of two or
+   * three components, whose number of bins is the product of the number
+   * of bins of each component.  Initial value is false.
+   */
+  vtkSetMacro(SparseOutput, vtkTypeBool);
+  vtkGetMacro(SparseOutput, vtkTypeBool);
+  vtkBooleanMacro(SparseOutput, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Get the sparse histogram after the execution of the filter, with
+   * SparseOutput on.  The indices have three components, the bin index for
+   * each component within the ComponentExtent, and are sorted in the order
+   * of the points of the image of bins.  The counts are the number of
+   * pixels in each of these bins.
+   */
+  vtkIdTypeArray* GetSparseBinIndices() { return this->SparseBinIndices; }
+  vtkIdTypeArray* GetSparseBinCounts() { return this->SparseBinCounts; }
+  //@}
+
 protected:
   vtkImageAccumulate();
   ~vtkImageAccumulate() override;
@@ -156,6 +190,10 @@ protected:
 
   vtkTypeBool ReverseStencil;
 
+  vtkTypeBool SparseOutput;
+  vtkIdTypeArray* SparseBinIndices;
+  vtkIdTypeArray* SparseBinCounts;
+
   int FillInputPortInformation(int port, vtkInformation* info) override;
 
 private: